@@ -0,0 +1,65 @@
+// SPDX-FileCopyrightText: 2026 TypeCombinator <typecombinator@foxmail.com>
+//
+// SPDX-License-Identifier: BSD 3-Clause
+
+#include <kon/adaptive_mutex.hpp>
+#include <kon/xt/pause.hpp>
+#ifdef __linux__
+    #include <linux/futex.h>
+    #include <sys/syscall.h>
+    #include <unistd.h>
+#endif
+
+namespace kon {
+namespace {
+// Sleeps while the word is value, the wakeups may be spurious.
+void futex_wait(std::atomic<std::uint32_t> &word, std::uint32_t value) noexcept {
+#ifdef __linux__
+    ::syscall(SYS_futex, &word, FUTEX_WAIT_PRIVATE, value, nullptr, nullptr, 0);
+#else
+    word.wait(value, std::memory_order_relaxed);
+#endif
+}
+
+void futex_wake_one(std::atomic<std::uint32_t> &word) noexcept {
+#ifdef __linux__
+    ::syscall(SYS_futex, &word, FUTEX_WAKE_PRIVATE, 1, nullptr, nullptr, 0);
+#else
+    word.notify_one();
+#endif
+}
+} // namespace
+
+void adaptive_mutex::lock_slow() noexcept {
+    // Spins while the holder runs, not once there are sleepers, the lock is held long then.
+    std::uint32_t spent = 0;
+    std::uint32_t pauses = 1;
+    while (spent < m_spin_pauses) {
+        std::uint32_t state = m_state.load(std::memory_order_relaxed);
+        if (state == 0) {
+            if (m_state.compare_exchange_weak(
+                    state, 1, std::memory_order_acquire, std::memory_order_relaxed)) {
+                return;
+            }
+        } else if (state == 2) {
+            break;
+        }
+        for (std::uint32_t i = 0; i < pauses; i++) {
+            rt::pause();
+        }
+        spent += pauses;
+        if (pauses < 64) {
+            pauses *= 2;
+        }
+    }
+    // Marked 2 from here on, the one taking it may leave sleepers behind, so its unlock wakes.
+    while (m_state.exchange(2, std::memory_order_acquire) != 0) {
+        futex_wait(m_state, 2);
+    }
+}
+
+void adaptive_mutex::wake_one() noexcept {
+    futex_wake_one(m_state);
+}
+
+} // namespace kon
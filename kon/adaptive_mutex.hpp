@@ -0,0 +1,60 @@
+// SPDX-FileCopyrightText: 2026 TypeCombinator <typecombinator@foxmail.com>
+//
+// SPDX-License-Identifier: BSD 3-Clause
+
+#ifndef ADAPTIVE_MUTEX_8EDC1E21_E2DA_4F1B_A273_E269DC486529
+#define ADAPTIVE_MUTEX_8EDC1E21_E2DA_4F1B_A273_E269DC486529
+#include <kon/xt/attributes.hpp>
+#include <atomic>
+#include <cstdint>
+
+namespace kon {
+
+// A mutex on a futex word, it spins with a pause backoff for spin_pauses pauses, then sleeps in
+// the kernel. The word is 0 when it's free, 1 when it's held and 2 when it's held and there may
+// be sleepers, so unlock() makes a syscall only if someone sleeps (Drepper, "Futexes Are
+// Tricky"). A short critical section is waited out by spinning, a long one costs no CPU.
+// It's a drop-in for std::mutex, without the ownership checks.
+class adaptive_mutex {
+   public:
+    // About a context switch on current cores.
+    static constexpr std::uint32_t default_spin_pauses = 256;
+
+    constexpr adaptive_mutex() noexcept = default;
+
+    constexpr explicit adaptive_mutex(std::uint32_t spin_pauses) noexcept
+        : m_spin_pauses{spin_pauses} {
+    }
+
+    KON_DISALLOW_COPY(adaptive_mutex);
+    KON_DISALLOW_MOVE(adaptive_mutex);
+
+    void lock() noexcept {
+        std::uint32_t expected = 0;
+        if (!m_state.compare_exchange_strong(
+                expected, 1, std::memory_order_acquire, std::memory_order_relaxed)) [[unlikely]] {
+            lock_slow();
+        }
+    }
+
+    bool try_lock() noexcept {
+        std::uint32_t expected = 0;
+        return m_state.compare_exchange_strong(
+            expected, 1, std::memory_order_acquire, std::memory_order_relaxed);
+    }
+
+    void unlock() noexcept {
+        if (m_state.exchange(0, std::memory_order_release) == 2) [[unlikely]] {
+            wake_one();
+        }
+    }
+   private:
+    void lock_slow() noexcept;
+    void wake_one() noexcept;
+
+    std::atomic<std::uint32_t> m_state{0};
+    std::uint32_t m_spin_pauses{default_spin_pauses};
+};
+
+} // namespace kon
+#endif // adaptive_mutex.hpp
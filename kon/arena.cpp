@@ -0,0 +1,81 @@
+// SPDX-FileCopyrightText: 2026 TypeCombinator <typecombinator@foxmail.com>
+//
+// SPDX-License-Identifier: BSD 3-Clause
+
+#include <kon/arena.hpp>
+
+namespace kon {
+namespace {
+constexpr std::size_t chunk_alignment = 64;
+constexpr std::size_t chunk_header_size =
+    (sizeof(arena::chunk) + chunk_alignment - 1) & ~(chunk_alignment - 1);
+} // namespace
+
+void *arena::allocate_slow(std::size_t size, std::size_t alignment) noexcept {
+    // Move along the chunks kept by reset() / rewind() first.
+    while ((m_current != nullptr) && (m_current->next != nullptr)) {
+        m_current = m_current->next;
+        m_ptr = m_current->va;
+        auto p = fit(m_current, m_ptr, size, alignment);
+        if (p != nullptr) {
+            m_ptr = p + size;
+            return p;
+        }
+    }
+    if (!m_grow) {
+        return nullptr;
+    }
+    std::size_t chunk_size = m_chunk_size;
+    if (chunk_size < (size + alignment)) {
+        chunk_size = size + alignment;
+    }
+    void *memory = ::operator new(
+        chunk_header_size + chunk_size,
+        std::align_val_t{chunk_alignment},
+        std::nothrow);
+    if (memory == nullptr) {
+        return nullptr;
+    }
+    auto c = static_cast<chunk *>(memory);
+    c->next = nullptr;
+    c->va = static_cast<std::uint8_t *>(memory) + chunk_header_size;
+    c->iova = reinterpret_cast<std::uintptr_t>(c->va);
+    c->size = chunk_size;
+    if (m_current == nullptr) {
+        m_head = c;
+    } else {
+        m_current->next = c;
+    }
+    m_current = c;
+    auto p = fit(c, c->va, size, alignment);
+    m_ptr = p + size;
+    return p;
+}
+
+void arena::release() noexcept {
+    chunk *c = m_head;
+    if (c == &m_region) {
+        c = m_region.next;
+        m_region.next = nullptr;
+    } else {
+        m_head = nullptr;
+    }
+    while (c != nullptr) {
+        chunk *next = c->next;
+        ::operator delete(c, std::align_val_t{chunk_alignment});
+        c = next;
+    }
+    reset();
+}
+
+std::uintptr_t arena::iova(const void *p) const noexcept {
+    auto addr = static_cast<const std::uint8_t *>(p);
+    for (const chunk *c = m_head; c != nullptr; c = c->next) {
+        if ((addr >= c->va) && (addr < (c->va + c->size))) {
+            return c->iova + (addr - c->va);
+        }
+    }
+    return 0;
+}
+
+} // namespace kon
@@ -0,0 +1,176 @@
+// SPDX-FileCopyrightText: 2026 TypeCombinator <typecombinator@foxmail.com>
+//
+// SPDX-License-Identifier: BSD 3-Clause
+
+#ifndef ARENA_F23A4DE7_577F_4C4E_A130_F176EEF63EA1
+#define ARENA_F23A4DE7_577F_4C4E_A130_F176EEF63EA1
+#include <kon/dbuf.hpp>
+#include <kon/xt/attributes.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+
+namespace kon {
+
+// Bump allocator over a chain of chunks, the memory is given back all at once by reset() or
+// rewind(). The heap chunks have an iova equal to their va (like the IOVA as VA mode of DPDK), a
+// borrowed region keeps its own iova.
+class arena {
+   public:
+    static constexpr std::size_t default_chunk_size = 64 * 1024;
+
+    struct chunk {
+        chunk *next;
+        std::uint8_t *va;
+        std::uintptr_t iova;
+        std::size_t size;
+    };
+
+    struct marker {
+        chunk *current;
+        std::uint8_t *ptr;
+    };
+
+    explicit arena(std::size_t chunk_size = default_chunk_size) noexcept
+        : m_chunk_size{chunk_size}
+        , m_grow{true} {
+    }
+
+    // The region is used first, then the heap chunks if grow is true.
+    arena(
+        std::uint8_t *va,
+        std::uintptr_t iova,
+        std::size_t size,
+        bool grow = false,
+        std::size_t chunk_size = default_chunk_size) noexcept
+        : m_region{nullptr, va, iova, size}
+        , m_head{&m_region}
+        , m_current{&m_region}
+        , m_ptr{va}
+        , m_chunk_size{chunk_size}
+        , m_grow{grow} {
+    }
+
+    ~arena() noexcept {
+        release();
+    }
+
+    KON_DISALLOW_COPY(arena);
+    KON_DISALLOW_MOVE(arena);
+
+    // Returns nullptr when the arena is exhausted and can't grow.
+    void *allocate(std::size_t size, std::size_t alignment = alignof(std::max_align_t)) noexcept {
+        if (m_current != nullptr) [[likely]] {
+            auto p = fit(m_current, m_ptr, size, alignment);
+            if (p != nullptr) [[likely]] {
+                m_ptr = p + size;
+                return p;
+            }
+        }
+        return allocate_slow(size, alignment);
+    }
+
+    // A dbuf over a new buffer of size bytes.
+    bool allocate(
+        dbuf &buf,
+        std::uint32_t size,
+        std::uint32_t headroom = 0,
+        std::size_t alignment = 64) noexcept {
+        auto va = static_cast<std::uint8_t *>(allocate(size, alignment));
+        if (va == nullptr) [[unlikely]] {
+            return false;
+        }
+        buf.init(va, m_current->iova + (va - m_current->va), headroom, size);
+        return true;
+    }
+
+    marker mark() const noexcept {
+        return {m_current, m_ptr};
+    }
+
+    // Frees everything allocated since the marker, the chunks are kept for reuse.
+    void rewind(const marker &point) noexcept {
+        if (point.current == nullptr) {
+            reset();
+            return;
+        }
+        m_current = point.current;
+        m_ptr = point.ptr;
+    }
+
+    // Frees everything, the chunks are kept for reuse.
+    void reset() noexcept {
+        m_current = m_head;
+        m_ptr = (m_head != nullptr) ? m_head->va : nullptr;
+    }
+
+    // Frees everything and gives the heap chunks back.
+    void release() noexcept;
+
+    // The iova of an address allocated from the arena, 0 if it isn't.
+    std::uintptr_t iova(const void *p) const noexcept;
+   private:
+    // The aligned address of size bytes from ptr in the chunk, nullptr if they don't fit.
+    static std::uint8_t *fit(
+        const chunk *c,
+        std::uint8_t *ptr,
+        std::size_t size,
+        std::size_t alignment) noexcept {
+        auto addr = reinterpret_cast<std::uintptr_t>(ptr);
+        auto aligned = (addr + alignment - 1) & ~(alignment - 1);
+        auto end = reinterpret_cast<std::uintptr_t>(c->va) + c->size;
+        if ((aligned > end) || ((end - aligned) < size)) {
+            return nullptr;
+        }
+        return ptr + (aligned - addr);
+    }
+
+    void *allocate_slow(std::size_t size, std::size_t alignment) noexcept;
+
+    chunk m_region{};
+    chunk *m_head{nullptr};
+    chunk *m_current{nullptr};
+    std::uint8_t *m_ptr{nullptr};
+    std::size_t m_chunk_size;
+    bool m_grow;
+};
+
+// Standard allocator over an arena, deallocate() does nothing.
+template <typename T>
+class arena_allocator {
+   public:
+    using value_type = T;
+
+    explicit arena_allocator(arena &a) noexcept
+        : m_arena{&a} {
+    }
+
+    template <typename U>
+    arena_allocator(const arena_allocator<U> &other) noexcept
+        : m_arena{other.m_arena} {
+    }
+
+    T *allocate(std::size_t n) {
+        void *p = m_arena->allocate(n * sizeof(T), alignof(T));
+        if (p == nullptr) {
+            throw std::bad_alloc();
+        }
+        return static_cast<T *>(p);
+    }
+
+    void deallocate(T *, std::size_t) noexcept {
+    }
+
+    template <typename U>
+    bool operator==(const arena_allocator<U> &other) const noexcept {
+        return m_arena == other.m_arena;
+    }
+   private:
+    template <typename U>
+    friend class arena_allocator;
+
+    arena *m_arena;
+};
+
+} // namespace kon
+#endif // arena.hpp
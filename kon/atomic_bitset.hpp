@@ -0,0 +1,155 @@
+// SPDX-FileCopyrightText: 2026 TypeCombinator <typecombinator@foxmail.com>
+//
+// SPDX-License-Identifier: BSD 3-Clause
+
+#ifndef ATOMIC_BITSET_881254E2_979E_45AF_828F_BF3BC6AF7871
+#define ATOMIC_BITSET_881254E2_979E_45AF_828F_BF3BC6AF7871
+#include <kon/bit.hpp>
+#include <kon/pool.hpp>
+#include <kon/xt/attributes.hpp>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+
+namespace kon {
+
+// A bitset of slots shared by threads, a set bit is a taken slot. A slot is taken by fetch_or and
+// given back by fetch_and, no lock is held.
+// The words are grouped by cache lines, every thread slot (see thread_slot()) starts its search
+// from the line it last took a slot from, the threads are spread over the lines at first, so
+// they rarely contend on a line while there are free slots.
+class atomic_bitset {
+   public:
+    using word_type = std::uint64_t;
+    static constexpr std::size_t word_bits = 64;
+    static constexpr std::size_t line_words = 8;
+    static constexpr std::size_t npos = ~std::size_t{0};
+
+    atomic_bitset() noexcept = default;
+
+    ~atomic_bitset() noexcept {
+        release_storage();
+    }
+
+    KON_DISALLOW_COPY(atomic_bitset);
+    KON_DISALLOW_MOVE(atomic_bitset);
+
+    // All the slots are free after it, it's not thread-safe. Returns false if the allocation
+    // fails, the bitset is unchanged then.
+    bool init(std::size_t size) noexcept {
+        std::size_t line_bits = line_words * word_bits;
+        std::size_t word_count = (size + line_bits - 1) / line_bits * line_words;
+        std::atomic<word_type> *words = nullptr;
+        if (word_count != 0) {
+            words = static_cast<std::atomic<word_type> *>(::operator new(
+                word_count * sizeof(std::atomic<word_type>),
+                std::align_val_t{64},
+                std::nothrow));
+            if (words == nullptr) {
+                return false;
+            }
+        }
+        release_storage();
+        for (std::size_t i = 0; i < word_count; i++) {
+            // The bits past size are taken for good.
+            std::size_t begin = i * word_bits;
+            word_type e = 0;
+            if (begin >= size) {
+                e = ~word_type{0};
+            } else if ((size - begin) < word_bits) {
+                e = ~word_type{0} << (size - begin);
+            }
+            new (words + i) std::atomic<word_type>{e};
+        }
+        m_words = words;
+        m_size = size;
+        m_word_count = word_count;
+        std::size_t lines = word_count / line_words;
+        for (std::size_t s = 0; s < pool::max_thread_slots; s++) {
+            m_hints[s].word = (lines != 0) ? (s * lines / pool::max_thread_slots * line_words) : 0;
+        }
+        return true;
+    }
+
+    [[nodiscard]]
+    std::size_t size() const noexcept {
+        return m_size;
+    }
+
+    // Takes the slot pos, false if it's taken already.
+    bool try_set(std::size_t pos) noexcept {
+        word_type bit = word_type{1} << (pos % word_bits);
+        return (m_words[pos / word_bits].fetch_or(bit, std::memory_order_acquire) & bit) == 0;
+    }
+
+    // Gives the slot pos back.
+    void release(std::size_t pos) noexcept {
+        word_type bit = word_type{1} << (pos % word_bits);
+        m_words[pos / word_bits].fetch_and(~bit, std::memory_order_release);
+    }
+
+    [[nodiscard]]
+    bool test(std::size_t pos) const noexcept {
+        return (m_words[pos / word_bits].load(std::memory_order_acquire) >> (pos % word_bits)) & 1;
+    }
+
+    // Takes a free slot, the first one at or after the hint of the calling thread, wrapping
+    // around. Returns npos if all the slots are taken.
+    std::size_t acquire_first_free() noexcept {
+        if (m_word_count == 0) [[unlikely]] {
+            return npos;
+        }
+        int slot = thread_slot();
+        std::size_t start = (slot >= 0) ? m_hints[slot].word : 0;
+        std::size_t y = start;
+        do {
+            word_type e = m_words[y].load(std::memory_order_relaxed);
+            while (~e != 0) {
+                word_type bit = word_type{1} << kon::countr_zero<word_type, true>(~e);
+                e = m_words[y].fetch_or(bit, std::memory_order_acquire);
+                if ((e & bit) == 0) {
+                    if (slot >= 0) {
+                        m_hints[slot].word = y;
+                    }
+                    return y * word_bits + kon::countr_zero<word_type, true>(bit);
+                }
+            }
+            if (++y == m_word_count) {
+                y = 0;
+            }
+        } while (y != start);
+        return npos;
+    }
+
+    // The number of taken slots, a snapshot with concurrent users.
+    [[nodiscard]]
+    std::size_t count() const noexcept {
+        std::size_t count = 0;
+        for (std::size_t i = 0; i < m_word_count; i++) {
+            count += kon::popcount(m_words[i].load(std::memory_order_relaxed));
+        }
+        return count - (m_word_count * word_bits - m_size);
+    }
+   private:
+    struct alignas(64) hint {
+        std::size_t word;
+    };
+
+    void release_storage() noexcept {
+        if (m_words != nullptr) {
+            ::operator delete(m_words, std::align_val_t{64});
+            m_words = nullptr;
+        }
+        m_size = 0;
+        m_word_count = 0;
+    }
+
+    std::atomic<word_type> *m_words{nullptr};
+    std::size_t m_size{0};
+    std::size_t m_word_count{0};
+    hint m_hints[pool::max_thread_slots]{}; // A hint per thread slot, only its thread writes it.
+};
+
+} // namespace kon
+#endif // atomic_bitset.hpp
@@ -3,6 +3,13 @@
 // SPDX-License-Identifier: BSD 3-Clause
 
 #include <kon/base16.hpp>
+#include <kon/xt/cpu.hpp>
+#include <cstring>
+#if defined(KON_ARCH_X86)
+    #include <immintrin.h>
+#elif defined(KON_ARCH_ARM64)
+    #include <arm_neon.h>
+#endif
 
 namespace kon {
 
@@ -63,34 +70,274 @@ const uint8_t base16_decode_table[256] = {
     0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
 };
 
-std::size_t base16_decode(
-    const char *str,
+static const char base16_lower_alphabet[17] = "0123456789abcdef";
+
+#if defined(KON_ARCH_X86)
+KON_ATTR_TARGET("ssse3")
+static std::size_t base16_encode_ssse3(
+    const std::uint8_t *data,
+    std::size_t size,
+    char *str,
+    const void *alphabet) noexcept {
+    const __m128i lut = _mm_loadu_si128(static_cast<const __m128i *>(alphabet));
+    const __m128i mask = _mm_set1_epi8(0x0F);
+    std::size_t i = 0;
+    for (; i + 16 <= size; i += 16) {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + i));
+        __m128i high = _mm_shuffle_epi8(lut, _mm_and_si128(_mm_srli_epi16(v, 4), mask));
+        __m128i low = _mm_shuffle_epi8(lut, _mm_and_si128(v, mask));
+        auto out = reinterpret_cast<__m128i *>(str + i * 2);
+        _mm_storeu_si128(out, _mm_unpacklo_epi8(high, low));
+        _mm_storeu_si128(out + 1, _mm_unpackhi_epi8(high, low));
+    }
+    return i;
+}
+
+KON_ATTR_TARGET("avx2")
+static std::size_t base16_encode_avx2(
+    const std::uint8_t *data,
+    std::size_t size,
+    char *str,
+    const void *alphabet) noexcept {
+    const __m256i lut =
+        _mm256_broadcastsi128_si256(_mm_loadu_si128(static_cast<const __m128i *>(alphabet)));
+    const __m256i mask = _mm256_set1_epi8(0x0F);
+    std::size_t i = 0;
+    for (; i + 32 <= size; i += 32) {
+        __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(data + i));
+        // [q0, q1 | q2, q3] -> [q0, q2 | q1, q3], so the in-lane unpacking keeps the byte order.
+        v = _mm256_permute4x64_epi64(v, 0xD8);
+        __m256i high = _mm256_shuffle_epi8(lut, _mm256_and_si256(_mm256_srli_epi16(v, 4), mask));
+        __m256i low = _mm256_shuffle_epi8(lut, _mm256_and_si256(v, mask));
+        auto out = reinterpret_cast<__m256i *>(str + i * 2);
+        _mm256_storeu_si256(out, _mm256_unpacklo_epi8(high, low));
+        _mm256_storeu_si256(out + 1, _mm256_unpackhi_epi8(high, low));
+    }
+    return i + base16_encode_ssse3(data + i, size - i, str + i * 2, alphabet);
+}
+
+// Map 16 characters to nibbles, lanes of valid are set to 0xFF for [0-9a-fA-F].
+KON_ATTR_TARGET("ssse3")
+static inline __m128i base16_decode_nibbles_ssse3(__m128i v, __m128i &valid) noexcept {
+    __m128i digit = _mm_sub_epi8(v, _mm_set1_epi8('0'));
+    __m128i alpha = _mm_sub_epi8(_mm_or_si128(v, _mm_set1_epi8(0x20)), _mm_set1_epi8('a'));
+    __m128i is_digit = _mm_cmpeq_epi8(_mm_min_epu8(digit, _mm_set1_epi8(9)), digit);
+    __m128i is_alpha = _mm_cmpeq_epi8(_mm_min_epu8(alpha, _mm_set1_epi8(5)), alpha);
+    valid = _mm_or_si128(is_digit, is_alpha);
+    return _mm_or_si128(
+        _mm_and_si128(is_digit, digit),
+        _mm_andnot_si128(is_digit, _mm_add_epi8(alpha, _mm_set1_epi8(10))));
+}
+
+KON_ATTR_TARGET("ssse3")
+static std::size_t
+    base16_decode_ssse3(const char *str, std::uint8_t *data, std::size_t size) noexcept {
+    // (high << 4) | low of each character pair.
+    const __m128i weight = _mm_set1_epi16(0x0110);
+    std::size_t i = 0;
+    for (; i + 16 <= size; i += 16) {
+        auto in = reinterpret_cast<const __m128i *>(str + i * 2);
+        __m128i valid0, valid1;
+        __m128i n0 = base16_decode_nibbles_ssse3(_mm_loadu_si128(in), valid0);
+        __m128i n1 = base16_decode_nibbles_ssse3(_mm_loadu_si128(in + 1), valid1);
+        if (_mm_movemask_epi8(_mm_and_si128(valid0, valid1)) != 0xFFFF) [[unlikely]] {
+            break; // Leave the block to the scalar code, it knows where to stop.
+        }
+        __m128i v = _mm_packus_epi16(_mm_maddubs_epi16(n0, weight), _mm_maddubs_epi16(n1, weight));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(data + i), v);
+    }
+    return i;
+}
+
+KON_ATTR_TARGET("avx2")
+static inline __m256i base16_decode_nibbles_avx2(__m256i v, __m256i &valid) noexcept {
+    __m256i digit = _mm256_sub_epi8(v, _mm256_set1_epi8('0'));
+    __m256i alpha =
+        _mm256_sub_epi8(_mm256_or_si256(v, _mm256_set1_epi8(0x20)), _mm256_set1_epi8('a'));
+    __m256i is_digit = _mm256_cmpeq_epi8(_mm256_min_epu8(digit, _mm256_set1_epi8(9)), digit);
+    __m256i is_alpha = _mm256_cmpeq_epi8(_mm256_min_epu8(alpha, _mm256_set1_epi8(5)), alpha);
+    valid = _mm256_or_si256(is_digit, is_alpha);
+    return _mm256_blendv_epi8(_mm256_add_epi8(alpha, _mm256_set1_epi8(10)), digit, is_digit);
+}
+
+KON_ATTR_TARGET("avx2")
+static std::size_t
+    base16_decode_avx2(const char *str, std::uint8_t *data, std::size_t size) noexcept {
+    const __m256i weight = _mm256_set1_epi16(0x0110);
+    std::size_t i = 0;
+    for (; i + 32 <= size; i += 32) {
+        auto in = reinterpret_cast<const __m256i *>(str + i * 2);
+        __m256i valid0, valid1;
+        __m256i n0 = base16_decode_nibbles_avx2(_mm256_loadu_si256(in), valid0);
+        __m256i n1 = base16_decode_nibbles_avx2(_mm256_loadu_si256(in + 1), valid1);
+        if (_mm256_movemask_epi8(_mm256_and_si256(valid0, valid1)) != -1) [[unlikely]] {
+            break;
+        }
+        __m256i v =
+            _mm256_packus_epi16(_mm256_maddubs_epi16(n0, weight), _mm256_maddubs_epi16(n1, weight));
+        _mm256_storeu_si256(
+            reinterpret_cast<__m256i *>(data + i), _mm256_permute4x64_epi64(v, 0xD8));
+    }
+    return i + base16_decode_ssse3(str + i * 2, data + i, size - i);
+}
+#elif defined(KON_ARCH_ARM64)
+static std::size_t base16_encode_neon(
+    const std::uint8_t *data,
+    std::size_t size,
+    char *str,
+    const void *alphabet) noexcept {
+    const uint8x16_t lut = vld1q_u8(static_cast<const std::uint8_t *>(alphabet));
+    const uint8x16_t mask = vdupq_n_u8(0x0F);
+    std::size_t i = 0;
+    for (; i + 16 <= size; i += 16) {
+        uint8x16_t v = vld1q_u8(data + i);
+        uint8x16x2_t out;
+        out.val[0] = vqtbl1q_u8(lut, vshrq_n_u8(v, 4));
+        out.val[1] = vqtbl1q_u8(lut, vandq_u8(v, mask));
+        vst2q_u8(reinterpret_cast<std::uint8_t *>(str + i * 2), out);
+    }
+    return i;
+}
+
+static inline uint8x16_t base16_decode_nibbles_neon(uint8x16_t v, uint8x16_t &valid) noexcept {
+    uint8x16_t digit = vsubq_u8(v, vdupq_n_u8('0'));
+    uint8x16_t alpha = vsubq_u8(vorrq_u8(v, vdupq_n_u8(0x20)), vdupq_n_u8('a'));
+    uint8x16_t is_digit = vcltq_u8(digit, vdupq_n_u8(10));
+    valid = vorrq_u8(is_digit, vcltq_u8(alpha, vdupq_n_u8(6)));
+    return vbslq_u8(is_digit, digit, vaddq_u8(alpha, vdupq_n_u8(10)));
+}
+
+static std::size_t
+    base16_decode_neon(const char *str, std::uint8_t *data, std::size_t size) noexcept {
+    std::size_t i = 0;
+    for (; i + 16 <= size; i += 16) {
+        // De-interleave the high and low characters.
+        uint8x16x2_t in = vld2q_u8(reinterpret_cast<const std::uint8_t *>(str + i * 2));
+        uint8x16_t valid_high, valid_low;
+        uint8x16_t high = base16_decode_nibbles_neon(in.val[0], valid_high);
+        uint8x16_t low = base16_decode_nibbles_neon(in.val[1], valid_low);
+        if (vminvq_u8(vandq_u8(valid_high, valid_low)) == 0) [[unlikely]] {
+            break;
+        }
+        vst1q_u8(data + i, vorrq_u8(vshlq_n_u8(high, 4), low));
+    }
+    return i;
+}
+#endif
+
+// Returns the number of bytes encoded by SIMD, the caller handles the tail.
+static std::size_t base16_encode_simd(
+    const std::uint8_t *data,
+    std::size_t size,
+    char *str,
+    const void *alphabet) noexcept {
+#if defined(KON_ARCH_X86)
+    if (rt::cpu().avx2) {
+        return base16_encode_avx2(data, size, str, alphabet);
+    }
+    if (rt::cpu().ssse3) {
+        return base16_encode_ssse3(data, size, str, alphabet);
+    }
+    return 0;
+#elif defined(KON_ARCH_ARM64)
+    return base16_encode_neon(data, size, str, alphabet);
+#else
+    return 0;
+#endif
+}
+
+// Returns the number of bytes decoded by SIMD, it stops before the first block with an invalid
+// character.
+static std::size_t
+    base16_decode_simd(const char *str, std::uint8_t *data, std::size_t size) noexcept {
+#if defined(KON_ARCH_X86)
+    if (rt::cpu().avx2) {
+        return base16_decode_avx2(str, data, size);
+    }
+    if (rt::cpu().ssse3) {
+        return base16_decode_ssse3(str, data, size);
+    }
+    return 0;
+#elif defined(KON_ARCH_ARM64)
+    return base16_decode_neon(str, data, size);
+#else
+    return 0;
+#endif
+}
+
+std::size_t base16_encode(
+    const std::uint8_t *data,
+    std::size_t data_size,
+    char *str,
     std::size_t str_size,
+    bool upper_case) noexcept {
+    if (data_size > (str_size / 2)) {
+        data_size = str_size / 2;
+    }
+    const void *alphabet = upper_case ? static_cast<const void *>(base16_encode_table)
+                                      : static_cast<const void *>(base16_lower_alphabet);
+    std::size_t i = 0;
+    if (data_size >= 16) {
+        i = base16_encode_simd(data, data_size, str, alphabet);
+    }
+    if (upper_case) {
+        for (; i < data_size; i++) {
+            str[i * 2] = base16_encode_table[data[i] >> 4];
+            str[i * 2 + 1] = base16_encode_table[data[i] & 0x0F];
+        }
+    } else {
+        for (; i < data_size; i++) {
+            std::memcpy(str + i * 2, &base16_encode_lut2[data[i] << 1], 2);
+        }
+    }
+    return data_size * 2;
+}
+
+// Returns nullptr on error.
+static const char *base16_decode_scalar(
+    const char *str,
+    const char *str_end,
     std::uint8_t *data,
     std::size_t data_size) noexcept {
-    const char *str_org = str;
-    const char *str_end = str + str_size;
     for (; str < str_end; str++) {
         uint8_t high = kon::base16_char_decode(*str);
         if (high >= 16u) [[unlikely]] {
-            return str - str_org;
+            return str;
         }
         str++;
         if (str >= str_end) [[unlikely]] {
-            return 0;
+            return nullptr;
         }
         if (data_size == 0) [[unlikely]] {
-            return 0;
+            return nullptr;
         }
         uint8_t low = kon::base16_char_decode(*str);
         if (low >= 16u) [[unlikely]] {
-            return 0;
+            return nullptr;
         }
         *data = (high << 4) | low;
         data++;
         data_size--;
     }
-    return str - str_org;
+    return str;
+}
+
+std::size_t base16_decode(
+    const char *str,
+    std::size_t str_size,
+    std::uint8_t *data,
+    std::size_t data_size) noexcept {
+    std::size_t size = (str_size / 2 < data_size) ? (str_size / 2) : data_size;
+    std::size_t done = 0;
+    if (size >= 16) {
+        done = base16_decode_simd(str, data, size);
+    }
+    const char *str_end = base16_decode_scalar(
+        str + done * 2, str + str_size, data + done, data_size - done);
+    if (str_end == nullptr) [[unlikely]] {
+        return 0;
+    }
+    return str_end - str;
 }
 
 } // namespace kon
\ No newline at end of file
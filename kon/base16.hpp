@@ -5,6 +5,7 @@
 #ifndef BASE16_46017852_440D_4C90_9265_E30FCAC05E2E
 #define BASE16_46017852_440D_4C90_9265_E30FCAC05E2E
 #include <cstdint>
+#include <cstddef>
 
 namespace kon {
 extern const uint8_t base16_encode_table[16];
@@ -19,6 +20,15 @@ static inline std::uint8_t base16_char_decode(char c) noexcept {
     return base16_decode_table[static_cast<uint8_t>(c)];
 }
 
+// Returns the number of characters written, it's 2 * data_size if str_size is large enough,
+// otherwise only the bytes that fit in str are encoded.
+std::size_t base16_encode(
+    const std::uint8_t *data,
+    std::size_t data_size,
+    char *str,
+    std::size_t str_size,
+    bool upper_case = false) noexcept;
+
 std::size_t base16_decode(
     const char *str,
     std::size_t str_size,
@@ -0,0 +1,139 @@
+// SPDX-FileCopyrightText: 2026 TypeCombinator <typecombinator@foxmail.com>
+//
+// SPDX-License-Identifier: BSD 3-Clause
+
+#include <kon/base32.hpp>
+#include <array>
+
+namespace kon {
+
+static constexpr char base32_standard_alphabet[33] = "ABCDEFGHIJKLMNOPQRSTUVWXYZ234567";
+static constexpr char base32_hex_alphabet[33] = "0123456789ABCDEFGHIJKLMNOPQRSTUV";
+
+static constexpr std::uint8_t base32_invalid = 0xFF;
+
+static constexpr auto base32_make_decode_table(const char (&alphabet)[33]) noexcept {
+    std::array<std::uint8_t, 256> table{};
+    for (auto &e: table) {
+        e = base32_invalid;
+    }
+    for (std::uint8_t i = 0; i < 32; i++) {
+        auto c = static_cast<std::uint8_t>(alphabet[i]);
+        table[c] = i;
+        if ((c >= 'A') && (c <= 'Z')) {
+            table[c | 0x20] = i;
+        }
+    }
+    return table;
+}
+
+static constexpr auto base32_standard_decode_table =
+    base32_make_decode_table(base32_standard_alphabet);
+static constexpr auto base32_hex_decode_table = base32_make_decode_table(base32_hex_alphabet);
+
+// Number of characters for 0 ~ 5 bytes, and the reverse.
+static constexpr std::uint8_t base32_chars_of_bytes[6] = {0, 2, 4, 5, 7, 8};
+static constexpr std::int8_t base32_bytes_of_chars[9] = {0, -1, 1, -1, 2, 3, -1, 4, 5};
+
+static inline bool base32_is_hex(base32_variant variant) noexcept {
+    return (variant == base32_variant::hex) || (variant == base32_variant::hex_nopad);
+}
+
+std::size_t base32_encode(
+    const std::uint8_t *data,
+    std::size_t data_size,
+    char *str,
+    std::size_t str_size,
+    base32_variant variant) noexcept {
+    std::size_t size = base32_encoded_size(data_size, variant);
+    if (str_size < size) [[unlikely]] {
+        return 0;
+    }
+    const char *alphabet = base32_is_hex(variant) ? base32_hex_alphabet : base32_standard_alphabet;
+    std::size_t i = 0;
+    for (; i + 5 <= data_size; i += 5) {
+        std::uint64_t v = (std::uint64_t{data[i]} << 32) | (std::uint64_t{data[i + 1]} << 24)
+                        | (std::uint64_t{data[i + 2]} << 16) | (std::uint64_t{data[i + 3]} << 8)
+                        | data[i + 4];
+        for (int k = 7; k >= 0; k--) {
+            str[k] = alphabet[v & 0x1F];
+            v >>= 5;
+        }
+        str += 8;
+    }
+    std::size_t rest = data_size - i;
+    if (rest == 0) {
+        return size;
+    }
+    std::uint64_t v = 0;
+    for (std::size_t k = 0; k < 5; k++) {
+        v = (v << 8) | ((k < rest) ? data[i + k] : 0);
+    }
+    std::size_t n = base32_chars_of_bytes[rest];
+    for (std::size_t k = 0; k < n; k++) {
+        str[k] = alphabet[(v >> (35 - k * 5)) & 0x1F];
+    }
+    if (base32_is_padded(variant)) {
+        for (std::size_t k = n; k < 8; k++) {
+            str[k] = '=';
+        }
+    }
+    return size;
+}
+
+std::size_t base32_decode(
+    const char *str,
+    std::size_t str_size,
+    std::uint8_t *data,
+    std::size_t &data_size,
+    base32_variant variant) noexcept {
+    const std::uint8_t *table = base32_is_hex(variant) ? base32_hex_decode_table.data()
+                                                       : base32_standard_decode_table.data();
+    const std::size_t capacity = data_size;
+    data_size = 0;
+    std::size_t pos = 0;
+    std::size_t out = 0;
+    while (true) {
+        std::uint64_t v = 0;
+        std::size_t n = 0;
+        for (; (n < 8) && (pos + n < str_size); n++) {
+            std::uint8_t c = table[static_cast<std::uint8_t>(str[pos + n])];
+            if (c == base32_invalid) {
+                break;
+            }
+            v = (v << 5) | c;
+        }
+        if (n == 0) {
+            break;
+        }
+        int bytes = base32_bytes_of_chars[n];
+        if (bytes < 0) [[unlikely]] { // Truncated.
+            return 0;
+        }
+        if (out + bytes > capacity) [[unlikely]] {
+            return 0;
+        }
+        v <<= (8 - n) * 5;
+        for (int k = 0; k < bytes; k++) {
+            data[out + k] = static_cast<std::uint8_t>(v >> (32 - k * 8));
+        }
+        out += bytes;
+        pos += n;
+        if (n < 8) { // The last group.
+            if (base32_is_padded(variant)) {
+                for (; n < 8; n++, pos++) {
+                    if ((pos >= str_size) || (str[pos] != '=')) [[unlikely]] {
+                        return 0;
+                    }
+                }
+            } else if (pos < str_size) [[unlikely]] { // Cut by a character out of the alphabet.
+                return 0;
+            }
+            break;
+        }
+    }
+    data_size = out;
+    return pos;
+}
+
+} // namespace kon
@@ -0,0 +1,56 @@
+// SPDX-FileCopyrightText: 2026 TypeCombinator <typecombinator@foxmail.com>
+//
+// SPDX-License-Identifier: BSD 3-Clause
+
+#ifndef BASE32_29E2B965_3853_4671_8DDD_1C0F075B8B19
+#define BASE32_29E2B965_3853_4671_8DDD_1C0F075B8B19
+// References:
+// [0]: https://www.rfc-editor.org/rfc/rfc4648
+#include <cstdint>
+#include <cstddef>
+
+namespace kon {
+
+enum class base32_variant : std::uint8_t {
+    standard,       // "A-Z2-7" with "=" padding.
+    standard_nopad, // "A-Z2-7" without padding.
+    hex,            // "0-9A-V" with "=" padding, it keeps the sort order.
+    hex_nopad,      // "0-9A-V" without padding.
+};
+
+static constexpr bool base32_is_padded(base32_variant variant) noexcept {
+    return (variant == base32_variant::standard) || (variant == base32_variant::hex);
+}
+
+static constexpr std::size_t base32_encoded_size(
+    std::size_t data_size,
+    base32_variant variant = base32_variant::standard) noexcept {
+    if (base32_is_padded(variant)) {
+        return (data_size + 4) / 5 * 8;
+    }
+    return (data_size * 8 + 4) / 5;
+}
+
+// Upper bound of the decoded size.
+static constexpr std::size_t base32_decoded_size(std::size_t str_size) noexcept {
+    return str_size * 5 / 8;
+}
+
+// Returns the number of characters written, or 0 if str_size < base32_encoded_size(data_size).
+std::size_t base32_encode(
+    const std::uint8_t *data,
+    std::size_t data_size,
+    char *str,
+    std::size_t str_size,
+    base32_variant variant = base32_variant::standard) noexcept;
+
+// Same conventions as base64_decode, letters are case-insensitive.
+std::size_t base32_decode(
+    const char *str,
+    std::size_t str_size,
+    std::uint8_t *data,
+    std::size_t &data_size,
+    base32_variant variant = base32_variant::standard) noexcept;
+
+} // namespace kon
+#endif /* base32.hpp */
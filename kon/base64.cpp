@@ -0,0 +1,548 @@
+// SPDX-FileCopyrightText: 2026 TypeCombinator <typecombinator@foxmail.com>
+//
+// SPDX-License-Identifier: BSD 3-Clause
+
+#include <kon/base64.hpp>
+#include <kon/xt/cpu.hpp>
+#include <array>
+#if defined(KON_ARCH_X86)
+    #include <immintrin.h>
+#elif defined(KON_ARCH_ARM64)
+    #include <arm_neon.h>
+#endif
+
+namespace kon {
+
+static constexpr char base64_standard_alphabet[65] =
+    "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+static constexpr char base64_url_alphabet[65] =
+    "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789-_";
+
+static constexpr std::uint8_t base64_invalid = 0xFF;
+
+static constexpr auto base64_make_decode_table(const char (&alphabet)[65]) noexcept {
+    std::array<std::uint8_t, 256> table{};
+    for (auto &e: table) {
+        e = base64_invalid;
+    }
+    for (std::uint8_t i = 0; i < 64; i++) {
+        table[static_cast<std::uint8_t>(alphabet[i])] = i;
+    }
+    return table;
+}
+
+alignas(64) static constexpr auto base64_standard_decode_table =
+    base64_make_decode_table(base64_standard_alphabet);
+alignas(64) static constexpr auto base64_url_decode_table =
+    base64_make_decode_table(base64_url_alphabet);
+
+static inline const char *base64_alphabet(base64_variant variant) noexcept {
+    return base64_is_url(variant) ? base64_url_alphabet : base64_standard_alphabet;
+}
+
+static inline const std::uint8_t *base64_decode_table(base64_variant variant) noexcept {
+    return base64_is_url(variant) ? base64_url_decode_table.data()
+                                  : base64_standard_decode_table.data();
+}
+
+#if defined(KON_ARCH_X86)
+// 24 bytes -> 32 characters per iteration, see [1].
+KON_ATTR_TARGET("avx2")
+static std::size_t base64_encode_avx2(
+    const std::uint8_t *data,
+    std::size_t size,
+    char *str,
+    bool is_url) noexcept {
+    const __m256i shuffle = _mm256_setr_epi8(
+        1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10, //
+        1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10);
+    const char c62 = is_url ? '-' : '+';
+    const char c63 = is_url ? '_' : '/';
+    const __m128i shift = _mm_setr_epi8(
+        'a' - 26,
+        '0' - 52,
+        '0' - 52,
+        '0' - 52,
+        '0' - 52,
+        '0' - 52,
+        '0' - 52,
+        '0' - 52,
+        '0' - 52,
+        '0' - 52,
+        '0' - 52,
+        static_cast<char>(c62 - 62),
+        static_cast<char>(c63 - 63),
+        'A',
+        0,
+        0);
+    const __m256i shift_lut = _mm256_broadcastsi128_si256(shift);
+    std::size_t i = 0;
+    char *out = str;
+    // Each lane loads 16 bytes and uses 12 of them.
+    for (; i + 28 <= size; i += 24) {
+        __m256i v = _mm256_inserti128_si256(
+            _mm256_castsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i *>(data + i))),
+            _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + i + 12)),
+            1);
+        v = _mm256_shuffle_epi8(v, shuffle);
+        // Split every 3 bytes into 4 indices of 6 bits.
+        __m256i t0 = _mm256_and_si256(v, _mm256_set1_epi32(0x0FC0FC00));
+        __m256i t1 = _mm256_mulhi_epu16(t0, _mm256_set1_epi32(0x04000040));
+        __m256i t2 = _mm256_and_si256(v, _mm256_set1_epi32(0x003F03F0));
+        __m256i t3 = _mm256_mullo_epi16(t2, _mm256_set1_epi32(0x01000010));
+        __m256i indices = _mm256_or_si256(t1, t3);
+        // Map the indices to ASCII by adding a per-range offset.
+        __m256i r = _mm256_subs_epu8(indices, _mm256_set1_epi8(51));
+        __m256i less = _mm256_cmpgt_epi8(_mm256_set1_epi8(26), indices);
+        r = _mm256_or_si256(r, _mm256_and_si256(less, _mm256_set1_epi8(13)));
+        r = _mm256_add_epi8(_mm256_shuffle_epi8(shift_lut, r), indices);
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(out), r);
+        out += 32;
+    }
+    return i;
+}
+
+// 32 characters -> 24 bytes per iteration, stops before the first block with a character out of
+// the alphabet, see [2].
+KON_ATTR_TARGET("avx2")
+static std::size_t base64_decode_avx2(
+    const char *str,
+    std::size_t quanta,
+    std::uint8_t *data,
+    const std::uint8_t *data_end,
+    bool is_url) noexcept {
+    const __m256i lut_lo = _mm256_setr_epi8(
+        0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, //
+        0x11, 0x11, 0x13, 0x1A, 0x1B, 0x1B, 0x1B, 0x1A, //
+        0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, //
+        0x11, 0x11, 0x13, 0x1A, 0x1B, 0x1B, 0x1B, 0x1A);
+    const __m256i lut_hi = _mm256_setr_epi8(
+        0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08, //
+        0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, //
+        0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08, //
+        0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10);
+    const __m256i lut_roll = _mm256_setr_epi8(
+        0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0, //
+        0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0);
+    const __m256i mask_2f = _mm256_set1_epi8(0x2F);
+    const __m256i pack = _mm256_setr_epi8(
+        2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1, //
+        2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1);
+    std::size_t q = 0;
+    // The store is 32 bytes wide.
+    for (; (q + 8 <= quanta) && (data + 32 <= data_end); q += 8) {
+        __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(str + q * 4));
+        if (is_url) {
+            // Map "-_" to "+/", after rejecting "+/".
+            __m256i eq_plus = _mm256_cmpeq_epi8(v, _mm256_set1_epi8('+'));
+            __m256i eq_slash = _mm256_cmpeq_epi8(v, _mm256_set1_epi8('/'));
+            __m256i bad = _mm256_or_si256(eq_plus, eq_slash);
+            if (!_mm256_testz_si256(bad, bad)) [[unlikely]] {
+                break;
+            }
+            v = _mm256_blendv_epi8(
+                v, _mm256_set1_epi8('+'), _mm256_cmpeq_epi8(v, _mm256_set1_epi8('-')));
+            v = _mm256_blendv_epi8(
+                v, _mm256_set1_epi8('/'), _mm256_cmpeq_epi8(v, _mm256_set1_epi8('_')));
+        }
+        __m256i hi_nibbles = _mm256_and_si256(_mm256_srli_epi32(v, 4), mask_2f);
+        __m256i lo_nibbles = _mm256_and_si256(v, mask_2f);
+        __m256i lo = _mm256_shuffle_epi8(lut_lo, lo_nibbles);
+        __m256i hi = _mm256_shuffle_epi8(lut_hi, hi_nibbles);
+        if (!_mm256_testz_si256(lo, hi)) [[unlikely]] {
+            break;
+        }
+        __m256i eq_2f = _mm256_cmpeq_epi8(v, mask_2f);
+        __m256i roll = _mm256_shuffle_epi8(lut_roll, _mm256_add_epi8(eq_2f, hi_nibbles));
+        v = _mm256_add_epi8(v, roll);
+        // Merge 4 values of 6 bits into 3 bytes.
+        __m256i merged = _mm256_maddubs_epi16(v, _mm256_set1_epi32(0x01400140));
+        merged = _mm256_madd_epi16(merged, _mm256_set1_epi32(0x00011000));
+        merged = _mm256_shuffle_epi8(merged, pack);
+        merged = _mm256_permutevar8x32_epi32(merged, _mm256_setr_epi32(0, 1, 2, 4, 5, 6, 7, 7));
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(data), merged);
+        data += 24;
+    }
+    return q;
+}
+#elif defined(KON_ARCH_ARM64)
+// 48 bytes -> 64 characters per iteration.
+static std::size_t base64_encode_neon(
+    const std::uint8_t *data,
+    std::size_t size,
+    char *str,
+    bool is_url) noexcept {
+    const uint8x16x4_t lut = vld1q_u8_x4(reinterpret_cast<const std::uint8_t *>(
+        is_url ? base64_url_alphabet : base64_standard_alphabet));
+    const uint8x16_t mask3 = vdupq_n_u8(0x03);
+    const uint8x16_t mask15 = vdupq_n_u8(0x0F);
+    const uint8x16_t mask63 = vdupq_n_u8(0x3F);
+    std::size_t i = 0;
+    auto out = reinterpret_cast<std::uint8_t *>(str);
+    for (; i + 48 <= size; i += 48) {
+        uint8x16x3_t in = vld3q_u8(data + i);
+        uint8x16x4_t indices;
+        indices.val[0] = vshrq_n_u8(in.val[0], 2);
+        indices.val[1] =
+            vorrq_u8(vshlq_n_u8(vandq_u8(in.val[0], mask3), 4), vshrq_n_u8(in.val[1], 4));
+        indices.val[2] =
+            vorrq_u8(vshlq_n_u8(vandq_u8(in.val[1], mask15), 2), vshrq_n_u8(in.val[2], 6));
+        indices.val[3] = vandq_u8(in.val[2], mask63);
+        uint8x16x4_t chars;
+        chars.val[0] = vqtbl4q_u8(lut, indices.val[0]);
+        chars.val[1] = vqtbl4q_u8(lut, indices.val[1]);
+        chars.val[2] = vqtbl4q_u8(lut, indices.val[2]);
+        chars.val[3] = vqtbl4q_u8(lut, indices.val[3]);
+        vst4q_u8(out, chars);
+        out += 64;
+    }
+    return i;
+}
+
+// 64 characters -> 48 bytes per iteration.
+static std::size_t base64_decode_neon(
+    const char *str,
+    std::size_t quanta,
+    std::uint8_t *data,
+    const std::uint8_t *data_end,
+    const std::uint8_t *table) noexcept {
+    const uint8x16x4_t lut_lo = vld1q_u8_x4(table);
+    const uint8x16x4_t lut_hi = vld1q_u8_x4(table + 64);
+    const uint8x16_t offset = vdupq_n_u8(64);
+    const uint8x16_t mask_msb = vdupq_n_u8(0x80);
+    std::size_t q = 0;
+    for (; (q + 16 <= quanta) && (data + 48 <= data_end); q += 16) {
+        uint8x16x4_t in = vld4q_u8(reinterpret_cast<const std::uint8_t *>(str + q * 4));
+        uint8x16_t error = vdupq_n_u8(0);
+        for (int k = 0; k < 4; k++) {
+            uint8x16_t c = in.val[k];
+            uint8x16_t v = vqtbx4q_u8(vqtbl4q_u8(lut_lo, c), lut_hi, vsubq_u8(c, offset));
+            // Non-ASCII characters are out of both tables.
+            error = vorrq_u8(error, vorrq_u8(v, vandq_u8(c, mask_msb)));
+            in.val[k] = v;
+        }
+        if (vmaxvq_u8(error) > 63) [[unlikely]] {
+            break;
+        }
+        uint8x16x3_t out;
+        out.val[0] = vorrq_u8(vshlq_n_u8(in.val[0], 2), vshrq_n_u8(in.val[1], 4));
+        out.val[1] = vorrq_u8(vshlq_n_u8(in.val[1], 4), vshrq_n_u8(in.val[2], 2));
+        out.val[2] = vorrq_u8(vshlq_n_u8(in.val[2], 6), in.val[3]);
+        vst3q_u8(data, out);
+        data += 48;
+    }
+    return q;
+}
+#endif
+
+// Encode the whole 3 bytes groups, returns the number of bytes encoded.
+static std::size_t base64_encode_groups(
+    const std::uint8_t *data,
+    std::size_t size,
+    char *str,
+    base64_variant variant) noexcept {
+    std::size_t i = 0;
+#if defined(KON_ARCH_X86)
+    if (rt::cpu().avx2) {
+        i = base64_encode_avx2(data, size, str, base64_is_url(variant));
+    }
+#elif defined(KON_ARCH_ARM64)
+    i = base64_encode_neon(data, size, str, base64_is_url(variant));
+#endif
+    const char *alphabet = base64_alphabet(variant);
+    char *out = str + i / 3 * 4;
+    for (; i + 3 <= size; i += 3) {
+        std::uint32_t v = (data[i] << 16) | (data[i + 1] << 8) | data[i + 2];
+        out[0] = alphabet[v >> 18];
+        out[1] = alphabet[(v >> 12) & 0x3F];
+        out[2] = alphabet[(v >> 6) & 0x3F];
+        out[3] = alphabet[v & 0x3F];
+        out += 4;
+    }
+    return i;
+}
+
+// Encode the last 1 or 2 bytes, returns the number of characters written.
+static std::size_t base64_encode_tail(
+    const std::uint8_t *data,
+    std::size_t size,
+    char *str,
+    base64_variant variant) noexcept {
+    const char *alphabet = base64_alphabet(variant);
+    if (size == 0) {
+        return 0;
+    }
+    std::uint32_t v = data[0] << 16;
+    if (size > 1) {
+        v |= data[1] << 8;
+    }
+    str[0] = alphabet[v >> 18];
+    str[1] = alphabet[(v >> 12) & 0x3F];
+    if (size > 1) {
+        str[2] = alphabet[(v >> 6) & 0x3F];
+    }
+    if (!base64_is_padded(variant)) {
+        return size + 1;
+    }
+    if (size == 1) {
+        str[2] = '=';
+    }
+    str[3] = '=';
+    return 4;
+}
+
+// Decode the whole 4 characters groups without padding, returns the number of groups decoded, it
+// stops before the first group with a character out of the alphabet or which doesn't fit in data.
+static std::size_t base64_decode_groups(
+    const char *str,
+    std::size_t quanta,
+    std::uint8_t *data,
+    const std::uint8_t *data_end,
+    base64_variant variant) noexcept {
+    const std::uint8_t *table = base64_decode_table(variant);
+    std::size_t q = 0;
+#if defined(KON_ARCH_X86)
+    if (rt::cpu().avx2) {
+        q = base64_decode_avx2(str, quanta, data, data_end, base64_is_url(variant));
+    }
+#elif defined(KON_ARCH_ARM64)
+    q = base64_decode_neon(str, quanta, data, data_end, table);
+#endif
+    data += q * 3;
+    str += q * 4;
+    for (; (q < quanta) && (data + 3 <= data_end); q++) {
+        std::uint32_t a = table[static_cast<std::uint8_t>(str[0])];
+        std::uint32_t b = table[static_cast<std::uint8_t>(str[1])];
+        std::uint32_t c = table[static_cast<std::uint8_t>(str[2])];
+        std::uint32_t d = table[static_cast<std::uint8_t>(str[3])];
+        if ((a | b | c | d) & 0x80) [[unlikely]] {
+            break;
+        }
+        std::uint32_t v = (a << 18) | (b << 12) | (c << 6) | d;
+        data[0] = static_cast<std::uint8_t>(v >> 16);
+        data[1] = static_cast<std::uint8_t>(v >> 8);
+        data[2] = static_cast<std::uint8_t>(v);
+        data += 3;
+        str += 4;
+    }
+    return q;
+}
+
+// Decode a group of 2 or 3 values into 1 or 2 bytes.
+static void base64_decode_partial(
+    const std::uint8_t *values,
+    std::size_t number,
+    std::uint8_t *data) noexcept {
+    std::uint32_t v = (values[0] << 18) | (values[1] << 12);
+    if (number > 2) {
+        v |= values[2] << 6;
+    }
+    data[0] = static_cast<std::uint8_t>(v >> 16);
+    if (number > 2) {
+        data[1] = static_cast<std::uint8_t>(v >> 8);
+    }
+}
+
+std::size_t base64_encode(
+    const std::uint8_t *data,
+    std::size_t data_size,
+    char *str,
+    std::size_t str_size,
+    base64_variant variant) noexcept {
+    std::size_t size = base64_encoded_size(data_size, variant);
+    if (str_size < size) [[unlikely]] {
+        return 0;
+    }
+    std::size_t i = base64_encode_groups(data, data_size, str, variant);
+    base64_encode_tail(data + i, data_size - i, str + i / 3 * 4, variant);
+    return size;
+}
+
+std::size_t base64_decode(
+    const char *str,
+    std::size_t str_size,
+    std::uint8_t *data,
+    std::size_t &data_size,
+    base64_variant variant) noexcept {
+    const std::size_t capacity = data_size;
+    data_size = 0;
+    std::size_t q = base64_decode_groups(str, str_size / 4, data, data + capacity, variant);
+    std::size_t pos = q * 4;
+    std::size_t out = q * 3;
+
+    // The last group, it may be partial.
+    const std::uint8_t *table = base64_decode_table(variant);
+    std::uint8_t values[4];
+    std::size_t n = 0;
+    for (; (n < 4) && (pos + n < str_size); n++) {
+        values[n] = table[static_cast<std::uint8_t>(str[pos + n])];
+        if (values[n] == base64_invalid) {
+            break;
+        }
+    }
+    if (n == 0) {
+        data_size = out;
+        return pos;
+    }
+    if ((n == 1) || (n == 4)) [[unlikely]] { // Truncated or no space.
+        return 0;
+    }
+    if (out + (n - 1) > capacity) [[unlikely]] {
+        return 0;
+    }
+    std::size_t end = pos + n;
+    if (base64_is_padded(variant)) {
+        for (; end < pos + 4; end++) {
+            if ((end >= str_size) || (str[end] != '=')) [[unlikely]] {
+                return 0;
+            }
+        }
+    } else if (end < str_size) [[unlikely]] { // Cut by a character out of the alphabet.
+        return 0;
+    }
+    base64_decode_partial(values, n, data + out);
+    data_size = out + (n - 1);
+    return end;
+}
+
+void base64_encoder::start(base64_variant variant) noexcept {
+    m_pending_size = 0;
+    m_variant = variant;
+}
+
+std::size_t base64_encoder::update(const std::uint8_t *data, std::size_t size, char *str) noexcept {
+    char *out = str;
+    if (m_pending_size > 0) {
+        std::uint8_t group[3];
+        if (m_pending_size + size < 3) {
+            for (; size > 0; size--) {
+                m_pending[m_pending_size++] = *data++;
+            }
+            return 0;
+        }
+        group[0] = m_pending[0];
+        std::size_t i = 1;
+        if (m_pending_size > 1) {
+            group[i++] = m_pending[1];
+        }
+        for (; i < 3; i++) {
+            group[i] = *data++;
+            size--;
+        }
+        base64_encode_groups(group, 3, out, m_variant);
+        out += 4;
+        m_pending_size = 0;
+    }
+    std::size_t i = base64_encode_groups(data, size, out, m_variant);
+    out += i / 3 * 4;
+    for (; i < size; i++) {
+        m_pending[m_pending_size++] = data[i];
+    }
+    return out - str;
+}
+
+std::size_t base64_encoder::finish(char *str) noexcept {
+    std::size_t n = base64_encode_tail(m_pending, m_pending_size, str, m_variant);
+    m_pending_size = 0;
+    return n;
+}
+
+void base64_decoder::start(base64_variant variant) noexcept {
+    m_pending_size = 0;
+    m_finished = false;
+    m_variant = variant;
+}
+
+bool base64_decoder::push(char c, std::uint8_t *&data) noexcept {
+    if (m_finished) [[unlikely]] { // Nothing is allowed after the padding.
+        return false;
+    }
+    m_pending[m_pending_size++] = c;
+    if (m_pending_size < 4) {
+        return true;
+    }
+    m_pending_size = 0;
+    const std::uint8_t *table = base64_decode_table(m_variant);
+    std::uint8_t values[4];
+    std::size_t n = 0;
+    for (; n < 4; n++) {
+        values[n] = table[static_cast<std::uint8_t>(m_pending[n])];
+        if (values[n] == base64_invalid) {
+            break;
+        }
+    }
+    if (n == 4) {
+        std::uint32_t v = (values[0] << 18) | (values[1] << 12) | (values[2] << 6) | values[3];
+        data[0] = static_cast<std::uint8_t>(v >> 16);
+        data[1] = static_cast<std::uint8_t>(v >> 8);
+        data[2] = static_cast<std::uint8_t>(v);
+        data += 3;
+        return true;
+    }
+    if ((n < 2) || !base64_is_padded(m_variant)) [[unlikely]] {
+        return false;
+    }
+    for (std::size_t i = n; i < 4; i++) {
+        if (m_pending[i] != '=') [[unlikely]] {
+            return false;
+        }
+    }
+    base64_decode_partial(values, n, data);
+    data += n - 1;
+    m_finished = true;
+    return true;
+}
+
+bool base64_decoder::update(
+    const char *str,
+    std::size_t size,
+    std::uint8_t *data,
+    std::size_t &data_size) noexcept {
+    std::uint8_t *out = data;
+    data_size = 0;
+    while (size > 0) {
+        if ((m_pending_size == 0) && (size >= 4) && !m_finished) {
+            std::size_t quanta = size / 4;
+            std::size_t q = base64_decode_groups(str, quanta, out, out + quanta * 3, m_variant);
+            str += q * 4;
+            size -= q * 4;
+            out += q * 3;
+            if (size == 0) {
+                break;
+            }
+        }
+        // Group boundaries, padding and errors are handled one character at a time.
+        if (!push(*str, out)) [[unlikely]] {
+            return false;
+        }
+        str++;
+        size--;
+    }
+    data_size = out - data;
+    return true;
+}
+
+bool base64_decoder::finish(std::uint8_t *data, std::size_t &data_size) noexcept {
+    data_size = 0;
+    std::size_t n = m_pending_size;
+    m_pending_size = 0;
+    if (n == 0) {
+        return true;
+    }
+    if ((n == 1) || base64_is_padded(m_variant)) [[unlikely]] {
+        return false;
+    }
+    const std::uint8_t *table = base64_decode_table(m_variant);
+    std::uint8_t values[3];
+    for (std::size_t i = 0; i < n; i++) {
+        values[i] = table[static_cast<std::uint8_t>(m_pending[i])];
+        if (values[i] == base64_invalid) [[unlikely]] {
+            return false;
+        }
+    }
+    base64_decode_partial(values, n, data);
+    data_size = n - 1;
+    return true;
+}
+
+} // namespace kon
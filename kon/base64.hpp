@@ -0,0 +1,103 @@
+// SPDX-FileCopyrightText: 2026 TypeCombinator <typecombinator@foxmail.com>
+//
+// SPDX-License-Identifier: BSD 3-Clause
+
+#ifndef BASE64_E63B6D17_8B5B_45AD_BC27_8BF2A84F5F82
+#define BASE64_E63B6D17_8B5B_45AD_BC27_8BF2A84F5F82
+// References:
+// [0]: https://www.rfc-editor.org/rfc/rfc4648
+// [1]: http://0x80.pl/notesen/2016-01-12-sse-base64-encoding.html
+// [2]: http://0x80.pl/notesen/2016-01-17-sse-base64-decoding.html
+#include <cstdint>
+#include <cstddef>
+
+namespace kon {
+
+enum class base64_variant : std::uint8_t {
+    standard,       // "+/" with "=" padding.
+    standard_nopad, // "+/" without padding.
+    url,            // "-_" with "=" padding, URL and filename safe.
+    url_nopad,      // "-_" without padding.
+};
+
+static constexpr bool base64_is_padded(base64_variant variant) noexcept {
+    return (variant == base64_variant::standard) || (variant == base64_variant::url);
+}
+
+static constexpr bool base64_is_url(base64_variant variant) noexcept {
+    return (variant == base64_variant::url) || (variant == base64_variant::url_nopad);
+}
+
+static constexpr std::size_t base64_encoded_size(
+    std::size_t data_size,
+    base64_variant variant = base64_variant::standard) noexcept {
+    if (base64_is_padded(variant)) {
+        return (data_size + 2) / 3 * 4;
+    }
+    std::size_t rest = data_size % 3;
+    return data_size / 3 * 4 + ((rest != 0) ? (rest + 1) : 0);
+}
+
+// Upper bound of the decoded size.
+static constexpr std::size_t base64_decoded_size(std::size_t str_size) noexcept {
+    return str_size / 4 * 3 + (str_size % 4) * 3 / 4;
+}
+
+// Returns the number of characters written, or 0 if str_size < base64_encoded_size(data_size).
+std::size_t base64_encode(
+    const std::uint8_t *data,
+    std::size_t data_size,
+    char *str,
+    std::size_t str_size,
+    base64_variant variant = base64_variant::standard) noexcept;
+
+// Returns the number of characters consumed, decoding stops at the end of the string, after the
+// padding, or at the first character out of the alphabet on a 4 characters boundary. On input,
+// data_size is the capacity of data, on output, it's the number of bytes decoded. 0 is returned for
+// a truncated group (a character out of the alphabet inside a group too), a bad padding or a too
+// small data buffer.
+std::size_t base64_decode(
+    const char *str,
+    std::size_t str_size,
+    std::uint8_t *data,
+    std::size_t &data_size,
+    base64_variant variant = base64_variant::standard) noexcept;
+
+// Streaming encoder for chunked input.
+class base64_encoder {
+   public:
+    void start(base64_variant variant = base64_variant::standard) noexcept;
+    // str must have room for (size + 2) / 3 * 4 characters, returns the number of characters
+    // written.
+    std::size_t update(const std::uint8_t *data, std::size_t size, char *str) noexcept;
+    // Flush the last group, str must have room for 4 characters.
+    std::size_t finish(char *str) noexcept;
+   private:
+    std::uint8_t m_pending[2];
+    std::uint8_t m_pending_size;
+    base64_variant m_variant;
+};
+
+// Streaming decoder for chunked input, characters out of the alphabet are errors.
+class base64_decoder {
+   public:
+    void start(base64_variant variant = base64_variant::standard) noexcept;
+    // data must have room for (size + 3) / 4 * 3 bytes, data_size is the number of bytes written.
+    bool update(
+        const char *str,
+        std::size_t size,
+        std::uint8_t *data,
+        std::size_t &data_size) noexcept;
+    // data must have room for 2 bytes.
+    bool finish(std::uint8_t *data, std::size_t &data_size) noexcept;
+   private:
+    bool push(char c, std::uint8_t *&data) noexcept;
+
+    char m_pending[4];
+    std::uint8_t m_pending_size;
+    bool m_finished;
+    base64_variant m_variant;
+};
+
+} // namespace kon
+#endif /* base64.hpp */
@@ -0,0 +1,417 @@
+// SPDX-FileCopyrightText: 2026 TypeCombinator <typecombinator@foxmail.com>
+//
+// SPDX-License-Identifier: BSD 3-Clause
+
+#ifndef BROADCAST_RING_76BF512B_8E82_496B_92B1_8AA4933DF89B
+#define BROADCAST_RING_76BF512B_8E82_496B_92B1_8AA4933DF89B
+#include <kon/vlm_ring.hpp>
+#include <kon/xt/attributes.hpp>
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <new>
+
+namespace kon {
+
+// A single producer multiple consumers ring of variable-length messages, every message is written
+// once and read by all the subscribed consumers, each of them has its own cursor.
+// - gating: the producer waits for the slowest consumer, push_begin() fails while it has no room.
+// - overwrite: the producer never waits, it overwrites the oldest messages, a consumer lapped by
+//   it skips to the oldest message left and counts the lost ones by the message sequence numbers.
+// The messages keep the vlm_ring framing, every one is a record of a sequence number and a
+// message_head followed by the data, aligned with 16 bytes, a record never wraps around.
+// In the overwrite mode a consumer may copy a message the producer is overwriting, the records are
+// written and copied by relaxed atomic words then, as seqlock does, so a torn copy is never a
+// data race, it's detected and dropped.
+class broadcast_ring {
+    // A message with its sequence number.
+    struct record_head {
+        std::uint64_t seq;
+        vlm_ring::message_head head;
+    };
+
+    static_assert(sizeof(record_head) == 16);
+    static_assert(std::atomic_ref<std::uint64_t>::is_always_lock_free);
+    static_assert(std::atomic_ref<std::uint64_t>::required_alignment <= 16);
+   public:
+    using message_head = vlm_ring::message_head;
+    using zc_scope = vlm_ring::zc_scope;
+
+    enum class mode : std::uint8_t {
+        gating,
+        overwrite,
+    };
+
+    static constexpr std::size_t max_consumers = 64;
+    static constexpr std::uint32_t turn_around_message_type = vlm_ring::turn_around_message_type;
+
+    // size is rounded up to a power of 2, 64 bytes at least.
+    broadcast_ring(std::size_t size, mode m)
+        : m_buffer(static_cast<std::uint8_t *>(
+              ::operator new(round_size(size), std::align_val_t{64})))
+        , m_size(round_size(size))
+        , m_mode(m)
+        , m_owned(true) {
+    }
+
+    // The storage is borrowed (e.g. from a shm), it's 16 bytes aligned and holds size bytes, size
+    // is a power of 2.
+    broadcast_ring(std::uint8_t *storage, std::size_t size, mode m) noexcept
+        : m_buffer(storage)
+        , m_size(size)
+        , m_mode(m)
+        , m_owned(false) {
+    }
+
+    ~broadcast_ring() {
+        if (m_owned) {
+            ::operator delete(m_buffer, std::align_val_t{64});
+        }
+    }
+
+    KON_DISALLOW_COPY(broadcast_ring);
+    KON_DISALLOW_MOVE(broadcast_ring);
+
+    // The longest message.
+    [[nodiscard]]
+    std::size_t max_message_length() const noexcept {
+        return m_size / 2 - sizeof(record_head);
+    }
+
+    // The producer side, the same as vlm_ring: push_begin(), fill the head and the data, then
+    // push_end(). Zero copy writing is in the gating mode only, it's false in the overwrite mode.
+
+    [[nodiscard]]
+    bool push_begin(zc_scope &zcs, std::uint32_t msg_length) noexcept {
+        if (m_mode == mode::overwrite) {
+            return false;
+        }
+        auto *record = reserve(msg_length);
+        if (record == nullptr) {
+            return false;
+        }
+        new (record) record_head;
+        zcs.head = &record->head;
+        zcs.data = reinterpret_cast<std::uint8_t *>(record + 1);
+        return true;
+    }
+
+    void push_end(const zc_scope &zcs) noexcept {
+        auto *record = reinterpret_cast<record_head *>(
+            reinterpret_cast<std::uint8_t *>(zcs.head) - offsetof(record_head, head));
+        record->seq = m_seq++;
+        m_write.store(m_pending, std::memory_order_release);
+    }
+
+    // If the data is a nullptr, it's UB.
+    bool push(std::uint32_t type, const std::uint8_t *data, std::uint32_t length) noexcept {
+        if (m_mode == mode::gating) {
+            zc_scope zcs;
+            if (!push_begin(zcs, length)) {
+                return false;
+            }
+            zcs.head->type = type;
+            zcs.head->length = length;
+            std::memcpy(zcs.data, data, length);
+            push_end(zcs);
+            return true;
+        }
+        auto *record = reserve(length);
+        if (record == nullptr) {
+            return false;
+        }
+        record_head head{m_seq++, {type, length}};
+        store_words(reinterpret_cast<std::uint8_t *>(record), &head, sizeof(head));
+        store_words(reinterpret_cast<std::uint8_t *>(record + 1), data, length);
+        m_write.store(m_pending, std::memory_order_release);
+        return true;
+    }
+
+    // A consumer, it reads the messages pushed after it's subscribed.
+    class consumer {
+       public:
+        consumer() noexcept = default;
+
+        ~consumer() {
+            unsubscribe();
+        }
+
+        KON_DISALLOW_COPY(consumer);
+        KON_DISALLOW_MOVE(consumer);
+
+        // Takes a cursor of the ring, false if all of them are taken.
+        bool subscribe(broadcast_ring &ring) noexcept {
+            unsubscribe();
+            for (std::size_t i = 0; i < max_consumers; i++) {
+                auto &c = ring.m_cursors[i];
+                std::uint64_t expected = inactive;
+                std::uint64_t pos = ring.m_write.load(std::memory_order_relaxed);
+                if (!c.pos.compare_exchange_strong(expected, pos, std::memory_order_seq_cst)) {
+                    continue;
+                }
+                // The producer may not have seen the cursor before it moved on, it sees it from
+                // the write index read after it on (see min_cursor()).
+                pos = ring.m_write.load(std::memory_order_seq_cst);
+                c.pos.store(pos, std::memory_order_release);
+                m_ring = &ring;
+                m_index = i;
+                m_pos = pos;
+                m_synced = false;
+                m_lost = 0;
+                return true;
+            }
+            return false;
+        }
+
+        void unsubscribe() noexcept {
+            if (m_ring != nullptr) {
+                m_ring->m_cursors[m_index].pos.store(inactive, std::memory_order_release);
+                m_ring = nullptr;
+            }
+        }
+
+        // Copies the next message, false if there is none, or its length is above the length
+        // (it stays the next one then).
+        bool read(message_head &msg_head, std::uint8_t *data, std::uint32_t length) noexcept {
+            while (true) {
+                record_head copy;
+                auto *record = next_record(copy);
+                if (record == nullptr) {
+                    return false;
+                }
+                if (copy.head.length > length) {
+                    return false;
+                }
+                if (m_ring->m_mode == mode::gating) {
+                    std::memcpy(data, record + 1, copy.head.length);
+                } else {
+                    load_words(
+                        data,
+                        reinterpret_cast<const std::uint8_t *>(record + 1),
+                        copy.head.length);
+                }
+                if (!intact()) {
+                    continue;
+                }
+                msg_head = copy.head;
+                advance(copy);
+                return true;
+            }
+        }
+
+        // Zero copy reading, in the gating mode only: read_begin(), use the head and the data,
+        // then read_end(). It's false in the overwrite mode, the record may be overwritten while
+        // it's used.
+        [[nodiscard]]
+        bool read_begin(zc_scope &zcs) noexcept {
+            if (m_ring->m_mode == mode::overwrite) {
+                return false;
+            }
+            record_head copy;
+            auto *record = next_record(copy);
+            if (record == nullptr) {
+                return false;
+            }
+            zcs.head = &record->head;
+            zcs.data = reinterpret_cast<std::uint8_t *>(record + 1);
+            return true;
+        }
+
+        void read_end(const zc_scope &zcs) noexcept {
+            auto *record = reinterpret_cast<const record_head *>(
+                reinterpret_cast<std::uint8_t *>(zcs.head) - offsetof(record_head, head));
+            advance(*record);
+        }
+
+        // The messages overwritten before this consumer read them.
+        [[nodiscard]]
+        std::uint64_t lost() const noexcept {
+            return m_lost;
+        }
+
+        [[nodiscard]]
+        bool subscribed() const noexcept {
+            return m_ring != nullptr;
+        }
+       private:
+        // The record at the cursor and a copy of its head, the turn arounds and the overwritten
+        // records are skipped.
+        record_head *next_record(record_head &copy) noexcept {
+            while (true) {
+                if (m_pos == m_ring->m_write.load(std::memory_order_acquire)) {
+                    return nullptr;
+                }
+                if (m_ring->m_mode == mode::overwrite) {
+                    std::uint64_t tail = m_ring->m_tail.load(std::memory_order_acquire);
+                    if (m_pos < tail) {
+                        m_pos = tail;
+                        continue;
+                    }
+                }
+                auto *record = reinterpret_cast<record_head *>(
+                    m_ring->m_buffer + (m_pos & (m_ring->m_size - 1)));
+                load_words(&copy, reinterpret_cast<const std::uint8_t *>(record), sizeof(copy));
+                if (!intact()) {
+                    continue;
+                }
+                if (copy.head.type != turn_around_message_type) {
+                    return record;
+                }
+                m_pos += sizeof(record_head) + copy.head.length;
+            }
+        }
+
+        // Whether the record at the cursor wasn't overwritten while it was copied.
+        bool intact() const noexcept {
+            if (m_ring->m_mode == mode::gating) {
+                return true;
+            }
+            std::atomic_thread_fence(std::memory_order_acquire);
+            return m_ring->m_tail.load(std::memory_order_relaxed) <= m_pos;
+        }
+
+        void advance(const record_head &record) noexcept {
+            if (m_synced && (record.seq != m_next_seq)) {
+                m_lost += record.seq - m_next_seq;
+            }
+            m_synced = true;
+            m_next_seq = record.seq + 1;
+            m_pos += record_size(record.head.length);
+            m_ring->m_cursors[m_index].pos.store(m_pos, std::memory_order_release);
+        }
+
+        broadcast_ring *m_ring{nullptr};
+        std::size_t m_index{0};
+        std::uint64_t m_pos{0};
+        std::uint64_t m_next_seq{0};
+        std::uint64_t m_lost{0};
+        bool m_synced{false};
+    };
+
+    [[nodiscard]]
+    std::size_t capacity() const noexcept {
+        return m_size;
+    }
+
+    [[nodiscard]]
+    std::uint64_t write_index() const noexcept {
+        return m_write.load(std::memory_order_relaxed);
+    }
+   private:
+    static constexpr std::uint64_t inactive = ~std::uint64_t{0};
+
+    struct alignas(64) cursor {
+        std::atomic<std::uint64_t> pos{inactive};
+    };
+
+    static std::size_t round_size(std::size_t size) noexcept {
+        return (size < 64) ? 64 : std::bit_ceil(size);
+    }
+
+    static std::size_t record_size(std::size_t msg_length) noexcept {
+        return (sizeof(record_head) + msg_length + 15) & ~std::size_t{15};
+    }
+
+    // The bytes of a record by relaxed atomic words, the last word may run into the padding of
+    // the record, it's 16 bytes aligned.
+    static void store_words(std::uint8_t *record, const void *src, std::size_t size) noexcept {
+        auto *in = static_cast<const std::uint8_t *>(src);
+        for (std::size_t i = 0; i < size; i += 8) {
+            std::uint64_t word = 0;
+            std::memcpy(&word, in + i, std::min<std::size_t>(8, size - i));
+            std::atomic_ref<std::uint64_t>(*reinterpret_cast<std::uint64_t *>(record + i))
+                .store(word, std::memory_order_relaxed);
+        }
+    }
+
+    static void load_words(void *dst, const std::uint8_t *record, std::size_t size) noexcept {
+        auto *out = static_cast<std::uint8_t *>(dst);
+        for (std::size_t i = 0; i < size; i += 8) {
+            auto &word = *reinterpret_cast<std::uint64_t *>(const_cast<std::uint8_t *>(record + i));
+            std::uint64_t value = std::atomic_ref<std::uint64_t>(word).load(
+                std::memory_order_relaxed);
+            std::memcpy(out + i, &value, std::min<std::size_t>(8, size - i));
+        }
+    }
+
+    // The room of a record, nullptr if there is none in the gating mode. The turn around record
+    // before it is written.
+    record_head *reserve(std::uint32_t msg_length) noexcept {
+        if (msg_length > max_message_length()) [[unlikely]] {
+            return nullptr;
+        }
+        std::size_t length = record_size(msg_length);
+        std::uint64_t pos = m_write.load(std::memory_order_relaxed);
+        std::size_t offset = pos & (m_size - 1);
+        std::size_t padding = ((offset + length) > m_size) ? (m_size - offset) : 0;
+        std::uint64_t end = pos + padding + length;
+        if (m_mode == mode::gating) {
+            if ((end - m_min_cursor) > m_size) {
+                m_min_cursor = min_cursor(pos);
+                if ((end - m_min_cursor) > m_size) {
+                    return nullptr;
+                }
+            }
+        } else {
+            drop_oldest(end);
+        }
+        if (padding != 0) {
+            record_head turn{
+                0, {turn_around_message_type, static_cast<std::uint32_t>(padding - sizeof(turn))}};
+            store_words(m_buffer + offset, &turn, sizeof(turn));
+            offset = 0;
+        }
+        m_pending = end;
+        return reinterpret_cast<record_head *>(m_buffer + offset);
+    }
+
+    // The slowest cursor, pos if there is no consumer. The fence pairs with the subscribe(), either
+    // a new cursor is seen here or the new consumer starts from pos on.
+    std::uint64_t min_cursor(std::uint64_t pos) const noexcept {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        std::uint64_t min = pos;
+        for (const auto &c: m_cursors) {
+            std::uint64_t e = c.pos.load(std::memory_order_acquire);
+            if (e < min) {
+                min = e;
+            }
+        }
+        return min;
+    }
+
+    // Moves the tail past the records overlapping the bytes up to end, before they're written.
+    void drop_oldest(std::uint64_t end) noexcept {
+        std::uint64_t tail = m_tail.load(std::memory_order_relaxed);
+        if ((end - tail) <= m_size) {
+            return;
+        }
+        std::uint64_t write = m_write.load(std::memory_order_relaxed);
+        while (((end - tail) > m_size) && (tail < write)) {
+            auto *record = reinterpret_cast<const record_head *>(m_buffer + (tail & (m_size - 1)));
+            tail += (record->head.type == turn_around_message_type)
+                        ? (sizeof(record_head) + record->head.length)
+                        : record_size(record->head.length);
+        }
+        m_tail.store(tail, std::memory_order_relaxed);
+        // The tail is seen before any of the new bytes.
+        std::atomic_thread_fence(std::memory_order_release);
+    }
+
+    std::uint8_t *m_buffer;
+    std::size_t m_size;
+    mode m_mode;
+    bool m_owned;
+    // The producer side.
+    std::uint64_t m_pending{0};
+    std::uint64_t m_seq{0};
+    std::uint64_t m_min_cursor{0};
+    alignas(64) std::atomic<std::uint64_t> m_write{0};
+    std::atomic<std::uint64_t> m_tail{0}; // The oldest record left, in the overwrite mode.
+    cursor m_cursors[max_consumers];
+};
+
+} // namespace kon
+#endif // broadcast_ring.hpp
@@ -0,0 +1,171 @@
+// SPDX-FileCopyrightText: 2026 TypeCombinator <typecombinator@foxmail.com>
+//
+// SPDX-License-Identifier: BSD 3-Clause
+
+#include <kon/dbuf_chain.hpp>
+#include <algorithm>
+#include <cstring>
+#include <sys/uio.h>
+
+namespace kon {
+
+void dbuf_chain::clear() noexcept {
+    for (std::size_t i = 0; i < m_count; i++) {
+        if ((m_owned >> i) & 1) {
+            m_pool->put(m_segments[i]);
+        }
+    }
+    m_count = 0;
+    m_first = 0;
+    m_length = 0;
+    m_owned = 0;
+}
+
+bool dbuf_chain::new_segment(bool front) noexcept {
+    if ((m_pool == nullptr) || (m_count == max_segments)) {
+        return false;
+    }
+    dbuf segment;
+    if (!m_pool->get(segment)) {
+        return false;
+    }
+    if (m_count == 0) {
+        // The first segment keeps the headroom of the pool.
+        m_segments[0] = segment;
+        m_owned = 1;
+        m_count = 1;
+        return true;
+    }
+    if (!front) {
+        segment.reset(0, 0);
+        m_segments[m_count] = segment;
+        m_owned |= std::uint32_t{1} << m_count;
+        m_count++;
+        return true;
+    }
+    segment.reset(segment.capacity(), 0);
+    for (std::size_t i = m_count; i > m_first; i--) {
+        m_segments[i] = m_segments[i - 1];
+    }
+    m_segments[m_first] = segment;
+    std::uint32_t low = m_owned & ((std::uint32_t{1} << m_first) - 1);
+    m_owned = low | ((m_owned & ~low) << 1) | (std::uint32_t{1} << m_first);
+    m_count++;
+    return true;
+}
+
+bool dbuf_chain::append(const void *data, std::size_t size) noexcept {
+    auto src = static_cast<const std::uint8_t *>(data);
+    while (size != 0) {
+        std::uint32_t rest = 0;
+        std::uint8_t *tail = nullptr;
+        if (m_count != 0) {
+            tail = m_segments[m_count - 1].append_rest_begin(rest);
+        }
+        if (rest == 0) {
+            if (!new_segment(false)) {
+                return false;
+            }
+            continue;
+        }
+        auto n = static_cast<std::uint32_t>(std::min<std::size_t>(rest, size));
+        std::memcpy(tail, src, n);
+        m_segments[m_count - 1].append_rest_end(n);
+        m_length += n;
+        src += n;
+        size -= n;
+    }
+    return true;
+}
+
+bool dbuf_chain::read(void *data, std::size_t size) noexcept {
+    if (size > m_length) {
+        return false;
+    }
+    auto dst = static_cast<std::uint8_t *>(data);
+    while (size != 0) {
+        skip_drained();
+        auto &segment = m_segments[m_first];
+        auto n = static_cast<std::uint32_t>(std::min<std::size_t>(segment.data_length(), size));
+        std::memcpy(dst, segment.read(n), n);
+        m_length -= n;
+        dst += n;
+        size -= n;
+    }
+    return true;
+}
+
+bool dbuf_chain::adjust(std::size_t size) noexcept {
+    if (size > m_length) {
+        return false;
+    }
+    while (size != 0) {
+        skip_drained();
+        auto &segment = m_segments[m_first];
+        auto n = static_cast<std::uint32_t>(std::min<std::size_t>(segment.data_length(), size));
+        segment.adjust(n);
+        m_length -= n;
+        size -= n;
+    }
+    return true;
+}
+
+std::size_t dbuf_chain::to_iovec(struct iovec *iov, std::size_t capacity) const noexcept {
+    std::size_t n = 0;
+    for (std::size_t i = m_first; (i < m_count) && (n < capacity); i++) {
+        const auto &segment = m_segments[i];
+        if (segment.data_length() != 0) {
+            iov[n].iov_base = segment.data();
+            iov[n].iov_len = segment.data_length();
+            n++;
+        }
+    }
+    return n;
+}
+
+void dbuf_chain::copy_to(void *data) const noexcept {
+    auto dst = static_cast<std::uint8_t *>(data);
+    for (std::size_t i = m_first; i < m_count; i++) {
+        const auto &segment = m_segments[i];
+        if (segment.data_length() != 0) {
+            std::memcpy(dst, segment.data(), segment.data_length());
+            dst += segment.data_length();
+        }
+    }
+}
+
+std::uint8_t *dbuf_chain::linearize() noexcept {
+    skip_drained();
+    if (m_first == m_count) {
+        return nullptr;
+    }
+    auto &first = m_segments[m_first];
+    if ((m_first + 1) == m_count) {
+        return first.data();
+    }
+    if (m_length > first.capacity()) {
+        return nullptr;
+    }
+    // Keep the headroom if the data fits behind it.
+    std::uint32_t headroom = first.headroom();
+    if ((headroom + m_length) > first.capacity()) {
+        headroom = first.capacity() - static_cast<std::uint32_t>(m_length);
+    }
+    std::uint32_t length = first.data_length();
+    std::memmove(first.va() + headroom, first.data(), length);
+    first.reset(headroom, length);
+    for (std::size_t i = m_first + 1; i < m_count; i++) {
+        auto &segment = m_segments[i];
+        if (segment.data_length() != 0) {
+            std::memcpy(first.append(segment.data_length()), segment.data(), segment.data_length());
+        }
+        if ((m_owned >> i) & 1) {
+            m_pool->put(segment);
+        }
+    }
+    m_owned &= (std::uint32_t{2} << m_first) - 1;
+    m_count = m_first + 1;
+    return first.data();
+}
+
+} // namespace kon
@@ -0,0 +1,177 @@
+// SPDX-FileCopyrightText: 2026 TypeCombinator <typecombinator@foxmail.com>
+//
+// SPDX-License-Identifier: BSD 3-Clause
+
+#ifndef DBUF_CHAIN_BD59C02A_ABC3_4AEC_8B31_4173EFFCFB9C
+#define DBUF_CHAIN_BD59C02A_ABC3_4AEC_8B31_4173EFFCFB9C
+#include <kon/dbuf.hpp>
+#include <kon/pool.hpp>
+#include <kon/xt/attributes.hpp>
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+struct iovec;
+
+namespace kon {
+
+// A message over a chain of dbuf segments. The typed append / prepend / read hand out contiguous
+// objects, so they spill into a new segment instead of crossing one, the byte ones span the
+// segments. The new segments come from the pool, they go back to it on clear().
+// Notice: the drained segments at the front are kept until clear(), the pointers read from them
+// stay valid.
+class dbuf_chain {
+   public:
+    static constexpr std::size_t max_segments = 16;
+
+    dbuf_chain() noexcept = default;
+
+    // Without a pool, the segments are only linked by push_back().
+    explicit dbuf_chain(pool &segment_pool) noexcept
+        : m_pool{&segment_pool} {
+    }
+
+    ~dbuf_chain() noexcept {
+        clear();
+    }
+
+    KON_DISALLOW_COPY(dbuf_chain);
+    KON_DISALLOW_MOVE(dbuf_chain);
+
+    // Links a segment without copying, the chain doesn't own it.
+    bool push_back(const dbuf &segment) noexcept {
+        if (m_count == max_segments) [[unlikely]] {
+            return false;
+        }
+        m_segments[m_count++] = segment;
+        m_length += segment.data_length();
+        return true;
+    }
+
+    // Gives the owned segments back to the pool and unlinks the others.
+    void clear() noexcept;
+
+    std::size_t segment_count() const noexcept {
+        return m_count;
+    }
+
+    dbuf &segment(std::size_t index) noexcept {
+        return m_segments[index];
+    }
+
+    std::size_t data_length() const noexcept {
+        return m_length;
+    }
+
+    template <typename T = std::uint8_t[], typename ET = std::remove_extent_t<T>>
+        requires(std::is_trivial_v<std::remove_all_extents_t<T>>)
+    ET *append(std::uint32_t number = 1) noexcept {
+        if (m_count != 0) [[likely]] {
+            auto p = m_segments[m_count - 1].append<T>(number);
+            if (p != nullptr) [[likely]] {
+                m_length += number * sizeof(ET);
+                return p;
+            }
+        }
+        // Taking a segment the object doesn't fit in would waste it.
+        if (((std::size_t{number} * sizeof(ET)) > segment_room(false)) || !new_segment(false)) {
+            return nullptr;
+        }
+        auto p = m_segments[m_count - 1].append<T>(number);
+        if (p != nullptr) {
+            m_length += number * sizeof(ET);
+        }
+        return p;
+    }
+
+    // Copies the bytes into the free space of the segments, returns false if they run out, the
+    // bytes copied so far stay appended.
+    bool append(const void *data, std::size_t size) noexcept;
+
+    // Into the headroom of the first segment, or a new segment linked before it.
+    template <typename T = std::uint8_t[], typename ET = std::remove_extent_t<T>>
+        requires(std::is_trivial_v<std::remove_all_extents_t<T>>)
+    ET *prepend(std::uint32_t number = 1) noexcept {
+        if (m_first < m_count) [[likely]] {
+            auto p = m_segments[m_first].prepend<T>(number);
+            if (p != nullptr) [[likely]] {
+                m_length += number * sizeof(ET);
+                return p;
+            }
+        }
+        if (((std::size_t{number} * sizeof(ET)) > segment_room(true)) || !new_segment(true)) {
+            return nullptr;
+        }
+        auto p = m_segments[m_first].prepend<T>(number);
+        if (p != nullptr) {
+            m_length += number * sizeof(ET);
+        }
+        return p;
+    }
+
+    // nullptr if the object crosses a segment, read(void *, size) copies it.
+    template <typename T = std::uint8_t[], typename ET = std::remove_extent_t<T>>
+        requires(std::is_trivial_v<std::remove_all_extents_t<T>>)
+    ET *read(std::uint32_t number = 1) noexcept {
+        skip_drained();
+        if (m_first == m_count) [[unlikely]] {
+            return nullptr;
+        }
+        auto p = m_segments[m_first].read<T>(number);
+        if (p != nullptr) [[likely]] {
+            m_length -= number * sizeof(ET);
+        }
+        return p;
+    }
+
+    // Copies and consumes size bytes, false if there are fewer.
+    bool read(void *data, std::size_t size) noexcept;
+
+    // Drops size bytes from the front, false if there are fewer.
+    bool adjust(std::size_t size) noexcept;
+
+    // The non-empty segments for writev() / sendmsg(), returns the number of the entries filled.
+    std::size_t to_iovec(struct iovec *iov, std::size_t capacity) const noexcept;
+
+    // Copies all the data without consuming it, data must hold data_length() bytes.
+    void copy_to(void *data) const noexcept;
+
+    // Moves all the data into the first segment and gives the others back, nullptr if it doesn't
+    // fit there. A single segment is returned as it is.
+    std::uint8_t *linearize() noexcept;
+   private:
+    // Links a new segment from the pool at the back, or at the front with all of its room as
+    // headroom. The first segment of the chain keeps the headroom of the pool.
+    bool new_segment(bool front) noexcept;
+
+    // The room new_segment(front) would give, 0 without a pool.
+    std::size_t segment_room(bool front) const noexcept {
+        if (m_pool == nullptr) {
+            return 0;
+        }
+        std::size_t capacity = m_pool->element_size();
+        if (m_count != 0) {
+            return capacity;
+        }
+        std::size_t headroom = std::min<std::size_t>(m_pool->headroom(), capacity);
+        return front ? headroom : (capacity - headroom);
+    }
+
+    void skip_drained() noexcept {
+        // The last segment stays the current one, append() goes on there.
+        while (((m_first + 1) < m_count) && (m_segments[m_first].data_length() == 0)) {
+            m_first++;
+        }
+    }
+
+    dbuf m_segments[max_segments];
+    std::size_t m_count{0};
+    std::size_t m_first{0}; // The first segment not drained.
+    std::size_t m_length{0};
+    std::uint32_t m_owned{0}; // A bit per segment taken from the pool.
+    pool *m_pool{nullptr};
+};
+
+} // namespace kon
+#endif // dbuf_chain.hpp
@@ -0,0 +1,415 @@
+// SPDX-FileCopyrightText: 2026 TypeCombinator <typecombinator@foxmail.com>
+//
+// SPDX-License-Identifier: BSD 3-Clause
+
+#include <kon/dynamic_bitset.hpp>
+#include <kon/xt/cpu.hpp>
+#include <algorithm>
+#include <cstring>
+#include <new>
+#if defined(KON_ARCH_X86)
+    #include <immintrin.h>
+#elif defined(KON_ARCH_ARM64)
+    #include <arm_neon.h>
+#endif
+
+namespace kon {
+namespace detail {
+namespace {
+constexpr std::size_t line_words = dynamic_bitset::line_words;
+
+template <bitset_op op>
+KON_ATTR_ALWAYS_INLINE std::uint64_t bitset_combine(std::uint64_t a, std::uint64_t b) noexcept {
+    if constexpr (op == bitset_op::and_) {
+        return a & b;
+    } else if constexpr (op == bitset_op::or_) {
+        return a | b;
+    } else if constexpr (op == bitset_op::xor_) {
+        return a ^ b;
+    } else {
+        return a & ~b;
+    }
+}
+
+template <bitset_op op>
+void bitset_apply_scalar(std::uint64_t *dst, const std::uint64_t *src, std::size_t n) noexcept {
+    for (std::size_t i = 0; i < n; i++) {
+        dst[i] = bitset_combine<op>(dst[i], src[i]);
+    }
+}
+
+std::size_t bitset_count_scalar(const std::uint64_t *words, std::size_t n) noexcept {
+    std::size_t count = 0;
+    for (std::size_t i = 0; i < n; i++) {
+        count += kon::popcount(words[i]);
+    }
+    return count;
+}
+
+std::size_t bitset_find_nonzero_scalar(
+    const std::uint64_t *words,
+    std::size_t begin,
+    std::size_t n) noexcept {
+    for (; begin < n; begin++) {
+        if (words[begin] != 0) {
+            return begin;
+        }
+    }
+    return n;
+}
+
+#if defined(KON_ARCH_X86)
+template <bitset_op op>
+KON_ATTR_TARGET("avx512f")
+void bitset_apply_avx512(std::uint64_t *dst, const std::uint64_t *src, std::size_t n) noexcept {
+    for (std::size_t i = 0; i < n; i += line_words) {
+        __m512i a = _mm512_load_si512(dst + i);
+        __m512i b = _mm512_load_si512(src + i);
+        if constexpr (op == bitset_op::and_) {
+            a = _mm512_and_si512(a, b);
+        } else if constexpr (op == bitset_op::or_) {
+            a = _mm512_or_si512(a, b);
+        } else if constexpr (op == bitset_op::xor_) {
+            a = _mm512_xor_si512(a, b);
+        } else {
+            a = _mm512_and_si512(a, _mm512_xor_si512(b, _mm512_set1_epi64(-1)));
+        }
+        _mm512_store_si512(dst + i, a);
+    }
+}
+
+template <bitset_op op>
+KON_ATTR_TARGET("avx2")
+void bitset_apply_avx2(std::uint64_t *dst, const std::uint64_t *src, std::size_t n) noexcept {
+    for (std::size_t i = 0; i < n; i += 4) {
+        auto d = reinterpret_cast<__m256i *>(dst + i);
+        __m256i a = _mm256_load_si256(d);
+        __m256i b = _mm256_load_si256(reinterpret_cast<const __m256i *>(src + i));
+        if constexpr (op == bitset_op::and_) {
+            a = _mm256_and_si256(a, b);
+        } else if constexpr (op == bitset_op::or_) {
+            a = _mm256_or_si256(a, b);
+        } else if constexpr (op == bitset_op::xor_) {
+            a = _mm256_xor_si256(a, b);
+        } else {
+            a = _mm256_andnot_si256(b, a);
+        }
+        _mm256_store_si256(d, a);
+    }
+}
+
+// The popcount of the nibbles by a lookup, summed up by psadbw (Wojciech Mula).
+KON_ATTR_TARGET("avx512bw")
+std::size_t bitset_count_avx512(const std::uint64_t *words, std::size_t n) noexcept {
+    // The popcounts of 0 ~ 15 in every 16 bytes.
+    const __m512i lookup = _mm512_set4_epi64(
+        0x0403030203020201,
+        0x0302020102010100,
+        0x0403030203020201,
+        0x0302020102010100);
+    const __m512i low_mask = _mm512_set1_epi8(0x0F);
+    __m512i total = _mm512_setzero_si512();
+    for (std::size_t i = 0; i < n; i += line_words) {
+        __m512i v = _mm512_load_si512(words + i);
+        __m512i low = _mm512_shuffle_epi8(lookup, _mm512_and_si512(v, low_mask));
+        __m512i high =
+            _mm512_shuffle_epi8(lookup, _mm512_and_si512(_mm512_srli_epi16(v, 4), low_mask));
+        __m512i bytes = _mm512_add_epi8(low, high);
+        total = _mm512_add_epi64(total, _mm512_sad_epu8(bytes, _mm512_setzero_si512()));
+    }
+    alignas(64) std::uint64_t lanes[8];
+    _mm512_store_si512(lanes, total);
+    std::size_t count = 0;
+    for (auto e: lanes) {
+        count += e;
+    }
+    return count;
+}
+
+KON_ATTR_TARGET("avx2")
+std::size_t bitset_count_avx2(const std::uint64_t *words, std::size_t n) noexcept {
+    const __m256i lookup =
+        _mm256_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4, //
+                         0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+    const __m256i low_mask = _mm256_set1_epi8(0x0F);
+    __m256i total = _mm256_setzero_si256();
+    for (std::size_t i = 0; i < n; i += 4) {
+        __m256i v = _mm256_load_si256(reinterpret_cast<const __m256i *>(words + i));
+        __m256i low = _mm256_shuffle_epi8(lookup, _mm256_and_si256(v, low_mask));
+        __m256i high =
+            _mm256_shuffle_epi8(lookup, _mm256_and_si256(_mm256_srli_epi16(v, 4), low_mask));
+        __m256i bytes = _mm256_add_epi8(low, high);
+        total = _mm256_add_epi64(total, _mm256_sad_epu8(bytes, _mm256_setzero_si256()));
+    }
+    __m128i sum = _mm_add_epi64(_mm256_castsi256_si128(total), _mm256_extracti128_si256(total, 1));
+    return static_cast<std::size_t>(_mm_cvtsi128_si64(sum) + _mm_extract_epi64(sum, 1));
+}
+
+KON_ATTR_TARGET("popcnt")
+std::size_t bitset_count_popcnt(const std::uint64_t *words, std::size_t n) noexcept {
+    std::size_t count = 0;
+    for (std::size_t i = 0; i < n; i++) {
+        count += static_cast<std::size_t>(__builtin_popcountll(words[i]));
+    }
+    return count;
+}
+
+KON_ATTR_TARGET("avx512f")
+std::size_t bitset_find_nonzero_avx512(
+    const std::uint64_t *words,
+    std::size_t begin,
+    std::size_t n) noexcept {
+    for (std::size_t i = begin; i < n; i += line_words) {
+        __m512i v = _mm512_load_si512(words + i);
+        auto mask = _mm512_test_epi64_mask(v, v);
+        if (mask != 0) {
+            return i + kon::countr_zero<unsigned, true>(mask);
+        }
+    }
+    return n;
+}
+
+KON_ATTR_TARGET("avx2")
+std::size_t bitset_find_nonzero_avx2(
+    const std::uint64_t *words,
+    std::size_t begin,
+    std::size_t n) noexcept {
+    for (std::size_t i = begin; i < n; i += line_words) {
+        __m256i a = _mm256_load_si256(reinterpret_cast<const __m256i *>(words + i));
+        __m256i b = _mm256_load_si256(reinterpret_cast<const __m256i *>(words + i + 4));
+        if (!_mm256_testz_si256(_mm256_or_si256(a, b), _mm256_or_si256(a, b))) {
+            return bitset_find_nonzero_scalar(words, i, i + line_words);
+        }
+    }
+    return n;
+}
+#elif defined(KON_ARCH_ARM64)
+template <bitset_op op>
+void bitset_apply_neon(std::uint64_t *dst, const std::uint64_t *src, std::size_t n) noexcept {
+    for (std::size_t i = 0; i < n; i += 2) {
+        uint64x2_t a = vld1q_u64(dst + i);
+        uint64x2_t b = vld1q_u64(src + i);
+        if constexpr (op == bitset_op::and_) {
+            a = vandq_u64(a, b);
+        } else if constexpr (op == bitset_op::or_) {
+            a = vorrq_u64(a, b);
+        } else if constexpr (op == bitset_op::xor_) {
+            a = veorq_u64(a, b);
+        } else {
+            a = vbicq_u64(a, b);
+        }
+        vst1q_u64(dst + i, a);
+    }
+}
+
+std::size_t bitset_count_neon(const std::uint64_t *words, std::size_t n) noexcept {
+    uint64x2_t total = vdupq_n_u64(0);
+    for (std::size_t i = 0; i < n; i += 2) {
+        uint8x16_t bytes = vcntq_u8(vreinterpretq_u8_u64(vld1q_u64(words + i)));
+        total = vpadalq_u32(total, vpaddlq_u16(vpaddlq_u8(bytes)));
+    }
+    return static_cast<std::size_t>(vaddvq_u64(total));
+}
+#endif
+
+template <bitset_op op>
+void bitset_apply(std::uint64_t *dst, const std::uint64_t *src, std::size_t n) noexcept {
+#if defined(KON_ARCH_X86)
+    if (rt::cpu().avx512f) {
+        return bitset_apply_avx512<op>(dst, src, n);
+    }
+    if (rt::cpu().avx2) {
+        return bitset_apply_avx2<op>(dst, src, n);
+    }
+#elif defined(KON_ARCH_ARM64)
+    return bitset_apply_neon<op>(dst, src, n);
+#endif
+    bitset_apply_scalar<op>(dst, src, n);
+}
+} // namespace
+
+void bitset_apply(
+    bitset_op op,
+    std::uint64_t *dst,
+    const std::uint64_t *src,
+    std::size_t n) noexcept {
+    switch (op) {
+    case bitset_op::and_:
+        return bitset_apply<bitset_op::and_>(dst, src, n);
+    case bitset_op::or_:
+        return bitset_apply<bitset_op::or_>(dst, src, n);
+    case bitset_op::xor_:
+        return bitset_apply<bitset_op::xor_>(dst, src, n);
+    case bitset_op::and_not:
+        return bitset_apply<bitset_op::and_not>(dst, src, n);
+    }
+}
+
+std::size_t bitset_count(const std::uint64_t *words, std::size_t n) noexcept {
+#if defined(KON_ARCH_X86)
+    if (rt::cpu().avx512bw) {
+        return bitset_count_avx512(words, n);
+    }
+    if (rt::cpu().avx2) {
+        return bitset_count_avx2(words, n);
+    }
+    if (rt::cpu().popcnt) {
+        return bitset_count_popcnt(words, n);
+    }
+#elif defined(KON_ARCH_ARM64)
+    return bitset_count_neon(words, n);
+#endif
+    return bitset_count_scalar(words, n);
+}
+
+std::size_t bitset_find_nonzero(
+    const std::uint64_t *words,
+    std::size_t begin,
+    std::size_t n) noexcept {
+    // The words up to the next cache line one by one, the neighbours are likely set.
+    std::size_t aligned = std::min((begin + line_words - 1) & ~(line_words - 1), n);
+    std::size_t i = bitset_find_nonzero_scalar(words, begin, aligned);
+    if (i != aligned) {
+        return i;
+    }
+#if defined(KON_ARCH_X86)
+    if (rt::cpu().avx512f) {
+        return bitset_find_nonzero_avx512(words, aligned, n);
+    }
+    if (rt::cpu().avx2) {
+        return bitset_find_nonzero_avx2(words, aligned, n);
+    }
+#endif
+    return bitset_find_nonzero_scalar(words, aligned, n);
+}
+} // namespace detail
+
+bool dynamic_bitset::resize(std::size_t size) noexcept {
+    std::size_t word_count = (size + line_words * word_bits - 1) / (line_words * word_bits);
+    word_count *= line_words;
+    if (word_count != m_word_count) {
+        word_type *words = nullptr;
+        if (word_count != 0) {
+            words = static_cast<word_type *>(::operator new(
+                word_count * sizeof(word_type),
+                std::align_val_t{line_words * sizeof(word_type)},
+                std::nothrow));
+            if (words == nullptr) {
+                return false;
+            }
+            std::size_t kept = std::min(word_count, m_word_count);
+            if (kept != 0) {
+                std::memcpy(words, m_words, kept * sizeof(word_type));
+            }
+            std::memset(words + kept, 0, (word_count - kept) * sizeof(word_type));
+        }
+        release();
+        m_words = words;
+        m_word_count = word_count;
+    }
+    m_size = size;
+    trim();
+    return true;
+}
+
+bool dynamic_bitset::assign(const dynamic_bitset &other) noexcept {
+    if (this == &other) {
+        return true;
+    }
+    if (!resize(other.m_size)) {
+        return false;
+    }
+    if (m_word_count != 0) {
+        std::memcpy(m_words, other.m_words, m_word_count * sizeof(word_type));
+    }
+    return true;
+}
+
+dynamic_bitset &dynamic_bitset::set() noexcept {
+    std::size_t n = (m_size + word_bits - 1) / word_bits;
+    if (n != 0) {
+        std::memset(m_words, 0xFF, n * sizeof(word_type));
+        trim();
+    }
+    return *this;
+}
+
+dynamic_bitset &dynamic_bitset::set(std::size_t msb, std::size_t lsb) noexcept {
+    std::size_t ly = lsb / word_bits;
+    std::size_t my = msb / word_bits;
+    word_type low = ~word_type{0} << (lsb % word_bits);
+    word_type high = ~word_type{0} >> (word_bits - 1 - msb % word_bits);
+    if (ly == my) {
+        m_words[ly] |= low & high;
+        return *this;
+    }
+    m_words[ly] |= low;
+    for (ly++; ly < my; ly++) {
+        m_words[ly] = ~word_type{0};
+    }
+    m_words[my] |= high;
+    return *this;
+}
+
+dynamic_bitset &dynamic_bitset::reset() noexcept {
+    if (m_word_count != 0) {
+        std::memset(m_words, 0, m_word_count * sizeof(word_type));
+    }
+    return *this;
+}
+
+dynamic_bitset &dynamic_bitset::reset(std::size_t msb, std::size_t lsb) noexcept {
+    std::size_t ly = lsb / word_bits;
+    std::size_t my = msb / word_bits;
+    word_type low = ~word_type{0} << (lsb % word_bits);
+    word_type high = ~word_type{0} >> (word_bits - 1 - msb % word_bits);
+    if (ly == my) {
+        m_words[ly] &= ~(low & high);
+        return *this;
+    }
+    m_words[ly] &= ~low;
+    for (ly++; ly < my; ly++) {
+        m_words[ly] = 0;
+    }
+    m_words[my] &= ~high;
+    return *this;
+}
+
+dynamic_bitset &dynamic_bitset::flip() noexcept {
+    std::size_t n = (m_size + word_bits - 1) / word_bits;
+    for (std::size_t i = 0; i < n; i++) {
+        m_words[i] = ~m_words[i];
+    }
+    trim();
+    return *this;
+}
+
+bool operator==(const dynamic_bitset &lhs, const dynamic_bitset &rhs) noexcept {
+    if (lhs.m_size != rhs.m_size) {
+        return false;
+    }
+    std::size_t bytes = lhs.m_word_count * sizeof(dynamic_bitset::word_type);
+    return (bytes == 0) || (std::memcmp(lhs.m_words, rhs.m_words, bytes) == 0);
+}
+
+void dynamic_bitset::trim() noexcept {
+    std::size_t y = m_size / word_bits;
+    if (y == m_word_count) {
+        return;
+    }
+    m_words[y] &= (word_type{1} << (m_size % word_bits)) - 1;
+    for (y++; y < m_word_count; y++) {
+        m_words[y] = 0;
+    }
+}
+
+void dynamic_bitset::release() noexcept {
+    if (m_words != nullptr) {
+        ::operator delete(m_words, std::align_val_t{line_words * sizeof(word_type)});
+        m_words = nullptr;
+    }
+    m_size = 0;
+    m_word_count = 0;
+}
+
+} // namespace kon
@@ -0,0 +1,235 @@
+// SPDX-FileCopyrightText: 2026 TypeCombinator <typecombinator@foxmail.com>
+//
+// SPDX-License-Identifier: BSD 3-Clause
+
+#ifndef DYNAMIC_BITSET_F16E8448_7B3C_4E88_B89B_2D6D6CD9C0F9
+#define DYNAMIC_BITSET_F16E8448_7B3C_4E88_B89B_2D6D6CD9C0F9
+#include <kon/bit.hpp>
+#include <kon/xt/attributes.hpp>
+#include <cstddef>
+#include <cstdint>
+
+namespace kon {
+namespace detail {
+enum class bitset_op {
+    and_,
+    or_,
+    xor_,
+    and_not,
+};
+
+// The kernels run over whole cache lines, n is a multiple of 8 words.
+void bitset_apply(
+    bitset_op op,
+    std::uint64_t *dst,
+    const std::uint64_t *src,
+    std::size_t n) noexcept;
+std::size_t bitset_count(const std::uint64_t *words, std::size_t n) noexcept;
+// The index of the first non-zero word in [begin, n), n if none.
+std::size_t bitset_find_nonzero(
+    const std::uint64_t *words,
+    std::size_t begin,
+    std::size_t n) noexcept;
+} // namespace detail
+
+// A bitset sized at run time. The words are aligned to and padded to cache lines, the padding
+// bits stay 0, so the bulk operations run on whole vectors. The binary operations require the
+// bitsets to have the same size.
+class dynamic_bitset {
+   public:
+    using word_type = std::uint64_t;
+    static constexpr std::size_t word_bits = 64;
+    static constexpr std::size_t line_words = 8;
+    static constexpr std::size_t npos = ~std::size_t{0};
+
+    dynamic_bitset() noexcept = default;
+
+    dynamic_bitset(dynamic_bitset &&other) noexcept
+        : m_words{other.m_words}
+        , m_size{other.m_size}
+        , m_word_count{other.m_word_count} {
+        other.m_words = nullptr;
+        other.m_size = 0;
+        other.m_word_count = 0;
+    }
+
+    dynamic_bitset &operator=(dynamic_bitset &&other) noexcept {
+        if (this != &other) {
+            release();
+            m_words = other.m_words;
+            m_size = other.m_size;
+            m_word_count = other.m_word_count;
+            other.m_words = nullptr;
+            other.m_size = 0;
+            other.m_word_count = 0;
+        }
+        return *this;
+    }
+
+    ~dynamic_bitset() noexcept {
+        release();
+    }
+
+    KON_DISALLOW_COPY(dynamic_bitset);
+
+    // The bits kept are unchanged, the new ones are 0. Returns false if the allocation fails, the
+    // bitset is unchanged then.
+    bool resize(std::size_t size) noexcept;
+
+    // Copies the other bitset, resizing this one. Returns false if the allocation fails.
+    bool assign(const dynamic_bitset &other) noexcept;
+
+    [[nodiscard]]
+    std::size_t size() const noexcept {
+        return m_size;
+    }
+
+    // The number of words, the padding included.
+    [[nodiscard]]
+    std::size_t word_count() const noexcept {
+        return m_word_count;
+    }
+
+    [[nodiscard]]
+    const word_type *words() const noexcept {
+        return m_words;
+    }
+
+    dynamic_bitset &set() noexcept;
+
+    dynamic_bitset &set(std::size_t pos) noexcept {
+        m_words[pos / word_bits] |= word_type{1} << (pos % word_bits);
+        return *this;
+    }
+
+    // The bits in [lsb, msb].
+    dynamic_bitset &set(std::size_t msb, std::size_t lsb) noexcept;
+
+    dynamic_bitset &reset() noexcept;
+
+    dynamic_bitset &reset(std::size_t pos) noexcept {
+        m_words[pos / word_bits] &= ~(word_type{1} << (pos % word_bits));
+        return *this;
+    }
+
+    dynamic_bitset &reset(std::size_t msb, std::size_t lsb) noexcept;
+
+    dynamic_bitset &flip() noexcept;
+
+    dynamic_bitset &flip(std::size_t pos) noexcept {
+        m_words[pos / word_bits] ^= word_type{1} << (pos % word_bits);
+        return *this;
+    }
+
+    [[nodiscard]]
+    bool test(std::size_t pos) const noexcept {
+        return (m_words[pos / word_bits] >> (pos % word_bits)) & 1;
+    }
+
+    [[nodiscard]]
+    bool operator[](std::size_t pos) const noexcept {
+        return test(pos);
+    }
+
+    [[nodiscard]]
+    std::size_t count() const noexcept {
+        return detail::bitset_count(m_words, m_word_count);
+    }
+
+    [[nodiscard]]
+    bool any() const noexcept {
+        return detail::bitset_find_nonzero(m_words, 0, m_word_count) != m_word_count;
+    }
+
+    [[nodiscard]]
+    bool none() const noexcept {
+        return !any();
+    }
+
+    [[nodiscard]]
+    bool all() const noexcept {
+        return count() == m_size;
+    }
+
+    // The first set bit, npos if none.
+    [[nodiscard]]
+    std::size_t find_first() const noexcept {
+        return find_from(0);
+    }
+
+    // The first set bit after pos, npos if none.
+    [[nodiscard]]
+    std::size_t find_next(std::size_t pos) const noexcept {
+        pos++;
+        if (pos >= m_size) [[unlikely]] {
+            return npos;
+        }
+        std::size_t y = pos / word_bits;
+        word_type e = m_words[y] & (~word_type{0} << (pos % word_bits));
+        if (e != 0) [[likely]] {
+            return y * word_bits + kon::countr_zero<word_type, true>(e);
+        }
+        return find_from(y + 1);
+    }
+
+    // Calls f(pos) for every set bit in ascending order, the runs of zero words are skipped by
+    // the vector scan. It's suitable for sparse data.
+    template <typename F>
+    void for_each_set(F &&f) const {
+        std::size_t y = 0;
+        while (y < m_word_count) {
+            word_type e = m_words[y];
+            if (e == 0) {
+                y = detail::bitset_find_nonzero(m_words, y + 1, m_word_count);
+                continue;
+            }
+            const std::size_t base = y * word_bits;
+            kon::bit_for_each(e, [&f, base](unsigned char i) {
+                f(base + i);
+            });
+            y++;
+        }
+    }
+
+    dynamic_bitset &operator&=(const dynamic_bitset &other) noexcept {
+        detail::bitset_apply(detail::bitset_op::and_, m_words, other.m_words, m_word_count);
+        return *this;
+    }
+
+    dynamic_bitset &operator|=(const dynamic_bitset &other) noexcept {
+        detail::bitset_apply(detail::bitset_op::or_, m_words, other.m_words, m_word_count);
+        return *this;
+    }
+
+    dynamic_bitset &operator^=(const dynamic_bitset &other) noexcept {
+        detail::bitset_apply(detail::bitset_op::xor_, m_words, other.m_words, m_word_count);
+        return *this;
+    }
+
+    // this &= ~other
+    dynamic_bitset &and_not(const dynamic_bitset &other) noexcept {
+        detail::bitset_apply(detail::bitset_op::and_not, m_words, other.m_words, m_word_count);
+        return *this;
+    }
+
+    friend bool operator==(const dynamic_bitset &lhs, const dynamic_bitset &rhs) noexcept;
+   private:
+    std::size_t find_from(std::size_t y) const noexcept {
+        y = detail::bitset_find_nonzero(m_words, y, m_word_count);
+        if (y == m_word_count) {
+            return npos;
+        }
+        return y * word_bits + kon::countr_zero<word_type, true>(m_words[y]);
+    }
+
+    // Clears the bits past size() in the last word.
+    void trim() noexcept;
+    void release() noexcept;
+
+    word_type *m_words{nullptr};
+    std::size_t m_size{0};
+    std::size_t m_word_count{0};
+};
+
+} // namespace kon
+#endif // dynamic_bitset.hpp
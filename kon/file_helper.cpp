@@ -3,8 +3,20 @@
 // SPDX-License-Identifier: BSD 3-Clause
 
 #include "file_helper.hpp"
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
 #include <fstream>
+#include <mutex>
+#include <thread>
 #include <fcntl.h>
+#ifdef __linux__
+    #include <dirent.h>
+    #include <sys/stat.h>
+    #include <sys/syscall.h>
+    #include <unistd.h>
+#endif
 
 namespace kon::file_helper {
 
@@ -30,6 +42,16 @@ std::unique_ptr<std::uint8_t[]> read_all(const std::string &file_name, size_t &f
     return buffer;
 }
 
+int read_all(const std::string &file_name, mapped_file &file) noexcept {
+    int err;
+    mapped_file mapped(err, file_name, {.populate = true, .advice = file_advice::sequential});
+    if (err != 0) {
+        return err;
+    }
+    file = std::move(mapped);
+    return 0;
+}
+
 int write_all(int fd, const uint8_t *data, std::size_t size) {
     std::size_t offset{};
     while (size > 0) {
@@ -97,6 +119,249 @@ std::string create_tempfile(std::string_view prefix, std::string_view script) {
     close(fd);
     return file_name;
 }
+
+namespace {
+struct linux_dirent64 {
+    ino64_t d_ino;
+    off64_t d_off;
+    unsigned short d_reclen;
+    unsigned char d_type;
+    char d_name[];
+};
+
+struct bulk_entry {
+    std::string path;
+    std::size_t size;
+};
+
+// Lists the directory path (relative to root_fd), appends its files and sub directories.
+int scan_directory(
+    int root_fd,
+    const std::string &path,
+    std::vector<bulk_entry> &files,
+    std::vector<std::string> &directories) noexcept {
+    int fd = ::openat(
+        root_fd,
+        path.empty() ? "." : path.c_str(),
+        O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if (fd < 0) {
+        return -1;
+    }
+    alignas(linux_dirent64) char buffer[32768];
+    int ret = 0;
+    try {
+        for (;;) {
+            long n = ::syscall(SYS_getdents64, fd, buffer, sizeof(buffer));
+            if (n <= 0) {
+                ret = (n < 0) ? -1 : 0;
+                break;
+            }
+            for (long offset = 0; offset < n;) {
+                auto entry = reinterpret_cast<linux_dirent64 *>(buffer + offset);
+                offset += entry->d_reclen;
+                const char *name = entry->d_name;
+                if ((name[0] == '.') &&
+                    ((name[1] == '\0') || ((name[1] == '.') && (name[2] == '\0')))) {
+                    continue;
+                }
+                std::string child = path.empty() ? std::string{name} : path + '/' + name;
+                if (entry->d_type == DT_DIR) {
+                    directories.push_back(std::move(child));
+                    continue;
+                }
+                if ((entry->d_type != DT_REG) && (entry->d_type != DT_LNK) &&
+                    (entry->d_type != DT_UNKNOWN)) {
+                    continue;
+                }
+                // The size is needed anyway, the symbolic links to files are followed.
+                struct stat st;
+                if (::fstatat(fd, name, &st, 0) != 0) {
+                    continue;
+                }
+                if (S_ISREG(st.st_mode)) {
+                    files.push_back({std::move(child), static_cast<std::size_t>(st.st_size)});
+                } else if (S_ISDIR(st.st_mode) && (entry->d_type == DT_UNKNOWN)) {
+                    directories.push_back(std::move(child));
+                }
+            }
+        }
+    } catch (...) {
+        ret = -2;
+    }
+    ::close(fd);
+    return ret;
+}
+
+// Reads up to size bytes, a file which grew since the scan is truncated.
+int read_at(int root_fd, const std::string &path, char *data, std::size_t &size) noexcept {
+    int fd = ::openat(root_fd, path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        size = 0;
+        return errno;
+    }
+    std::size_t sum = 0;
+    while (sum < size) {
+        auto n = ::read(fd, data + sum, size - sum);
+        if (n < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            int err = errno;
+            ::close(fd);
+            size = sum;
+            return err;
+        }
+        if (n == 0) {
+            break;
+        }
+        sum += n;
+    }
+    ::close(fd);
+    size = sum;
+    return 0;
+}
+} // namespace
+
+int load_directory(const std::string &dir_name, bulk_load &result, std::size_t threads) {
+    constexpr std::size_t max_threads = 8;
+
+    result.storage.reset();
+    result.files.clear();
+    int root_fd = ::open(dir_name.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if (root_fd < 0) {
+        return -1;
+    }
+    if (threads == 0) {
+        threads = std::min<std::size_t>(
+            max_threads,
+            std::max(1U, std::thread::hardware_concurrency()));
+    }
+
+    // Scan, the sub directories found by a worker are shared with the others.
+    std::vector<bulk_entry> entries;
+    std::deque<std::string> pending{""};
+    std::size_t busy = 0;
+    int ret = 0;
+    std::mutex lock;
+    std::condition_variable cv;
+    auto scanner = [&]() {
+        std::vector<bulk_entry> files;
+        std::vector<std::string> directories;
+        std::unique_lock guard{lock};
+        for (;;) {
+            cv.wait(guard, [&]() {
+                return !pending.empty() || (busy == 0) || (ret != 0);
+            });
+            if (pending.empty() || (ret != 0)) {
+                cv.notify_all();
+                return;
+            }
+            std::string path = std::move(pending.front());
+            pending.pop_front();
+            busy++;
+            guard.unlock();
+
+            files.clear();
+            directories.clear();
+            int err = scan_directory(root_fd, path, files, directories);
+
+            guard.lock();
+            busy--;
+            if (err != 0) {
+                ret = err;
+            }
+            for (auto &d: directories) {
+                pending.push_back(std::move(d));
+            }
+            for (auto &f: files) {
+                entries.push_back(std::move(f));
+            }
+            cv.notify_all();
+        }
+    };
+    std::vector<std::thread> pool;
+    pool.reserve(threads);
+    try {
+        for (std::size_t i = 1; i < threads; i++) {
+            pool.emplace_back(scanner);
+        }
+    } catch (...) {
+        // The workers started already stop, so does the caller.
+        std::lock_guard guard{lock};
+        ret = -3;
+        cv.notify_all();
+    }
+    scanner();
+    for (auto &t: pool) {
+        t.join();
+    }
+    pool.clear();
+    if (ret != 0) {
+        ::close(root_fd);
+        return ret;
+    }
+
+    // Lay the contents out in one allocation, each one followed by a '\0'.
+    std::sort(entries.begin(), entries.end(), [](const auto &lhs, const auto &rhs) {
+        return lhs.path < rhs.path;
+    });
+    std::size_t total = 0;
+    for (const auto &e: entries) {
+        total += e.size + 1;
+    }
+    result.storage.reset(new (std::nothrow) char[std::max<std::size_t>(total, 1)]);
+    if (result.storage == nullptr) {
+        ::close(root_fd);
+        return -2;
+    }
+    result.files.reserve(entries.size());
+    std::vector<std::size_t> offsets;
+    offsets.reserve(entries.size());
+    std::size_t offset = 0;
+    for (auto &e: entries) {
+        offsets.push_back(offset);
+        offset += e.size + 1;
+        result.files.push_back({std::move(e.path), {}, 0});
+    }
+
+    // Each worker takes the next file, large and small files are balanced on the fly.
+    std::atomic<std::size_t> next{0};
+    auto reader = [&]() noexcept {
+        for (;;) {
+            std::size_t i = next.fetch_add(1, std::memory_order_relaxed);
+            if (i >= entries.size()) {
+                return;
+            }
+            auto &file = result.files[i];
+            char *data = result.storage.get() + offsets[i];
+            std::size_t size = entries[i].size;
+            file.err = read_at(root_fd, file.path, data, size);
+            data[size] = '\0';
+            file.content = std::string_view{data, size};
+        }
+    };
+    threads = std::min(threads, entries.size());
+    try {
+        for (std::size_t i = 1; i < threads; i++) {
+            pool.emplace_back(reader);
+        }
+    } catch (...) {
+        next.store(entries.size(), std::memory_order_relaxed);
+        for (auto &t: pool) {
+            t.join();
+        }
+        result.storage.reset();
+        result.files.clear();
+        ::close(root_fd);
+        return -3;
+    }
+    reader();
+    for (auto &t: pool) {
+        t.join();
+    }
+    ::close(root_fd);
+    return 0;
+}
 #endif
 
 
@@ -5,13 +5,20 @@
 #ifndef FILE_HELPER_F096EED7_C6AD_44B1_A05D_5EC47CA6B5E7
 #define FILE_HELPER_F096EED7_C6AD_44B1_A05D_5EC47CA6B5E7
 
+#include <kon/mapped_file.hpp>
 #include <memory>
 #include <filesystem>
+#include <string>
+#include <vector>
 
 namespace kon::file_helper {
 
 std::unique_ptr<std::uint8_t[]> read_all(const std::string &file_name, size_t &file_size);
 
+// Maps the file read-only and prefaulted instead of copying it to the heap, the data isn't NUL
+// terminated.
+int read_all(const std::string &file_name, mapped_file &file) noexcept;
+
 int write_all(int fd, const uint8_t *data, std::size_t size);
 
 // 0: {file0(content0), file1(content1)}
@@ -27,6 +34,22 @@ int rename_swap(
 int swap(const std::string &file0_name, const std::string &file1_name) noexcept;
 
 std::string create_tempfile(std::string_view prefix, std::string_view script);
+
+struct bulk_file {
+    std::string path;         // relative to the loaded directory
+    std::string_view content; // into bulk_load::storage, followed by a '\0'
+    int err;                  // 0, or the errno of a failed open / read
+};
+
+struct bulk_load {
+    std::unique_ptr<char[]> storage; // all the contents in one allocation
+    std::vector<bulk_file> files;    // sorted by path
+};
+
+// Loads all the regular files under dir_name, the tree is walked with getdents64 / openat and the
+// files are read by a pool of threads (0: up to 8). Returns -1 if a directory can't be read, -2 if
+// the storage can't be allocated, -3 if the threads can't be started.
+int load_directory(const std::string &dir_name, bulk_load &result, std::size_t threads = 0);
 #endif
 
 int create_file_directories(const std::filesystem::path &filename);
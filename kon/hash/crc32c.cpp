@@ -0,0 +1,245 @@
+// SPDX-FileCopyrightText: 2026 TypeCombinator <typecombinator@foxmail.com>
+//
+// SPDX-License-Identifier: BSD 3-Clause
+
+#include <kon/hash/crc32c.hpp>
+#include <kon/xt/cpu.hpp>
+#include <array>
+#include <cstring>
+#if defined(KON_ARCH_X86) && (defined(__x86_64__) || defined(_M_X64))
+    #define KON_CRC32C_X86_64 1
+    #include <immintrin.h>
+#elif defined(KON_ARCH_ARM64)
+    #include <arm_acle.h>
+#endif
+
+namespace kon {
+namespace {
+constexpr std::uint32_t crc32c_poly = 0x82F63B78; // reflected 0x1EDC6F41
+
+// The hardware kernels run 3 independent streams of long_len or short_len bytes, the crc32
+// instruction has a latency of 3 cycles and a throughput of 1, then merge them by shifting the
+// previous crc over the zeros of the following streams.
+constexpr std::size_t crc32c_long_len = 8192;
+constexpr std::size_t crc32c_short_len = 256;
+
+using gf2_matrix = std::array<std::uint32_t, 32>;
+using crc32c_table = std::array<std::array<std::uint32_t, 256>, 4>;
+
+constexpr std::uint32_t gf2_matrix_times(const gf2_matrix &mat, std::uint32_t vec) noexcept {
+    std::uint32_t sum = 0;
+    for (std::size_t i = 0; vec != 0; i++, vec >>= 1) {
+        if (vec & 1) {
+            sum ^= mat[i];
+        }
+    }
+    return sum;
+}
+
+constexpr gf2_matrix gf2_matrix_square(const gf2_matrix &mat) noexcept {
+    gf2_matrix square{};
+    for (std::size_t i = 0; i < 32; i++) {
+        square[i] = gf2_matrix_times(mat, mat[i]);
+    }
+    return square;
+}
+
+// Operator of len (power of 2) zero bytes, split into 4 byte tables.
+constexpr crc32c_table crc32c_zeros(std::size_t len) noexcept {
+    gf2_matrix op{};
+    op[0] = crc32c_poly; // one zero bit
+    for (std::size_t i = 1; i < 32; i++) {
+        op[i] = std::uint32_t{1} << (i - 1);
+    }
+    for (std::size_t bits = 1; bits < len * 8; bits <<= 1) {
+        op = gf2_matrix_square(op);
+    }
+    crc32c_table table{};
+    for (std::uint32_t i = 0; i < 256; i++) {
+        for (std::uint32_t k = 0; k < 4; k++) {
+            table[k][i] = gf2_matrix_times(op, i << (8 * k));
+        }
+    }
+    return table;
+}
+
+constexpr std::array<std::array<std::uint32_t, 256>, 8> crc32c_slicing_table() noexcept {
+    std::array<std::array<std::uint32_t, 256>, 8> table{};
+    for (std::uint32_t i = 0; i < 256; i++) {
+        std::uint32_t crc = i;
+        for (int k = 0; k < 8; k++) {
+            crc = (crc >> 1) ^ ((crc & 1) ? crc32c_poly : 0);
+        }
+        table[0][i] = crc;
+    }
+    for (std::uint32_t i = 0; i < 256; i++) {
+        for (std::size_t k = 1; k < 8; k++) {
+            std::uint32_t crc = table[k - 1][i];
+            table[k][i] = (crc >> 8) ^ table[0][crc & 0xFF];
+        }
+    }
+    return table;
+}
+
+constexpr auto crc32c_table8 = crc32c_slicing_table();
+[[maybe_unused]] constexpr auto crc32c_long_zeros = crc32c_zeros(crc32c_long_len);
+[[maybe_unused]] constexpr auto crc32c_short_zeros = crc32c_zeros(crc32c_short_len);
+
+[[maybe_unused]] inline std::uint32_t crc32c_shift(
+    const crc32c_table &zeros,
+    std::uint32_t crc) noexcept {
+    return zeros[0][crc & 0xFF] ^ zeros[1][(crc >> 8) & 0xFF] ^ zeros[2][(crc >> 16) & 0xFF] ^
+           zeros[3][crc >> 24];
+}
+
+inline std::uint64_t crc32c_load64(const unsigned char *p) noexcept {
+    std::uint64_t v;
+    std::memcpy(&v, p, sizeof(v)); // Need little endian!!!
+    return v;
+}
+
+// Slicing-by-8, crc is the inverted register.
+std::uint32_t crc32c_sw(std::uint32_t crc, const unsigned char *p, std::size_t n) noexcept {
+    const auto &t = crc32c_table8;
+    while (n >= 8) {
+        std::uint64_t v = crc32c_load64(p) ^ crc;
+        crc = t[7][v & 0xFF] ^ t[6][(v >> 8) & 0xFF] ^ t[5][(v >> 16) & 0xFF] ^
+              t[4][(v >> 24) & 0xFF] ^ t[3][(v >> 32) & 0xFF] ^ t[2][(v >> 40) & 0xFF] ^
+              t[1][(v >> 48) & 0xFF] ^ t[0][v >> 56];
+        p += 8;
+        n -= 8;
+    }
+    while (n-- != 0) {
+        crc = (crc >> 8) ^ t[0][(crc ^ *p++) & 0xFF];
+    }
+    return crc;
+}
+
+#if defined(KON_CRC32C_X86_64)
+KON_ATTR_TARGET("sse4.2")
+std::uint32_t crc32c_sse42(std::uint32_t crc, const unsigned char *p, std::size_t n) noexcept {
+    while ((n != 0) && ((reinterpret_cast<std::uintptr_t>(p) & 7) != 0)) {
+        crc = _mm_crc32_u8(crc, *p++);
+        n--;
+    }
+    std::uint64_t crc0 = crc;
+    while (n >= crc32c_long_len * 3) {
+        std::uint64_t crc1 = 0, crc2 = 0;
+        const unsigned char *end = p + crc32c_long_len;
+        do {
+            crc0 = _mm_crc32_u64(crc0, crc32c_load64(p));
+            crc1 = _mm_crc32_u64(crc1, crc32c_load64(p + crc32c_long_len));
+            crc2 = _mm_crc32_u64(crc2, crc32c_load64(p + crc32c_long_len * 2));
+            p += 8;
+        } while (p < end);
+        crc0 = crc32c_shift(crc32c_long_zeros, static_cast<std::uint32_t>(crc0)) ^ crc1;
+        crc0 = crc32c_shift(crc32c_long_zeros, static_cast<std::uint32_t>(crc0)) ^ crc2;
+        p += crc32c_long_len * 2;
+        n -= crc32c_long_len * 3;
+    }
+    while (n >= crc32c_short_len * 3) {
+        std::uint64_t crc1 = 0, crc2 = 0;
+        const unsigned char *end = p + crc32c_short_len;
+        do {
+            crc0 = _mm_crc32_u64(crc0, crc32c_load64(p));
+            crc1 = _mm_crc32_u64(crc1, crc32c_load64(p + crc32c_short_len));
+            crc2 = _mm_crc32_u64(crc2, crc32c_load64(p + crc32c_short_len * 2));
+            p += 8;
+        } while (p < end);
+        crc0 = crc32c_shift(crc32c_short_zeros, static_cast<std::uint32_t>(crc0)) ^ crc1;
+        crc0 = crc32c_shift(crc32c_short_zeros, static_cast<std::uint32_t>(crc0)) ^ crc2;
+        p += crc32c_short_len * 2;
+        n -= crc32c_short_len * 3;
+    }
+    while (n >= 8) {
+        crc0 = _mm_crc32_u64(crc0, crc32c_load64(p));
+        p += 8;
+        n -= 8;
+    }
+    crc = static_cast<std::uint32_t>(crc0);
+    while (n-- != 0) {
+        crc = _mm_crc32_u8(crc, *p++);
+    }
+    return crc;
+}
+#elif defined(KON_ARCH_ARM64)
+KON_ATTR_TARGET("+crc")
+std::uint32_t crc32c_armv8(std::uint32_t crc, const unsigned char *p, std::size_t n) noexcept {
+    while ((n != 0) && ((reinterpret_cast<std::uintptr_t>(p) & 7) != 0)) {
+        crc = __crc32cb(crc, *p++);
+        n--;
+    }
+    while (n >= crc32c_long_len * 3) {
+        std::uint32_t crc1 = 0, crc2 = 0;
+        const unsigned char *end = p + crc32c_long_len;
+        do {
+            crc = __crc32cd(crc, crc32c_load64(p));
+            crc1 = __crc32cd(crc1, crc32c_load64(p + crc32c_long_len));
+            crc2 = __crc32cd(crc2, crc32c_load64(p + crc32c_long_len * 2));
+            p += 8;
+        } while (p < end);
+        crc = crc32c_shift(crc32c_long_zeros, crc) ^ crc1;
+        crc = crc32c_shift(crc32c_long_zeros, crc) ^ crc2;
+        p += crc32c_long_len * 2;
+        n -= crc32c_long_len * 3;
+    }
+    while (n >= crc32c_short_len * 3) {
+        std::uint32_t crc1 = 0, crc2 = 0;
+        const unsigned char *end = p + crc32c_short_len;
+        do {
+            crc = __crc32cd(crc, crc32c_load64(p));
+            crc1 = __crc32cd(crc1, crc32c_load64(p + crc32c_short_len));
+            crc2 = __crc32cd(crc2, crc32c_load64(p + crc32c_short_len * 2));
+            p += 8;
+        } while (p < end);
+        crc = crc32c_shift(crc32c_short_zeros, crc) ^ crc1;
+        crc = crc32c_shift(crc32c_short_zeros, crc) ^ crc2;
+        p += crc32c_short_len * 2;
+        n -= crc32c_short_len * 3;
+    }
+    while (n >= 8) {
+        crc = __crc32cd(crc, crc32c_load64(p));
+        p += 8;
+        n -= 8;
+    }
+    while (n-- != 0) {
+        crc = __crc32cb(crc, *p++);
+    }
+    return crc;
+}
+#endif
+
+std::uint32_t crc32c_raw(std::uint32_t crc, const unsigned char *p, std::size_t n) noexcept {
+#if defined(KON_CRC32C_X86_64)
+    if (rt::cpu().sse42) {
+        return crc32c_sse42(crc, p, n);
+    }
+#elif defined(KON_ARCH_ARM64)
+    if (rt::cpu().crc32) {
+        return crc32c_armv8(crc, p, n);
+    }
+#endif
+    return crc32c_sw(crc, p, n);
+}
+} // namespace
+
+void crc32c_context::start() noexcept {
+    m_crc = 0xFFFFFFFF;
+}
+
+void crc32c_context::update(const unsigned char *input, std::size_t ilen) noexcept {
+    m_crc = crc32c_raw(m_crc, input, ilen);
+}
+
+std::uint32_t crc32c_context::finish() noexcept {
+    return ~m_crc;
+}
+
+std::uint32_t crc32c_extend(
+    std::uint32_t crc,
+    const unsigned char *input,
+    std::size_t ilen) noexcept {
+    return ~crc32c_raw(~crc, input, ilen);
+}
+
+} // namespace kon
@@ -0,0 +1,37 @@
+// SPDX-FileCopyrightText: 2026 TypeCombinator <typecombinator@foxmail.com>
+//
+// SPDX-License-Identifier: BSD 3-Clause
+
+#ifndef HASH_CRC32C_57B084BB_9D35_4B17_82EC_35E346FE00EB
+#define HASH_CRC32C_57B084BB_9D35_4B17_82EC_35E346FE00EB
+// References:
+// [0]: https://www.rfc-editor.org/rfc/rfc3720#appendix-B.4
+// [1]: https://stackoverflow.com/questions/17645167/implementing-sse-4-2s-crc32c-in-software
+#include <cstddef>
+#include <cstdint>
+
+namespace kon {
+
+// CRC-32C (Castagnoli), the polynomial of iSCSI, ext4 and SCTP. Uses the SSE4.2 / ARMv8 CRC
+// instructions on 3 interleaved streams when available, slicing-by-8 otherwise.
+class crc32c_context {
+   public:
+    void start() noexcept;
+    void update(const unsigned char *input, std::size_t ilen) noexcept;
+    std::uint32_t finish() noexcept;
+   private:
+    std::uint32_t m_crc; // inverted intermediate crc
+};
+
+// Extend a finished crc with more data, crc32c_extend(0, ...) is the crc of the data.
+std::uint32_t crc32c_extend(
+    std::uint32_t crc,
+    const unsigned char *input,
+    std::size_t ilen) noexcept;
+
+static inline std::uint32_t crc32c(const unsigned char *input, std::size_t ilen) noexcept {
+    return crc32c_extend(0, input, ilen);
+}
+
+} // namespace kon
+#endif // crc32c.hpp
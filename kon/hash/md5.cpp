@@ -3,7 +3,20 @@
 // SPDX-License-Identifier: BSD 3-Clause
 
 #include <cstring>
+#include <kon/bit.hpp>
 #include <kon/hash/md5.hpp>
+#include <kon/mapped_file.hpp>
+#include <algorithm>
+#include <bit>
+#include <atomic>
+#include <cstdio>
+#include <filesystem>
+#include <memory>
+#include <semaphore>
+#include <thread>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
 
 #define MD5_PUT_UINT32_LE(_value_, _data_, _offset_)                                               \
     std::memcpy((_data_) + (_offset_), &(_value_), 4)
@@ -19,115 +32,154 @@ void md5_context::start() noexcept {
     m_state[3] = 0x10325476;
 }
 
-void md5_context::process(const unsigned char data[64]) noexcept {
-    struct {
-        uint32_t X[16], A, B, C, D;
-    } local;
+// Little endian load from an unaligned address, a single mov on x86 and ARM.
+static inline uint32_t md5_load(const unsigned char *p) noexcept {
+    uint32_t v;
+    std::memcpy(&v, p, sizeof(v));
+    if constexpr (std::endian::native == std::endian::big) {
+        v = byteswap(v);
+    }
+    return v;
+}
 
-    // Need little endian!!!
-    std::memcpy(local.X, data, sizeof(local.X));
+// Process all the blocks in one call, the state stays in registers and the words are loaded from
+// the input in place. The message word and the constant are added first, they don't depend on the
+// previous step, so only the boolean function and the rotation are on the critical path.
+void md5_context::process(const unsigned char *data, size_t blocks) noexcept {
+    uint32_t a = m_state[0];
+    uint32_t b = m_state[1];
+    uint32_t c = m_state[2];
+    uint32_t d = m_state[3];
 
-#define S(x, n) (((x) << (n)) | (((x) & 0xFFFFFFFF) >> (32 - (n))))
+#define X(k) md5_load(data + (k) * 4)
 
 #define P(a, b, c, d, k, s, t)                                                                     \
     do {                                                                                           \
-        (a) += F((b), (c), (d)) + local.X[(k)] + (t);                                              \
-        (a) = S((a), (s)) + (b);                                                                   \
+        (a) += X(k) + (t);                                                                         \
+        (a) += F((b), (c), (d));                                                                   \
+        (a) = std::rotl((a), (s)) + (b);                                                           \
     } while (0)
 
-    local.A = m_state[0];
-    local.B = m_state[1];
-    local.C = m_state[2];
-    local.D = m_state[3];
+    for (; blocks != 0; blocks--, data += 64) {
+        const uint32_t aa = a;
+        const uint32_t bb = b;
+        const uint32_t cc = c;
+        const uint32_t dd = d;
 
 #define F(x, y, z) ((z) ^ ((x) & ((y) ^ (z))))
 
-    P(local.A, local.B, local.C, local.D, 0, 7, 0xD76AA478);
-    P(local.D, local.A, local.B, local.C, 1, 12, 0xE8C7B756);
-    P(local.C, local.D, local.A, local.B, 2, 17, 0x242070DB);
-    P(local.B, local.C, local.D, local.A, 3, 22, 0xC1BDCEEE);
-    P(local.A, local.B, local.C, local.D, 4, 7, 0xF57C0FAF);
-    P(local.D, local.A, local.B, local.C, 5, 12, 0x4787C62A);
-    P(local.C, local.D, local.A, local.B, 6, 17, 0xA8304613);
-    P(local.B, local.C, local.D, local.A, 7, 22, 0xFD469501);
-    P(local.A, local.B, local.C, local.D, 8, 7, 0x698098D8);
-    P(local.D, local.A, local.B, local.C, 9, 12, 0x8B44F7AF);
-    P(local.C, local.D, local.A, local.B, 10, 17, 0xFFFF5BB1);
-    P(local.B, local.C, local.D, local.A, 11, 22, 0x895CD7BE);
-    P(local.A, local.B, local.C, local.D, 12, 7, 0x6B901122);
-    P(local.D, local.A, local.B, local.C, 13, 12, 0xFD987193);
-    P(local.C, local.D, local.A, local.B, 14, 17, 0xA679438E);
-    P(local.B, local.C, local.D, local.A, 15, 22, 0x49B40821);
+        P(a, b, c, d, 0, 7, 0xD76AA478);
+        P(d, a, b, c, 1, 12, 0xE8C7B756);
+        P(c, d, a, b, 2, 17, 0x242070DB);
+        P(b, c, d, a, 3, 22, 0xC1BDCEEE);
+        P(a, b, c, d, 4, 7, 0xF57C0FAF);
+        P(d, a, b, c, 5, 12, 0x4787C62A);
+        P(c, d, a, b, 6, 17, 0xA8304613);
+        P(b, c, d, a, 7, 22, 0xFD469501);
+        P(a, b, c, d, 8, 7, 0x698098D8);
+        P(d, a, b, c, 9, 12, 0x8B44F7AF);
+        P(c, d, a, b, 10, 17, 0xFFFF5BB1);
+        P(b, c, d, a, 11, 22, 0x895CD7BE);
+        P(a, b, c, d, 12, 7, 0x6B901122);
+        P(d, a, b, c, 13, 12, 0xFD987193);
+        P(c, d, a, b, 14, 17, 0xA679438E);
+        P(b, c, d, a, 15, 22, 0x49B40821);
 
 #undef F
 
-#define F(x, y, z) ((y) ^ ((z) & ((x) ^ (y))))
-
-    P(local.A, local.B, local.C, local.D, 1, 5, 0xF61E2562);
-    P(local.D, local.A, local.B, local.C, 6, 9, 0xC040B340);
-    P(local.C, local.D, local.A, local.B, 11, 14, 0x265E5A51);
-    P(local.B, local.C, local.D, local.A, 0, 20, 0xE9B6C7AA);
-    P(local.A, local.B, local.C, local.D, 5, 5, 0xD62F105D);
-    P(local.D, local.A, local.B, local.C, 10, 9, 0x02441453);
-    P(local.C, local.D, local.A, local.B, 15, 14, 0xD8A1E681);
-    P(local.B, local.C, local.D, local.A, 4, 20, 0xE7D3FBC8);
-    P(local.A, local.B, local.C, local.D, 9, 5, 0x21E1CDE6);
-    P(local.D, local.A, local.B, local.C, 14, 9, 0xC33707D6);
-    P(local.C, local.D, local.A, local.B, 3, 14, 0xF4D50D87);
-    P(local.B, local.C, local.D, local.A, 8, 20, 0x455A14ED);
-    P(local.A, local.B, local.C, local.D, 13, 5, 0xA9E3E905);
-    P(local.D, local.A, local.B, local.C, 2, 9, 0xFCEFA3F8);
-    P(local.C, local.D, local.A, local.B, 7, 14, 0x676F02D9);
-    P(local.B, local.C, local.D, local.A, 12, 20, 0x8D2A4C8A);
+// G(x, y, z) = (x & z) | (y & ~z), the two terms are disjoint, so they are added separately and
+// (y & ~z) doesn't wait for x, the result of the previous step.
+#undef P
+#define P(a, b, c, d, k, s, t)                                                                     \
+    do {                                                                                           \
+        (a) += X(k) + (t);                                                                         \
+        (a) += (c) & ~(d);                                                                         \
+        (a) += (b) & (d);                                                                          \
+        (a) = std::rotl((a), (s)) + (b);                                                           \
+    } while (0)
 
-#undef F
+        P(a, b, c, d, 1, 5, 0xF61E2562);
+        P(d, a, b, c, 6, 9, 0xC040B340);
+        P(c, d, a, b, 11, 14, 0x265E5A51);
+        P(b, c, d, a, 0, 20, 0xE9B6C7AA);
+        P(a, b, c, d, 5, 5, 0xD62F105D);
+        P(d, a, b, c, 10, 9, 0x02441453);
+        P(c, d, a, b, 15, 14, 0xD8A1E681);
+        P(b, c, d, a, 4, 20, 0xE7D3FBC8);
+        P(a, b, c, d, 9, 5, 0x21E1CDE6);
+        P(d, a, b, c, 14, 9, 0xC33707D6);
+        P(c, d, a, b, 3, 14, 0xF4D50D87);
+        P(b, c, d, a, 8, 20, 0x455A14ED);
+        P(a, b, c, d, 13, 5, 0xA9E3E905);
+        P(d, a, b, c, 2, 9, 0xFCEFA3F8);
+        P(c, d, a, b, 7, 14, 0x676F02D9);
+        P(b, c, d, a, 12, 20, 0x8D2A4C8A);
+
+#undef P
+#define P(a, b, c, d, k, s, t)                                                                     \
+    do {                                                                                           \
+        (a) += X(k) + (t);                                                                         \
+        (a) += F((b), (c), (d));                                                                   \
+        (a) = std::rotl((a), (s)) + (b);                                                           \
+    } while (0)
 
-#define F(x, y, z) ((x) ^ (y) ^ (z))
-
-    P(local.A, local.B, local.C, local.D, 5, 4, 0xFFFA3942);
-    P(local.D, local.A, local.B, local.C, 8, 11, 0x8771F681);
-    P(local.C, local.D, local.A, local.B, 11, 16, 0x6D9D6122);
-    P(local.B, local.C, local.D, local.A, 14, 23, 0xFDE5380C);
-    P(local.A, local.B, local.C, local.D, 1, 4, 0xA4BEEA44);
-    P(local.D, local.A, local.B, local.C, 4, 11, 0x4BDECFA9);
-    P(local.C, local.D, local.A, local.B, 7, 16, 0xF6BB4B60);
-    P(local.B, local.C, local.D, local.A, 10, 23, 0xBEBFBC70);
-    P(local.A, local.B, local.C, local.D, 13, 4, 0x289B7EC6);
-    P(local.D, local.A, local.B, local.C, 0, 11, 0xEAA127FA);
-    P(local.C, local.D, local.A, local.B, 3, 16, 0xD4EF3085);
-    P(local.B, local.C, local.D, local.A, 6, 23, 0x04881D05);
-    P(local.A, local.B, local.C, local.D, 9, 4, 0xD9D4D039);
-    P(local.D, local.A, local.B, local.C, 12, 11, 0xE6DB99E5);
-    P(local.C, local.D, local.A, local.B, 15, 16, 0x1FA27CF8);
-    P(local.B, local.C, local.D, local.A, 2, 23, 0xC4AC5665);
+// H(x, y, z) = x ^ y ^ z, y ^ z first as x is the result of the previous step.
+#define F(x, y, z) ((x) ^ ((y) ^ (z)))
+
+        P(a, b, c, d, 5, 4, 0xFFFA3942);
+        P(d, a, b, c, 8, 11, 0x8771F681);
+        P(c, d, a, b, 11, 16, 0x6D9D6122);
+        P(b, c, d, a, 14, 23, 0xFDE5380C);
+        P(a, b, c, d, 1, 4, 0xA4BEEA44);
+        P(d, a, b, c, 4, 11, 0x4BDECFA9);
+        P(c, d, a, b, 7, 16, 0xF6BB4B60);
+        P(b, c, d, a, 10, 23, 0xBEBFBC70);
+        P(a, b, c, d, 13, 4, 0x289B7EC6);
+        P(d, a, b, c, 0, 11, 0xEAA127FA);
+        P(c, d, a, b, 3, 16, 0xD4EF3085);
+        P(b, c, d, a, 6, 23, 0x04881D05);
+        P(a, b, c, d, 9, 4, 0xD9D4D039);
+        P(d, a, b, c, 12, 11, 0xE6DB99E5);
+        P(c, d, a, b, 15, 16, 0x1FA27CF8);
+        P(b, c, d, a, 2, 23, 0xC4AC5665);
 
 #undef F
 
-#define F(x, y, z) ((y) ^ ((x) | ~(z)))
-
-    P(local.A, local.B, local.C, local.D, 0, 6, 0xF4292244);
-    P(local.D, local.A, local.B, local.C, 7, 10, 0x432AFF97);
-    P(local.C, local.D, local.A, local.B, 14, 15, 0xAB9423A7);
-    P(local.B, local.C, local.D, local.A, 5, 21, 0xFC93A039);
-    P(local.A, local.B, local.C, local.D, 12, 6, 0x655B59C3);
-    P(local.D, local.A, local.B, local.C, 3, 10, 0x8F0CCC92);
-    P(local.C, local.D, local.A, local.B, 10, 15, 0xFFEFF47D);
-    P(local.B, local.C, local.D, local.A, 1, 21, 0x85845DD1);
-    P(local.A, local.B, local.C, local.D, 8, 6, 0x6FA87E4F);
-    P(local.D, local.A, local.B, local.C, 15, 10, 0xFE2CE6E0);
-    P(local.C, local.D, local.A, local.B, 6, 15, 0xA3014314);
-    P(local.B, local.C, local.D, local.A, 13, 21, 0x4E0811A1);
-    P(local.A, local.B, local.C, local.D, 4, 6, 0xF7537E82);
-    P(local.D, local.A, local.B, local.C, 11, 10, 0xBD3AF235);
-    P(local.C, local.D, local.A, local.B, 2, 15, 0x2AD7D2BB);
-    P(local.B, local.C, local.D, local.A, 9, 21, 0xEB86D391);
+// I(x, y, z) = y ^ (x | ~z), ~z is off the critical path.
+#define F(x, y, z) ((y) ^ (~(z) | (x)))
+
+        P(a, b, c, d, 0, 6, 0xF4292244);
+        P(d, a, b, c, 7, 10, 0x432AFF97);
+        P(c, d, a, b, 14, 15, 0xAB9423A7);
+        P(b, c, d, a, 5, 21, 0xFC93A039);
+        P(a, b, c, d, 12, 6, 0x655B59C3);
+        P(d, a, b, c, 3, 10, 0x8F0CCC92);
+        P(c, d, a, b, 10, 15, 0xFFEFF47D);
+        P(b, c, d, a, 1, 21, 0x85845DD1);
+        P(a, b, c, d, 8, 6, 0x6FA87E4F);
+        P(d, a, b, c, 15, 10, 0xFE2CE6E0);
+        P(c, d, a, b, 6, 15, 0xA3014314);
+        P(b, c, d, a, 13, 21, 0x4E0811A1);
+        P(a, b, c, d, 4, 6, 0xF7537E82);
+        P(d, a, b, c, 11, 10, 0xBD3AF235);
+        P(c, d, a, b, 2, 15, 0x2AD7D2BB);
+        P(b, c, d, a, 9, 21, 0xEB86D391);
 
 #undef F
 
-    m_state[0] += local.A;
-    m_state[1] += local.B;
-    m_state[2] += local.C;
-    m_state[3] += local.D;
+        a += aa;
+        b += bb;
+        c += cc;
+        d += dd;
+    }
+
+#undef P
+#undef X
+
+    m_state[0] = a;
+    m_state[1] = b;
+    m_state[2] = c;
+    m_state[3] = d;
 }
 
 void md5_context::update(const unsigned char *input, size_t ilen) noexcept {
@@ -150,18 +202,19 @@ void md5_context::update(const unsigned char *input, size_t ilen) noexcept {
 
     if (left && ilen >= fill) {
         std::memcpy(m_buffer + left, input, fill);
-        process(m_buffer);
+        process(m_buffer, 1);
 
         input += fill;
         ilen -= fill;
         left = 0;
     }
 
-    while (ilen >= 64) {
-        process(input);
+    if (ilen >= 64) {
+        size_t blocks = ilen / 64;
+        process(input, blocks);
 
-        input += 64;
-        ilen -= 64;
+        input += blocks * 64;
+        ilen -= blocks * 64;
     }
 
     if (ilen > 0) {
@@ -184,7 +237,7 @@ void md5_context::finish(unsigned char output[16]) noexcept {
         // We'll need an extra block
         std::memset(m_buffer + used, 0, 64 - used);
 
-        process(m_buffer);
+        process(m_buffer, 1);
 
         std::memset(m_buffer, 0, 56);
     }
@@ -196,7 +249,7 @@ void md5_context::finish(unsigned char output[16]) noexcept {
     MD5_PUT_UINT32_LE(low, m_buffer, 56);
     MD5_PUT_UINT32_LE(high, m_buffer, 60);
 
-    process(m_buffer);
+    process(m_buffer, 1);
 
     // Output final state
     MD5_PUT_UINT32_LE(m_state[0], output, 0);
@@ -205,16 +258,12 @@ void md5_context::finish(unsigned char output[16]) noexcept {
     MD5_PUT_UINT32_LE(m_state[3], output, 12);
 }
 
-int file_md5(const std::string &file_name, unsigned char output[16]) noexcept {
+namespace {
+int file_md5_stream(std::FILE *stream, unsigned char output[16]) noexcept {
     constexpr std::size_t block_size = 32768;
 
-    auto stream = std::fopen(file_name.c_str(), "rb");
-    if (stream == nullptr) {
-        return -1;
-    }
     auto buffer = new (std::nothrow) uint8_t[block_size + 72];
     if (buffer == nullptr) {
-        std::fclose(stream);
         return -1;
     }
 
@@ -245,7 +294,6 @@ int file_md5(const std::string &file_name, unsigned char output[16]) noexcept {
                 // partial read due to EAGAIN or EWOULDBLOCK.
                 if (std::ferror(stream)) {
                     delete[] buffer;
-                    std::fclose(stream);
                     return 1;
                 }
                 goto lb_process_partial_block;
@@ -263,8 +311,213 @@ lb_process_partial_block:
     ctx.finish(output);
 
     delete[] buffer;
+    return 0;
+}
+
+int file_md5_mmap(int fd, unsigned char output[16]) noexcept {
+    // Keep the read-ahead a window in front of the hashing.
+    constexpr std::size_t window_size = 8 * 1024 * 1024;
+
+    int err;
+    mapped_file file(err, fd, {.advice = file_advice::sequential});
+    if (err != 0) {
+        return -1;
+    }
+    md5_context ctx;
+    ctx.start();
+    auto p = reinterpret_cast<const unsigned char *>(file.data());
+    std::size_t file_size = file.size();
+    file.prefetch(0, window_size);
+    for (std::size_t offset = 0; offset < file_size; offset += window_size) {
+        file.prefetch(offset + window_size, window_size);
+        ctx.update(p + offset, std::min(window_size, file_size - offset));
+    }
+    ctx.finish(output);
+    return 0;
+}
+
+// The reader thread fills one buffer while the caller hashes the other one.
+int file_md5_threaded(int fd, unsigned char output[16]) noexcept {
+    constexpr std::size_t buffer_size = 1024 * 1024;
+
+    struct buffer {
+        std::unique_ptr<unsigned char[]> data;
+        ssize_t size; // a short buffer is the last one, -1 for an error
+    };
+    buffer buffers[2];
+    for (auto &b: buffers) {
+        b.data.reset(new (std::nothrow) unsigned char[buffer_size]);
+        if (b.data == nullptr) {
+            return -1;
+        }
+    }
+    std::counting_semaphore<2> free_buffers{2};
+    std::counting_semaphore<2> full_buffers{0};
+
+    auto reader = [&]() noexcept {
+        for (std::size_t i = 0;; i++) {
+            free_buffers.acquire();
+            auto &b = buffers[i & 1];
+            std::size_t sum = 0;
+            b.size = 0;
+            while (sum < buffer_size) {
+                auto n = ::read(fd, b.data.get() + sum, buffer_size - sum);
+                if (n < 0) {
+                    if (errno == EINTR) {
+                        continue;
+                    }
+                    b.size = -1;
+                    break;
+                }
+                if (n == 0) {
+                    break;
+                }
+                sum += n;
+                b.size = static_cast<ssize_t>(sum);
+            }
+            full_buffers.release();
+            // A short buffer is the last one.
+            if (sum < buffer_size) {
+                return;
+            }
+        }
+    };
+    std::thread thread;
+    try {
+        thread = std::thread(reader);
+    } catch (...) {
+        return -1;
+    }
+
+    md5_context ctx;
+    ctx.start();
+    int ret = 0;
+    for (std::size_t i = 0;; i++) {
+        full_buffers.acquire();
+        auto &b = buffers[i & 1];
+        if (b.size < 0) {
+            ret = 1;
+            break;
+        }
+        ctx.update(b.data.get(), static_cast<std::size_t>(b.size));
+        if (static_cast<std::size_t>(b.size) < buffer_size) {
+            break;
+        }
+        free_buffers.release();
+    }
+    thread.join();
+    ctx.finish(output);
+    return ret;
+}
+} // namespace
+
+int file_md5(const std::string &file_name, unsigned char output[16], file_md5_mode mode) noexcept {
+    constexpr std::size_t mmap_threshold = 1024 * 1024;
+
+    int fd = ::open(file_name.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        return -1;
+    }
+    struct stat st;
+    if (::fstat(fd, &st) != 0) {
+        ::close(fd);
+        return -1;
+    }
+    bool regular = S_ISREG(st.st_mode);
+    if (mode == file_md5_mode::automatic) {
+        if (!regular) {
+            mode = file_md5_mode::threaded;
+        } else if (static_cast<std::size_t>(st.st_size) >= mmap_threshold) {
+            mode = file_md5_mode::mmap;
+        } else {
+            mode = file_md5_mode::stream;
+        }
+    }
+    if ((mode == file_md5_mode::mmap) && regular) {
+        int ret = file_md5_mmap(fd, output);
+        if (ret == 0) {
+            ::close(fd);
+            return 0;
+        }
+        mode = file_md5_mode::threaded; // mmap isn't supported by the file system.
+    }
+    if (mode == file_md5_mode::threaded) {
+        ::posix_fadvise(fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+        int ret = file_md5_threaded(fd, output);
+        ::close(fd);
+        return ret;
+    }
+
+    auto stream = ::fdopen(fd, "rb");
+    if (stream == nullptr) {
+        ::close(fd);
+        return -1;
+    }
+    int ret = file_md5_stream(stream, output);
     std::fclose(stream);
+    return ret;
+}
+
+int directory_md5(
+    const std::string &dir_name,
+    std::vector<file_md5_result> &results,
+    std::size_t threads) {
+    namespace fs = std::filesystem;
+
+    results.clear();
+    std::error_code ec;
+    fs::recursive_directory_iterator it{dir_name, ec}, end;
+    if (ec) {
+        return -1;
+    }
+    for (; it != end; it.increment(ec)) {
+        if (ec) {
+            return -1;
+        }
+        if (it->is_regular_file(ec)) {
+            results.push_back({it->path().string(), {}, 0});
+        }
+    }
+    std::sort(results.begin(), results.end(), [](const auto &lhs, const auto &rhs) {
+        return lhs.file_name < rhs.file_name;
+    });
+
+    if (threads == 0) {
+        threads = std::max(1U, std::thread::hardware_concurrency());
+    }
+    threads = std::min(threads, results.size());
+
+    // Each worker takes the next file, large and small files are balanced on the fly.
+    std::atomic<std::size_t> next{0};
+    auto worker = [&]() noexcept {
+        for (;;) {
+            std::size_t i = next.fetch_add(1, std::memory_order_relaxed);
+            if (i >= results.size()) {
+                return;
+            }
+            results[i].err = file_md5(results[i].file_name, results[i].md5);
+        }
+    };
+    std::vector<std::thread> pool;
+    pool.reserve(threads);
+    try {
+        for (std::size_t i = 1; i < threads; i++) {
+            pool.emplace_back(worker);
+        }
+    } catch (...) {
+        // Stop the workers started already.
+        next.store(results.size(), std::memory_order_relaxed);
+        for (auto &t: pool) {
+            t.join();
+        }
+        results.clear();
+        return -2;
+    }
+    worker();
+    for (auto &t: pool) {
+        t.join();
+    }
     return 0;
 }
 
-} // namespace kon
\ No newline at end of file
+} // namespace kon
@@ -7,6 +7,7 @@
 // References:
 // [0]: http://www.ietf.org/rfc/rfc1321.txt
 #include <string>
+#include <vector>
 #include <cstdint>
 
 namespace kon {
@@ -17,7 +18,7 @@ class md5_context {
     void update(const unsigned char *input, size_t ilen) noexcept;
     void finish(unsigned char output[16]) noexcept;
    private:
-    void process(const unsigned char data[64]) noexcept;
+    void process(const unsigned char *data, size_t blocks) noexcept;
 
     uint32_t m_total[2];        // number of bytes processed
     uint32_t m_state[4];        // intermediate digest state
@@ -32,7 +33,31 @@ static inline void md5(const unsigned char *input, size_t ilen, unsigned char ou
     ctx.finish(output);
 }
 
-int file_md5(const std::string &file_name, unsigned char output[16]) noexcept;
+enum class file_md5_mode : std::uint8_t {
+    automatic, // mmap for the large regular files, stream for the small ones, threaded otherwise
+    stream,    // fread by blocks of 32 KB
+    mmap,      // mmap with madvise(MADV_SEQUENTIAL) and a read-ahead window
+    threaded,  // a reader thread fills 2 buffers of 1 MB in turn while the caller hashes
+};
+
+int file_md5(
+    const std::string &file_name,
+    unsigned char output[16],
+    file_md5_mode mode = file_md5_mode::automatic) noexcept;
+
+struct file_md5_result {
+    std::string file_name;
+    unsigned char md5[16];
+    int err; // returned by file_md5
+};
+
+// Hash the regular files of a directory tree on a pool of threads, threads is 0 for the number of
+// hardware threads. The results are sorted by file name, returns -1 if the directory can't be
+// walked, -2 if the threads can't be started.
+int directory_md5(
+    const std::string &dir_name,
+    std::vector<file_md5_result> &results,
+    std::size_t threads = 0);
 
 } // namespace kon
 #endif // md5.hpp
\ No newline at end of file
@@ -0,0 +1,291 @@
+// SPDX-FileCopyrightText: 2026 TypeCombinator <typecombinator@foxmail.com>
+//
+// SPDX-License-Identifier: BSD 3-Clause
+
+#include <kon/hash/md5_multi.hpp>
+#include <kon/xt/cpu.hpp>
+#include <cstring>
+
+namespace kon {
+namespace {
+// GCC / Clang vector extensions, lowered to SSE2 / AVX2 / NEON by the target of the caller.
+typedef std::uint32_t md5_v4 __attribute__((vector_size(16)));
+typedef std::uint32_t md5_v8 __attribute__((vector_size(32)));
+
+using md5_lane_state = std::uint32_t[md5_multi::max_lanes];
+
+template <typename V, std::size_t L>
+KON_ATTR_ALWAYS_INLINE void md5_lanes(
+    md5_lane_state *state,
+    const unsigned char *const *data,
+    std::size_t blocks) noexcept {
+    V a, b, c, d;
+    std::memcpy(&a, state[0], sizeof(V));
+    std::memcpy(&b, state[1], sizeof(V));
+    std::memcpy(&c, state[2], sizeof(V));
+    std::memcpy(&d, state[3], sizeof(V));
+
+    for (std::size_t n = 0; n < blocks; n++) {
+        // Transpose, X[k] holds the word k of all the lanes. Need little endian!!!
+        alignas(sizeof(V)) std::uint32_t words[16][L];
+        for (std::size_t l = 0; l < L; l++) {
+            std::uint32_t block[16];
+            std::memcpy(block, data[l] + n * 64, sizeof(block));
+            for (std::size_t k = 0; k < 16; k++) {
+                words[k][l] = block[k];
+            }
+        }
+        V X[16];
+        std::memcpy(X, words, sizeof(X));
+
+        V A = a, B = b, C = c, D = d;
+
+#define S(x, n) (((x) << (n)) | ((x) >> (32 - (n))))
+
+#define P(a, b, c, d, k, s, t)                                                                     \
+    do {                                                                                           \
+        (a) += F((b), (c), (d)) + X[(k)] + static_cast<std::uint32_t>(t);                          \
+        (a) = S((a), (s)) + (b);                                                                   \
+    } while (0)
+
+#define F(x, y, z) ((z) ^ ((x) & ((y) ^ (z))))
+
+        P(A, B, C, D, 0, 7, 0xD76AA478);
+        P(D, A, B, C, 1, 12, 0xE8C7B756);
+        P(C, D, A, B, 2, 17, 0x242070DB);
+        P(B, C, D, A, 3, 22, 0xC1BDCEEE);
+        P(A, B, C, D, 4, 7, 0xF57C0FAF);
+        P(D, A, B, C, 5, 12, 0x4787C62A);
+        P(C, D, A, B, 6, 17, 0xA8304613);
+        P(B, C, D, A, 7, 22, 0xFD469501);
+        P(A, B, C, D, 8, 7, 0x698098D8);
+        P(D, A, B, C, 9, 12, 0x8B44F7AF);
+        P(C, D, A, B, 10, 17, 0xFFFF5BB1);
+        P(B, C, D, A, 11, 22, 0x895CD7BE);
+        P(A, B, C, D, 12, 7, 0x6B901122);
+        P(D, A, B, C, 13, 12, 0xFD987193);
+        P(C, D, A, B, 14, 17, 0xA679438E);
+        P(B, C, D, A, 15, 22, 0x49B40821);
+
+#undef F
+
+#define F(x, y, z) ((y) ^ ((z) & ((x) ^ (y))))
+
+        P(A, B, C, D, 1, 5, 0xF61E2562);
+        P(D, A, B, C, 6, 9, 0xC040B340);
+        P(C, D, A, B, 11, 14, 0x265E5A51);
+        P(B, C, D, A, 0, 20, 0xE9B6C7AA);
+        P(A, B, C, D, 5, 5, 0xD62F105D);
+        P(D, A, B, C, 10, 9, 0x02441453);
+        P(C, D, A, B, 15, 14, 0xD8A1E681);
+        P(B, C, D, A, 4, 20, 0xE7D3FBC8);
+        P(A, B, C, D, 9, 5, 0x21E1CDE6);
+        P(D, A, B, C, 14, 9, 0xC33707D6);
+        P(C, D, A, B, 3, 14, 0xF4D50D87);
+        P(B, C, D, A, 8, 20, 0x455A14ED);
+        P(A, B, C, D, 13, 5, 0xA9E3E905);
+        P(D, A, B, C, 2, 9, 0xFCEFA3F8);
+        P(C, D, A, B, 7, 14, 0x676F02D9);
+        P(B, C, D, A, 12, 20, 0x8D2A4C8A);
+
+#undef F
+
+#define F(x, y, z) ((x) ^ (y) ^ (z))
+
+        P(A, B, C, D, 5, 4, 0xFFFA3942);
+        P(D, A, B, C, 8, 11, 0x8771F681);
+        P(C, D, A, B, 11, 16, 0x6D9D6122);
+        P(B, C, D, A, 14, 23, 0xFDE5380C);
+        P(A, B, C, D, 1, 4, 0xA4BEEA44);
+        P(D, A, B, C, 4, 11, 0x4BDECFA9);
+        P(C, D, A, B, 7, 16, 0xF6BB4B60);
+        P(B, C, D, A, 10, 23, 0xBEBFBC70);
+        P(A, B, C, D, 13, 4, 0x289B7EC6);
+        P(D, A, B, C, 0, 11, 0xEAA127FA);
+        P(C, D, A, B, 3, 16, 0xD4EF3085);
+        P(B, C, D, A, 6, 23, 0x04881D05);
+        P(A, B, C, D, 9, 4, 0xD9D4D039);
+        P(D, A, B, C, 12, 11, 0xE6DB99E5);
+        P(C, D, A, B, 15, 16, 0x1FA27CF8);
+        P(B, C, D, A, 2, 23, 0xC4AC5665);
+
+#undef F
+
+#define F(x, y, z) ((y) ^ ((x) | ~(z)))
+
+        P(A, B, C, D, 0, 6, 0xF4292244);
+        P(D, A, B, C, 7, 10, 0x432AFF97);
+        P(C, D, A, B, 14, 15, 0xAB9423A7);
+        P(B, C, D, A, 5, 21, 0xFC93A039);
+        P(A, B, C, D, 12, 6, 0x655B59C3);
+        P(D, A, B, C, 3, 10, 0x8F0CCC92);
+        P(C, D, A, B, 10, 15, 0xFFEFF47D);
+        P(B, C, D, A, 1, 21, 0x85845DD1);
+        P(A, B, C, D, 8, 6, 0x6FA87E4F);
+        P(D, A, B, C, 15, 10, 0xFE2CE6E0);
+        P(C, D, A, B, 6, 15, 0xA3014314);
+        P(B, C, D, A, 13, 21, 0x4E0811A1);
+        P(A, B, C, D, 4, 6, 0xF7537E82);
+        P(D, A, B, C, 11, 10, 0xBD3AF235);
+        P(C, D, A, B, 2, 15, 0x2AD7D2BB);
+        P(B, C, D, A, 9, 21, 0xEB86D391);
+
+#undef F
+#undef P
+#undef S
+
+        a += A;
+        b += B;
+        c += C;
+        d += D;
+    }
+
+    std::memcpy(state[0], &a, sizeof(V));
+    std::memcpy(state[1], &b, sizeof(V));
+    std::memcpy(state[2], &c, sizeof(V));
+    std::memcpy(state[3], &d, sizeof(V));
+}
+
+void md5_x4(md5_lane_state *state, const unsigned char *const *data, std::size_t blocks) noexcept {
+    md5_lanes<md5_v4, 4>(state, data, blocks);
+}
+
+#if defined(KON_ARCH_X86)
+KON_ATTR_TARGET("avx2")
+void md5_x8_avx2(
+    md5_lane_state *state,
+    const unsigned char *const *data,
+    std::size_t blocks) noexcept {
+    md5_lanes<md5_v8, 8>(state, data, blocks);
+}
+#endif
+} // namespace
+
+void md5_multi::start() noexcept {
+    m_lanes = 4;
+#if defined(KON_ARCH_X86)
+    if (rt::cpu().avx2) {
+        m_lanes = 8;
+    }
+#endif
+    m_busy = 0;
+    for (std::size_t l = 0; l < max_lanes; l++) {
+        m_jobs[l] = nullptr;
+    }
+}
+
+md5_job *md5_multi::submit(md5_job *job) noexcept {
+    std::size_t l = 0;
+    while (m_jobs[l] != nullptr) {
+        l++;
+    }
+    m_jobs[l] = job;
+    m_busy++;
+
+    m_state[0][l] = 0x67452301;
+    m_state[1][l] = 0xEFCDAB89;
+    m_state[2][l] = 0x98BADCFE;
+    m_state[3][l] = 0x10325476;
+
+    // Pad the tail at submission, the lane then runs the whole blocks of the input in place and
+    // the 1 or 2 blocks of the tail.
+    std::size_t used = job->ilen & 0x3F;
+    unsigned char *tail = m_tail[l];
+    if (used != 0) {
+        std::memcpy(tail, job->input + job->ilen - used, used);
+    }
+    tail[used++] = 0x80;
+    std::size_t tail_len = (used <= 56) ? 64 : 128;
+    std::memset(tail + used, 0, tail_len - 8 - used);
+    std::uint64_t bits = static_cast<std::uint64_t>(job->ilen) << 3;
+    std::memcpy(tail + tail_len - 8, &bits, 8); // Need little endian!!!
+    m_tail_blocks[l] = tail_len / 64;
+
+    m_blocks[l] = job->ilen / 64;
+    if (m_blocks[l] != 0) {
+        m_data[l] = job->input;
+        m_in_tail[l] = false;
+    } else {
+        m_data[l] = tail;
+        m_blocks[l] = m_tail_blocks[l];
+        m_in_tail[l] = true;
+    }
+
+    if (m_busy < m_lanes) {
+        return nullptr;
+    }
+    return advance();
+}
+
+md5_job *md5_multi::flush() noexcept {
+    if (m_busy == 0) {
+        return nullptr;
+    }
+    return advance();
+}
+
+md5_job *md5_multi::advance() noexcept {
+    while (true) {
+        // Hand out the completed lanes first, several lanes can complete in the same step.
+        std::size_t steps = SIZE_MAX;
+        std::size_t busy_lane = 0;
+        for (std::size_t l = 0; l < m_lanes; l++) {
+            if (m_jobs[l] == nullptr) {
+                continue;
+            }
+            if (m_blocks[l] == 0) {
+                md5_job *job = m_jobs[l];
+                for (std::size_t w = 0; w < 4; w++) {
+                    std::memcpy(job->output + w * 4, &m_state[w][l], 4);
+                }
+                m_jobs[l] = nullptr;
+                m_busy--;
+                return job;
+            }
+            if (m_blocks[l] < steps) {
+                steps = m_blocks[l];
+            }
+            busy_lane = l;
+        }
+
+        // The idle lanes hash the data of a busy lane, their states are garbage.
+        const unsigned char *data[max_lanes];
+        for (std::size_t l = 0; l < m_lanes; l++) {
+            data[l] = (m_jobs[l] != nullptr) ? m_data[l] : m_data[busy_lane];
+        }
+#if defined(KON_ARCH_X86)
+        if (m_lanes == 8) {
+            md5_x8_avx2(m_state, data, steps);
+        } else {
+            md5_x4(m_state, data, steps);
+        }
+#else
+        md5_x4(m_state, data, steps);
+#endif
+        for (std::size_t l = 0; l < m_lanes; l++) {
+            if (m_jobs[l] == nullptr) {
+                continue;
+            }
+            m_data[l] += steps * 64;
+            m_blocks[l] -= steps;
+            if ((m_blocks[l] == 0) && !m_in_tail[l]) {
+                m_data[l] = m_tail[l];
+                m_blocks[l] = m_tail_blocks[l];
+                m_in_tail[l] = true;
+            }
+        }
+    }
+}
+
+void md5_multi_hash(md5_job *jobs, std::size_t count) noexcept {
+    md5_multi ctx;
+
+    ctx.start();
+    for (std::size_t i = 0; i < count; i++) {
+        ctx.submit(&jobs[i]);
+    }
+    while (ctx.flush() != nullptr) {
+    }
+}
+
+} // namespace kon
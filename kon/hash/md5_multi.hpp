@@ -0,0 +1,57 @@
+// SPDX-FileCopyrightText: 2026 TypeCombinator <typecombinator@foxmail.com>
+//
+// SPDX-License-Identifier: BSD 3-Clause
+
+#ifndef HASH_MD5_MULTI_3ADAC20D_A53F_4B6C_A6B5_76317B5F6C68
+#define HASH_MD5_MULTI_3ADAC20D_A53F_4B6C_A6B5_76317B5F6C68
+// References:
+// [0]: https://github.com/intel/isa-l_crypto/tree/master/md5_mb
+#include <cstddef>
+#include <cstdint>
+
+namespace kon {
+
+struct md5_job {
+    const unsigned char *input;
+    std::size_t ilen;
+    unsigned char output[16]; // written when the job is returned by submit() or flush()
+    void *user_data;
+};
+
+// Multi-buffer MD5, runs 8 (AVX2) or 4 (SSE2, NEON) independent jobs in the SIMD lanes, one block
+// of each lane per step. The output of every job is the same as md5_context. Jobs of similar
+// lengths keep the lanes busy, a lane is refilled as soon as its job completes.
+class md5_multi {
+   public:
+    static constexpr std::size_t max_lanes = 8;
+
+    void start() noexcept;
+
+    std::size_t lanes() const noexcept {
+        return m_lanes;
+    }
+
+    // The job must stay alive until it's returned. Returns a completed job when all the lanes are
+    // busy, nullptr otherwise.
+    md5_job *submit(md5_job *job) noexcept;
+    // Returns a completed job, nullptr if there is no job in flight.
+    md5_job *flush() noexcept;
+   private:
+    md5_job *advance() noexcept;
+
+    alignas(32) std::uint32_t m_state[4][max_lanes]; // lane states, one row per word
+    const unsigned char *m_data[max_lanes];           // next block of each lane
+    std::size_t m_blocks[max_lanes];                  // remaining blocks of the current phase
+    std::size_t m_tail_blocks[max_lanes];             // blocks of the padded tail
+    md5_job *m_jobs[max_lanes];                       // nullptr for an idle lane
+    bool m_in_tail[max_lanes];
+    std::size_t m_lanes;
+    std::size_t m_busy;
+    alignas(64) unsigned char m_tail[max_lanes][128]; // last partial block with the padding
+};
+
+// Hash all the jobs, it's the shortcut of submit() and flush().
+void md5_multi_hash(md5_job *jobs, std::size_t count) noexcept;
+
+} // namespace kon
+#endif // md5_multi.hpp
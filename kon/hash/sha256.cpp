@@ -0,0 +1,253 @@
+// SPDX-FileCopyrightText: 2026 TypeCombinator <typecombinator@foxmail.com>
+//
+// SPDX-License-Identifier: BSD 3-Clause
+
+#include <kon/hash/sha256.hpp>
+#include <kon/xt/cpu.hpp>
+#include <cstring>
+#if defined(KON_ARCH_X86)
+    #include <immintrin.h>
+#elif defined(KON_ARCH_ARM64)
+    #include <arm_neon.h>
+#endif
+
+namespace kon {
+namespace {
+alignas(64) constexpr std::uint32_t sha256_k[64] = {
+    0x428A2F98, 0x71374491, 0xB5C0FBCF, 0xE9B5DBA5, 0x3956C25B, 0x59F111F1, 0x923F82A4, 0xAB1C5ED5,
+    0xD807AA98, 0x12835B01, 0x243185BE, 0x550C7DC3, 0x72BE5D74, 0x80DEB1FE, 0x9BDC06A7, 0xC19BF174,
+    0xE49B69C1, 0xEFBE4786, 0x0FC19DC6, 0x240CA1CC, 0x2DE92C6F, 0x4A7484AA, 0x5CB0A9DC, 0x76F988DA,
+    0x983E5152, 0xA831C66D, 0xB00327C8, 0xBF597FC7, 0xC6E00BF3, 0xD5A79147, 0x06CA6351, 0x14292967,
+    0x27B70A85, 0x2E1B2138, 0x4D2C6DFC, 0x53380D13, 0x650A7354, 0x766A0ABB, 0x81C2C92E, 0x92722C85,
+    0xA2BFE8A1, 0xA81A664B, 0xC24B8B70, 0xC76C51A3, 0xD192E819, 0xD6990624, 0xF40E3585, 0x106AA070,
+    0x19A4C116, 0x1E376C08, 0x2748774C, 0x34B0BCB5, 0x391C0CB3, 0x4ED8AA4A, 0x5B9CCA4F, 0x682E6FF3,
+    0x748F82EE, 0x78A5636F, 0x84C87814, 0x8CC70208, 0x90BEFFFA, 0xA4506CEB, 0xBEF9A3F7, 0xC67178F2,
+};
+
+inline std::uint32_t rotr32(std::uint32_t x, int n) noexcept {
+    return (x >> n) | (x << (32 - n));
+}
+
+inline std::uint32_t load32_be(const unsigned char *p) noexcept {
+    return (static_cast<std::uint32_t>(p[0]) << 24) | (static_cast<std::uint32_t>(p[1]) << 16) |
+           (static_cast<std::uint32_t>(p[2]) << 8) | static_cast<std::uint32_t>(p[3]);
+}
+
+void sha256_process_scalar(
+    std::uint32_t state[8],
+    const unsigned char *data,
+    std::size_t blocks) noexcept {
+    for (; blocks != 0; blocks--, data += 64) {
+        std::uint32_t w[64];
+        for (int i = 0; i < 16; i++) {
+            w[i] = load32_be(data + i * 4);
+        }
+        for (int i = 16; i < 64; i++) {
+            std::uint32_t s0 = rotr32(w[i - 15], 7) ^ rotr32(w[i - 15], 18) ^ (w[i - 15] >> 3);
+            std::uint32_t s1 = rotr32(w[i - 2], 17) ^ rotr32(w[i - 2], 19) ^ (w[i - 2] >> 10);
+            w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+        }
+        std::uint32_t a = state[0], b = state[1], c = state[2], d = state[3];
+        std::uint32_t e = state[4], f = state[5], g = state[6], h = state[7];
+        for (int i = 0; i < 64; i++) {
+            std::uint32_t s1 = rotr32(e, 6) ^ rotr32(e, 11) ^ rotr32(e, 25);
+            std::uint32_t ch = g ^ (e & (f ^ g));
+            std::uint32_t t1 = h + s1 + ch + sha256_k[i] + w[i];
+            std::uint32_t s0 = rotr32(a, 2) ^ rotr32(a, 13) ^ rotr32(a, 22);
+            std::uint32_t maj = (a & b) | (c & (a | b));
+            std::uint32_t t2 = s0 + maj;
+            h = g;
+            g = f;
+            f = e;
+            e = d + t1;
+            d = c;
+            c = b;
+            b = a;
+            a = t1 + t2;
+        }
+        state[0] += a;
+        state[1] += b;
+        state[2] += c;
+        state[3] += d;
+        state[4] += e;
+        state[5] += f;
+        state[6] += g;
+        state[7] += h;
+    }
+}
+
+#if defined(KON_ARCH_X86)
+// The message schedule is kept in 4 registers of 4 words, msg[g % 4] holds W[4g .. 4g + 3] and is
+// rewritten with W[4g + 16 .. 4g + 19] by sha256msg1 / sha256msg2.
+KON_ATTR_TARGET("sha,sse4.1")
+void sha256_process_shani(
+    std::uint32_t state[8],
+    const unsigned char *data,
+    std::size_t blocks) noexcept {
+    const __m128i shuffle_mask = _mm_set_epi64x(0x0C0D0E0F08090A0BULL, 0x0405060700010203ULL);
+    __m128i tmp = _mm_loadu_si128(reinterpret_cast<const __m128i *>(&state[0]));
+    __m128i state1 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(&state[4]));
+    tmp = _mm_shuffle_epi32(tmp, 0xB1); // CDAB
+    state1 = _mm_shuffle_epi32(state1, 0x1B); // EFGH
+    __m128i state0 = _mm_alignr_epi8(tmp, state1, 8); // ABEF
+    state1 = _mm_blend_epi16(state1, tmp, 0xF0); // CDGH
+
+    for (; blocks != 0; blocks--, data += 64) {
+        __m128i abef_save = state0;
+        __m128i cdgh_save = state1;
+        __m128i msg[4];
+        for (int i = 0; i < 4; i++) {
+            msg[i] = _mm_shuffle_epi8(
+                _mm_loadu_si128(reinterpret_cast<const __m128i *>(data) + i),
+                shuffle_mask);
+        }
+#pragma GCC unroll 16
+        for (int g = 0; g < 16; g++) {
+            __m128i m = _mm_add_epi32(
+                msg[g % 4],
+                _mm_load_si128(reinterpret_cast<const __m128i *>(&sha256_k[g * 4])));
+            state1 = _mm_sha256rnds2_epu32(state1, state0, m);
+            if ((g >= 3) && (g <= 14)) {
+                __m128i &next = msg[(g + 1) % 4];
+                next = _mm_add_epi32(next, _mm_alignr_epi8(msg[g % 4], msg[(g + 3) % 4], 4));
+                next = _mm_sha256msg2_epu32(next, msg[g % 4]);
+            }
+            m = _mm_shuffle_epi32(m, 0x0E);
+            state0 = _mm_sha256rnds2_epu32(state0, state1, m);
+            if ((g >= 1) && (g <= 12)) {
+                msg[(g + 3) % 4] = _mm_sha256msg1_epu32(msg[(g + 3) % 4], msg[g % 4]);
+            }
+        }
+        state0 = _mm_add_epi32(state0, abef_save);
+        state1 = _mm_add_epi32(state1, cdgh_save);
+    }
+
+    tmp = _mm_shuffle_epi32(state0, 0x1B); // FEBA
+    state1 = _mm_shuffle_epi32(state1, 0xB1); // DCHG
+    state0 = _mm_blend_epi16(tmp, state1, 0xF0); // DCBA
+    state1 = _mm_alignr_epi8(state1, tmp, 8); // ABEF
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(&state[0]), state0);
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(&state[4]), state1);
+}
+#elif defined(KON_ARCH_ARM64)
+KON_ATTR_TARGET("+crypto")
+void sha256_process_armv8(
+    std::uint32_t state[8],
+    const unsigned char *data,
+    std::size_t blocks) noexcept {
+    uint32x4_t state0 = vld1q_u32(&state[0]);
+    uint32x4_t state1 = vld1q_u32(&state[4]);
+
+    for (; blocks != 0; blocks--, data += 64) {
+        uint32x4_t abcd_save = state0;
+        uint32x4_t efgh_save = state1;
+        uint32x4_t msg[4];
+        for (int i = 0; i < 4; i++) {
+            msg[i] = vreinterpretq_u32_u8(vrev32q_u8(vld1q_u8(data + 16 * i)));
+        }
+        for (int g = 0; g < 16; g++) {
+            uint32x4_t m = vaddq_u32(msg[g % 4], vld1q_u32(&sha256_k[g * 4]));
+            if (g < 12) {
+                msg[g % 4] = vsha256su0q_u32(msg[g % 4], msg[(g + 1) % 4]);
+            }
+            uint32x4_t tmp = state0;
+            state0 = vsha256hq_u32(state0, state1, m);
+            state1 = vsha256h2q_u32(state1, tmp, m);
+            if (g < 12) {
+                msg[g % 4] = vsha256su1q_u32(msg[g % 4], msg[(g + 2) % 4], msg[(g + 3) % 4]);
+            }
+        }
+        state0 = vaddq_u32(state0, abcd_save);
+        state1 = vaddq_u32(state1, efgh_save);
+    }
+
+    vst1q_u32(&state[0], state0);
+    vst1q_u32(&state[4], state1);
+}
+#endif
+
+void sha256_process(
+    std::uint32_t state[8],
+    const unsigned char *data,
+    std::size_t blocks) noexcept {
+#if defined(KON_ARCH_X86)
+    if (rt::cpu().sha) {
+        sha256_process_shani(state, data, blocks);
+        return;
+    }
+#elif defined(KON_ARCH_ARM64)
+    if (rt::cpu().sha2) {
+        sha256_process_armv8(state, data, blocks);
+        return;
+    }
+#endif
+    sha256_process_scalar(state, data, blocks);
+}
+} // namespace
+
+void sha256_context::start() noexcept {
+    m_total = 0;
+
+    m_state[0] = 0x6A09E667;
+    m_state[1] = 0xBB67AE85;
+    m_state[2] = 0x3C6EF372;
+    m_state[3] = 0xA54FF53A;
+    m_state[4] = 0x510E527F;
+    m_state[5] = 0x9B05688C;
+    m_state[6] = 0x1F83D9AB;
+    m_state[7] = 0x5BE0CD19;
+}
+
+void sha256_context::update(const unsigned char *input, std::size_t ilen) noexcept {
+    if (ilen == 0) {
+        return;
+    }
+    std::size_t left = m_total & 0x3F;
+    std::size_t fill = 64 - left;
+    m_total += ilen;
+
+    if ((left != 0) && (ilen >= fill)) {
+        std::memcpy(m_buffer + left, input, fill);
+        sha256_process(m_state, m_buffer, 1);
+        input += fill;
+        ilen -= fill;
+        left = 0;
+    }
+    // Compress all the whole blocks in place.
+    if (ilen >= 64) {
+        std::size_t blocks = ilen / 64;
+        sha256_process(m_state, input, blocks);
+        input += blocks * 64;
+        ilen -= blocks * 64;
+    }
+    if (ilen > 0) {
+        std::memcpy(m_buffer + left, input, ilen);
+    }
+}
+
+void sha256_context::finish(unsigned char output[32]) noexcept {
+    std::size_t used = m_total & 0x3F;
+    std::uint64_t bits = m_total << 3;
+
+    m_buffer[used++] = 0x80;
+    if (used <= 56) {
+        std::memset(m_buffer + used, 0, 56 - used);
+    } else {
+        std::memset(m_buffer + used, 0, 64 - used);
+        sha256_process(m_state, m_buffer, 1);
+        std::memset(m_buffer, 0, 56);
+    }
+    for (int i = 0; i < 8; i++) {
+        m_buffer[56 + i] = static_cast<unsigned char>(bits >> (56 - 8 * i));
+    }
+    sha256_process(m_state, m_buffer, 1);
+
+    for (int i = 0; i < 8; i++) {
+        output[i * 4] = static_cast<unsigned char>(m_state[i] >> 24);
+        output[i * 4 + 1] = static_cast<unsigned char>(m_state[i] >> 16);
+        output[i * 4 + 2] = static_cast<unsigned char>(m_state[i] >> 8);
+        output[i * 4 + 3] = static_cast<unsigned char>(m_state[i]);
+    }
+}
+
+} // namespace kon
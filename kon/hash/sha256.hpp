@@ -0,0 +1,39 @@
+// SPDX-FileCopyrightText: 2026 TypeCombinator <typecombinator@foxmail.com>
+//
+// SPDX-License-Identifier: BSD 3-Clause
+
+#ifndef HASH_SHA256_B561272D_077C_445B_9DFC_15C5B8656B47
+#define HASH_SHA256_B561272D_077C_445B_9DFC_15C5B8656B47
+// References:
+// [0]: https://csrc.nist.gov/pubs/fips/180-4/upd1/final
+// [1]: https://www.intel.com/content/www/us/en/developer/articles/technical/intel-sha-extensions.html
+#include <cstddef>
+#include <cstdint>
+
+namespace kon {
+
+// SHA-256, the blocks are compressed with SHA-NI / ARMv8 crypto extensions when available.
+class sha256_context {
+   public:
+    void start() noexcept;
+    void update(const unsigned char *input, std::size_t ilen) noexcept;
+    void finish(unsigned char output[32]) noexcept;
+   private:
+    std::uint64_t m_total;      // number of bytes processed
+    std::uint32_t m_state[8];   // intermediate digest state
+    unsigned char m_buffer[64]; // data block being processed
+};
+
+static inline void sha256(
+    const unsigned char *input,
+    std::size_t ilen,
+    unsigned char output[32]) noexcept {
+    sha256_context ctx;
+
+    ctx.start();
+    ctx.update(input, ilen);
+    ctx.finish(output);
+}
+
+} // namespace kon
+#endif // sha256.hpp
@@ -0,0 +1,550 @@
+// SPDX-FileCopyrightText: 2026 TypeCombinator <typecombinator@foxmail.com>
+//
+// SPDX-License-Identifier: BSD 3-Clause
+
+#include <kon/hash/xxh3.hpp>
+#include <kon/xt/cpu.hpp>
+#include <cstring>
+#if defined(KON_ARCH_X86) && (defined(__x86_64__) || defined(_M_X64))
+    #define KON_XXH3_X86_64 1 // SSE2 is the baseline of x86-64.
+    #include <immintrin.h>
+#elif defined(KON_ARCH_ARM64)
+    #include <arm_neon.h>
+#endif
+
+namespace kon {
+namespace {
+constexpr std::uint32_t prime32_1 = 0x9E3779B1U;
+constexpr std::uint32_t prime32_2 = 0x85EBCA77U;
+constexpr std::uint32_t prime32_3 = 0xC2B2AE3DU;
+constexpr std::uint64_t prime64_1 = 0x9E3779B185EBCA87ULL;
+constexpr std::uint64_t prime64_2 = 0xC2B2AE3D27D4EB4FULL;
+constexpr std::uint64_t prime64_3 = 0x165667B19E3779F9ULL;
+constexpr std::uint64_t prime64_4 = 0x85EBCA77C2B2AE63ULL;
+constexpr std::uint64_t prime64_5 = 0x27D4EB2F165667C5ULL;
+constexpr std::uint64_t prime_mx1 = 0x165667919E3779F9ULL;
+constexpr std::uint64_t prime_mx2 = 0x9FB21C651E98DF25ULL;
+
+constexpr std::size_t stripe_len = 64;
+constexpr std::size_t secret_size = 192;
+constexpr std::size_t secret_consume_rate = 8;
+constexpr std::size_t stripes_per_block = (secret_size - stripe_len) / secret_consume_rate;
+constexpr std::size_t block_len = stripe_len * stripes_per_block;
+constexpr std::size_t secret_limit = secret_size - stripe_len;
+constexpr std::size_t secret_lastacc_start = 7;
+constexpr std::size_t secret_mergeaccs_start = 11;
+constexpr std::size_t midsize_max = 240;
+constexpr std::size_t midsize_startoffset = 3;
+constexpr std::size_t midsize_lastoffset = 17;
+constexpr std::size_t secret_size_min = 136;
+
+// Pseudorandom secret taken from FARSH.
+alignas(64) constexpr unsigned char default_secret[secret_size] = {
+    0xb8, 0xfe, 0x6c, 0x39, 0x23, 0xa4, 0x4b, 0xbe, 0x7c, 0x01, 0x81, 0x2c, 0xf7, 0x21, 0xad, 0x1c,
+    0xde, 0xd4, 0x6d, 0xe9, 0x83, 0x90, 0x97, 0xdb, 0x72, 0x40, 0xa4, 0xa4, 0xb7, 0xb3, 0x67, 0x1f,
+    0xcb, 0x79, 0xe6, 0x4e, 0xcc, 0xc0, 0xe5, 0x78, 0x82, 0x5a, 0xd0, 0x7d, 0xcc, 0xff, 0x72, 0x21,
+    0xb8, 0x08, 0x46, 0x74, 0xf7, 0x43, 0x24, 0x8e, 0xe0, 0x35, 0x90, 0xe6, 0x81, 0x3a, 0x26, 0x4c,
+    0x3c, 0x28, 0x52, 0xbb, 0x91, 0xc3, 0x00, 0xcb, 0x88, 0xd0, 0x65, 0x8b, 0x1b, 0x53, 0x2e, 0xa3,
+    0x71, 0x64, 0x48, 0x97, 0xa2, 0x0d, 0xf9, 0x4e, 0x38, 0x19, 0xef, 0x46, 0xa9, 0xde, 0xac, 0xd8,
+    0xa8, 0xfa, 0x76, 0x3f, 0xe3, 0x9c, 0x34, 0x3f, 0xf9, 0xdc, 0xbb, 0xc7, 0xc7, 0x0b, 0x4f, 0x1d,
+    0x8a, 0x51, 0xe0, 0x4b, 0xcd, 0xb4, 0x59, 0x31, 0xc8, 0x9f, 0x7e, 0xc9, 0xd9, 0x78, 0x73, 0x64,
+    0xea, 0xc5, 0xac, 0x83, 0x34, 0xd3, 0xeb, 0xc3, 0xc5, 0x81, 0xa0, 0xff, 0xfa, 0x13, 0x63, 0xeb,
+    0x17, 0x0d, 0xdd, 0x51, 0xb7, 0xf0, 0xda, 0x49, 0xd3, 0x16, 0x55, 0x26, 0x29, 0xd4, 0x68, 0x9e,
+    0x2b, 0x16, 0xbe, 0x58, 0x7d, 0x47, 0xa1, 0xfc, 0x8f, 0xf8, 0xb8, 0xd1, 0x7a, 0xd0, 0x31, 0xce,
+    0x45, 0xcb, 0x3a, 0x8f, 0x95, 0x16, 0x04, 0x28, 0xaf, 0xd7, 0xfb, 0xca, 0xbb, 0x4b, 0x40, 0x7e,
+};
+
+// Need little endian!!!
+inline std::uint32_t read32(const unsigned char *p) noexcept {
+    std::uint32_t v;
+    std::memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+inline std::uint64_t read64(const unsigned char *p) noexcept {
+    std::uint64_t v;
+    std::memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+inline std::uint64_t rotl64(std::uint64_t x, int r) noexcept {
+    return (x << r) | (x >> (64 - r));
+}
+
+inline std::uint64_t mul128_fold64(std::uint64_t lhs, std::uint64_t rhs) noexcept {
+#if defined(__SIZEOF_INT128__)
+    auto product = static_cast<unsigned __int128>(lhs) * rhs;
+    return static_cast<std::uint64_t>(product) ^ static_cast<std::uint64_t>(product >> 64);
+#else
+    std::uint64_t lo_lo = (lhs & 0xFFFFFFFF) * (rhs & 0xFFFFFFFF);
+    std::uint64_t hi_lo = (lhs >> 32) * (rhs & 0xFFFFFFFF);
+    std::uint64_t lo_hi = (lhs & 0xFFFFFFFF) * (rhs >> 32);
+    std::uint64_t hi_hi = (lhs >> 32) * (rhs >> 32);
+    std::uint64_t cross = (lo_lo >> 32) + (hi_lo & 0xFFFFFFFF) + lo_hi;
+    std::uint64_t upper = (hi_lo >> 32) + (cross >> 32) + hi_hi;
+    std::uint64_t lower = (cross << 32) | (lo_lo & 0xFFFFFFFF);
+    return lower ^ upper;
+#endif
+}
+
+inline std::uint64_t xxh64_avalanche(std::uint64_t h) noexcept {
+    h ^= h >> 33;
+    h *= prime64_2;
+    h ^= h >> 29;
+    h *= prime64_3;
+    h ^= h >> 32;
+    return h;
+}
+
+inline std::uint64_t avalanche(std::uint64_t h) noexcept {
+    h ^= h >> 37;
+    h *= prime_mx1;
+    h ^= h >> 32;
+    return h;
+}
+
+inline std::uint64_t rrmxmx(std::uint64_t h, std::uint64_t len) noexcept {
+    h ^= rotl64(h, 49) ^ rotl64(h, 24);
+    h *= prime_mx2;
+    h ^= (h >> 35) + len;
+    h *= prime_mx2;
+    return h ^ (h >> 28);
+}
+
+inline std::uint64_t len_1to3(
+    const unsigned char *input,
+    std::size_t len,
+    const unsigned char *secret,
+    std::uint64_t seed) noexcept {
+    std::uint32_t c1 = input[0];
+    std::uint32_t c2 = input[len >> 1];
+    std::uint32_t c3 = input[len - 1];
+    std::uint32_t combined = (c1 << 16) | (c2 << 24) | c3 | (static_cast<std::uint32_t>(len) << 8);
+    std::uint64_t bitflip = (read32(secret) ^ read32(secret + 4)) + seed;
+    return xxh64_avalanche(combined ^ bitflip);
+}
+
+inline std::uint64_t len_4to8(
+    const unsigned char *input,
+    std::size_t len,
+    const unsigned char *secret,
+    std::uint64_t seed) noexcept {
+    seed ^= static_cast<std::uint64_t>(__builtin_bswap32(static_cast<std::uint32_t>(seed))) << 32;
+    std::uint64_t input1 = read32(input);
+    std::uint64_t input2 = read32(input + len - 4);
+    std::uint64_t bitflip = (read64(secret + 8) ^ read64(secret + 16)) - seed;
+    std::uint64_t keyed = (input2 + (input1 << 32)) ^ bitflip;
+    return rrmxmx(keyed, len);
+}
+
+inline std::uint64_t len_9to16(
+    const unsigned char *input,
+    std::size_t len,
+    const unsigned char *secret,
+    std::uint64_t seed) noexcept {
+    std::uint64_t bitflip1 = (read64(secret + 24) ^ read64(secret + 32)) + seed;
+    std::uint64_t bitflip2 = (read64(secret + 40) ^ read64(secret + 48)) - seed;
+    std::uint64_t input_lo = read64(input) ^ bitflip1;
+    std::uint64_t input_hi = read64(input + len - 8) ^ bitflip2;
+    std::uint64_t acc =
+        len + __builtin_bswap64(input_lo) + input_hi + mul128_fold64(input_lo, input_hi);
+    return avalanche(acc);
+}
+
+inline std::uint64_t mix16(
+    const unsigned char *input,
+    const unsigned char *secret,
+    std::uint64_t seed) noexcept {
+    return mul128_fold64(
+        read64(input) ^ (read64(secret) + seed),
+        read64(input + 8) ^ (read64(secret + 8) - seed));
+}
+
+inline std::uint64_t len_17to128(
+    const unsigned char *input,
+    std::size_t len,
+    const unsigned char *secret,
+    std::uint64_t seed) noexcept {
+    std::uint64_t acc = len * prime64_1;
+    if (len > 32) {
+        if (len > 64) {
+            if (len > 96) {
+                acc += mix16(input + 48, secret + 96, seed);
+                acc += mix16(input + len - 64, secret + 112, seed);
+            }
+            acc += mix16(input + 32, secret + 64, seed);
+            acc += mix16(input + len - 48, secret + 80, seed);
+        }
+        acc += mix16(input + 16, secret + 32, seed);
+        acc += mix16(input + len - 32, secret + 48, seed);
+    }
+    acc += mix16(input, secret, seed);
+    acc += mix16(input + len - 16, secret + 16, seed);
+    return avalanche(acc);
+}
+
+std::uint64_t len_129to240(
+    const unsigned char *input,
+    std::size_t len,
+    const unsigned char *secret,
+    std::uint64_t seed) noexcept {
+    std::uint64_t acc = len * prime64_1;
+    std::size_t rounds = len / 16;
+    for (std::size_t i = 0; i < 8; i++) {
+        acc += mix16(input + 16 * i, secret + 16 * i, seed);
+    }
+    std::uint64_t acc_end =
+        mix16(input + len - 16, secret + secret_size_min - midsize_lastoffset, seed);
+    acc = avalanche(acc);
+    for (std::size_t i = 8; i < rounds; i++) {
+        acc_end += mix16(input + 16 * i, secret + 16 * (i - 8) + midsize_startoffset, seed);
+    }
+    return avalanche(acc + acc_end);
+}
+
+// Long inputs are processed by stripes of 64 bytes into 8 accumulators, the accumulators are
+// scrambled after each block of 16 stripes.
+using accumulate_fn = void (*)(
+    std::uint64_t *acc,
+    const unsigned char *input,
+    const unsigned char *secret,
+    std::size_t stripes) noexcept;
+using scramble_fn = void (*)(std::uint64_t *acc, const unsigned char *secret) noexcept;
+
+struct xxh3_kernels {
+    accumulate_fn accumulate;
+    scramble_fn scramble;
+};
+
+[[maybe_unused]] void accumulate_scalar(
+    std::uint64_t *acc,
+    const unsigned char *input,
+    const unsigned char *secret,
+    std::size_t stripes) noexcept {
+    for (std::size_t n = 0; n < stripes; n++) {
+        const unsigned char *in = input + n * stripe_len;
+        const unsigned char *key = secret + n * secret_consume_rate;
+        for (std::size_t i = 0; i < 8; i++) {
+            std::uint64_t data_val = read64(in + i * 8);
+            std::uint64_t data_key = data_val ^ read64(key + i * 8);
+            acc[i ^ 1] += data_val; // swap adjacent lanes
+            acc[i] += (data_key & 0xFFFFFFFF) * (data_key >> 32);
+        }
+    }
+}
+
+[[maybe_unused]] void scramble_scalar(std::uint64_t *acc, const unsigned char *secret) noexcept {
+    for (std::size_t i = 0; i < 8; i++) {
+        std::uint64_t a = acc[i];
+        a ^= a >> 47;
+        a ^= read64(secret + i * 8);
+        a *= prime32_1;
+        acc[i] = a;
+    }
+}
+
+#if defined(KON_XXH3_X86_64)
+void accumulate_sse2(
+    std::uint64_t *acc,
+    const unsigned char *input,
+    const unsigned char *secret,
+    std::size_t stripes) noexcept {
+    __m128i a[4];
+    for (int i = 0; i < 4; i++) {
+        a[i] = _mm_load_si128(reinterpret_cast<const __m128i *>(acc) + i);
+    }
+    for (std::size_t n = 0; n < stripes; n++) {
+        auto in = reinterpret_cast<const __m128i *>(input + n * stripe_len);
+        auto key = reinterpret_cast<const __m128i *>(secret + n * secret_consume_rate);
+        for (int i = 0; i < 4; i++) {
+            __m128i data_vec = _mm_loadu_si128(in + i);
+            __m128i data_key = _mm_xor_si128(data_vec, _mm_loadu_si128(key + i));
+            __m128i product = _mm_mul_epu32(data_key, _mm_srli_epi64(data_key, 32));
+            __m128i data_swap = _mm_shuffle_epi32(data_vec, _MM_SHUFFLE(1, 0, 3, 2));
+            a[i] = _mm_add_epi64(product, _mm_add_epi64(a[i], data_swap));
+        }
+    }
+    for (int i = 0; i < 4; i++) {
+        _mm_store_si128(reinterpret_cast<__m128i *>(acc) + i, a[i]);
+    }
+}
+
+void scramble_sse2(std::uint64_t *acc, const unsigned char *secret) noexcept {
+    const __m128i prime = _mm_set1_epi32(static_cast<int>(prime32_1));
+    for (int i = 0; i < 4; i++) {
+        __m128i a = _mm_load_si128(reinterpret_cast<const __m128i *>(acc) + i);
+        a = _mm_xor_si128(a, _mm_srli_epi64(a, 47));
+        a = _mm_xor_si128(a, _mm_loadu_si128(reinterpret_cast<const __m128i *>(secret) + i));
+        __m128i prod_lo = _mm_mul_epu32(a, prime);
+        __m128i prod_hi = _mm_mul_epu32(_mm_srli_epi64(a, 32), prime);
+        a = _mm_add_epi64(prod_lo, _mm_slli_epi64(prod_hi, 32));
+        _mm_store_si128(reinterpret_cast<__m128i *>(acc) + i, a);
+    }
+}
+
+KON_ATTR_TARGET("avx2")
+inline __m256i accumulate_round_avx2(__m256i acc, __m256i data_vec, __m256i key_vec) noexcept {
+    __m256i data_key = _mm256_xor_si256(data_vec, key_vec);
+    __m256i product = _mm256_mul_epu32(data_key, _mm256_srli_epi64(data_key, 32));
+    __m256i data_swap = _mm256_shuffle_epi32(data_vec, _MM_SHUFFLE(1, 0, 3, 2));
+    return _mm256_add_epi64(product, _mm256_add_epi64(acc, data_swap));
+}
+
+KON_ATTR_TARGET("avx2")
+void accumulate_avx2(
+    std::uint64_t *acc,
+    const unsigned char *input,
+    const unsigned char *secret,
+    std::size_t stripes) noexcept {
+    __m256i a0 = _mm256_load_si256(reinterpret_cast<const __m256i *>(acc));
+    __m256i a1 = _mm256_load_si256(reinterpret_cast<const __m256i *>(acc) + 1);
+    for (std::size_t n = 0; n < stripes; n++) {
+        auto in = reinterpret_cast<const __m256i *>(input + n * stripe_len);
+        auto key = reinterpret_cast<const __m256i *>(secret + n * secret_consume_rate);
+        a0 = accumulate_round_avx2(a0, _mm256_loadu_si256(in), _mm256_loadu_si256(key));
+        a1 = accumulate_round_avx2(a1, _mm256_loadu_si256(in + 1), _mm256_loadu_si256(key + 1));
+    }
+    _mm256_store_si256(reinterpret_cast<__m256i *>(acc), a0);
+    _mm256_store_si256(reinterpret_cast<__m256i *>(acc) + 1, a1);
+}
+
+KON_ATTR_TARGET("avx2")
+void scramble_avx2(std::uint64_t *acc, const unsigned char *secret) noexcept {
+    const __m256i prime = _mm256_set1_epi32(static_cast<int>(prime32_1));
+    for (int i = 0; i < 2; i++) {
+        __m256i a = _mm256_load_si256(reinterpret_cast<const __m256i *>(acc) + i);
+        a = _mm256_xor_si256(a, _mm256_srli_epi64(a, 47));
+        a = _mm256_xor_si256(
+            a,
+            _mm256_loadu_si256(reinterpret_cast<const __m256i *>(secret) + i));
+        __m256i prod_lo = _mm256_mul_epu32(a, prime);
+        __m256i prod_hi = _mm256_mul_epu32(_mm256_srli_epi64(a, 32), prime);
+        a = _mm256_add_epi64(prod_lo, _mm256_slli_epi64(prod_hi, 32));
+        _mm256_store_si256(reinterpret_cast<__m256i *>(acc) + i, a);
+    }
+}
+#elif defined(KON_ARCH_ARM64)
+void accumulate_neon(
+    std::uint64_t *acc,
+    const unsigned char *input,
+    const unsigned char *secret,
+    std::size_t stripes) noexcept {
+    uint64x2_t a[4];
+    for (int i = 0; i < 4; i++) {
+        a[i] = vld1q_u64(acc + 2 * i);
+    }
+    for (std::size_t n = 0; n < stripes; n++) {
+        const unsigned char *in = input + n * stripe_len;
+        const unsigned char *key = secret + n * secret_consume_rate;
+        for (int i = 0; i < 4; i++) {
+            uint64x2_t data_vec = vreinterpretq_u64_u8(vld1q_u8(in + 16 * i));
+            uint64x2_t data_key = veorq_u64(data_vec, vreinterpretq_u64_u8(vld1q_u8(key + 16 * i)));
+            a[i] = vaddq_u64(a[i], vextq_u64(data_vec, data_vec, 1));
+            a[i] = vmlal_u32(a[i], vmovn_u64(data_key), vshrn_n_u64(data_key, 32));
+        }
+    }
+    for (int i = 0; i < 4; i++) {
+        vst1q_u64(acc + 2 * i, a[i]);
+    }
+}
+
+void scramble_neon(std::uint64_t *acc, const unsigned char *secret) noexcept {
+    const uint32x2_t prime = vdup_n_u32(prime32_1);
+    for (int i = 0; i < 4; i++) {
+        uint64x2_t a = vld1q_u64(acc + 2 * i);
+        a = veorq_u64(a, vshrq_n_u64(a, 47));
+        a = veorq_u64(a, vreinterpretq_u64_u8(vld1q_u8(secret + 16 * i)));
+        uint64x2_t prod_hi = vshlq_n_u64(vmull_u32(vshrn_n_u64(a, 32), prime), 32);
+        vst1q_u64(acc + 2 * i, vmlal_u32(prod_hi, vmovn_u64(a), prime));
+    }
+}
+#endif
+
+inline xxh3_kernels select_kernels() noexcept {
+#if defined(KON_XXH3_X86_64)
+    if (rt::cpu().avx2) {
+        return {accumulate_avx2, scramble_avx2};
+    }
+    return {accumulate_sse2, scramble_sse2};
+#elif defined(KON_ARCH_ARM64)
+    return {accumulate_neon, scramble_neon};
+#else
+    return {accumulate_scalar, scramble_scalar};
+#endif
+}
+
+constexpr std::uint64_t init_acc[8] = {
+    prime32_3,
+    prime64_1,
+    prime64_2,
+    prime64_3,
+    prime64_4,
+    prime32_2,
+    prime64_5,
+    prime32_1,
+};
+
+std::uint64_t merge_accs(
+    const std::uint64_t *acc,
+    const unsigned char *secret,
+    std::uint64_t start) noexcept {
+    std::uint64_t result = start;
+    for (std::size_t i = 0; i < 4; i++) {
+        result += mul128_fold64(
+            acc[2 * i] ^ read64(secret + 16 * i),
+            acc[2 * i + 1] ^ read64(secret + 16 * i + 8));
+    }
+    return avalanche(result);
+}
+
+void init_secret(unsigned char *secret, std::uint64_t seed) noexcept {
+    for (std::size_t i = 0; i < secret_size; i += 16) {
+        std::uint64_t lo = read64(default_secret + i) + seed;
+        std::uint64_t hi = read64(default_secret + i + 8) - seed;
+        std::memcpy(secret + i, &lo, 8);
+        std::memcpy(secret + i + 8, &hi, 8);
+    }
+}
+
+std::uint64_t hash_long(
+    const unsigned char *input,
+    std::size_t len,
+    std::uint64_t seed) noexcept {
+    alignas(64) unsigned char custom_secret[secret_size];
+    const unsigned char *secret = default_secret;
+    if (seed != 0) {
+        init_secret(custom_secret, seed);
+        secret = custom_secret;
+    }
+    alignas(64) std::uint64_t acc[8];
+    std::memcpy(acc, init_acc, sizeof(acc));
+    auto k = select_kernels();
+
+    std::size_t blocks = (len - 1) / block_len;
+    for (std::size_t n = 0; n < blocks; n++) {
+        k.accumulate(acc, input + n * block_len, secret, stripes_per_block);
+        k.scramble(acc, secret + secret_limit);
+    }
+    // Last partial block.
+    std::size_t stripes = ((len - 1) - (block_len * blocks)) / stripe_len;
+    k.accumulate(acc, input + blocks * block_len, secret, stripes);
+    // Last stripe.
+    k.accumulate(acc, input + len - stripe_len, secret + secret_limit - secret_lastacc_start, 1);
+    return merge_accs(acc, secret + secret_mergeaccs_start, len * prime64_1);
+}
+
+// Process stripes which may cross a block, stripes_so_far is the position in the block.
+const unsigned char *consume_stripes(
+    const xxh3_kernels &k,
+    std::uint64_t *acc,
+    std::uint32_t &stripes_so_far,
+    const unsigned char *input,
+    std::size_t stripes,
+    const unsigned char *secret) noexcept {
+    const unsigned char *initial_secret = secret + stripes_so_far * secret_consume_rate;
+    if (stripes >= (stripes_per_block - stripes_so_far)) {
+        std::size_t stripes_this_iter = stripes_per_block - stripes_so_far;
+        do {
+            k.accumulate(acc, input, initial_secret, stripes_this_iter);
+            k.scramble(acc, secret + secret_limit);
+            input += stripes_this_iter * stripe_len;
+            stripes -= stripes_this_iter;
+            stripes_this_iter = stripes_per_block;
+            initial_secret = secret;
+        } while (stripes >= stripes_per_block);
+        stripes_so_far = 0;
+    }
+    if (stripes > 0) {
+        k.accumulate(acc, input, initial_secret, stripes);
+        input += stripes * stripe_len;
+        stripes_so_far += static_cast<std::uint32_t>(stripes);
+    }
+    return input;
+}
+} // namespace
+
+std::uint64_t xxh3(const unsigned char *input, std::size_t ilen, std::uint64_t seed) noexcept {
+    const unsigned char *secret = default_secret;
+    if (ilen <= 16) {
+        if (ilen > 8) {
+            return len_9to16(input, ilen, secret, seed);
+        }
+        if (ilen >= 4) {
+            return len_4to8(input, ilen, secret, seed);
+        }
+        if (ilen != 0) {
+            return len_1to3(input, ilen, secret, seed);
+        }
+        return xxh64_avalanche(seed ^ (read64(secret + 56) ^ read64(secret + 64)));
+    }
+    if (ilen <= 128) {
+        return len_17to128(input, ilen, secret, seed);
+    }
+    if (ilen <= midsize_max) {
+        return len_129to240(input, ilen, secret, seed);
+    }
+    return hash_long(input, ilen, seed);
+}
+
+void xxh3_context::start(std::uint64_t seed) noexcept {
+    std::memcpy(m_acc, init_acc, sizeof(m_acc));
+    init_secret(m_secret, seed);
+    m_total = 0;
+    m_seed = seed;
+    m_buffered = 0;
+    m_stripes = 0;
+}
+
+void xxh3_context::update(const unsigned char *input, std::size_t ilen) noexcept {
+    const unsigned char *end = input + ilen;
+    m_total += ilen;
+    // Keep at least one byte buffered, so finish() always has the last stripe.
+    if (ilen <= sizeof(m_buffer) - m_buffered) {
+        std::memcpy(m_buffer + m_buffered, input, ilen);
+        m_buffered += static_cast<std::uint32_t>(ilen);
+        return;
+    }
+    auto k = select_kernels();
+    constexpr std::size_t buffer_stripes = sizeof(m_buffer) / stripe_len;
+    if (m_buffered != 0) {
+        std::size_t load_size = sizeof(m_buffer) - m_buffered;
+        std::memcpy(m_buffer + m_buffered, input, load_size);
+        input += load_size;
+        consume_stripes(k, m_acc, m_stripes, m_buffer, buffer_stripes, m_secret);
+        m_buffered = 0;
+    }
+    if (static_cast<std::size_t>(end - input) > sizeof(m_buffer)) {
+        std::size_t stripes = static_cast<std::size_t>(end - 1 - input) / stripe_len;
+        input = consume_stripes(k, m_acc, m_stripes, input, stripes, m_secret);
+        // The last stripe is needed by finish() if less than a stripe is left.
+        std::memcpy(m_buffer + sizeof(m_buffer) - stripe_len, input - stripe_len, stripe_len);
+    }
+    m_buffered = static_cast<std::uint32_t>(end - input);
+    std::memcpy(m_buffer, input, m_buffered);
+}
+
+std::uint64_t xxh3_context::finish() const noexcept {
+    if (m_total <= midsize_max) {
+        return xxh3(m_buffer, static_cast<std::size_t>(m_total), m_seed);
+    }
+    auto k = select_kernels();
+    alignas(64) std::uint64_t acc[8];
+    std::memcpy(acc, m_acc, sizeof(acc));
+    const unsigned char *last_stripe;
+    unsigned char last_stripe_buf[stripe_len];
+    if (m_buffered >= stripe_len) {
+        std::size_t stripes = (m_buffered - 1) / stripe_len;
+        std::uint32_t stripes_so_far = m_stripes;
+        consume_stripes(k, acc, stripes_so_far, m_buffer, stripes, m_secret);
+        last_stripe = m_buffer + m_buffered - stripe_len;
+    } else {
+        std::size_t catchup = stripe_len - m_buffered;
+        std::memcpy(last_stripe_buf, m_buffer + sizeof(m_buffer) - catchup, catchup);
+        std::memcpy(last_stripe_buf + catchup, m_buffer, m_buffered);
+        last_stripe = last_stripe_buf;
+    }
+    k.accumulate(acc, last_stripe, m_secret + secret_limit - secret_lastacc_start, 1);
+    return merge_accs(acc, m_secret + secret_mergeaccs_start, m_total * prime64_1);
+}
+
+} // namespace kon
@@ -0,0 +1,36 @@
+// SPDX-FileCopyrightText: 2026 TypeCombinator <typecombinator@foxmail.com>
+//
+// SPDX-License-Identifier: BSD 3-Clause
+
+#ifndef HASH_XXH3_A460FD8A_AA6C_4955_9576_444A16E6B89C
+#define HASH_XXH3_A460FD8A_AA6C_4955_9576_444A16E6B89C
+// References:
+// [0]: https://github.com/Cyan4973/xxHash/blob/dev/doc/xxhash_spec.md
+#include <cstddef>
+#include <cstdint>
+
+namespace kon {
+
+// XXH3 64 bits, a fast non-cryptographic hash, the results are the same as XXH3_64bits_withSeed.
+// Long inputs are accumulated with AVX2 / SSE2 / NEON.
+class xxh3_context {
+   public:
+    void start(std::uint64_t seed = 0) noexcept;
+    void update(const unsigned char *input, std::size_t ilen) noexcept;
+    // Doesn't alter the context, more data can be fed after it.
+    std::uint64_t finish() const noexcept;
+   private:
+    alignas(64) std::uint64_t m_acc[8];
+    alignas(64) unsigned char m_secret[192];
+    alignas(64) unsigned char m_buffer[256];
+    std::uint64_t m_total;         // number of bytes processed
+    std::uint64_t m_seed;
+    std::uint32_t m_buffered;      // number of bytes in m_buffer
+    std::uint32_t m_stripes;       // number of stripes processed in the current block
+};
+
+// One shot hash, much faster than the context for short inputs.
+std::uint64_t xxh3(const unsigned char *input, std::size_t ilen, std::uint64_t seed = 0) noexcept;
+
+} // namespace kon
+#endif // xxh3.hpp
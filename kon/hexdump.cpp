@@ -0,0 +1,93 @@
+// SPDX-FileCopyrightText: 2026 TypeCombinator <typecombinator@foxmail.com>
+//
+// SPDX-License-Identifier: BSD 3-Clause
+
+#include <kon/hexdump.hpp>
+#include <kon/base16.hpp>
+#include <cstring>
+
+namespace kon {
+
+// The hex digits of a block are expanded by the SIMD base16 kernels in one call, then spread over
+// the lines.
+static constexpr std::size_t hexdump_block_lines = 32;
+static constexpr std::size_t hexdump_block_bytes = hexdump_block_lines * hexdump_line_bytes;
+
+static inline char *hexdump_offset(char *out, std::size_t offset) noexcept {
+    auto v = static_cast<std::uint32_t>(offset);
+    std::memcpy(out, &base16_encode_lut2[((v >> 24) & 0xFF) << 1], 2);
+    std::memcpy(out + 2, &base16_encode_lut2[((v >> 16) & 0xFF) << 1], 2);
+    std::memcpy(out + 4, &base16_encode_lut2[((v >> 8) & 0xFF) << 1], 2);
+    std::memcpy(out + 6, &base16_encode_lut2[(v & 0xFF) << 1], 2);
+    out[8] = ':';
+    out[9] = ' ';
+    return out + hexdump_offset_width;
+}
+
+static inline char *hexdump_ascii(char *out, const std::uint8_t *data, std::size_t size) noexcept {
+    out[0] = ' ';
+    out[1] = ' ';
+    out += 2;
+    for (std::size_t i = 0; i < size; i++) {
+        std::uint8_t c = data[i];
+        out[i] = (static_cast<std::uint8_t>(c - 0x20) < 0x5F) ? static_cast<char>(c) : '.';
+    }
+    return out + size;
+}
+
+std::size_t hexdump(
+    const void *va,
+    std::size_t size,
+    char *out,
+    hexdump_options options,
+    std::size_t base_offset) noexcept {
+    auto data = static_cast<const std::uint8_t *>(va);
+    char *const out_org = out;
+    char hex[hexdump_block_bytes * 2];
+    for (std::size_t i = 0; i < size; i += hexdump_block_bytes) {
+        const std::size_t block =
+            (size - i < hexdump_block_bytes) ? (size - i) : hexdump_block_bytes;
+        base16_encode(data + i, block, hex, sizeof(hex));
+        for (std::size_t j = 0; j < block; j += hexdump_line_bytes) {
+            const std::size_t line =
+                (block - j < hexdump_line_bytes) ? (block - j) : hexdump_line_bytes;
+            if ((i + j) != 0) {
+                *out++ = '\n';
+            }
+            if (options.offset) {
+                out = hexdump_offset(out, base_offset + i + j);
+            }
+            const char *h = hex + j * 2;
+            if (line == hexdump_line_bytes) [[likely]] {
+                for (int g = 0; g < 7; g++) {
+                    std::memcpy(out, h, 8);
+                    out[8] = ' ';
+                    out += 9;
+                    h += 8;
+                }
+                std::memcpy(out, h, 8);
+                out += 8;
+            } else {
+                char *hex_start = out;
+                for (std::size_t b = 0; b < line; b++) {
+                    if ((b != 0) && ((b & 3) == 0)) {
+                        *out++ = ' ';
+                    }
+                    std::memcpy(out, h + b * 2, 2);
+                    out += 2;
+                }
+                if (options.ascii) {
+                    std::size_t pad = hexdump_hex_width - (out - hex_start);
+                    std::memset(out, ' ', pad);
+                    out += pad;
+                }
+            }
+            if (options.ascii) {
+                out = hexdump_ascii(out, data + i + j, line);
+            }
+        }
+    }
+    return out - out_org;
+}
+
+} // namespace kon
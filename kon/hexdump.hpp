@@ -0,0 +1,53 @@
+// SPDX-FileCopyrightText: 2026 TypeCombinator <typecombinator@foxmail.com>
+//
+// SPDX-License-Identifier: BSD 3-Clause
+
+#ifndef HEXDUMP_32F639BA_8C7A_4BAF_A7B7_3964879D2AA8
+#define HEXDUMP_32F639BA_8C7A_4BAF_A7B7_3964879D2AA8
+#include <cstdint>
+#include <cstddef>
+
+namespace kon {
+
+// Line layout, the columns in brackets are optional:
+// [00000020: ]00010203 04050607 08090a0b 0c0d0e0f 10111213 14151617 18191a1b 1c1d1e1f[  ascii...]
+// Lines are separated by '\n', and there's no trailing '\n'.
+struct hexdump_options {
+    bool offset{false};
+    bool ascii{false};
+};
+
+static constexpr std::size_t hexdump_line_bytes = 32;
+static constexpr std::size_t hexdump_offset_width = 10;                       // "00000020: "
+static constexpr std::size_t hexdump_hex_width = hexdump_line_bytes * 2 + 7; // 8 groups
+static constexpr std::size_t hexdump_ascii_width = 2 + hexdump_line_bytes;    // "  ascii..."
+
+static constexpr std::size_t hexdump_size(std::size_t size, hexdump_options options) noexcept {
+    if (size == 0) {
+        return 0;
+    }
+    const std::size_t lines = (size + hexdump_line_bytes - 1) / hexdump_line_bytes;
+    const std::size_t last = size - (lines - 1) * hexdump_line_bytes;
+    const std::size_t offset_width = options.offset ? hexdump_offset_width : 0;
+    const std::size_t line_width =
+        offset_width + hexdump_hex_width + (options.ascii ? hexdump_ascii_width : 0);
+    std::size_t last_width = offset_width;
+    if (options.ascii) { // The hex column is padded, so the ascii column is aligned.
+        last_width += hexdump_hex_width + 2 + last;
+    } else {
+        last_width += last * 2 + (last + 3) / 4 - 1;
+    }
+    return (lines - 1) * (line_width + 1) + last_width;
+}
+
+// Writes exactly hexdump_size(size, options) characters to out, base_offset is the value printed in
+// the offset column of the first line.
+std::size_t hexdump(
+    const void *va,
+    std::size_t size,
+    char *out,
+    hexdump_options options = {},
+    std::size_t base_offset = 0) noexcept;
+
+} // namespace kon
+#endif /* hexdump.hpp */
@@ -0,0 +1,254 @@
+// SPDX-FileCopyrightText: 2026 TypeCombinator <typecombinator@foxmail.com>
+//
+// SPDX-License-Identifier: BSD 3-Clause
+
+#ifndef HIERARCHICAL_BITSET_0ACB1352_D764_467D_92D4_DD821407AADC
+#define HIERARCHICAL_BITSET_0ACB1352_D764_467D_92D4_DD821407AADC
+#include <kon/bit.hpp>
+#include <kon/xt/attributes.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <new>
+
+namespace kon {
+
+// A bitset with summary levels, a bit of a level marks a non-empty word of the level below, up
+// to a single top word. The searches walk the levels with a countr_zero / countl_zero per level,
+// so they cost the same on a sparse set of any size, e.g. 4 levels for 16M bits. set() and
+// reset() update the summaries only when a word turns empty or non-empty.
+class hierarchical_bitset {
+   public:
+    using word_type = std::uint64_t;
+    static constexpr std::size_t word_bits = 64;
+    static constexpr std::size_t max_levels = 6; // 2^36 bits
+    static constexpr std::size_t npos = ~std::size_t{0};
+
+    hierarchical_bitset() noexcept = default;
+
+    hierarchical_bitset(hierarchical_bitset &&other) noexcept {
+        take(other);
+    }
+
+    hierarchical_bitset &operator=(hierarchical_bitset &&other) noexcept {
+        if (this != &other) {
+            release();
+            take(other);
+        }
+        return *this;
+    }
+
+    ~hierarchical_bitset() noexcept {
+        release();
+    }
+
+    KON_DISALLOW_COPY(hierarchical_bitset);
+
+    // All the bits are 0 after it. Returns false if the allocation fails or size is above 2^36,
+    // the bitset is unchanged then.
+    bool init(std::size_t size) noexcept {
+        std::size_t counts[max_levels];
+        std::size_t depth = 0;
+        std::size_t total = 0;
+        std::size_t bits = size;
+        do {
+            if (depth == max_levels) {
+                return false;
+            }
+            counts[depth] = (bits > word_bits) ? ((bits + word_bits - 1) / word_bits) : 1;
+            total += counts[depth];
+            bits = counts[depth++];
+        } while (bits > 1);
+        auto words = static_cast<word_type *>(
+            ::operator new(total * sizeof(word_type), std::align_val_t{64}, std::nothrow));
+        if (words == nullptr) {
+            return false;
+        }
+        std::memset(words, 0, total * sizeof(word_type));
+        release();
+        m_size = size;
+        m_depth = depth;
+        for (std::size_t k = 0; k < depth; k++) {
+            m_levels[k] = words;
+            m_counts[k] = counts[k];
+            words += counts[k];
+        }
+        return true;
+    }
+
+    [[nodiscard]]
+    std::size_t size() const noexcept {
+        return m_size;
+    }
+
+    // The number of levels, the leaves included.
+    [[nodiscard]]
+    std::size_t depth() const noexcept {
+        return m_depth;
+    }
+
+    [[nodiscard]]
+    bool test(std::size_t pos) const noexcept {
+        return (m_levels[0][pos / word_bits] >> (pos % word_bits)) & 1;
+    }
+
+    [[nodiscard]]
+    bool operator[](std::size_t pos) const noexcept {
+        return test(pos);
+    }
+
+    [[nodiscard]]
+    bool any() const noexcept {
+        return (m_depth != 0) && (m_levels[m_depth - 1][0] != 0);
+    }
+
+    [[nodiscard]]
+    bool none() const noexcept {
+        return !any();
+    }
+
+    hierarchical_bitset &set(std::size_t pos) noexcept {
+        for (std::size_t k = 0; k < m_depth; k++) {
+            word_type &e = m_levels[k][pos / word_bits];
+            word_type old = e;
+            e |= word_type{1} << (pos % word_bits);
+            if (old != 0) {
+                break; // The summaries above are set already.
+            }
+            pos /= word_bits;
+        }
+        return *this;
+    }
+
+    hierarchical_bitset &reset(std::size_t pos) noexcept {
+        for (std::size_t k = 0; k < m_depth; k++) {
+            word_type &e = m_levels[k][pos / word_bits];
+            e &= ~(word_type{1} << (pos % word_bits));
+            if (e != 0) {
+                break;
+            }
+            pos /= word_bits;
+        }
+        return *this;
+    }
+
+    hierarchical_bitset &reset() noexcept {
+        for (std::size_t k = 0; k < m_depth; k++) {
+            std::memset(m_levels[k], 0, m_counts[k] * sizeof(word_type));
+        }
+        return *this;
+    }
+
+    // The first set bit, npos if none.
+    [[nodiscard]]
+    std::size_t find_first() const noexcept {
+        if (!any()) {
+            return npos;
+        }
+        return descend_first(m_depth, 0);
+    }
+
+    // The last set bit, npos if none.
+    [[nodiscard]]
+    std::size_t find_last() const noexcept {
+        if (!any()) {
+            return npos;
+        }
+        return descend_last(m_depth, 0);
+    }
+
+    // The first set bit after pos, npos if none.
+    [[nodiscard]]
+    std::size_t find_next(std::size_t pos) const noexcept {
+        pos++;
+        if (pos >= m_size) [[unlikely]] {
+            return npos;
+        }
+        // Up to the first level with a set bit at or after pos, then down to its first leaf.
+        for (std::size_t k = 0; k < m_depth; k++) {
+            std::size_t y = pos / word_bits;
+            if (y == m_counts[k]) {
+                return npos;
+            }
+            word_type e = m_levels[k][y] & kon::msb_mask<word_type>(pos % word_bits);
+            if (e != 0) {
+                return descend_first(k, y * word_bits + kon::countr_zero<word_type, true>(e));
+            }
+            pos = y + 1;
+        }
+        return npos;
+    }
+
+    // The last set bit before pos, npos if none.
+    [[nodiscard]]
+    std::size_t find_prev(std::size_t pos) const noexcept {
+        if ((pos == 0) || (m_size == 0)) [[unlikely]] {
+            return npos;
+        }
+        // Up to the first level with a set bit at or before last, then down to its last leaf.
+        std::size_t last = ((pos < m_size) ? pos : m_size) - 1;
+        for (std::size_t k = 0; k < m_depth; k++) {
+            std::size_t y = last / word_bits;
+            word_type e = m_levels[k][y] & (~word_type{0} >> (word_bits - 1 - last % word_bits));
+            if (e != 0) {
+                return descend_last(k, y * word_bits + last_bit(e));
+            }
+            if (y == 0) {
+                return npos;
+            }
+            last = y - 1;
+        }
+        return npos;
+    }
+   private:
+    static std::size_t last_bit(word_type e) noexcept {
+        return word_bits - 1 - kon::countl_zero<word_type, true>(e);
+    }
+
+    // From the set bit pos of level k down to the first leaf under it, the top word is the bit 0
+    // of the level m_depth.
+    std::size_t descend_first(std::size_t k, std::size_t pos) const noexcept {
+        while (k != 0) {
+            word_type e = m_levels[--k][pos];
+            pos = pos * word_bits + kon::countr_zero<word_type, true>(e);
+        }
+        return pos;
+    }
+
+    std::size_t descend_last(std::size_t k, std::size_t pos) const noexcept {
+        while (k != 0) {
+            word_type e = m_levels[--k][pos];
+            pos = pos * word_bits + last_bit(e);
+        }
+        return pos;
+    }
+
+    void take(hierarchical_bitset &other) noexcept {
+        m_size = other.m_size;
+        m_depth = other.m_depth;
+        for (std::size_t k = 0; k < max_levels; k++) {
+            m_levels[k] = other.m_levels[k];
+            m_counts[k] = other.m_counts[k];
+        }
+        other.m_size = 0;
+        other.m_depth = 0;
+        other.m_levels[0] = nullptr;
+    }
+
+    void release() noexcept {
+        if (m_depth != 0) {
+            ::operator delete(m_levels[0], std::align_val_t{64});
+            m_levels[0] = nullptr;
+            m_depth = 0;
+            m_size = 0;
+        }
+    }
+
+    word_type *m_levels[max_levels]{}; // The leaves first, all in one allocation.
+    std::size_t m_counts[max_levels]{}; // The words of each level.
+    std::size_t m_size{0};
+    std::size_t m_depth{0};
+};
+
+} // namespace kon
+#endif // hierarchical_bitset.hpp
@@ -0,0 +1,345 @@
+// SPDX-FileCopyrightText: 2026 TypeCombinator <typecombinator@foxmail.com>
+//
+// SPDX-License-Identifier: BSD 3-Clause
+
+#include <kon/line_reader.hpp>
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <semaphore>
+#include <thread>
+#include <vector>
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace kon {
+
+// Every buffer has a headroom of chunk_size bytes in front of the data, the carry of the previous
+// chunk is copied there. A longer carry spills into a heap buffer with the whole chunk.
+struct chunk_reader::stream {
+    struct buffer {
+        std::unique_ptr<char[]> data;
+        ssize_t size; // -1 for an error
+        bool end;     // the last buffer, after the end of the file or an error
+    };
+
+    int fd;
+    int wake_fd{-1}; // written by close(), a read of a pipe or a socket may block for good
+    bool pollable{false};
+    std::size_t chunk_size;
+    buffer buffers[ring_size];
+    std::counting_semaphore<> free_buffers{ring_size};
+    std::counting_semaphore<> full_buffers{0};
+    std::atomic<bool> stop{false};
+    std::thread thread;
+    std::size_t index{0}; // next buffer of the caller
+    bool holding{false};  // the caller holds the buffer before index
+    bool last{false};     // the last buffer was returned
+    std::vector<char> spill;
+
+    ~stream() {
+        if (wake_fd >= 0) {
+            ::close(wake_fd);
+        }
+    }
+
+    void read_loop() noexcept {
+        for (std::size_t i = 0;; i++) {
+            free_buffers.acquire();
+            if (stop.load(std::memory_order_relaxed)) {
+                return;
+            }
+            auto &b = buffers[i % ring_size];
+            char *data = b.data.get() + chunk_size;
+            std::size_t sum = 0;
+            b.size = 0;
+            b.end = false;
+            while (sum < chunk_size) {
+                if (pollable && !wait_readable()) {
+                    return;
+                }
+                auto n = ::read(fd, data + sum, chunk_size - sum);
+                if (n < 0) {
+                    if (errno == EINTR) {
+                        continue;
+                    }
+                    b.size = -1;
+                    b.end = true;
+                    break;
+                }
+                if (n == 0) {
+                    b.end = true;
+                    break;
+                }
+                sum += n;
+                b.size = static_cast<ssize_t>(sum);
+                // A pipe or a socket hands over what it has, the producer may write a line at a
+                // time.
+                if (pollable) {
+                    break;
+                }
+            }
+            full_buffers.release();
+            if (b.end) {
+                return;
+            }
+        }
+    }
+
+    // Waits until the fd can be read, false if close() woke it up first.
+    bool wait_readable() noexcept {
+        pollfd fds[2] = {{fd, POLLIN, 0}, {wake_fd, POLLIN, 0}};
+        while (true) {
+            int n = ::poll(fds, 2, -1);
+            if (n < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                return true; // The read reports the error.
+            }
+            return fds[1].revents == 0;
+        }
+    }
+};
+
+chunk_reader::chunk_reader() noexcept = default;
+
+chunk_reader::~chunk_reader() noexcept {
+    close();
+}
+
+int chunk_reader::open(
+    const std::string &file_name,
+    read_mode mode,
+    std::size_t chunk_size) noexcept {
+    close();
+    if (chunk_size == 0) {
+        return -1;
+    }
+    int fd = ::open(file_name.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        return -1;
+    }
+    struct stat st;
+    if (::fstat(fd, &st) != 0) {
+        ::close(fd);
+        return -1;
+    }
+    m_chunk_size = chunk_size;
+    m_chunk = {};
+    bool regular = S_ISREG(st.st_mode);
+    if ((mode != read_mode::stream) && regular) {
+        std::size_t size = static_cast<std::size_t>(st.st_size);
+        m_offset = 0;
+        m_released = 0;
+        // The files of procfs and sysfs have a size of 0.
+        if ((size == 0) && (mode == read_mode::automatic)) {
+            goto lb_stream;
+        }
+        int err;
+        mapped_file file(err, fd, {.advice = file_advice::sequential});
+        if (err == 0) {
+            ::close(fd);
+            m_file = std::move(file);
+            m_mapped = true;
+            m_file.prefetch(0, m_chunk_size);
+            return 0;
+        }
+        // mmap isn't supported by the file system, fall back to the stream.
+    }
+lb_stream:
+
+    std::unique_ptr<stream> s{new (std::nothrow) stream{}};
+    if (s == nullptr) {
+        ::close(fd);
+        return -1;
+    }
+    s->fd = fd;
+    s->chunk_size = chunk_size;
+    // A regular file is never waited for.
+    s->pollable = !regular;
+    if (s->pollable) {
+        s->wake_fd = ::eventfd(0, EFD_CLOEXEC);
+        if (s->wake_fd < 0) {
+            ::close(fd);
+            return -1;
+        }
+    }
+    for (auto &b: s->buffers) {
+        b.data.reset(new (std::nothrow) char[chunk_size * 2]);
+        if (b.data == nullptr) {
+            ::close(fd);
+            return -1;
+        }
+    }
+    ::posix_fadvise(fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+    try {
+        s->thread = std::thread(&stream::read_loop, s.get());
+    } catch (...) {
+        ::close(fd);
+        return -1;
+    }
+    m_stream = std::move(s);
+    return 0;
+}
+
+void chunk_reader::close() noexcept {
+    m_file = mapped_file();
+    m_mapped = false;
+    if (m_stream != nullptr) {
+        // Wake the reader up if it waits for a free buffer or for the input, it exits after the
+        // last buffer anyway.
+        m_stream->stop.store(true, std::memory_order_relaxed);
+        m_stream->free_buffers.release(ring_size);
+        if (m_stream->wake_fd >= 0) {
+            std::uint64_t one = 1;
+            [[maybe_unused]] auto n = ::write(m_stream->wake_fd, &one, sizeof(one));
+        }
+        m_stream->thread.join();
+        ::close(m_stream->fd);
+        m_stream.reset();
+    }
+    m_chunk = {};
+}
+
+int chunk_reader::next(std::string_view &chunk, std::size_t carry) noexcept {
+    carry = std::min(carry, m_chunk.size());
+    int ret;
+    if (m_mapped) {
+        ret = next_mapped(chunk, carry);
+    } else if (m_stream != nullptr) {
+        ret = next_streamed(chunk, carry);
+    } else {
+        return -1;
+    }
+    if (ret == 1) {
+        m_chunk = chunk;
+    }
+    return ret;
+}
+
+int chunk_reader::next_mapped(std::string_view &chunk, std::size_t carry) noexcept {
+    if (m_offset >= m_file.size()) {
+        return 0;
+    }
+    std::size_t size = std::min(m_chunk_size, m_file.size() - m_offset);
+    // Map the pages of the chunk in one call rather than one fault every few pages, and read the
+    // next chunk ahead.
+    m_file.populate(m_offset, size);
+    m_file.prefetch(m_offset + size, m_chunk_size);
+    // Release the pages in front of the carry, a file larger than the memory doesn't stay
+    // resident. They are read again if the previous chunks are touched.
+    m_file.release(m_released, m_offset - carry - m_released);
+    m_released = m_offset - carry;
+    // The chunks are contiguous, the carry is just in front of the new one.
+    chunk = std::string_view(m_file.data() + m_offset - carry, size + carry);
+    m_offset += size;
+    return 1;
+}
+
+int chunk_reader::next_streamed(std::string_view &chunk, std::size_t carry) noexcept {
+    auto &s = *m_stream;
+    if (s.last) {
+        return 0;
+    }
+    s.full_buffers.acquire();
+    auto &b = s.buffers[s.index % ring_size];
+    if (b.size < 0) {
+        s.last = true;
+        return -1;
+    }
+    std::size_t size = static_cast<std::size_t>(b.size);
+    if (b.end) {
+        s.last = true;
+        if (size == 0) {
+            return 0; // the previous chunk and its carry stay valid
+        }
+    }
+    char *data = b.data.get() + s.chunk_size;
+    if (carry <= s.chunk_size) {
+        if (carry != 0) {
+            std::memcpy(data - carry, m_chunk.data() + m_chunk.size() - carry, carry);
+        }
+        chunk = std::string_view(data - carry, size + carry);
+    } else {
+        // The carry may live in the spill buffer already.
+        std::vector<char> spill;
+        try {
+            spill.reserve(carry + size);
+        } catch (...) {
+            s.last = true;
+            return -1;
+        }
+        spill.insert(spill.end(), m_chunk.end() - carry, m_chunk.end());
+        spill.insert(spill.end(), data, data + size);
+        s.spill.swap(spill);
+        chunk = std::string_view(s.spill.data(), s.spill.size());
+    }
+    // The previous buffer isn't referenced anymore, hand it back to the reader.
+    if (s.holding) {
+        s.free_buffers.release();
+    }
+    s.holding = true;
+    s.index++;
+    return 1;
+}
+
+int line_reader::open(
+    const std::string &file_name,
+    read_mode mode,
+    std::size_t chunk_size) noexcept {
+    m_chunk = {};
+    m_splitter = field_splitter(nullptr, 0, "\n");
+    m_line = 0;
+    m_end = true;
+    if (m_chunks.open(file_name, mode, chunk_size) != 0) {
+        return -1;
+    }
+    m_end = false;
+    return 0;
+}
+
+void line_reader::close() noexcept {
+    m_chunks.close();
+    m_chunk = {};
+    m_end = true;
+}
+
+int line_reader::next(std::string_view &line) noexcept {
+    while (!m_end) {
+        std::size_t offset;
+        if (m_splitter.next_offsets(&offset, 1) == 1) {
+            offset += m_base;
+            line = m_chunk.substr(m_line, offset - m_line);
+            m_line = offset + 1;
+            return 1;
+        }
+        // Continue the unterminated line in the next chunk.
+        std::size_t carry = m_chunk.size() - m_line;
+        std::string_view chunk;
+        int ret = m_chunks.next(chunk, carry);
+        if (ret < 0) {
+            m_end = true;
+            return -1;
+        }
+        if (ret == 0) {
+            m_end = true;
+            if (carry == 0) {
+                return 0;
+            }
+            line = m_chunk.substr(m_line);
+            return 1;
+        }
+        // The carry was scanned already, skip it.
+        m_chunk = chunk;
+        m_splitter = field_splitter(chunk.data() + carry, chunk.size() - carry, "\n");
+        m_line = 0;
+        m_base = carry;
+    }
+    return 0;
+}
+
+} // namespace kon
@@ -0,0 +1,89 @@
+// SPDX-FileCopyrightText: 2026 TypeCombinator <typecombinator@foxmail.com>
+//
+// SPDX-License-Identifier: BSD 3-Clause
+
+#ifndef LINE_READER_0C9E7A5B_42E6_491B_8D4B_329607FE8587
+#define LINE_READER_0C9E7A5B_42E6_491B_8D4B_329607FE8587
+#include <kon/mapped_file.hpp>
+#include <kon/string_helper.hpp>
+#include <kon/xt/attributes.hpp>
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <string_view>
+
+namespace kon {
+
+enum class read_mode {
+    automatic, // mmap for the regular files, stream otherwise
+    mmap,
+    stream,    // a reader thread fills a ring of buffers ahead of the caller
+};
+
+// Reads a file chunk by chunk without copying it to the heap.
+class chunk_reader {
+   public:
+    static constexpr std::size_t default_chunk_size = 4 * 1024 * 1024;
+    static constexpr std::size_t ring_size = 3;
+
+    chunk_reader() noexcept;
+    ~chunk_reader() noexcept;
+
+    KON_DISALLOW_COPY(chunk_reader);
+    KON_DISALLOW_MOVE(chunk_reader);
+
+    int open(
+        const std::string &file_name,
+        read_mode mode = read_mode::automatic,
+        std::size_t chunk_size = default_chunk_size) noexcept;
+    void close() noexcept;
+
+    // Returns 1 with the next chunk, 0 at the end of the file, -1 on an error. The last carry
+    // bytes of the previous chunk are prepended to the new one, they are only copied in the stream
+    // mode. A mapped chunk stays valid until close(), its pages are released once it's behind the
+    // carry and read again if touched. A streamed chunk stays valid until the next call, a pipe or
+    // a socket gives a short one with what it has.
+    int next(std::string_view &chunk, std::size_t carry = 0) noexcept;
+
+    bool mapped() const noexcept {
+        return m_mapped;
+    }
+   private:
+    struct stream;
+
+    int next_mapped(std::string_view &chunk, std::size_t carry) noexcept;
+    int next_streamed(std::string_view &chunk, std::size_t carry) noexcept;
+
+    std::string_view m_chunk;
+    std::size_t m_chunk_size{};
+    bool m_mapped{};
+    mapped_file m_file;
+    std::size_t m_offset{};
+    std::size_t m_released{}; // the pages in front of it were released
+    std::unique_ptr<stream> m_stream;
+};
+
+// Yields the lines of a file as views into the chunks, only a line crossing two streamed chunks is
+// copied. The newlines are found 64 bytes at a time by field_splitter.
+class line_reader {
+   public:
+    int open(
+        const std::string &file_name,
+        read_mode mode = read_mode::automatic,
+        std::size_t chunk_size = chunk_reader::default_chunk_size) noexcept;
+    void close() noexcept;
+
+    // Returns 1 with the next line without the '\n', 0 at the end of the file, -1 on an error. The
+    // line stays valid until the next call.
+    int next(std::string_view &line) noexcept;
+   private:
+    chunk_reader m_chunks;
+    std::string_view m_chunk;
+    field_splitter m_splitter{nullptr, 0, "\n"};
+    std::size_t m_base{}; // offset of the splitter in m_chunk, the carry was scanned already
+    std::size_t m_line{}; // start of the next line in m_chunk
+    bool m_end{true};
+};
+
+} // namespace kon
+#endif // line_reader.hpp
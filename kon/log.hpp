@@ -1,45 +1,56 @@
 #ifndef LOG_64B080C0_927C_4ABA_ABAF_AF90D4715D49
 #define LOG_64B080C0_927C_4ABA_ABAF_AF90D4715D49
+#include <algorithm>
 #include <fmt/base.h>
+#include <kon/hexdump.hpp>
 
 namespace kon {
-extern const char base16_encode_lut2[512];
-
 struct mem_view {
     const void* va;
     std::size_t size;
 };
 } // namespace kon
 
+// "{}": hex only, "{:o}": with the offset column, "{:a}": with the ascii column, "{:oa}": both.
 template <>
 struct fmt::formatter<kon::mem_view> {
     constexpr auto parse(fmt::format_parse_context& ctx) {
-        return ctx.begin();
+        auto it = ctx.begin();
+        for (; (it != ctx.end()) && (*it != '}'); ++it) {
+            if (*it == 'o') {
+                options.offset = true;
+            } else if (*it == 'a') {
+                options.ascii = true;
+            } else {
+                fmt::report_error("invalid mem_view format specifier");
+            }
+        }
+        return it;
     }
 
     template <typename FormatContext>
     auto format(const kon::mem_view& mem, FormatContext& ctx) const {
+        // Whole lines are formatted into a contiguous buffer, and copied out in one go.
+        constexpr std::size_t chunk_bytes = kon::hexdump_line_bytes * 16;
+        char buffer[kon::hexdump_size(chunk_bytes, {true, true})];
+
         auto data = static_cast<const unsigned char*>(mem.va);
-        auto data_end = data + mem.size;
         auto out = ctx.out();
-        std::size_t line_count = 0;
-        for (; data < data_end; data++) {
-            if (line_count < 32u) {
-                if ((line_count != 0) && (line_count & 3) == 0) {
-                    *out++ = ' ';
-                }
-            } else {
+        for (std::size_t offset = 0; offset < mem.size; offset += chunk_bytes) {
+            if (offset != 0) {
                 *out++ = '\n';
-                line_count = 0;
             }
-            const char* encode_pair = &kon::base16_encode_lut2[*data << 1];
-            *out++ = encode_pair[0];
-            *out++ = encode_pair[1];
-
-            line_count++;
+            std::size_t size = mem.size - offset;
+            if (size > chunk_bytes) {
+                size = chunk_bytes;
+            }
+            std::size_t length = kon::hexdump(data + offset, size, buffer, options, offset);
+            out = std::copy(buffer, buffer + length, out);
         }
         return out;
     }
+
+    kon::hexdump_options options{};
 };
 
-#endif // log.hpp
\ No newline at end of file
+#endif // log.hpp
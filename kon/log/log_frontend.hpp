@@ -6,7 +6,9 @@
 #define LOG_FRONTEND_E7EDAB0E_F47C_4242_B71B_2EFD24A68056
 #include <fmt/base.h>
 #include <fmt/format.h>
+#include <kon/arena.hpp>
 #include <kon/chrono/time_format.hpp>
+#include <kon/scope.hpp>
 
 namespace kon {
 enum class log_level : unsigned {
@@ -59,7 +61,13 @@ struct logger {
 
     template <typename... T>
     void print(fmt::format_string<T...> fmt, T&&... args) {
-        auto buffer = fmt::memory_buffer();
+        // The long messages grow into the arena of the thread instead of the heap.
+        auto point = tls_format_arena.mark();
+        // Rewinds on a throwing formatter too, or the buffer stays below every later marker.
+        scope_exit rewind{[&point]() noexcept { tls_format_arena.rewind(point); }};
+        using allocator = arena_allocator<char>;
+        fmt::basic_memory_buffer<char, fmt::inline_buffer_size, allocator> buffer{
+            allocator{tls_format_arena}};
         fmt::vargs<T...> va = {{args...}};
         fmt::detail::vformat_to(buffer, fmt, va);
         m_sink_if->write_all(m_sink, {buffer.data(), buffer.size()});
@@ -79,6 +87,7 @@ struct logger {
 
     inline static thread_local std::string tls_prefix{};
     inline static thread_local kon::ymd_hms_format_context ymd_hms_context{};
+    inline static thread_local kon::arena tls_format_arena{16 * 1024};
    private:
     log_level m_log_level{log_level::none};
 
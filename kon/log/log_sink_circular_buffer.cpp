@@ -19,13 +19,13 @@ int log_sink_circular_buffer::initialize(std::size_t capacity) {
 }
 
 void log_sink_circular_buffer::reset() {
-    std::unique_lock<std::mutex> lock{m_lock};
+    std::unique_lock<adaptive_mutex> lock{m_lock};
     m_offset = 0;
     m_round = 0;
 }
 
 void log_sink_circular_buffer::get_tail(std::size_t size, tail_space &space) {
-    std::unique_lock<std::mutex> lock{m_lock};
+    std::unique_lock<adaptive_mutex> lock{m_lock};
     if (m_round > 0) {
         if (size > m_capacity) {
             size = m_capacity;
@@ -87,7 +87,7 @@ std::size_t log_sink_circular_buffer::tail_space::read_slice(
 
 int log_sink_circular_buffer::write_all(void *v_self, std::string_view input) {
     auto self = static_cast<log_sink_circular_buffer *>(v_self);
-    std::unique_lock<std::mutex> lock{self->m_lock};
+    std::unique_lock<adaptive_mutex> lock{self->m_lock};
 
     std::size_t buffer_remain = self->m_capacity - self->m_offset;
     std::size_t input_remain = input.size();
@@ -123,7 +123,7 @@ int log_sink_circular_buffer::write_all(void *v_self, std::string_view input) {
 }
 
 int log_sink_circular_buffer::validate() noexcept {
-    std::unique_lock<std::mutex> lock{m_lock};
+    std::unique_lock<adaptive_mutex> lock{m_lock};
     if (m_offset >= m_capacity) {
         return -1;
     }
@@ -5,6 +5,7 @@
 #ifndef LOG_SINK_CIRCULAR_BUFFER_DC4636C7_6068_47ED_91CB_91413C2DA4C7
 #define LOG_SINK_CIRCULAR_BUFFER_DC4636C7_6068_47ED_91CB_91413C2DA4C7
 #include <mutex>
+#include <kon/adaptive_mutex.hpp>
 #include <kon/log/log_frontend.hpp>
 
 namespace kon {
@@ -14,7 +15,7 @@ struct log_sink_circular_buffer {
     std::size_t m_capacity{};
     std::size_t m_offset{};
     std::size_t m_round{};
-    std::mutex m_lock;
+    adaptive_mutex m_lock;
 
     static constexpr std::string_view buffer_guard_data{"01234567"};
 
@@ -32,7 +32,7 @@ int log_sink_file::initialize(
 
 int log_sink_file::write_all(void *v_self, std::string_view data) {
     auto self = static_cast<log_sink_file *>(v_self);
-    std::unique_lock<std::mutex> lock{self->m_lock};
+    std::unique_lock<adaptive_mutex> lock{self->m_lock};
     if (self->m_file == nullptr) {
         return -1;
     }
@@ -51,7 +51,7 @@ int log_sink_file::write_all(void *v_self, std::string_view data) {
 
 int log_sink_file::flush_all(void *v_self) {
     auto self = static_cast<log_sink_file *>(v_self);
-    std::unique_lock<std::mutex> lock{self->m_lock};
+    std::unique_lock<adaptive_mutex> lock{self->m_lock};
     if (self->m_file == nullptr) {
         return -1;
     }
@@ -60,7 +60,7 @@ int log_sink_file::flush_all(void *v_self) {
 
 int log_sink_file::sync_all(void *v_self) {
     auto self = static_cast<log_sink_file *>(v_self);
-    std::unique_lock<std::mutex> lock{self->m_lock};
+    std::unique_lock<adaptive_mutex> lock{self->m_lock};
     if (self->m_file == nullptr) {
         return -1;
     }
@@ -69,7 +69,7 @@ int log_sink_file::sync_all(void *v_self) {
 
 int log_sink_file::clear_all(void *v_self) {
     auto self = static_cast<log_sink_file *>(v_self);
-    std::unique_lock<std::mutex> lock{self->m_lock};
+    std::unique_lock<adaptive_mutex> lock{self->m_lock};
     if (self->m_file == nullptr) {
         return -1;
     }
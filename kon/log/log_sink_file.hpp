@@ -6,6 +6,7 @@
 #define LOG_SINK_FILE_F841EE79_69D9_493A_B994_CF9707301A90
 #include <filesystem>
 #include <mutex>
+#include <kon/adaptive_mutex.hpp>
 #include <kon/log/log_frontend.hpp>
 
 namespace kon {
@@ -37,7 +38,7 @@ struct log_sink_file {
     std::filesystem::path m_filename;
     std::size_t m_file_size{};
     std::size_t m_file_size_limit{};
-    std::mutex m_lock;
+    adaptive_mutex m_lock;
 };
 
 } // namespace kon
@@ -0,0 +1,279 @@
+// SPDX-FileCopyrightText: 2026 TypeCombinator <typecombinator@foxmail.com>
+//
+// SPDX-License-Identifier: BSD 3-Clause
+
+#include <kon/mapped_file.hpp>
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace kon {
+namespace {
+constexpr std::size_t huge_page_size = 2 * 1024 * 1024;
+
+std::size_t page_size() noexcept {
+    static const std::size_t size = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+    return size;
+}
+
+std::size_t page_align(std::size_t size) noexcept {
+    return (size + (page_size() - 1)) & ~(page_size() - 1);
+}
+
+// Inaccessible address space, aligned to the huge pages if asked.
+char *reserve_address(std::size_t size, bool huge_pages) noexcept {
+    std::size_t alignment = huge_pages ? huge_page_size : page_size();
+    std::size_t len = size + alignment - page_size();
+    void *p = ::mmap(nullptr, len, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+    if (p == MAP_FAILED) {
+        return nullptr;
+    }
+    auto begin = reinterpret_cast<std::uintptr_t>(p);
+    auto aligned = (begin + alignment - 1) & ~(alignment - 1);
+    if (aligned != begin) {
+        ::munmap(p, aligned - begin);
+    }
+    std::size_t tail = (begin + len) - (aligned + size);
+    if (tail != 0) {
+        ::munmap(reinterpret_cast<char *>(aligned + size), tail);
+    }
+    return reinterpret_cast<char *>(aligned);
+}
+
+int to_madvise(file_advice advice) noexcept {
+    switch (advice) {
+    case file_advice::sequential:
+        return MADV_SEQUENTIAL;
+    case file_advice::random:
+        return MADV_RANDOM;
+    default:
+        return MADV_NORMAL;
+    }
+}
+} // namespace
+
+mapped_file::mapped_file(
+    int &err,
+    const std::string &file_name,
+    const mapped_file_options &options) noexcept
+    : mapped_file() {
+    int flags = options.writable ? (O_RDWR | O_CREAT) : O_RDONLY;
+    int fd = ::open(file_name.c_str(), flags | O_CLOEXEC, 0644);
+    if (fd < 0) {
+        err = -1;
+        return;
+    }
+    err = map(fd, options);
+    if (err != 0) {
+        ::close(fd);
+    }
+}
+
+mapped_file::mapped_file(int &err, int fd, const mapped_file_options &options) noexcept
+    : mapped_file() {
+    int dup_fd = ::fcntl(fd, F_DUPFD_CLOEXEC, 0);
+    if (dup_fd < 0) {
+        err = -1;
+        return;
+    }
+    err = map(dup_fd, options);
+    if (err != 0) {
+        ::close(dup_fd);
+    }
+}
+
+mapped_file::~mapped_file() noexcept {
+    release();
+}
+
+int mapped_file::map(int fd, const mapped_file_options &options) noexcept {
+    struct stat st;
+    if (::fstat(fd, &st) != 0) {
+        return -2;
+    }
+    std::size_t size = static_cast<std::size_t>(st.st_size);
+    std::size_t mapped = page_align(size);
+    std::size_t reserved = std::max(mapped, page_align(options.reserve));
+    char *data = nullptr;
+    if (reserved != 0) {
+        data = reserve_address(reserved, options.huge_pages);
+        if (data == nullptr) {
+            return -3;
+        }
+    }
+    if (mapped != 0) {
+        int prot = options.writable ? (PROT_READ | PROT_WRITE) : PROT_READ;
+        int flags = (options.writable ? MAP_SHARED : MAP_PRIVATE) | MAP_FIXED;
+        if (options.populate) {
+            flags |= MAP_POPULATE;
+        }
+        if (::mmap(data, mapped, prot, flags, fd, 0) == MAP_FAILED) {
+            ::munmap(data, reserved);
+            return -3;
+        }
+    }
+    if (data != nullptr) {
+        if (options.advice != file_advice::normal) {
+            ::madvise(data, reserved, to_madvise(options.advice));
+        }
+#if defined(MADV_HUGEPAGE)
+        if (options.huge_pages) {
+            ::madvise(data, reserved, MADV_HUGEPAGE);
+        }
+#endif
+    }
+    m_fd = fd;
+    m_data = data;
+    m_size = size;
+    m_mapped = mapped;
+    m_reserved = reserved;
+    m_writable = options.writable;
+    m_huge_pages = options.huge_pages;
+    return 0;
+}
+
+void mapped_file::release() noexcept {
+    if (m_data != nullptr) {
+        ::munmap(m_data, m_reserved);
+        m_data = nullptr;
+    }
+    if (m_fd >= 0) {
+        ::close(m_fd);
+        m_fd = -1;
+    }
+    m_size = 0;
+    m_mapped = 0;
+    m_reserved = 0;
+}
+
+int mapped_file::resize(std::size_t size) noexcept {
+    if ((m_fd < 0) || !m_writable) {
+        return -1;
+    }
+    if (::ftruncate(m_fd, static_cast<off_t>(size)) != 0) {
+        return -2;
+    }
+    std::size_t mapped = page_align(size);
+    if (mapped > m_reserved) {
+        // Move to a reservation twice as large, the old mapping is dropped as a whole.
+        std::size_t reserved = std::max(mapped, m_reserved * 2);
+        char *data = reserve_address(reserved, m_huge_pages);
+        if (data == nullptr) {
+            return -3;
+        }
+        if (::mmap(data, mapped, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, m_fd, 0) ==
+            MAP_FAILED) {
+            ::munmap(data, reserved);
+            return -3;
+        }
+#if defined(MADV_HUGEPAGE)
+        if (m_huge_pages) {
+            ::madvise(data, reserved, MADV_HUGEPAGE);
+        }
+#endif
+        if (m_data != nullptr) {
+            ::munmap(m_data, m_reserved);
+        }
+        m_data = data;
+        m_reserved = reserved;
+    } else if (mapped > m_mapped) {
+        if (::mmap(
+                m_data + m_mapped,
+                mapped - m_mapped,
+                PROT_READ | PROT_WRITE,
+                MAP_SHARED | MAP_FIXED,
+                m_fd,
+                static_cast<off_t>(m_mapped)) == MAP_FAILED) {
+            return -3;
+        }
+    } else if (mapped < m_mapped) {
+        // Give the truncated pages back to the reservation.
+        if (::mmap(
+                m_data + mapped,
+                m_mapped - mapped,
+                PROT_NONE,
+                MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE | MAP_FIXED,
+                -1,
+                0) == MAP_FAILED) {
+            return -3;
+        }
+    }
+    m_mapped = mapped;
+    m_size = size;
+    return 0;
+}
+
+int mapped_file::write(std::size_t offset, const void *data, std::size_t size) noexcept {
+    if ((m_fd < 0) || !m_writable) {
+        return -1;
+    }
+    if ((offset + size) > m_size) {
+        int ret = resize(offset + size);
+        if (ret != 0) {
+            return ret;
+        }
+    }
+    if (size != 0) {
+        std::memcpy(m_data + offset, data, size);
+    }
+    return 0;
+}
+
+void mapped_file::prefetch(std::size_t offset, std::size_t size) noexcept {
+    if (offset >= m_size) {
+        return;
+    }
+    size = std::min(size, m_size - offset);
+    std::size_t start = offset & ~(page_size() - 1);
+    ::madvise(m_data + start, size + (offset - start), MADV_WILLNEED);
+}
+
+void mapped_file::populate(std::size_t offset, std::size_t size) noexcept {
+    if (offset >= m_size) {
+        return;
+    }
+    size = std::min(size, m_size - offset);
+    std::size_t start = offset & ~(page_size() - 1);
+#if defined(MADV_POPULATE_READ)
+    int advice = m_writable ? MADV_POPULATE_WRITE : MADV_POPULATE_READ;
+    if (::madvise(m_data + start, size + (offset - start), advice) == 0) {
+        return;
+    }
+#endif
+    // Older kernels, touch one byte of every page.
+    for (std::size_t i = start; i < (offset + size); i += page_size()) {
+        static_cast<void>(*static_cast<volatile char *>(m_data + i));
+    }
+}
+
+void mapped_file::release(std::size_t offset, std::size_t size) noexcept {
+    if (offset >= m_size) {
+        return;
+    }
+    std::size_t end = std::min(size, m_size - offset) + offset;
+    std::size_t start = offset & ~(page_size() - 1);
+    // The last page is kept unless the range runs to the end of the file.
+    end = (end == m_size) ? page_align(end) : (end & ~(page_size() - 1));
+    if (end > start) {
+        ::madvise(m_data + start, end - start, MADV_DONTNEED);
+    }
+}
+
+void mapped_file::advise(file_advice advice) noexcept {
+    if (m_data != nullptr) {
+        ::madvise(m_data, m_reserved, to_madvise(advice));
+    }
+}
+
+int mapped_file::sync() noexcept {
+    if ((m_data == nullptr) || !m_writable) {
+        return 0;
+    }
+    return ::msync(m_data, m_mapped, MS_SYNC);
+}
+
+} // namespace kon
@@ -0,0 +1,127 @@
+// SPDX-FileCopyrightText: 2026 TypeCombinator <typecombinator@foxmail.com>
+//
+// SPDX-License-Identifier: BSD 3-Clause
+
+#ifndef MAPPED_FILE_D0FDF04A_2141_4EF1_AB10_CB03B4B8A85E
+#define MAPPED_FILE_D0FDF04A_2141_4EF1_AB10_CB03B4B8A85E
+#include <cstddef>
+#include <string>
+#include <utility>
+
+namespace kon {
+
+enum class file_advice {
+    normal,
+    sequential, // aggressive read-ahead, the pages are dropped soon after they are read
+    random,     // no read-ahead
+};
+
+struct mapped_file_options {
+    bool writable = false;   // shared read-write mapping, the file is created if it doesn't exist
+    bool populate = false;   // prefault the whole file at the mapping (MAP_POPULATE)
+    bool huge_pages = false; // 2 MiB aligned address and MADV_HUGEPAGE
+    file_advice advice = file_advice::normal;
+    std::size_t reserve = 0; // address space kept for resize() without moving the data
+};
+
+// A file mapped into memory, the mapping is followed by an inaccessible reservation which the file
+// grows into.
+class mapped_file {
+   public:
+    mapped_file() noexcept {
+        m_fd = -1;
+        m_data = nullptr;
+        m_size = 0;
+        m_mapped = 0;
+        m_reserved = 0;
+        m_writable = false;
+        m_huge_pages = false;
+    }
+
+    mapped_file(
+        int &err,
+        const std::string &file_name,
+        const mapped_file_options &options = {}) noexcept;
+    // The descriptor is duplicated, the caller still owns fd.
+    mapped_file(int &err, int fd, const mapped_file_options &options = {}) noexcept;
+    ~mapped_file() noexcept;
+
+    mapped_file(const mapped_file &) = delete;
+    mapped_file &operator=(const mapped_file &) = delete;
+
+    mapped_file(mapped_file &&other) noexcept {
+        move_from(std::move(other));
+    }
+
+    mapped_file &operator=(mapped_file &&other) noexcept {
+        if (this != &other) {
+            release();
+            move_from(std::move(other));
+        }
+        return *this;
+    }
+
+    explicit operator bool() const noexcept {
+        return m_fd >= 0;
+    }
+
+    // nullptr for an empty file without reservation.
+    char *data() noexcept {
+        return m_data;
+    }
+
+    const char *data() const noexcept {
+        return m_data;
+    }
+
+    std::size_t size() const noexcept {
+        return m_size;
+    }
+
+    // Changes the size of a writable file, the data moves only when the size exceeds the
+    // reservation, which then doubles.
+    int resize(std::size_t size) noexcept;
+    // Copies data at offset, the file grows if it's too small. -1 if it isn't writable.
+    int write(std::size_t offset, const void *data, std::size_t size) noexcept;
+
+    // Starts reading the range ahead asynchronously (MADV_WILLNEED).
+    void prefetch(std::size_t offset, std::size_t size) noexcept;
+    // Maps the pages of the range in one call, so that they don't fault one by one.
+    void populate(std::size_t offset, std::size_t size) noexcept;
+    // Drops the pages of the range which hold no byte past it from the memory (MADV_DONTNEED),
+    // the page of offset included. They are read from the file again if they are touched.
+    void release(std::size_t offset, std::size_t size) noexcept;
+    void advise(file_advice advice) noexcept;
+
+    int sync() noexcept;
+   private:
+    int map(int fd, const mapped_file_options &options) noexcept;
+    void release() noexcept;
+
+    void move_from(mapped_file &&other) noexcept {
+        m_fd = other.m_fd;
+        m_data = other.m_data;
+        m_size = other.m_size;
+        m_mapped = other.m_mapped;
+        m_reserved = other.m_reserved;
+        m_writable = other.m_writable;
+        m_huge_pages = other.m_huge_pages;
+
+        other.m_fd = -1;
+        other.m_data = nullptr;
+        other.m_size = 0;
+        other.m_mapped = 0;
+        other.m_reserved = 0;
+    }
+
+    int m_fd;
+    char *m_data;
+    std::size_t m_size;     // size of the file
+    std::size_t m_mapped;   // mapped bytes of the file, page aligned
+    std::size_t m_reserved; // address space from m_data, the mapping included
+    bool m_writable;
+    bool m_huge_pages;
+};
+
+} // namespace kon
+#endif // mapped_file.hpp
@@ -0,0 +1,179 @@
+// SPDX-FileCopyrightText: 2026 TypeCombinator <typecombinator@foxmail.com>
+//
+// SPDX-License-Identifier: BSD 3-Clause
+
+#ifndef MPMC_QUEUE_48A891DD_887E_40D2_84DB_CDDDB1CA5933
+#define MPMC_QUEUE_48A891DD_887E_40D2_84DB_CDDDB1CA5933
+#include <kon/xt/attributes.hpp>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+namespace kon {
+
+// A lock-free multiple producers multiple consumers queue of N fixed-size objects (Vyukov's
+// bounded queue). Every slot has a sequence number telling which round may use it next, a
+// producer claims a position by a CAS on the tail and waits for nobody, a consumer the same on
+// the head. A claimed slot is published by its sequence, so a preempted producer delays the
+// consumer of its slot only.
+template <typename T, std::size_t N>
+class mpmc_queue {
+    static_assert(std::is_trivially_copyable_v<T>);
+    static_assert((N >= 2) && ((N & (N - 1)) == 0), "N must be a power of 2");
+   public:
+    using value_type = T;
+
+    mpmc_queue() noexcept {
+        for (std::size_t i = 0; i < N; i++) {
+            m_cells[i].seq.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    KON_DISALLOW_COPY(mpmc_queue);
+    KON_DISALLOW_MOVE(mpmc_queue);
+
+    bool try_push(const T &value) noexcept {
+        std::size_t pos = m_tail.load(std::memory_order_relaxed);
+        cell *c;
+        while (true) {
+            c = &m_cells[pos & mask];
+            auto diff = static_cast<std::intptr_t>(c->seq.load(std::memory_order_acquire) - pos);
+            if (diff == 0) {
+                if (m_tail.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (diff < 0) {
+                return false; // The slot of the last round isn't popped yet.
+            } else {
+                pos = m_tail.load(std::memory_order_relaxed);
+            }
+        }
+        std::memcpy(c->bytes, &value, sizeof(T));
+        c->seq.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Claims up to count consecutive free slots with a single CAS, returns the number pushed.
+    std::size_t try_push_bulk(const T *values, std::size_t count) noexcept {
+        if (count == 0) {
+            return 0;
+        }
+        std::size_t pos = m_tail.load(std::memory_order_relaxed);
+        std::size_t claimed;
+        while (true) {
+            claimed = 0;
+            while ((claimed < count) &&
+                   (m_cells[(pos + claimed) & mask].seq.load(std::memory_order_acquire) ==
+                    (pos + claimed))) {
+                claimed++;
+            }
+            if (claimed == 0) {
+                auto seq = m_cells[pos & mask].seq.load(std::memory_order_relaxed);
+                if (static_cast<std::intptr_t>(seq - pos) < 0) {
+                    return 0;
+                }
+                pos = m_tail.load(std::memory_order_relaxed);
+                continue;
+            }
+            if (m_tail.compare_exchange_weak(pos, pos + claimed, std::memory_order_relaxed)) {
+                break;
+            }
+        }
+        for (std::size_t i = 0; i < claimed; i++) {
+            cell &c = m_cells[(pos + i) & mask];
+            std::memcpy(c.bytes, values + i, sizeof(T));
+            c.seq.store(pos + i + 1, std::memory_order_release);
+        }
+        return claimed;
+    }
+
+    bool try_pop(T &value) noexcept {
+        std::size_t pos = m_head.load(std::memory_order_relaxed);
+        cell *c;
+        while (true) {
+            c = &m_cells[pos & mask];
+            auto seq = c->seq.load(std::memory_order_acquire);
+            auto diff = static_cast<std::intptr_t>(seq - (pos + 1));
+            if (diff == 0) {
+                if (m_head.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (diff < 0) {
+                return false; // Not pushed yet.
+            } else {
+                pos = m_head.load(std::memory_order_relaxed);
+            }
+        }
+        std::memcpy(&value, c->bytes, sizeof(T));
+        c->seq.store(pos + N, std::memory_order_release);
+        return true;
+    }
+
+    // Claims up to count consecutive pushed slots with a single CAS, returns the number popped.
+    std::size_t try_pop_bulk(T *values, std::size_t count) noexcept {
+        if (count == 0) {
+            return 0;
+        }
+        std::size_t pos = m_head.load(std::memory_order_relaxed);
+        std::size_t claimed;
+        while (true) {
+            claimed = 0;
+            while ((claimed < count) &&
+                   (m_cells[(pos + claimed) & mask].seq.load(std::memory_order_acquire) ==
+                    (pos + claimed + 1))) {
+                claimed++;
+            }
+            if (claimed == 0) {
+                auto seq = m_cells[pos & mask].seq.load(std::memory_order_relaxed);
+                if (static_cast<std::intptr_t>(seq - (pos + 1)) < 0) {
+                    return 0;
+                }
+                pos = m_head.load(std::memory_order_relaxed);
+                continue;
+            }
+            if (m_head.compare_exchange_weak(pos, pos + claimed, std::memory_order_relaxed)) {
+                break;
+            }
+        }
+        for (std::size_t i = 0; i < claimed; i++) {
+            cell &c = m_cells[(pos + i) & mask];
+            std::memcpy(values + i, c.bytes, sizeof(T));
+            c.seq.store(pos + i + N, std::memory_order_release);
+        }
+        return claimed;
+    }
+
+    // A snapshot, the claimed slots are counted.
+    [[nodiscard]]
+    std::size_t size() const noexcept {
+        std::size_t head = m_head.load(std::memory_order_acquire);
+        std::size_t tail = m_tail.load(std::memory_order_acquire);
+        return (tail > head) ? (tail - head) : 0;
+    }
+
+    [[nodiscard]]
+    bool empty() const noexcept {
+        return size() == 0;
+    }
+
+    [[nodiscard]]
+    static constexpr std::size_t capacity() noexcept {
+        return N;
+    }
+   private:
+    static constexpr std::size_t mask = N - 1;
+
+    struct cell {
+        std::atomic<std::size_t> seq;
+        alignas(T) unsigned char bytes[sizeof(T)];
+    };
+
+    alignas(64) std::atomic<std::size_t> m_tail{0};
+    alignas(64) std::atomic<std::size_t> m_head{0};
+    alignas(64) cell m_cells[N];
+};
+
+} // namespace kon
+#endif // mpmc_queue.hpp
@@ -0,0 +1,433 @@
+// SPDX-FileCopyrightText: 2026 TypeCombinator <typecombinator@foxmail.com>
+//
+// SPDX-License-Identifier: BSD 3-Clause
+
+#include <kon/pool.hpp>
+#include <kon/bit.hpp>
+#include <kon/xt/pause.hpp>
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstring>
+#include <fcntl.h>
+#include <mutex>
+#include <new>
+#include <sys/mman.h>
+#include <thread>
+#include <unistd.h>
+
+namespace kon {
+namespace {
+static_assert(pool::max_thread_slots == 64);
+std::atomic<std::uint64_t> thread_slots{0};
+// The live pools, guarded by the mutex.
+std::mutex pools_mutex;
+pool *pools_head = nullptr;
+// The ring indexes are 32 bits.
+constexpr std::size_t max_count = std::size_t{1} << 31;
+
+// Waits for the earlier producers / consumers to publish their part.
+void wait_for(const std::atomic<std::uint32_t> &tail, std::uint32_t value) noexcept {
+    unsigned spins = 0;
+    while (tail.load(std::memory_order_acquire) != value) {
+        if (++spins < 64) {
+            rt::pause();
+        } else {
+            std::this_thread::yield();
+        }
+    }
+}
+
+struct thread_slot_holder {
+    int slot{-1};
+
+    ~thread_slot_holder() noexcept {
+        if (slot >= 0) {
+            detail::tls_thread_slot = -1; // For the later destructors of the thread.
+            detail::release_thread_slot(slot);
+        }
+    }
+};
+
+thread_local thread_slot_holder tls_slot_holder;
+} // namespace
+
+namespace detail {
+int acquire_thread_slot() noexcept {
+    int slot = -1;
+    auto slots = thread_slots.load(std::memory_order_relaxed);
+    while (~slots != 0) {
+        int free_slot = countr_zero(~slots);
+        if (thread_slots.compare_exchange_weak(
+                slots,
+                slots | (std::uint64_t{1} << free_slot),
+                std::memory_order_acquire,
+                std::memory_order_relaxed)) {
+            slot = free_slot;
+            break;
+        }
+    }
+    tls_slot_holder.slot = slot;
+    tls_thread_slot = slot;
+    return slot;
+}
+
+void release_thread_slot(int slot) noexcept {
+    {
+        std::lock_guard lock{pools_mutex};
+        for (auto p = pools_head; p != nullptr; p = p->m_next) {
+            p->flush_cache(slot);
+        }
+    }
+    thread_slots.fetch_and(~(std::uint64_t{1} << slot), std::memory_order_release);
+}
+} // namespace detail
+
+pool::pool(
+    int &err,
+    std::uint32_t element_size,
+    std::size_t count,
+    const pool_options &options) noexcept {
+    std::size_t alignment = options.alignment;
+    if ((element_size == 0) || (count == 0) || (count > max_count) || (alignment == 0) ||
+        ((alignment & (alignment - 1)) != 0)) {
+        err = -2;
+        return;
+    }
+    m_stride = (element_size + alignment - 1) & ~(alignment - 1);
+    m_element_size = element_size;
+    m_headroom = options.headroom;
+    if (options.huge_pages) {
+        err = init_huge_pages(count, options.physical_iova);
+        if (err != 0) {
+            return;
+        }
+    } else {
+        m_heap = static_cast<std::uint8_t *>(
+            ::operator new(m_stride * count, std::align_val_t{alignment}, std::nothrow));
+        if (m_heap == nullptr) {
+            err = -1;
+            return;
+        }
+        m_heap_size = m_stride * count;
+        m_heap_alignment = alignment;
+        m_va = m_heap;
+        m_iova = reinterpret_cast<std::uintptr_t>(m_heap);
+        m_count = count;
+    }
+    err = init_free();
+}
+
+pool::pool(
+    int &err,
+    std::uint8_t *va,
+    std::uintptr_t iova,
+    std::size_t size,
+    std::uint32_t element_size,
+    const pool_options &options) noexcept {
+    std::size_t alignment = options.alignment;
+    if ((element_size == 0) || (alignment == 0) || ((alignment & (alignment - 1)) != 0)) {
+        err = -2;
+        return;
+    }
+    // The first element is aligned in the virtual and the io address spaces.
+    auto skip = ((iova + alignment - 1) & ~(alignment - 1)) - iova;
+    m_stride = (element_size + alignment - 1) & ~(alignment - 1);
+    if ((skip > size) || (((size - skip) / m_stride) == 0)) {
+        err = -2;
+        return;
+    }
+    m_va = va + skip;
+    m_iova = iova + skip;
+    m_element_size = element_size;
+    m_headroom = options.headroom;
+    m_count = std::min((size - skip) / m_stride, max_count);
+    err = init_free();
+}
+
+pool::~pool() noexcept {
+    if (m_caches != nullptr) {
+        std::lock_guard lock{pools_mutex};
+        if (pools_head == this) {
+            pools_head = m_next;
+        } else if (m_prev != nullptr) {
+            m_prev->m_next = m_next;
+        }
+        if (m_next != nullptr) {
+            m_next->m_prev = m_prev;
+        }
+    }
+    delete[] m_free.slots;
+    delete[] m_page_iovas;
+    if (m_caches != nullptr) {
+        ::operator delete[](m_caches, std::align_val_t{alignof(thread_cache)});
+    }
+    if (m_heap != nullptr) {
+        if (m_heap_alignment != 0) {
+            ::operator delete(m_heap, std::align_val_t{m_heap_alignment});
+        } else {
+            ::munmap(m_heap, m_heap_size);
+        }
+    }
+}
+
+int pool::init_huge_pages(std::size_t count, bool physical_iova) noexcept {
+    if (m_stride > huge_page_size) {
+        return -2;
+    }
+    m_page_elements = huge_page_size / m_stride;
+    std::size_t pages = (count + m_page_elements - 1) / m_page_elements;
+    std::size_t size = pages * huge_page_size;
+
+    void *p = MAP_FAILED;
+#if defined(MAP_HUGETLB)
+    p = ::mmap(
+        nullptr,
+        size,
+        PROT_READ | PROT_WRITE,
+        MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB | MAP_POPULATE,
+        -1,
+        0);
+#endif
+    if (p == MAP_FAILED) {
+        // The transparent huge pages may move, so they have no stable physical address.
+        if (physical_iova) {
+            return -3;
+        }
+        std::size_t len = size + huge_page_size;
+        p = ::mmap(nullptr, len, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (p == MAP_FAILED) {
+            return -1;
+        }
+        auto begin = reinterpret_cast<std::uintptr_t>(p);
+        auto aligned = (begin + huge_page_size - 1) & ~(huge_page_size - 1);
+        if (aligned != begin) {
+            ::munmap(p, aligned - begin);
+        }
+        if ((begin + len) != (aligned + size)) {
+            ::munmap(reinterpret_cast<void *>(aligned + size), (begin + len) - (aligned + size));
+        }
+        p = reinterpret_cast<void *>(aligned);
+#if defined(MADV_HUGEPAGE)
+        ::madvise(p, size, MADV_HUGEPAGE);
+#endif
+    }
+    m_heap = static_cast<std::uint8_t *>(p);
+    m_heap_size = size;
+    m_va = m_heap;
+    m_iova = reinterpret_cast<std::uintptr_t>(m_heap);
+    m_count = count;
+    if (!physical_iova) {
+        return 0;
+    }
+
+    m_page_iovas = new (std::nothrow) std::uintptr_t[pages];
+    if (m_page_iovas == nullptr) {
+        return -1;
+    }
+    int fd = ::open("/proc/self/pagemap", O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        return -3;
+    }
+    auto page_size = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+    int ret = 0;
+    for (std::size_t i = 0; i < pages; i++) {
+        // Bits 0-54: the page frame number, bit 63: present. The frame number reads as 0 without
+        // CAP_SYS_ADMIN.
+        auto va = reinterpret_cast<std::uintptr_t>(m_heap + i * huge_page_size);
+        std::uint64_t entry;
+        auto offset = static_cast<off_t>((va / page_size) * sizeof(entry));
+        if (::pread(fd, &entry, sizeof(entry), offset) != sizeof(entry)) {
+            ret = -3;
+            break;
+        }
+        std::uint64_t frame = entry & ((std::uint64_t{1} << 55) - 1);
+        if (((entry >> 63) == 0) || (frame == 0)) {
+            ret = -3;
+            break;
+        }
+        m_page_iovas[i] = frame * page_size;
+    }
+    ::close(fd);
+    return ret;
+}
+
+int pool::init_free() noexcept {
+    std::size_t capacity = std::bit_ceil(m_count);
+    m_free.slots = new (std::nothrow) void *[capacity];
+    m_caches = static_cast<thread_cache *>(::operator new[](
+        sizeof(thread_cache) * max_thread_slots,
+        std::align_val_t{alignof(thread_cache)},
+        std::nothrow));
+    if ((m_free.slots == nullptr) || (m_caches == nullptr)) {
+        return -1;
+    }
+    for (std::size_t i = 0; i < max_thread_slots; i++) {
+        new (&m_caches[i].length) std::atomic<std::size_t>{0};
+    }
+    for (std::size_t i = 0; i < m_count; i++) {
+        if (m_page_elements != 0) {
+            auto page = i / m_page_elements;
+            auto index = i % m_page_elements;
+            m_free.slots[i] = m_va + page * huge_page_size + index * m_stride;
+        } else {
+            m_free.slots[i] = m_va + i * m_stride;
+        }
+    }
+    m_free.mask = static_cast<std::uint32_t>(capacity - 1);
+    m_free.prod_head.store(static_cast<std::uint32_t>(m_count), std::memory_order_relaxed);
+    m_free.prod_tail.store(static_cast<std::uint32_t>(m_count), std::memory_order_relaxed);
+
+    std::lock_guard lock{pools_mutex};
+    m_next = pools_head;
+    if (pools_head != nullptr) {
+        pools_head->m_prev = this;
+    }
+    pools_head = this;
+    return 0;
+}
+
+void pool::flush_cache(int slot) noexcept {
+    auto &cache = m_caches[slot];
+    auto length = cache.length.load(std::memory_order_relaxed);
+    if (length != 0) {
+        m_free.enqueue(cache.elements, static_cast<std::uint32_t>(length));
+        cache.length.store(0, std::memory_order_relaxed);
+    }
+}
+
+bool pool::free_ring::enqueue(void *const *elements, std::uint32_t n) noexcept {
+    std::uint32_t capacity = mask + 1;
+    std::uint32_t head = prod_head.load(std::memory_order_acquire);
+    do {
+        std::uint32_t free = capacity + cons_tail.load(std::memory_order_acquire) - head;
+        if (n > free) [[unlikely]] {
+            return false;
+        }
+    } while (!prod_head.compare_exchange_weak(
+        head, head + n, std::memory_order_acq_rel, std::memory_order_acquire));
+    for (std::uint32_t i = 0; i < n; i++) {
+        slots[(head + i) & mask] = elements[i];
+    }
+    wait_for(prod_tail, head);
+    prod_tail.store(head + n, std::memory_order_release);
+    return true;
+}
+
+std::uint32_t pool::free_ring::dequeue(void **elements, std::uint32_t n, bool burst) noexcept {
+    std::uint32_t head = cons_head.load(std::memory_order_acquire);
+    std::uint32_t count;
+    do {
+        std::uint32_t entries = prod_tail.load(std::memory_order_acquire) - head;
+        count = n;
+        if (count > entries) {
+            if (!burst || (entries == 0)) {
+                return 0;
+            }
+            count = entries;
+        }
+    } while (!cons_head.compare_exchange_weak(
+        head, head + count, std::memory_order_acq_rel, std::memory_order_acquire));
+    for (std::uint32_t i = 0; i < count; i++) {
+        elements[i] = slots[(head + i) & mask];
+    }
+    wait_for(cons_tail, head);
+    cons_tail.store(head + count, std::memory_order_release);
+    return count;
+}
+
+bool pool::get_bulk(void **elements, std::size_t n) noexcept {
+    int slot = thread_slot();
+    if ((slot >= 0) && (n <= cache_size)) {
+        auto &cache = m_caches[slot];
+        auto length = cache.length.load(std::memory_order_relaxed);
+        if (length < n) {
+            // Refill up to cache_size more than asked.
+            auto want = static_cast<std::uint32_t>(cache_size + n - length);
+            length += m_free.dequeue(cache.elements + length, want, true);
+            if (length < n) {
+                cache.length.store(length, std::memory_order_relaxed);
+                return false;
+            }
+        }
+        for (std::size_t i = 0; i < n; i++) {
+            elements[i] = cache.elements[--length];
+        }
+        cache.length.store(length, std::memory_order_relaxed);
+        return true;
+    }
+    if (n > m_count) {
+        return false;
+    }
+    if (m_free.dequeue(elements, static_cast<std::uint32_t>(n), false) == n) {
+        return true;
+    }
+    if ((slot < 0) || (m_caches[slot].length.load(std::memory_order_relaxed) == 0)) {
+        return false;
+    }
+    // Give the cache back and retry.
+    flush_cache(slot);
+    return m_free.dequeue(elements, static_cast<std::uint32_t>(n), false) == n;
+}
+
+void pool::put_bulk(void *const *elements, std::size_t n) noexcept {
+    int slot = thread_slot();
+    if ((slot >= 0) && (n <= cache_size)) {
+        auto &cache = m_caches[slot];
+        auto length = cache.length.load(std::memory_order_relaxed);
+        if ((length + n) > (cache_size * 2)) {
+            // Flush the oldest ones down to cache_size, the most recent ones are still hot.
+            std::size_t flush = length + n - cache_size;
+            m_free.enqueue(cache.elements, static_cast<std::uint32_t>(flush));
+            length -= flush;
+            std::memmove(cache.elements, cache.elements + flush, length * sizeof(void *));
+        }
+        for (std::size_t i = 0; i < n; i++) {
+            cache.elements[length++] = elements[i];
+        }
+        cache.length.store(length, std::memory_order_relaxed);
+        return;
+    }
+    m_free.enqueue(elements, static_cast<std::uint32_t>(n));
+}
+
+bool pool::get_bulk(dbuf *bufs, std::size_t n) noexcept {
+    void *elements[cache_size];
+    for (std::size_t done = 0; done < n;) {
+        std::size_t batch = std::min(n - done, cache_size);
+        if (!get_bulk(elements, batch)) {
+            put_bulk(bufs, done);
+            return false;
+        }
+        for (std::size_t i = 0; i < batch; i++) {
+            auto va = static_cast<std::uint8_t *>(elements[i]);
+            bufs[done + i].init(va, iova(va), m_headroom, m_element_size);
+        }
+        done += batch;
+    }
+    return true;
+}
+
+void pool::put_bulk(const dbuf *bufs, std::size_t n) noexcept {
+    void *elements[cache_size];
+    for (std::size_t done = 0; done < n;) {
+        std::size_t batch = std::min(n - done, cache_size);
+        for (std::size_t i = 0; i < batch; i++) {
+            elements[i] = bufs[done + i].va();
+        }
+        put_bulk(elements, batch);
+        done += batch;
+    }
+}
+
+std::size_t pool::available() const noexcept {
+    std::size_t n = m_free.size();
+    if (m_caches != nullptr) {
+        for (std::size_t i = 0; i < max_thread_slots; i++) {
+            n += m_caches[i].length.load(std::memory_order_relaxed);
+        }
+    }
+    return n;
+}
+
+} // namespace kon
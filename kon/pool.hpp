@@ -0,0 +1,202 @@
+// SPDX-FileCopyrightText: 2026 TypeCombinator <typecombinator@foxmail.com>
+//
+// SPDX-License-Identifier: BSD 3-Clause
+
+#ifndef POOL_7802A8AB_EDB3_42F2_ADEE_25BF8EA2D7EC
+#define POOL_7802A8AB_EDB3_42F2_ADEE_25BF8EA2D7EC
+#include <kon/dbuf.hpp>
+#include <kon/xt/attributes.hpp>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace kon {
+namespace detail {
+inline thread_local int tls_thread_slot = -2; // -2: not acquired yet
+int acquire_thread_slot() noexcept;
+// Flushes the caches of the slot in every live pool and frees the slot, at the thread exit.
+void release_thread_slot(int slot) noexcept;
+} // namespace detail
+
+// The slot of the calling thread in [0, 64), -1 if all the slots are taken. A slot is freed when
+// its thread exits.
+inline int thread_slot() noexcept {
+    int slot = detail::tls_thread_slot;
+    if (slot == -2) [[unlikely]] {
+        slot = detail::acquire_thread_slot();
+    }
+    return slot;
+}
+
+struct pool_options {
+    std::uint32_t headroom{0};
+    std::size_t alignment{64};
+    // The heap buffers are carved from 2 MB huge pages, the transparent ones if no hugetlbfs page
+    // is reserved. A buffer never crosses a huge page.
+    bool huge_pages{false};
+    // The iova is the physical address read from /proc/self/pagemap (CAP_SYS_ADMIN), it requires
+    // the hugetlbfs pages as they never move.
+    bool physical_iova{false};
+};
+
+// Fixed size buffers with a cache per thread, a thread gets and puts buffers in its cache and
+// moves them to / from the shared free ring in bulk. The free ring is a lock-free MPMC ring like
+// the rte_ring of DPDK.
+class pool {
+   public:
+    static constexpr std::size_t max_thread_slots = 64;
+    static constexpr std::size_t cache_size = 32;
+
+    pool() noexcept = default;
+    // count buffers of element_size bytes on the heap, the iova is the va unless asked otherwise.
+    pool(
+        int &err,
+        std::uint32_t element_size,
+        std::size_t count,
+        const pool_options &options = {}) noexcept;
+    // The buffers are carved from a borrowed region, e.g. the mapping of dev_mem or shm, the
+    // huge_pages and physical_iova options are ignored.
+    pool(
+        int &err,
+        std::uint8_t *va,
+        std::uintptr_t iova,
+        std::size_t size,
+        std::uint32_t element_size,
+        const pool_options &options = {}) noexcept;
+    ~pool() noexcept;
+
+    KON_DISALLOW_COPY(pool);
+    KON_DISALLOW_MOVE(pool);
+
+    // Returns nullptr when the pool is exhausted.
+    void *get() noexcept {
+        int slot = thread_slot();
+        if (slot >= 0) [[likely]] {
+            auto &cache = m_caches[slot];
+            auto length = cache.length.load(std::memory_order_relaxed);
+            if (length != 0) [[likely]] {
+                cache.length.store(length - 1, std::memory_order_relaxed);
+                return cache.elements[length - 1];
+            }
+        }
+        void *element;
+        return get_bulk(&element, 1) ? element : nullptr;
+    }
+
+    // Putting a buffer twice is UB.
+    void put(void *element) noexcept {
+        int slot = thread_slot();
+        if (slot >= 0) [[likely]] {
+            auto &cache = m_caches[slot];
+            auto length = cache.length.load(std::memory_order_relaxed);
+            if (length != (cache_size * 2)) [[likely]] {
+                cache.elements[length] = element;
+                cache.length.store(length + 1, std::memory_order_relaxed);
+                return;
+            }
+        }
+        put_bulk(&element, 1);
+    }
+
+    // All or nothing, false if there are fewer than n buffers left.
+    bool get_bulk(void **elements, std::size_t n) noexcept;
+    void put_bulk(void *const *elements, std::size_t n) noexcept;
+
+    // The dbuf is initialized with the headroom of the pool.
+    bool get(dbuf &buf) noexcept {
+        auto va = static_cast<std::uint8_t *>(get());
+        if (va == nullptr) [[unlikely]] {
+            return false;
+        }
+        buf.init(va, iova(va), m_headroom, m_element_size);
+        return true;
+    }
+
+    void put(const dbuf &buf) noexcept {
+        put(buf.va());
+    }
+
+    bool get_bulk(dbuf *bufs, std::size_t n) noexcept;
+    void put_bulk(const dbuf *bufs, std::size_t n) noexcept;
+
+    std::uintptr_t iova(const void *element) const noexcept {
+        std::size_t offset = static_cast<const std::uint8_t *>(element) - m_va;
+        if (m_page_iovas != nullptr) {
+            return m_page_iovas[offset >> huge_page_shift] + (offset & (huge_page_size - 1));
+        }
+        return m_iova + offset;
+    }
+
+    std::uint32_t element_size() const noexcept {
+        return m_element_size;
+    }
+
+    std::uint32_t headroom() const noexcept {
+        return m_headroom;
+    }
+
+    std::size_t count() const noexcept {
+        return m_count;
+    }
+
+    // The number of free buffers, the caches included. It's a snapshot with concurrent users.
+    std::size_t available() const noexcept;
+   private:
+    static constexpr unsigned huge_page_shift = 21;
+    static constexpr std::size_t huge_page_size = std::size_t{1} << huge_page_shift;
+
+    // Only the owner thread writes the length, available() reads it from the others.
+    struct alignas(64) thread_cache {
+        std::atomic<std::size_t> length{0};
+        void *elements[cache_size * 2];
+    };
+
+    // The producers and the consumers claim their range with a CAS on the head, then wait for the
+    // earlier ones to move the tail.
+    struct free_ring {
+        alignas(64) std::atomic<std::uint32_t> prod_head{0};
+        std::atomic<std::uint32_t> prod_tail{0};
+        alignas(64) std::atomic<std::uint32_t> cons_head{0};
+        std::atomic<std::uint32_t> cons_tail{0};
+        alignas(64) std::uint32_t mask{0};
+        void **slots{nullptr};
+
+        bool enqueue(void *const *elements, std::uint32_t n) noexcept;
+        // Up to n elements if burst, else n or nothing.
+        std::uint32_t dequeue(void **elements, std::uint32_t n, bool burst) noexcept;
+
+        std::uint32_t size() const noexcept {
+            return prod_tail.load(std::memory_order_relaxed) -
+                   cons_tail.load(std::memory_order_relaxed);
+        }
+    };
+
+    int init_huge_pages(std::size_t count, bool physical_iova) noexcept;
+    int init_free() noexcept;
+    void flush_cache(int slot) noexcept;
+
+    friend void detail::release_thread_slot(int slot) noexcept;
+
+    std::uint8_t *m_va{nullptr};
+    std::uintptr_t m_iova{0};
+    std::uintptr_t *m_page_iovas{nullptr}; // The physical address of every huge page.
+    std::size_t m_stride{0};
+    std::size_t m_page_elements{0}; // The elements of a huge page, 0 if it's not paged.
+    std::uint32_t m_element_size{0};
+    std::uint32_t m_headroom{0};
+    std::size_t m_count{0};
+    thread_cache *m_caches{nullptr};
+    free_ring m_free;
+
+    // The owned storage.
+    std::uint8_t *m_heap{nullptr};
+    std::size_t m_heap_size{0};
+    std::size_t m_heap_alignment{0}; // 0 if it's mapped.
+
+    // The live pools, the exiting threads flush their caches into them.
+    pool *m_prev{nullptr};
+    pool *m_next{nullptr};
+};
+
+} // namespace kon
+#endif // pool.hpp
@@ -0,0 +1,638 @@
+// SPDX-FileCopyrightText: 2026 TypeCombinator <typecombinator@foxmail.com>
+//
+// SPDX-License-Identifier: BSD 3-Clause
+
+#include <kon/dynamic_bitset.hpp>
+#include <kon/roaring.hpp>
+#include <kon/xt/cpu.hpp>
+#include <algorithm>
+#include <array>
+#include <cstring>
+#if defined(KON_ARCH_X86)
+    #include <immintrin.h>
+#endif
+
+namespace kon {
+namespace {
+using container = detail::roaring_container;
+using container_type = roaring_container_type;
+using bitmap_block = container::bitmap_block;
+
+constexpr std::size_t bitmap_words = 1024;
+
+std::size_t array_and_scalar(
+    const std::uint16_t *a,
+    std::size_t na,
+    const std::uint16_t *b,
+    std::size_t nb,
+    std::uint16_t *out) noexcept {
+    std::size_t count = 0;
+    std::size_t i = 0;
+    std::size_t j = 0;
+    while ((i < na) && (j < nb)) {
+        if (a[i] < b[j]) {
+            i++;
+        } else if (a[i] > b[j]) {
+            j++;
+        } else {
+            if (out != nullptr) {
+                out[count] = a[i];
+            }
+            count++;
+            i++;
+            j++;
+        }
+    }
+    return count;
+}
+
+#if defined(KON_ARCH_X86)
+// The pshufb masks moving the u16 lanes selected by the 8 bits to the front.
+constexpr auto array_and_shuffles = []() {
+    std::array<std::array<std::uint8_t, 16>, 256> masks{};
+    for (std::size_t r = 0; r < 256; r++) {
+        std::size_t k = 0;
+        for (std::uint8_t lane = 0; lane < 8; lane++) {
+            if ((r >> lane) & 1) {
+                masks[r][k++] = lane * 2;
+                masks[r][k++] = lane * 2 + 1;
+            }
+        }
+        while (k < 16) {
+            masks[r][k++] = 0x80;
+        }
+    }
+    return masks;
+}();
+
+// pcmpestrm compares 8 values of a with 8 values of b all at once, the block with the smaller
+// maximum moves on (Schlegel et al., also in CRoaring). out takes up to 8 values more than the
+// result, nullptr only counts.
+KON_ATTR_TARGET("sse4.2")
+std::size_t array_and_sse42(
+    const std::uint16_t *a,
+    std::size_t na,
+    const std::uint16_t *b,
+    std::size_t nb,
+    std::uint16_t *out) noexcept {
+    constexpr int mode = _SIDD_UWORD_OPS | _SIDD_CMP_EQUAL_ANY | _SIDD_BIT_MASK;
+    const std::size_t end_a = na & ~std::size_t{7};
+    const std::size_t end_b = nb & ~std::size_t{7};
+    std::size_t count = 0;
+    std::size_t i = 0;
+    std::size_t j = 0;
+    if ((end_a != 0) && (end_b != 0)) {
+        __m128i va = _mm_loadu_si128(reinterpret_cast<const __m128i *>(a));
+        __m128i vb = _mm_loadu_si128(reinterpret_cast<const __m128i *>(b));
+        while (true) {
+            __m128i mask = _mm_cmpestrm(vb, 8, va, 8, mode);
+            auto r = static_cast<unsigned>(_mm_cvtsi128_si32(mask));
+            if (out != nullptr) {
+                auto shuffle = reinterpret_cast<const __m128i *>(array_and_shuffles[r].data());
+                _mm_storeu_si128(
+                    reinterpret_cast<__m128i *>(out + count),
+                    _mm_shuffle_epi8(va, _mm_loadu_si128(shuffle)));
+            }
+            count += kon::popcount(r);
+            const std::uint16_t max_a = a[i + 7];
+            const std::uint16_t max_b = b[j + 7];
+            if (max_a <= max_b) {
+                i += 8;
+                if (i == end_a) {
+                    break;
+                }
+                va = _mm_loadu_si128(reinterpret_cast<const __m128i *>(a + i));
+            }
+            if (max_b <= max_a) {
+                j += 8;
+                if (j == end_b) {
+                    break;
+                }
+                vb = _mm_loadu_si128(reinterpret_cast<const __m128i *>(b + j));
+            }
+        }
+    }
+    return count + array_and_scalar(
+                       a + i, na - i, b + j, nb - j, (out != nullptr) ? (out + count) : nullptr);
+}
+#endif
+
+std::size_t array_and(
+    const std::uint16_t *a,
+    std::size_t na,
+    const std::uint16_t *b,
+    std::size_t nb,
+    std::uint16_t *out) noexcept {
+#if defined(KON_ARCH_X86)
+    if (rt::cpu().sse42) {
+        return array_and_sse42(a, na, b, nb, out);
+    }
+#endif
+    return array_and_scalar(a, na, b, nb, out);
+}
+
+void set_range(std::uint64_t *words, std::uint32_t start, std::uint32_t last) noexcept {
+    std::uint32_t ly = start / 64;
+    std::uint32_t my = last / 64;
+    std::uint64_t low = ~std::uint64_t{0} << (start % 64);
+    std::uint64_t high = ~std::uint64_t{0} >> (63 - last % 64);
+    if (ly == my) {
+        words[ly] |= low & high;
+        return;
+    }
+    words[ly] |= low;
+    for (ly++; ly < my; ly++) {
+        words[ly] = ~std::uint64_t{0};
+    }
+    words[my] |= high;
+}
+
+// The words of any container, a bitmap is used in place, the others are expanded into block.
+const std::uint64_t *to_words(const roaring_container_ref &c, bitmap_block &block) noexcept {
+    if (c.type == container_type::bitmap) {
+        return c.words();
+    }
+    std::memset(block.words, 0, sizeof(block.words));
+    if (c.type == container_type::array) {
+        for (std::uint32_t i = 0; i < c.size; i++) {
+            block.words[c.values()[i] / 64] |= std::uint64_t{1} << (c.values()[i] % 64);
+        }
+    } else {
+        for (std::uint32_t i = 0; i < c.size; i++) {
+            std::uint32_t start = c.values()[i * 2];
+            set_range(block.words, start, start + c.values()[i * 2 + 1]);
+        }
+    }
+    return block.words;
+}
+
+// An array if the block holds up to array_max values, else a bitmap taking the block.
+container from_block(std::unique_ptr<bitmap_block> block, std::uint32_t cardinality) {
+    container c;
+    c.cardinality = cardinality;
+    if (cardinality > roaring_bitmap::array_max) {
+        c.type = container_type::bitmap;
+        c.bitmap = std::move(block);
+        return c;
+    }
+    c.type = container_type::array;
+    c.values.reserve(cardinality);
+    for (std::uint32_t y = 0; y < bitmap_words; y++) {
+        kon::bit_for_each(block->words[y], [&c, y](unsigned char x) {
+            c.values.push_back(static_cast<std::uint16_t>(y * 64 + x));
+        });
+    }
+    return c;
+}
+
+std::uint32_t block_count(const bitmap_block &block) noexcept {
+    return static_cast<std::uint32_t>(detail::bitset_count(block.words, bitmap_words));
+}
+
+// The values of a container, a run container is made an array or a bitmap.
+container to_plain(const roaring_container_ref &c) {
+    auto block = std::make_unique<bitmap_block>();
+    auto words = to_words(c, *block);
+    if (words != block->words) {
+        std::memcpy(block->words, words, sizeof(block->words));
+    }
+    return from_block(std::move(block), c.cardinality);
+}
+
+std::uint32_t count_runs(const roaring_container_ref &c) noexcept {
+    if (c.type == container_type::run) {
+        return c.size;
+    }
+    std::uint32_t runs = 0;
+    if (c.type == container_type::array) {
+        for (std::uint32_t i = 0; i < c.size; i++) {
+            runs += (i == 0) || (c.values()[i] != (c.values()[i - 1] + 1));
+        }
+        return runs;
+    }
+    std::uint64_t carry = 0;
+    for (std::uint32_t y = 0; y < bitmap_words; y++) {
+        std::uint64_t e = c.words()[y];
+        runs += kon::popcount(e & ~((e << 1) | carry));
+        carry = e >> 63;
+    }
+    return runs;
+}
+
+container to_runs(const roaring_container_ref &c) {
+    container r;
+    r.type = container_type::run;
+    r.cardinality = c.cardinality;
+    r.values.reserve(count_runs(c) * 2);
+    std::int32_t start = -1;
+    std::int32_t last = -2;
+    c.for_each(0, [&r, &start, &last](std::uint32_t v) {
+        if (static_cast<std::int32_t>(v) != (last + 1)) {
+            if (start >= 0) {
+                r.values.push_back(static_cast<std::uint16_t>(start));
+                r.values.push_back(static_cast<std::uint16_t>(last - start));
+            }
+            start = static_cast<std::int32_t>(v);
+        }
+        last = static_cast<std::int32_t>(v);
+    });
+    if (start >= 0) {
+        r.values.push_back(static_cast<std::uint16_t>(start));
+        r.values.push_back(static_cast<std::uint16_t>(last - start));
+    }
+    return r;
+}
+
+std::size_t payload_bytes(const roaring_container_ref &c) noexcept {
+    if (c.type == container_type::bitmap) {
+        return bitmap_words * 8;
+    }
+    return (c.type == container_type::run) ? (c.size * 4) : (c.size * 2);
+}
+
+std::size_t payload_alignment(container_type type) noexcept {
+    return (type == container_type::bitmap) ? 64 : 8;
+}
+
+std::size_t align_up(std::size_t n, std::size_t alignment) noexcept {
+    return (n + alignment - 1) & ~(alignment - 1);
+}
+
+// The values of an array are ascending, the runs are ascending, apart and end up to 0xFFFF.
+bool sorted_payload(const roaring_container_ref &c) noexcept {
+    if (c.type == container_type::array) {
+        for (std::uint32_t i = 1; i < c.size; i++) {
+            if (c.values()[i] <= c.values()[i - 1]) {
+                return false;
+            }
+        }
+    } else if (c.type == container_type::run) {
+        std::int32_t last = -1;
+        for (std::uint32_t i = 0; i < c.size; i++) {
+            std::int32_t start = c.values()[i * 2];
+            std::int32_t end = start + c.values()[i * 2 + 1];
+            if ((start <= last) || (end > 0xFFFF)) {
+                return false;
+            }
+            last = end;
+        }
+    }
+    return true;
+}
+
+// The values a payload holds, a run holds its length + 1.
+std::uint32_t payload_cardinality(const roaring_container_ref &c) noexcept {
+    std::uint32_t count = 0;
+    if (c.type == container_type::array) {
+        count = c.size;
+    } else if (c.type == container_type::bitmap) {
+        for (std::size_t i = 0; i < bitmap_words; i++) {
+            count += kon::popcount(c.words()[i]);
+        }
+    } else {
+        for (std::uint32_t i = 0; i < c.size; i++) {
+            count += std::uint32_t{c.values()[i * 2 + 1]} + 1;
+        }
+    }
+    return count;
+}
+} // namespace
+
+bool roaring_container_ref::contains(std::uint16_t low) const noexcept {
+    if (type == container_type::bitmap) {
+        return (words()[low / 64] >> (low % 64)) & 1;
+    }
+    if (type == container_type::array) {
+        return std::binary_search(values(), values() + size, low);
+    }
+    // The last run starting at or before low.
+    std::uint32_t lo = 0;
+    std::uint32_t hi = size;
+    while (lo < hi) {
+        std::uint32_t mid = (lo + hi) / 2;
+        if (values()[mid * 2] <= low) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    if (lo == 0) {
+        return false;
+    }
+    std::uint32_t start = values()[(lo - 1) * 2];
+    return (low - start) <= values()[(lo - 1) * 2 + 1];
+}
+
+namespace detail {
+roaring_container::roaring_container(const roaring_container &other)
+    : type{other.type}
+    , cardinality{other.cardinality}
+    , values{other.values} {
+    if (other.bitmap != nullptr) {
+        bitmap = std::make_unique<bitmap_block>(*other.bitmap);
+    }
+}
+
+roaring_container &roaring_container::operator=(const roaring_container &other) {
+    if (this != &other) {
+        roaring_container copy{other};
+        *this = std::move(copy);
+    }
+    return *this;
+}
+
+roaring_container roaring_copy(const roaring_container_ref &c) {
+    container r;
+    r.type = c.type;
+    r.cardinality = c.cardinality;
+    if (c.type == container_type::bitmap) {
+        r.bitmap = std::make_unique<bitmap_block>();
+        std::memcpy(r.bitmap->words, c.words(), sizeof(r.bitmap->words));
+    } else {
+        std::size_t n = (c.type == container_type::run) ? (c.size * 2) : c.size;
+        r.values.assign(c.values(), c.values() + n);
+    }
+    return r;
+}
+
+// The runs are expanded to words, a run container is rarely intersected with an array.
+roaring_container roaring_and(const roaring_container_ref &a, const roaring_container_ref &b) {
+    container r;
+    if ((a.type == container_type::array) && (b.type == container_type::array)) {
+        r.values.resize(std::min(a.size, b.size) + 8);
+        r.cardinality = static_cast<std::uint32_t>(
+            array_and(a.values(), a.size, b.values(), b.size, r.values.data()));
+        r.values.resize(r.cardinality);
+        return r;
+    }
+    if ((a.type == container_type::array) || (b.type == container_type::array)) {
+        const auto &array = (a.type == container_type::array) ? a : b;
+        const auto &other = (a.type == container_type::array) ? b : a;
+        r.values.reserve(array.size);
+        for (std::uint32_t i = 0; i < array.size; i++) {
+            if (other.contains(array.values()[i])) {
+                r.values.push_back(array.values()[i]);
+            }
+        }
+        r.cardinality = static_cast<std::uint32_t>(r.values.size());
+        return r;
+    }
+    auto block = std::make_unique<bitmap_block>();
+    bitmap_block temp;
+    auto words = to_words(a, *block);
+    if (words != block->words) {
+        std::memcpy(block->words, words, sizeof(block->words));
+    }
+    detail::bitset_apply(detail::bitset_op::and_, block->words, to_words(b, temp), bitmap_words);
+    return from_block(std::move(block), block_count(*block));
+}
+
+roaring_container roaring_or(const roaring_container_ref &a, const roaring_container_ref &b) {
+    if ((a.type == container_type::array) && (b.type == container_type::array) &&
+        ((a.size + b.size) <= roaring_bitmap::array_max)) {
+        container r;
+        r.values.resize(a.size + b.size);
+        auto end = std::set_union(
+            a.values(), a.values() + a.size, b.values(), b.values() + b.size, r.values.begin());
+        r.values.erase(end, r.values.end());
+        r.cardinality = static_cast<std::uint32_t>(r.values.size());
+        return r;
+    }
+    auto block = std::make_unique<bitmap_block>();
+    bitmap_block temp;
+    auto words = to_words(a, *block);
+    if (words != block->words) {
+        std::memcpy(block->words, words, sizeof(block->words));
+    }
+    if (b.type == container_type::array) {
+        for (std::uint32_t i = 0; i < b.size; i++) {
+            block->words[b.values()[i] / 64] |= std::uint64_t{1} << (b.values()[i] % 64);
+        }
+    } else {
+        detail::bitset_apply(detail::bitset_op::or_, block->words, to_words(b, temp), bitmap_words);
+    }
+    return from_block(std::move(block), block_count(*block));
+}
+
+std::uint32_t roaring_and_cardinality(
+    const roaring_container_ref &a,
+    const roaring_container_ref &b) noexcept {
+    if ((a.type == container_type::array) && (b.type == container_type::array)) {
+        return static_cast<std::uint32_t>(
+            array_and(a.values(), a.size, b.values(), b.size, nullptr));
+    }
+    if ((a.type == container_type::array) || (b.type == container_type::array)) {
+        const auto &array = (a.type == container_type::array) ? a : b;
+        const auto &other = (a.type == container_type::array) ? b : a;
+        std::uint32_t count = 0;
+        for (std::uint32_t i = 0; i < array.size; i++) {
+            count += other.contains(array.values()[i]);
+        }
+        return count;
+    }
+    bitmap_block block;
+    bitmap_block temp;
+    auto words = to_words(a, block);
+    if (words != block.words) {
+        std::memcpy(block.words, words, sizeof(block.words));
+    }
+    detail::bitset_apply(detail::bitset_op::and_, block.words, to_words(b, temp), bitmap_words);
+    return block_count(block);
+}
+} // namespace detail
+
+std::size_t roaring_bitmap::find(std::uint16_t key) const noexcept {
+    return std::lower_bound(m_keys.begin(), m_keys.end(), key) - m_keys.begin();
+}
+
+void roaring_bitmap::add(std::uint32_t value) {
+    auto key = static_cast<std::uint16_t>(value >> 16);
+    auto low = static_cast<std::uint16_t>(value);
+    std::size_t index = find(key);
+    if ((index == m_keys.size()) || (m_keys[index] != key)) {
+        m_keys.insert(m_keys.begin() + index, key);
+        m_containers.emplace(m_containers.begin() + index);
+    }
+    auto &c = m_containers[index];
+    if (c.type == container_type::run) {
+        c = to_plain(c.ref());
+    }
+    if (c.type == container_type::array) {
+        auto it = std::lower_bound(c.values.begin(), c.values.end(), low);
+        if ((it != c.values.end()) && (*it == low)) {
+            return;
+        }
+        if (c.cardinality < array_max) {
+            c.values.insert(it, low);
+            c.cardinality++;
+            return;
+        }
+        auto block = std::make_unique<bitmap_block>();
+        to_words(c.ref(), *block);
+        c.values.clear();
+        c.values.shrink_to_fit();
+        c.type = container_type::bitmap;
+        c.bitmap = std::move(block);
+    }
+    std::uint64_t &e = c.bitmap->words[low / 64];
+    std::uint64_t bit = std::uint64_t{1} << (low % 64);
+    c.cardinality += (e & bit) == 0;
+    e |= bit;
+}
+
+bool roaring_bitmap::remove(std::uint32_t value) {
+    auto key = static_cast<std::uint16_t>(value >> 16);
+    auto low = static_cast<std::uint16_t>(value);
+    std::size_t index = find(key);
+    if ((index == m_keys.size()) || (m_keys[index] != key)) {
+        return false;
+    }
+    auto &c = m_containers[index];
+    if (!c.ref().contains(low)) {
+        return false;
+    }
+    if (c.type == container_type::run) {
+        c = to_plain(c.ref());
+    }
+    if (c.type == container_type::array) {
+        c.values.erase(std::lower_bound(c.values.begin(), c.values.end(), low));
+    } else {
+        c.bitmap->words[low / 64] &= ~(std::uint64_t{1} << (low % 64));
+        if ((c.cardinality - 1) == array_max) {
+            c = from_block(std::move(c.bitmap), array_max);
+            return true;
+        }
+    }
+    if (--c.cardinality == 0) {
+        m_keys.erase(m_keys.begin() + index);
+        m_containers.erase(m_containers.begin() + index);
+    }
+    return true;
+}
+
+bool roaring_bitmap::contains(std::uint32_t value) const noexcept {
+    auto key = static_cast<std::uint16_t>(value >> 16);
+    std::size_t index = find(key);
+    if ((index == m_keys.size()) || (m_keys[index] != key)) {
+        return false;
+    }
+    return m_containers[index].ref().contains(static_cast<std::uint16_t>(value));
+}
+
+void roaring_bitmap::run_optimize() {
+    for (auto &c: m_containers) {
+        auto ref = c.ref();
+        if (c.type != container_type::run) {
+            if ((count_runs(ref) * 4) < payload_bytes(ref)) {
+                c = to_runs(ref);
+            }
+        }
+    }
+}
+
+void roaring_bitmap::append(std::uint16_t key, detail::roaring_container &&container) {
+    m_keys.push_back(key);
+    m_containers.push_back(std::move(container));
+}
+
+std::size_t roaring_bitmap::memory_usage() const noexcept {
+    std::size_t bytes = m_keys.capacity() * sizeof(std::uint16_t) +
+                        m_containers.capacity() * sizeof(detail::roaring_container);
+    for (const auto &c: m_containers) {
+        bytes += c.values.capacity() * sizeof(std::uint16_t);
+        bytes += (c.bitmap != nullptr) ? sizeof(bitmap_block) : 0;
+    }
+    return bytes;
+}
+
+std::size_t roaring_bitmap::serialized_size() const noexcept {
+    std::size_t size = sizeof(roaring_view::header) + m_keys.size() * sizeof(roaring_view::entry);
+    for (const auto &c: m_containers) {
+        size = align_up(size, payload_alignment(c.type)) + payload_bytes(c.ref());
+    }
+    return size;
+}
+
+void roaring_bitmap::serialize(void *data) const noexcept {
+    auto base = static_cast<std::uint8_t *>(data);
+    roaring_view::header h{roaring_view::magic, static_cast<std::uint32_t>(m_keys.size()), 0};
+    std::memcpy(base, &h, sizeof(h));
+    auto entries = base + sizeof(h);
+    std::size_t offset = sizeof(h) + m_keys.size() * sizeof(roaring_view::entry);
+    for (std::size_t i = 0; i < m_keys.size(); i++) {
+        auto ref = m_containers[i].ref();
+        std::size_t aligned = align_up(offset, payload_alignment(ref.type));
+        std::memset(base + offset, 0, aligned - offset);
+        offset = aligned;
+        roaring_view::entry e{
+            m_keys[i], ref.type, 0, ref.cardinality, static_cast<std::uint32_t>(offset), ref.size};
+        std::memcpy(entries + i * sizeof(e), &e, sizeof(e));
+        std::memcpy(base + offset, ref.data, payload_bytes(ref));
+        offset += payload_bytes(ref);
+    }
+}
+
+bool roaring_view::init(const void *data, std::size_t size) noexcept {
+    auto base = static_cast<const std::uint8_t *>(data);
+    if (((reinterpret_cast<std::uintptr_t>(base) % 64) != 0) || (size < sizeof(header))) {
+        return false;
+    }
+    auto h = reinterpret_cast<const header *>(base);
+    if ((h->magic != magic) || (h->count > 65536) ||
+        ((sizeof(header) + h->count * sizeof(entry)) > size)) {
+        return false;
+    }
+    auto entries = reinterpret_cast<const entry *>(base + sizeof(header));
+    for (std::size_t i = 0; i < h->count; i++) {
+        const auto &e = entries[i];
+        if ((i != 0) && (e.key <= entries[i - 1].key)) {
+            return false;
+        }
+        std::size_t limit = 0;
+        if (e.type == container_type::array) {
+            limit = roaring_bitmap::array_max;
+        } else if (e.type == container_type::bitmap) {
+            limit = bitmap_words;
+        } else if (e.type == container_type::run) {
+            limit = 32768;
+        }
+        if ((e.size == 0) || (e.size > limit) || ((e.offset % payload_alignment(e.type)) != 0)) {
+            return false;
+        }
+        roaring_container_ref ref{e.type, e.cardinality, e.size, nullptr};
+        if ((e.offset > size) || (payload_bytes(ref) > (size - e.offset))) {
+            return false;
+        }
+        if ((e.type == container_type::bitmap) && (e.size != bitmap_words)) {
+            return false;
+        }
+        // A run past 0xFFFF would be set past the block of the algebra.
+        ref.data = base + e.offset;
+        if (!sorted_payload(ref)) {
+            return false;
+        }
+        // The cardinality is trusted by the algebra and the copies, a bitmap holds more than
+        // array_max values.
+        if ((payload_cardinality(ref) != e.cardinality) ||
+            ((e.type == container_type::bitmap) && (e.cardinality <= roaring_bitmap::array_max))) {
+            return false;
+        }
+    }
+    m_base = base;
+    m_entries = entries;
+    m_count = h->count;
+    return true;
+}
+
+bool roaring_view::contains(std::uint32_t value) const noexcept {
+    auto key = static_cast<std::uint16_t>(value >> 16);
+    auto it = std::lower_bound(m_entries, m_entries + m_count, key, [](const entry &e, auto k) {
+        return e.key < k;
+    });
+    if ((it == (m_entries + m_count)) || (it->key != key)) {
+        return false;
+    }
+    return container(it - m_entries).contains(static_cast<std::uint16_t>(value));
+}
+
+} // namespace kon
@@ -0,0 +1,316 @@
+// SPDX-FileCopyrightText: 2026 TypeCombinator <typecombinator@foxmail.com>
+//
+// SPDX-License-Identifier: BSD 3-Clause
+
+#ifndef ROARING_750D3E2F_6262_444A_B326_88CC5155579B
+#define ROARING_750D3E2F_6262_444A_B326_88CC5155579B
+#include <kon/bit.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace kon {
+
+enum class roaring_container_type : std::uint8_t {
+    array = 1, // The sorted values, up to 4096.
+    bitmap = 2, // 1024 words.
+    run = 3, // The sorted (start, length - 1) pairs.
+};
+
+// A read-only container, of a roaring_bitmap or of a serialized one.
+struct roaring_container_ref {
+    roaring_container_type type;
+    std::uint32_t cardinality;
+    std::uint32_t size; // The values of an array, the pairs of a run, 1024 for a bitmap.
+    const void *data; // A bitmap is 64 bytes aligned.
+
+    const std::uint16_t *values() const noexcept {
+        return static_cast<const std::uint16_t *>(data);
+    }
+
+    const std::uint64_t *words() const noexcept {
+        return static_cast<const std::uint64_t *>(data);
+    }
+
+    bool contains(std::uint16_t low) const noexcept;
+
+    template <typename F>
+    void for_each(std::uint32_t high, F &&f) const {
+        if (type == roaring_container_type::array) {
+            for (std::uint32_t i = 0; i < size; i++) {
+                f(high | values()[i]);
+            }
+        } else if (type == roaring_container_type::bitmap) {
+            for (std::uint32_t y = 0; y < 1024; y++) {
+                std::uint32_t base = high | (y * 64);
+                kon::bit_for_each(words()[y], [&f, base](unsigned char x) {
+                    f(base + x);
+                });
+            }
+        } else {
+            for (std::uint32_t i = 0; i < size; i++) {
+                // Counted by the length, the run may end at 0xFFFFFFFF.
+                std::uint32_t start = high | values()[i * 2];
+                std::uint32_t count = std::uint32_t{values()[i * 2 + 1]} + 1;
+                for (std::uint32_t j = 0; j < count; j++) {
+                    f(start + j);
+                }
+            }
+        }
+    }
+};
+
+namespace detail {
+// An owned container, the bitmap words are in a 64 bytes aligned block.
+struct roaring_container {
+    struct alignas(64) bitmap_block {
+        std::uint64_t words[1024];
+    };
+
+    roaring_container_type type{roaring_container_type::array};
+    std::uint32_t cardinality{0};
+    std::vector<std::uint16_t> values; // The array values or the run pairs.
+    std::unique_ptr<bitmap_block> bitmap;
+
+    roaring_container() = default;
+    roaring_container(roaring_container &&) noexcept = default;
+    roaring_container &operator=(roaring_container &&) noexcept = default;
+    roaring_container(const roaring_container &other);
+    roaring_container &operator=(const roaring_container &other);
+
+    roaring_container_ref ref() const noexcept {
+        if (type == roaring_container_type::bitmap) {
+            return {type, cardinality, 1024, bitmap->words};
+        }
+        auto size = static_cast<std::uint32_t>(values.size());
+        return {type, cardinality, (type == roaring_container_type::run) ? (size / 2) : size,
+                values.data()};
+    }
+};
+
+roaring_container roaring_copy(const roaring_container_ref &c);
+roaring_container roaring_and(const roaring_container_ref &a, const roaring_container_ref &b);
+roaring_container roaring_or(const roaring_container_ref &a, const roaring_container_ref &b);
+std::uint32_t roaring_and_cardinality(
+    const roaring_container_ref &a,
+    const roaring_container_ref &b) noexcept;
+} // namespace detail
+
+// A compressed bitmap of 32-bit values, the values are grouped by their high 16 bits into
+// containers keyed by them. A container is an array of the low 16 bits while it holds up to 4096
+// values, a 8 KB bitmap above, or runs after run_optimize() if those are smaller.
+// The changes allocate and may throw std::bad_alloc, the queries don't.
+class roaring_bitmap {
+   public:
+    static constexpr std::uint32_t array_max = 4096;
+
+    void add(std::uint32_t value);
+    // Returns false if the value is not in it.
+    bool remove(std::uint32_t value);
+
+    [[nodiscard]]
+    bool contains(std::uint32_t value) const noexcept;
+
+    [[nodiscard]]
+    std::uint64_t cardinality() const noexcept {
+        std::uint64_t count = 0;
+        for (const auto &c: m_containers) {
+            count += c.cardinality;
+        }
+        return count;
+    }
+
+    [[nodiscard]]
+    bool empty() const noexcept {
+        return m_keys.empty();
+    }
+
+    void clear() noexcept {
+        m_keys.clear();
+        m_containers.clear();
+    }
+
+    // Turns the containers into runs where those are smaller. A run container goes back to an
+    // array or a bitmap when it's changed.
+    void run_optimize();
+
+    // Calls f(value) for every value in ascending order.
+    template <typename F>
+    void for_each(F &&f) const {
+        for (std::size_t i = 0; i < m_keys.size(); i++) {
+            m_containers[i].ref().for_each(std::uint32_t{m_keys[i]} << 16, f);
+        }
+    }
+
+    [[nodiscard]]
+    std::size_t container_count() const noexcept {
+        return m_keys.size();
+    }
+
+    [[nodiscard]]
+    std::uint16_t key(std::size_t index) const noexcept {
+        return m_keys[index];
+    }
+
+    [[nodiscard]]
+    roaring_container_ref container(std::size_t index) const noexcept {
+        return m_containers[index].ref();
+    }
+
+    // The bytes held by the containers.
+    [[nodiscard]]
+    std::size_t memory_usage() const noexcept;
+
+    [[nodiscard]]
+    std::size_t serialized_size() const noexcept;
+
+    // Writes serialized_size() bytes, data is 64 bytes aligned. The layout is in the host byte
+    // order, roaring_view reads it in place, e.g. from a mapped file.
+    void serialize(void *data) const noexcept;
+
+    // Appends a container, the keys must be ascending.
+    void append(std::uint16_t key, detail::roaring_container &&container);
+   private:
+    std::size_t find(std::uint16_t key) const noexcept;
+
+    std::vector<std::uint16_t> m_keys;
+    std::vector<detail::roaring_container> m_containers;
+};
+
+// A serialized roaring_bitmap read in place.
+class roaring_view {
+   public:
+    static constexpr std::uint32_t magic = 0x3142524B; // "KRB1"
+
+    struct header {
+        std::uint32_t magic;
+        std::uint32_t count;
+        std::uint64_t reserved;
+    };
+
+    struct entry {
+        std::uint16_t key;
+        roaring_container_type type;
+        std::uint8_t reserved;
+        std::uint32_t cardinality;
+        std::uint32_t offset; // From the header.
+        std::uint32_t size;
+    };
+
+    roaring_view() noexcept = default;
+
+    // Checks the layout, the order of the values and the cardinalities, false if it's not a
+    // serialized roaring_bitmap of this host. data is 64 bytes aligned.
+    bool init(const void *data, std::size_t size) noexcept;
+
+    [[nodiscard]]
+    bool contains(std::uint32_t value) const noexcept;
+
+    [[nodiscard]]
+    std::uint64_t cardinality() const noexcept {
+        std::uint64_t count = 0;
+        for (std::size_t i = 0; i < m_count; i++) {
+            count += m_entries[i].cardinality;
+        }
+        return count;
+    }
+
+    template <typename F>
+    void for_each(F &&f) const {
+        for (std::size_t i = 0; i < m_count; i++) {
+            container(i).for_each(std::uint32_t{m_entries[i].key} << 16, f);
+        }
+    }
+
+    [[nodiscard]]
+    std::size_t container_count() const noexcept {
+        return m_count;
+    }
+
+    [[nodiscard]]
+    std::uint16_t key(std::size_t index) const noexcept {
+        return m_entries[index].key;
+    }
+
+    [[nodiscard]]
+    roaring_container_ref container(std::size_t index) const noexcept {
+        const auto &e = m_entries[index];
+        return {e.type, e.cardinality, e.size, m_base + e.offset};
+    }
+   private:
+    const std::uint8_t *m_base{nullptr};
+    const entry *m_entries{nullptr};
+    std::size_t m_count{0};
+};
+
+// The set algebra over roaring_bitmap and roaring_view, the containers with the same key are
+// combined.
+template <typename L, typename R>
+roaring_bitmap roaring_and(const L &lhs, const R &rhs) {
+    roaring_bitmap result;
+    std::size_t i = 0;
+    std::size_t j = 0;
+    while ((i < lhs.container_count()) && (j < rhs.container_count())) {
+        if (lhs.key(i) < rhs.key(j)) {
+            i++;
+        } else if (lhs.key(i) > rhs.key(j)) {
+            j++;
+        } else {
+            auto c = detail::roaring_and(lhs.container(i), rhs.container(j));
+            if (c.cardinality != 0) {
+                result.append(lhs.key(i), std::move(c));
+            }
+            i++;
+            j++;
+        }
+    }
+    return result;
+}
+
+template <typename L, typename R>
+roaring_bitmap roaring_or(const L &lhs, const R &rhs) {
+    roaring_bitmap result;
+    std::size_t i = 0;
+    std::size_t j = 0;
+    auto copy = [&result](std::uint16_t key, const roaring_container_ref &ref) {
+        result.append(key, detail::roaring_copy(ref));
+    };
+    while ((i < lhs.container_count()) || (j < rhs.container_count())) {
+        if ((j == rhs.container_count()) ||
+            ((i < lhs.container_count()) && (lhs.key(i) < rhs.key(j)))) {
+            copy(lhs.key(i), lhs.container(i));
+            i++;
+        } else if ((i == lhs.container_count()) || (lhs.key(i) > rhs.key(j))) {
+            copy(rhs.key(j), rhs.container(j));
+            j++;
+        } else {
+            result.append(lhs.key(i), detail::roaring_or(lhs.container(i), rhs.container(j)));
+            i++;
+            j++;
+        }
+    }
+    return result;
+}
+
+template <typename L, typename R>
+std::uint64_t roaring_and_cardinality(const L &lhs, const R &rhs) noexcept {
+    std::uint64_t count = 0;
+    std::size_t i = 0;
+    std::size_t j = 0;
+    while ((i < lhs.container_count()) && (j < rhs.container_count())) {
+        if (lhs.key(i) < rhs.key(j)) {
+            i++;
+        } else if (lhs.key(i) > rhs.key(j)) {
+            j++;
+        } else {
+            count += detail::roaring_and_cardinality(lhs.container(i), rhs.container(j));
+            i++;
+            j++;
+        }
+    }
+    return count;
+}
+
+} // namespace kon
+#endif // roaring.hpp
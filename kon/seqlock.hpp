@@ -0,0 +1,113 @@
+// SPDX-FileCopyrightText: 2026 TypeCombinator <typecombinator@foxmail.com>
+//
+// SPDX-License-Identifier: BSD 3-Clause
+
+#ifndef SEQLOCK_AFD31471_09B8_41DD_9A1D_E1ED8CA6FFEC
+#define SEQLOCK_AFD31471_09B8_41DD_9A1D_E1ED8CA6FFEC
+#include <kon/scope.hpp>
+#include <kon/spin_lock.hpp>
+#include <kon/xt/attributes.hpp>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+namespace kon {
+
+// A snapshot of a small trivially copyable T, the readers never write a shared line. A writer
+// makes the sequence odd while it copies, a reader retries while the sequence is odd or has
+// changed over its copy. The value is held in relaxed atomic words, so a torn read is never a
+// data race, it's thrown away.
+// The writers are serialized by the sequence, a reader may spin as long as a writer holds it.
+template <typename T>
+class seqlock {
+    static_assert(std::is_trivially_copyable_v<T>);
+   public:
+    seqlock() noexcept
+        : seqlock(T{}) {
+    }
+
+    explicit seqlock(const T &value) noexcept {
+        store_words(value);
+    }
+
+    KON_DISALLOW_COPY(seqlock);
+    KON_DISALLOW_MOVE(seqlock);
+
+    [[nodiscard]]
+    T load() const noexcept {
+        spin_wait spin;
+        while (true) {
+            auto seq = m_seq.load(std::memory_order_acquire);
+            if ((seq & 1) == 0) {
+                T value = load_words();
+                std::atomic_thread_fence(std::memory_order_acquire);
+                if (m_seq.load(std::memory_order_relaxed) == seq) {
+                    return value;
+                }
+            }
+            spin.wait();
+        }
+    }
+
+    void store(const T &value) noexcept {
+        auto seq = begin_write();
+        store_words(value);
+        m_seq.store(seq + 2, std::memory_order_release);
+    }
+
+    // Changes the value in place, f(T &) runs with the other writers held off. If f throws, the
+    // value is left unchanged and the write still ends.
+    template <typename F>
+    void update(F &&f) noexcept(noexcept(f(std::declval<T &>()))) {
+        auto seq = begin_write();
+        scope_exit end_write{[this, seq]() noexcept {
+            m_seq.store(seq + 2, std::memory_order_release);
+        }};
+        T value = load_words();
+        f(value);
+        store_words(value);
+    }
+   private:
+    static constexpr std::size_t word_count = (sizeof(T) + 7) / 8;
+
+    // Makes the sequence odd, returns the even one before it.
+    std::uint64_t begin_write() noexcept {
+        spin_wait spin;
+        auto seq = m_seq.load(std::memory_order_relaxed);
+        while (((seq & 1) != 0) ||
+               !m_seq.compare_exchange_weak(
+                   seq, seq + 1, std::memory_order_acquire, std::memory_order_relaxed)) {
+            spin.wait();
+            seq = m_seq.load(std::memory_order_relaxed);
+        }
+        // The odd sequence is seen before any of the words.
+        std::atomic_thread_fence(std::memory_order_release);
+        return seq;
+    }
+
+    T load_words() const noexcept {
+        std::uint64_t words[word_count];
+        for (std::size_t i = 0; i < word_count; i++) {
+            words[i] = m_words[i].load(std::memory_order_relaxed);
+        }
+        T value;
+        std::memcpy(&value, words, sizeof(T));
+        return value;
+    }
+
+    void store_words(const T &value) noexcept {
+        std::uint64_t words[word_count]{};
+        std::memcpy(words, &value, sizeof(T));
+        for (std::size_t i = 0; i < word_count; i++) {
+            m_words[i].store(words[i], std::memory_order_relaxed);
+        }
+    }
+
+    alignas(64) std::atomic<std::uint64_t> m_seq{0};
+    std::atomic<std::uint64_t> m_words[word_count];
+};
+
+} // namespace kon
+#endif // seqlock.hpp
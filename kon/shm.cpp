@@ -5,6 +5,7 @@
 #include <kon/shm.hpp>
 #include <unistd.h>
 #include <fcntl.h>
+#include <sys/file.h>
 #include <sys/stat.h>
 #include <sys/mman.h>
 #include <filesystem>
@@ -18,7 +19,9 @@ shm::shm(int& err, const std::string& file, std::size_t size) noexcept {
     auto&& file_path = std::filesystem::path{"/dev/shm"} / file;
     struct stat st;
     bool is_file_exist = (stat(file_path.c_str(), &st) == 0);
-    if (is_file_exist && (size > st.st_size)) {
+    // A file of no size is being created by another process, or its creator died before sizing it.
+    bool is_file_sized = is_file_exist && (st.st_size != 0);
+    if (is_file_sized && (size > st.st_size)) {
         err = -1;
         return;
     }
@@ -39,10 +42,23 @@ shm::shm(int& err, const std::string& file, std::size_t size) noexcept {
         err = -3;
         return;
     }
-    if ((!is_file_exist) && (ftruncate(fd, msize) != 0)) {
-        err = -4;
-        close(fd);
-        return;
+    if (!is_file_sized) {
+        // The processes racing to size it are serialized, it's only grown, never shrunk under the
+        // mapping of another one.
+        int size_err = 0;
+        flock(fd, LOCK_EX);
+        bool is_sized = (fstat(fd, &st) == 0) && (st.st_size != 0);
+        if (is_sized && (size > static_cast<std::size_t>(st.st_size))) {
+            size_err = -1;
+        } else if ((!is_sized) && (ftruncate(fd, msize) != 0)) {
+            size_err = -4;
+        }
+        flock(fd, LOCK_UN);
+        if (size_err != 0) {
+            err = size_err;
+            close(fd);
+            return;
+        }
     }
     auto* m = mmap(0, msize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
     if (m == MAP_FAILED) {
@@ -58,7 +74,7 @@ shm::shm(int& err, const std::string& file, std::size_t size) noexcept {
 }
 
 shm::~shm() noexcept {
-    if (memory == nullptr) {
+    if (memory != nullptr) {
         munmap(memory, msize);
         memory = nullptr;
         msize = 0;
@@ -0,0 +1,235 @@
+// SPDX-FileCopyrightText: 2026 TypeCombinator <typecombinator@foxmail.com>
+//
+// SPDX-License-Identifier: BSD 3-Clause
+
+#include <kon/shm_store.hpp>
+#include <kon/spin_lock.hpp>
+#include <cerrno>
+#include <cstring>
+#include <signal.h>
+#include <unistd.h>
+
+namespace kon {
+namespace {
+constexpr std::uint32_t store_magic = 0x4f54534b; // "KSTO"
+constexpr std::uint32_t store_layout = 1;
+constexpr std::uint64_t phase_initializing = 1;
+constexpr std::uint64_t phase_ready = 2;
+// The waits between the checks of a dead owner.
+constexpr std::uint32_t owner_check_waits = 64;
+constexpr std::uint32_t max_pid = 4 * 1024 * 1024; // PID_MAX_LIMIT of Linux.
+
+static_assert(std::atomic<std::uint64_t>::is_always_lock_free);
+static_assert(std::atomic<std::uint32_t>::is_always_lock_free);
+
+std::uint32_t self_pid() noexcept {
+    return static_cast<std::uint32_t>(::getpid());
+}
+
+// 0 and the negative pids are groups of processes, they aren't the pid of an owner.
+bool alive(std::uint32_t pid) noexcept {
+    if ((pid == 0) || (pid > max_pid)) {
+        return false;
+    }
+    return (::kill(static_cast<pid_t>(pid), 0) == 0) || (errno == EPERM);
+}
+
+// A lock word holding the pid of its owner, it's taken over if the owner died holding it.
+void lock_owned(std::atomic<std::uint32_t> &word) noexcept {
+    std::uint32_t self = self_pid();
+    std::uint32_t owner = 0;
+    std::uint32_t waits = 0;
+    spin_wait spin;
+    while (!word.compare_exchange_weak(
+        owner, self, std::memory_order_acquire, std::memory_order_relaxed)) {
+        while (owner != 0) {
+            spin.wait();
+            if (((++waits % owner_check_waits) == 0) && !alive(owner)) {
+                break; // The next CAS expects the dead owner.
+            }
+            owner = word.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+void unlock_owned(std::atomic<std::uint32_t> &word) noexcept {
+    word.store(0, std::memory_order_release);
+}
+} // namespace
+
+struct shm_store::header {
+    // The pid of the initializer << 32 | the phase, 0 in a new segment.
+    std::atomic<std::uint64_t> state;
+    std::uint32_t magic;
+    std::uint32_t layout;
+    std::uint32_t version;
+    std::atomic<std::uint32_t> lock; // The directory lock, it guards the new entries.
+    std::uint64_t size;
+    std::atomic<std::uint64_t> top; // The next free offset.
+    std::atomic<std::uint32_t> count; // The published entries, they're never changed.
+    alignas(64) entry entries[max_objects];
+};
+
+shm_store::shm_store(
+    int &err,
+    const std::string &file,
+    std::size_t size,
+    std::uint32_t version) noexcept {
+    if (size < sizeof(header)) {
+        err = -6;
+        return;
+    }
+    m_shm = shm(err, file, size);
+    if (err != 0) {
+        return;
+    }
+    m_base = static_cast<std::uint8_t *>(m_shm.data());
+    auto *h = reinterpret_cast<header *>(m_base);
+    std::uint64_t claimed = (std::uint64_t{self_pid()} << 32) | phase_initializing;
+    std::uint64_t state = h->state.load(std::memory_order_acquire);
+    std::uint32_t waits = 0;
+    spin_wait spin;
+    while ((state & 0xffffffff) != phase_ready) {
+        if ((state != 0) && ((state & 0xffffffff) != phase_initializing)) {
+            err = -7; // Another program's data, it's left as it is.
+            return;
+        }
+        // A new segment, or one its initializer died on.
+        bool claim = (state == 0) ||
+                     (((++waits % owner_check_waits) == 0) && !alive(state >> 32));
+        if (claim) {
+            if (h->state.compare_exchange_strong(state, claimed, std::memory_order_acquire)) {
+                h->magic = store_magic;
+                h->layout = store_layout;
+                h->version = version;
+                h->lock.store(0, std::memory_order_relaxed);
+                h->size = m_shm.size();
+                h->top.store(sizeof(header), std::memory_order_relaxed);
+                h->count.store(0, std::memory_order_relaxed);
+                h->state.store(phase_ready, std::memory_order_release);
+                m_first = true;
+                break;
+            }
+            continue;
+        }
+        spin.wait();
+        state = h->state.load(std::memory_order_acquire);
+    }
+    if ((h->magic != store_magic) || (h->layout != store_layout)) {
+        err = -7;
+        return;
+    }
+    if (h->version != version) {
+        err = -8;
+        return;
+    }
+    if (h->size != m_shm.size()) {
+        err = -9;
+        return;
+    }
+    m_header = h;
+}
+
+void *shm_store::find_or_allocate(
+    std::string_view name,
+    std::size_t size,
+    std::size_t alignment) noexcept {
+    entry *e = nullptr;
+    void *p = acquire(name, size, alignment, e);
+    if (e != nullptr) {
+        // The segment may have been initialized again over the old blocks.
+        std::memset(p, 0, size);
+        publish(e);
+    }
+    return p;
+}
+
+void *shm_store::find(std::string_view name, std::size_t *size) const noexcept {
+    if (m_header == nullptr) {
+        return nullptr;
+    }
+    std::uint32_t count = m_header->count.load(std::memory_order_acquire);
+    for (std::uint32_t i = 0; i < count; i++) {
+        const entry &e = m_header->entries[i];
+        if (std::string_view{e.name} == name) {
+            if (size != nullptr) {
+                *size = e.size;
+            }
+            return m_base + e.offset;
+        }
+    }
+    return nullptr;
+}
+
+std::uint64_t shm_store::allocate(std::size_t size, std::size_t alignment) noexcept {
+    if ((m_header == nullptr) || (alignment == 0) || ((alignment & (alignment - 1)) != 0)) {
+        return 0;
+    }
+    // The base is page aligned, so is an offset aligned the same as its address up to a page.
+    std::uint64_t top = m_header->top.load(std::memory_order_relaxed);
+    std::uint64_t offset;
+    do {
+        offset = (top + alignment - 1) & ~std::uint64_t{alignment - 1};
+        if ((offset > m_header->size) || ((m_header->size - offset) < size)) {
+            return 0;
+        }
+    } while (!m_header->top.compare_exchange_weak(top, offset + size, std::memory_order_relaxed));
+    return offset;
+}
+
+std::size_t shm_store::available() const noexcept {
+    if (m_header == nullptr) {
+        return 0;
+    }
+    return m_header->size - m_header->top.load(std::memory_order_relaxed);
+}
+
+void *shm_store::acquire(
+    std::string_view name,
+    std::size_t size,
+    std::size_t alignment,
+    entry *&e) noexcept {
+    e = nullptr;
+    if ((m_header == nullptr) || name.empty() || (name.size() > max_name_length) ||
+        (alignment == 0) || ((alignment & (alignment - 1)) != 0)) {
+        return nullptr;
+    }
+    auto matches = [this, name, size, alignment]() -> void * {
+        std::size_t found_size = 0;
+        void *p = find(name, &found_size);
+        if ((p == nullptr) || (found_size != size) ||
+            ((reinterpret_cast<std::uintptr_t>(p) & (alignment - 1)) != 0)) {
+            return nullptr;
+        }
+        return p;
+    };
+    if (find(name) != nullptr) {
+        return matches();
+    }
+    lock_owned(m_header->lock);
+    // It may have been published meanwhile.
+    if (find(name) != nullptr) {
+        unlock_owned(m_header->lock);
+        return matches();
+    }
+    std::uint32_t count = m_header->count.load(std::memory_order_relaxed);
+    std::uint64_t offset = (count < max_objects) ? allocate(size, alignment) : 0;
+    if (offset == 0) {
+        unlock_owned(m_header->lock);
+        return nullptr;
+    }
+    e = &m_header->entries[count];
+    std::memset(e->name, 0, sizeof(e->name));
+    std::memcpy(e->name, name.data(), name.size());
+    e->offset = offset;
+    e->size = size;
+    return m_base + offset;
+}
+
+void shm_store::publish(entry *e) noexcept {
+    auto count = static_cast<std::uint32_t>(e - m_header->entries) + 1;
+    m_header->count.store(count, std::memory_order_release);
+    unlock_owned(m_header->lock);
+}
+
+} // namespace kon
@@ -0,0 +1,124 @@
+// SPDX-FileCopyrightText: 2026 TypeCombinator <typecombinator@foxmail.com>
+//
+// SPDX-License-Identifier: BSD 3-Clause
+
+#ifndef SHM_STORE_D05AA2D2_2543_4134_9357_886BEB92B911
+#define SHM_STORE_D05AA2D2_2543_4134_9357_886BEB92B911
+#include <kon/shm.hpp>
+#include <kon/xt/attributes.hpp>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+namespace kon {
+
+// A shm segment managed by a header: a directory of named objects and a bump allocator of
+// offsets, so the processes mapping it at different addresses share the objects by their names.
+// The first process initializing the segment claims it by a word holding its pid, the others wait
+// until it's ready, then check the version. If the initializer died, the segment is initialized
+// again by one of the waiters. The directory is guarded by a lock of the same kind.
+// The objects are never destroyed, their space is given back with the segment only. An object
+// holds no pointer, e.g. bitset, spsc_queue, mpmc_queue or seqlock, its atomics are lock-free.
+// Notice: a dead process is told by its pid, which may be reused meanwhile.
+class shm_store {
+   public:
+    static constexpr std::size_t max_objects = 64;
+    static constexpr std::size_t max_name_length = 47;
+
+    // err is the one of shm or:
+    // -6: size can't hold the header.
+    // -7: the segment isn't a store of this layout.
+    // -8: the version isn't the one of the segment.
+    // -9: size isn't the one of the segment.
+    shm_store(int &err, const std::string &file, std::size_t size, std::uint32_t version) noexcept;
+
+    KON_DISALLOW_COPY(shm_store);
+    KON_DISALLOW_MOVE(shm_store);
+
+    // Whether this process initialized the segment.
+    [[nodiscard]]
+    bool is_first() const noexcept {
+        return m_first;
+    }
+
+    // The named block, allocated and zeroed if it's missing. Returns nullptr if there is no room,
+    // the name is too long, or the block has another size or alignment.
+    void *find_or_allocate(
+        std::string_view name,
+        std::size_t size,
+        std::size_t alignment = alignof(std::max_align_t)) noexcept;
+
+    // The named block, nullptr if it's missing.
+    void *find(std::string_view name, std::size_t *size = nullptr) const noexcept;
+
+    // The named object, constructed from args if it's missing. The same as find_or_allocate()
+    // when it's nullptr.
+    template <typename T, typename... Args>
+    T *find_or_construct(std::string_view name, Args &&...args) noexcept {
+        static_assert(std::is_trivially_destructible_v<T>, "the objects are never destroyed");
+        static_assert(std::is_nothrow_constructible_v<T, Args...>);
+        entry *e = nullptr;
+        void *p = acquire(name, sizeof(T), alignof(T), e);
+        if (e != nullptr) {
+            p = new (p) T(std::forward<Args>(args)...);
+            publish(e);
+        }
+        return static_cast<T *>(p);
+    }
+
+    template <typename T>
+    T *find(std::string_view name) const noexcept {
+        std::size_t size = 0;
+        void *p = find(name, &size);
+        return (size == sizeof(T)) ? static_cast<T *>(p) : nullptr;
+    }
+
+    // An unnamed block, its offset is shared instead. Returns 0 if there is no room.
+    std::uint64_t allocate(
+        std::size_t size,
+        std::size_t alignment = alignof(std::max_align_t)) noexcept;
+
+    void *at(std::uint64_t offset) const noexcept {
+        return m_base + offset;
+    }
+
+    std::uint64_t offset_of(const void *p) const noexcept {
+        return static_cast<const std::uint8_t *>(p) - m_base;
+    }
+
+    // The bytes left to the allocations, the alignment paddings aside.
+    [[nodiscard]]
+    std::size_t available() const noexcept;
+
+    [[nodiscard]]
+    std::size_t size() const noexcept {
+        return m_shm.size();
+    }
+   private:
+    struct entry {
+        char name[max_name_length + 1];
+        std::uint64_t offset;
+        std::uint64_t size;
+    };
+
+    struct header;
+
+    // The named block, with the directory locked and e set if it's new, the caller constructs the
+    // object in it and publishes e.
+    void *acquire(std::string_view name, std::size_t size, std::size_t alignment, entry *&e)
+        noexcept;
+    void publish(entry *e) noexcept;
+
+    shm m_shm;
+    std::uint8_t *m_base{nullptr};
+    header *m_header{nullptr};
+    bool m_first{false};
+};
+
+} // namespace kon
+#endif // shm_store.hpp
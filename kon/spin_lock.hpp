@@ -4,29 +4,41 @@
 
 #ifndef SPIN_LOCK_BA9F0A7B_7B4C_471E_9909_219135CAED00
 #define SPIN_LOCK_BA9F0A7B_7B4C_471E_9909_219135CAED00
-// #include <kon/xt/pause.hpp>
+#include <kon/xt/attributes.hpp>
+#include <kon/xt/pause.hpp>
 #include <thread>
 #include <atomic>
+#include <cstdint>
 
 namespace kon {
-class spin_lock {
-    struct [[nodiscard]] spin_wait {
-        spin_wait() noexcept = default;
-
-        inline void wait() noexcept {
-            if (count++ < yield_threshold) {
-                // rt::pause();
-            } else {
-                if (count == 0) [[unlikely]] {
-                    count = yield_threshold;
-                }
-                std::this_thread::yield();
+// The backoff of a waiter, the pauses double up to max_pauses per wait, then it yields so a
+// preempted holder can run.
+struct [[nodiscard]] spin_wait {
+    spin_wait() noexcept = default;
+
+    inline void wait() noexcept {
+        if (count < yield_threshold) {
+            for (std::uint32_t i = 0; i < pauses; i++) {
+                rt::pause();
             }
+            if (pauses < max_pauses) {
+                pauses *= 2;
+            }
+            count++;
+        } else {
+            std::this_thread::yield();
         }
-       private:
-        static constexpr uint32_t yield_threshold = 20;
-        uint32_t count{0};
-    };
+    }
+   private:
+    static constexpr std::uint32_t yield_threshold = 20;
+    static constexpr std::uint32_t max_pauses = 64;
+    std::uint32_t count{0};
+    std::uint32_t pauses{1};
+};
+
+// A test-and-test-and-set lock, the cheapest one without contention. It's unfair, see
+// ticket_lock and mcs_lock for the contended ones.
+class spin_lock {
    public:
     void lock() noexcept {
         spin_wait spin;
@@ -40,6 +52,12 @@ class spin_lock {
             old_state, 1, std::memory_order_acquire, std::memory_order_relaxed));
     }
 
+    bool try_lock() noexcept {
+        unsigned char old_state = 0;
+        return state.compare_exchange_strong(
+            old_state, 1, std::memory_order_acquire, std::memory_order_relaxed);
+    }
+
     void unlock() noexcept {
         state.store(0, std::memory_order_release);
     }
@@ -47,5 +65,170 @@ class spin_lock {
     std::atomic<unsigned char> state{0};
 };
 
+// A FIFO lock, a waiter takes a ticket and waits for its turn. The waiters still spin on the
+// same line, the backoff is proportional to the waiters ahead.
+// The FIFO locks need a core per waiter, with more threads than cores a preempted waiter stalls
+// the ones behind it, spin_lock or std::mutex fit there.
+class ticket_lock {
+   public:
+    void lock() noexcept {
+        auto ticket = m_next.fetch_add(1, std::memory_order_relaxed);
+        spin_wait spin;
+        while (true) {
+            auto serving = m_serving.load(std::memory_order_acquire);
+            if (serving == ticket) {
+                return;
+            }
+            for (std::uint32_t i = 1; i < (ticket - serving); i++) {
+                for (std::uint32_t k = 0; k < 16; k++) {
+                    rt::pause();
+                }
+            }
+            spin.wait();
+        }
+    }
+
+    bool try_lock() noexcept {
+        auto serving = m_serving.load(std::memory_order_relaxed);
+        auto ticket = serving;
+        return m_next.compare_exchange_strong(
+            ticket, serving + 1, std::memory_order_acquire, std::memory_order_relaxed);
+    }
+
+    void unlock() noexcept {
+        m_serving.store(m_serving.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+   private:
+    std::atomic<std::uint32_t> m_next{0};
+    std::atomic<std::uint32_t> m_serving{0};
+};
+
+// A FIFO queue lock (Mellor-Crummey and Scott), every waiter spins on its own node, so a release
+// touches the line of the next waiter only. The node lives from lock() to unlock(), usually on
+// the stack of the holder, see guard.
+class mcs_lock {
+   public:
+    struct alignas(64) node {
+        std::atomic<node *> next{nullptr};
+        std::atomic<bool> locked{false};
+    };
+
+    class [[nodiscard]] guard {
+       public:
+        explicit guard(mcs_lock &lock) noexcept
+            : m_lock{lock} {
+            m_lock.lock(m_node);
+        }
+
+        ~guard() noexcept {
+            m_lock.unlock(m_node);
+        }
+
+        KON_DISALLOW_COPY(guard);
+        KON_DISALLOW_MOVE(guard);
+       private:
+        mcs_lock &m_lock;
+        node m_node;
+    };
+
+    mcs_lock() noexcept = default;
+    KON_DISALLOW_COPY(mcs_lock);
+    KON_DISALLOW_MOVE(mcs_lock);
+
+    void lock(node &n) noexcept {
+        n.next.store(nullptr, std::memory_order_relaxed);
+        n.locked.store(true, std::memory_order_relaxed);
+        node *prev = m_tail.exchange(&n, std::memory_order_acq_rel);
+        if (prev == nullptr) {
+            return;
+        }
+        prev->next.store(&n, std::memory_order_release);
+        spin_wait spin;
+        while (n.locked.load(std::memory_order_acquire)) {
+            spin.wait();
+        }
+    }
+
+    bool try_lock(node &n) noexcept {
+        n.next.store(nullptr, std::memory_order_relaxed);
+        node *expected = nullptr;
+        return m_tail.compare_exchange_strong(
+            expected, &n, std::memory_order_acquire, std::memory_order_relaxed);
+    }
+
+    void unlock(node &n) noexcept {
+        node *next = n.next.load(std::memory_order_acquire);
+        if (next == nullptr) {
+            node *expected = &n;
+            if (m_tail.compare_exchange_strong(
+                    expected, nullptr, std::memory_order_release, std::memory_order_relaxed)) {
+                return;
+            }
+            // A waiter took the tail and is linking itself.
+            spin_wait spin;
+            while ((next = n.next.load(std::memory_order_acquire)) == nullptr) {
+                spin.wait();
+            }
+        }
+        next->locked.store(false, std::memory_order_release);
+    }
+   private:
+    std::atomic<node *> m_tail{nullptr};
+};
+
+// A reader-writer lock for read-mostly data, the readers share it, a writer holds it alone. A
+// waiting writer blocks the new readers, so the writers aren't starved. It fits
+// std::shared_lock and std::unique_lock.
+class rw_spin_lock {
+   public:
+    void lock() noexcept {
+        spin_wait spin;
+        // The writer bit first, then the readers drain.
+        while (m_state.fetch_or(writer, std::memory_order_acquire) & writer) {
+            while (m_state.load(std::memory_order_relaxed) & writer) {
+                spin.wait();
+            }
+        }
+        while (m_state.load(std::memory_order_acquire) != writer) {
+            spin.wait();
+        }
+    }
+
+    bool try_lock() noexcept {
+        std::uint32_t expected = 0;
+        return m_state.compare_exchange_strong(
+            expected, writer, std::memory_order_acquire, std::memory_order_relaxed);
+    }
+
+    void unlock() noexcept {
+        m_state.fetch_and(~writer, std::memory_order_release);
+    }
+
+    void lock_shared() noexcept {
+        spin_wait spin;
+        while (!try_lock_shared()) {
+            while (m_state.load(std::memory_order_relaxed) & writer) {
+                spin.wait();
+            }
+        }
+    }
+
+    bool try_lock_shared() noexcept {
+        if ((m_state.fetch_add(1, std::memory_order_acquire) & writer) == 0) {
+            return true;
+        }
+        m_state.fetch_sub(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    void unlock_shared() noexcept {
+        m_state.fetch_sub(1, std::memory_order_release);
+    }
+   private:
+    static constexpr std::uint32_t writer = std::uint32_t{1} << 31;
+
+    std::atomic<std::uint32_t> m_state{0}; // The writer bit and the readers.
+};
+
 } // namespace kon
-#endif // spin_lock.hpp
\ No newline at end of file
+#endif // spin_lock.hpp
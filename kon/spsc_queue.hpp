@@ -0,0 +1,143 @@
+// SPDX-FileCopyrightText: 2026 TypeCombinator <typecombinator@foxmail.com>
+//
+// SPDX-License-Identifier: BSD 3-Clause
+
+#ifndef SPSC_QUEUE_0CE45859_88FA_4D03_B02A_CA1661E6B32B
+#define SPSC_QUEUE_0CE45859_88FA_4D03_B02A_CA1661E6B32B
+#include <kon/xt/attributes.hpp>
+#include <atomic>
+#include <cstddef>
+#include <cstring>
+#include <type_traits>
+
+namespace kon {
+
+// A lock-free single producer single consumer queue of N fixed-size objects, e.g. pointers or
+// small events, see vlm_ring for variable-length messages.
+// The indices run freely and are on their own cache lines, each side keeps a copy of the index
+// of the other side and reloads it only when the queue looks full or empty, so the lines of the
+// indices move between the cores about once per N / 2 objects under load.
+template <typename T, std::size_t N>
+class spsc_queue {
+    static_assert(std::is_trivially_copyable_v<T>);
+    static_assert((N != 0) && ((N & (N - 1)) == 0), "N must be a power of 2");
+   public:
+    using value_type = T;
+
+    spsc_queue() noexcept = default;
+    KON_DISALLOW_COPY(spsc_queue);
+    KON_DISALLOW_MOVE(spsc_queue);
+
+    // The producer side.
+
+    bool try_push(const T &value) noexcept {
+        std::size_t tail = m_tail.load(std::memory_order_relaxed);
+        if ((tail - m_cached_head) == N) {
+            m_cached_head = m_head.load(std::memory_order_acquire);
+            if ((tail - m_cached_head) == N) {
+                return false;
+            }
+        }
+        std::memcpy(&m_slots[tail & mask], &value, sizeof(T));
+        m_tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Pushes up to count objects with a single publication, returns the number pushed.
+    std::size_t try_push_bulk(const T *values, std::size_t count) noexcept {
+        std::size_t tail = m_tail.load(std::memory_order_relaxed);
+        std::size_t space = N - (tail - m_cached_head);
+        if (space < count) {
+            m_cached_head = m_head.load(std::memory_order_acquire);
+            space = N - (tail - m_cached_head);
+        }
+        if (count > space) {
+            count = space;
+        }
+        copy_in(tail, values, count);
+        m_tail.store(tail + count, std::memory_order_release);
+        return count;
+    }
+
+    // The consumer side.
+
+    bool try_pop(T &value) noexcept {
+        std::size_t head = m_head.load(std::memory_order_relaxed);
+        if (head == m_cached_tail) {
+            m_cached_tail = m_tail.load(std::memory_order_acquire);
+            if (head == m_cached_tail) {
+                return false;
+            }
+        }
+        std::memcpy(&value, &m_slots[head & mask], sizeof(T));
+        m_head.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Pops up to count objects with a single release, returns the number popped.
+    std::size_t try_pop_bulk(T *values, std::size_t count) noexcept {
+        std::size_t head = m_head.load(std::memory_order_relaxed);
+        std::size_t ready = m_cached_tail - head;
+        if (ready < count) {
+            m_cached_tail = m_tail.load(std::memory_order_acquire);
+            ready = m_cached_tail - head;
+        }
+        if (count > ready) {
+            count = ready;
+        }
+        copy_out(head, values, count);
+        m_head.store(head + count, std::memory_order_release);
+        return count;
+    }
+
+    // A snapshot from any side.
+    [[nodiscard]]
+    std::size_t size() const noexcept {
+        std::size_t head = m_head.load(std::memory_order_acquire);
+        return m_tail.load(std::memory_order_acquire) - head;
+    }
+
+    [[nodiscard]]
+    bool empty() const noexcept {
+        return size() == 0;
+    }
+
+    [[nodiscard]]
+    static constexpr std::size_t capacity() noexcept {
+        return N;
+    }
+   private:
+    static constexpr std::size_t mask = N - 1;
+
+    struct slot {
+        alignas(T) unsigned char bytes[sizeof(T)];
+    };
+
+    // The slots from index on, in two parts if they wrap.
+    void copy_in(std::size_t index, const T *values, std::size_t count) noexcept {
+        std::size_t first = N - (index & mask);
+        if (first > count) {
+            first = count;
+        }
+        std::memcpy(&m_slots[index & mask], values, first * sizeof(T));
+        std::memcpy(&m_slots[0], values + first, (count - first) * sizeof(T));
+    }
+
+    void copy_out(std::size_t index, T *values, std::size_t count) const noexcept {
+        std::size_t first = N - (index & mask);
+        if (first > count) {
+            first = count;
+        }
+        std::memcpy(values, &m_slots[index & mask], first * sizeof(T));
+        std::memcpy(values + first, &m_slots[0], (count - first) * sizeof(T));
+    }
+
+    alignas(64) std::atomic<std::size_t> m_head{0}; // Written by the consumer.
+    std::size_t m_cached_tail{0};
+    alignas(64) std::atomic<std::size_t> m_tail{0}; // Written by the producer.
+    std::size_t m_cached_head{0};
+    alignas(64) slot m_slots[N];
+};
+
+} // namespace kon
+#endif // spsc_queue.hpp
@@ -0,0 +1,274 @@
+// SPDX-FileCopyrightText: 2026 TypeCombinator <typecombinator@foxmail.com>
+//
+// SPDX-License-Identifier: BSD 3-Clause
+
+#include <kon/string_helper.hpp>
+#include <kon/bit.hpp>
+#include <kon/xt/cpu.hpp>
+#include <cstring>
+#if defined(KON_ARCH_X86)
+    #include <immintrin.h>
+#elif defined(KON_ARCH_ARM64)
+    #include <arm_neon.h>
+#endif
+
+namespace kon {
+namespace {
+// Bit i is set if the bit i of x is the last of an odd number of set bits up to i, the quoted
+// regions are the runs from an opening quote (included) to its closing quote (excluded).
+inline std::uint64_t prefix_xor(std::uint64_t x) noexcept {
+    x ^= x << 1;
+    x ^= x << 2;
+    x ^= x << 4;
+    x ^= x << 8;
+    x ^= x << 16;
+    x ^= x << 32;
+    return x;
+}
+
+std::uint64_t field_scan_scalar(
+    const char *block,
+    const char *delimiters,
+    std::size_t count,
+    char quote,
+    std::uint64_t &quotes) noexcept {
+    std::uint64_t mask = 0;
+    quotes = 0;
+    for (std::size_t i = 0; i < 64; i++) {
+        char c = block[i];
+        for (std::size_t k = 0; k < count; k++) {
+            if (c == delimiters[k]) {
+                mask |= std::uint64_t{1} << i;
+            }
+        }
+        if (c == quote) {
+            quotes |= std::uint64_t{1} << i;
+        }
+    }
+    return mask;
+}
+
+#if defined(KON_ARCH_X86)
+inline std::uint64_t movemask_sse2(__m128i m0, __m128i m1, __m128i m2, __m128i m3) noexcept {
+    return static_cast<std::uint64_t>(static_cast<std::uint16_t>(_mm_movemask_epi8(m0))) |
+           (static_cast<std::uint64_t>(static_cast<std::uint16_t>(_mm_movemask_epi8(m1))) << 16) |
+           (static_cast<std::uint64_t>(static_cast<std::uint16_t>(_mm_movemask_epi8(m2))) << 32) |
+           (static_cast<std::uint64_t>(static_cast<std::uint16_t>(_mm_movemask_epi8(m3))) << 48);
+}
+
+KON_ATTR_TARGET("sse2")
+std::uint64_t field_scan_sse2(
+    const char *block,
+    const char *delimiters,
+    std::size_t count,
+    char quote,
+    std::uint64_t &quotes) noexcept {
+    __m128i v[4];
+    __m128i d[4];
+    for (int i = 0; i < 4; i++) {
+        v[i] = _mm_loadu_si128(reinterpret_cast<const __m128i *>(block) + i);
+        d[i] = _mm_setzero_si128();
+    }
+    for (std::size_t k = 0; k < count; k++) {
+        __m128i c = _mm_set1_epi8(delimiters[k]);
+        for (int i = 0; i < 4; i++) {
+            d[i] = _mm_or_si128(d[i], _mm_cmpeq_epi8(v[i], c));
+        }
+    }
+    __m128i q = _mm_set1_epi8(quote);
+    quotes = movemask_sse2(
+        _mm_cmpeq_epi8(v[0], q),
+        _mm_cmpeq_epi8(v[1], q),
+        _mm_cmpeq_epi8(v[2], q),
+        _mm_cmpeq_epi8(v[3], q));
+    return movemask_sse2(d[0], d[1], d[2], d[3]);
+}
+
+KON_ATTR_TARGET("avx2")
+std::uint64_t field_scan_avx2(
+    const char *block,
+    const char *delimiters,
+    std::size_t count,
+    char quote,
+    std::uint64_t &quotes) noexcept {
+    __m256i lo = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(block));
+    __m256i hi = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(block) + 1);
+    __m256i dlo = _mm256_setzero_si256();
+    __m256i dhi = _mm256_setzero_si256();
+    for (std::size_t k = 0; k < count; k++) {
+        __m256i c = _mm256_set1_epi8(delimiters[k]);
+        dlo = _mm256_or_si256(dlo, _mm256_cmpeq_epi8(lo, c));
+        dhi = _mm256_or_si256(dhi, _mm256_cmpeq_epi8(hi, c));
+    }
+    __m256i q = _mm256_set1_epi8(quote);
+    quotes = static_cast<std::uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(lo, q))) |
+             (static_cast<std::uint64_t>(
+                  static_cast<std::uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(hi, q))))
+              << 32);
+    return static_cast<std::uint32_t>(_mm256_movemask_epi8(dlo)) |
+           (static_cast<std::uint64_t>(static_cast<std::uint32_t>(_mm256_movemask_epi8(dhi)))
+            << 32);
+}
+
+KON_ATTR_TARGET("avx512f,avx512bw")
+std::uint64_t field_scan_avx512(
+    const char *block,
+    const char *delimiters,
+    std::size_t count,
+    char quote,
+    std::uint64_t &quotes) noexcept {
+    __m512i v = _mm512_loadu_si512(block);
+    __mmask64 mask = 0;
+    for (std::size_t k = 0; k < count; k++) {
+        mask |= _mm512_cmpeq_epi8_mask(v, _mm512_set1_epi8(delimiters[k]));
+    }
+    quotes = _mm512_cmpeq_epi8_mask(v, _mm512_set1_epi8(quote));
+    return mask;
+}
+#elif defined(KON_ARCH_ARM64)
+// There is no movemask on NEON, weight the bytes by their bit and add the pairs 3 times.
+inline std::uint64_t movemask_neon(
+    uint8x16_t m0,
+    uint8x16_t m1,
+    uint8x16_t m2,
+    uint8x16_t m3) noexcept {
+    const uint8x16_t bits = {1, 2, 4, 8, 16, 32, 64, 128, 1, 2, 4, 8, 16, 32, 64, 128};
+    uint8x16_t s0 = vpaddq_u8(vandq_u8(m0, bits), vandq_u8(m1, bits));
+    uint8x16_t s1 = vpaddq_u8(vandq_u8(m2, bits), vandq_u8(m3, bits));
+    s0 = vpaddq_u8(s0, s1);
+    s0 = vpaddq_u8(s0, s0);
+    return vgetq_lane_u64(vreinterpretq_u64_u8(s0), 0);
+}
+
+std::uint64_t field_scan_neon(
+    const char *block,
+    const char *delimiters,
+    std::size_t count,
+    char quote,
+    std::uint64_t &quotes) noexcept {
+    uint8x16_t v[4];
+    uint8x16_t d[4];
+    for (int i = 0; i < 4; i++) {
+        v[i] = vld1q_u8(reinterpret_cast<const std::uint8_t *>(block) + 16 * i);
+        d[i] = vdupq_n_u8(0);
+    }
+    for (std::size_t k = 0; k < count; k++) {
+        uint8x16_t c = vdupq_n_u8(static_cast<std::uint8_t>(delimiters[k]));
+        for (int i = 0; i < 4; i++) {
+            d[i] = vorrq_u8(d[i], vceqq_u8(v[i], c));
+        }
+    }
+    uint8x16_t q = vdupq_n_u8(static_cast<std::uint8_t>(quote));
+    quotes = movemask_neon(
+        vceqq_u8(v[0], q),
+        vceqq_u8(v[1], q),
+        vceqq_u8(v[2], q),
+        vceqq_u8(v[3], q));
+    return movemask_neon(d[0], d[1], d[2], d[3]);
+}
+#endif
+} // namespace
+
+field_splitter::field_splitter(
+    const char *str,
+    std::size_t size,
+    std::string_view delimiters,
+    char quote) noexcept {
+    m_str = str;
+    m_size = size;
+    m_next = 0;
+    m_base = 0;
+    m_mask = 0;
+    m_in_quote = 0;
+    m_field = 0;
+    m_count = (delimiters.size() < max_delimiters) ? delimiters.size() : max_delimiters;
+    std::memcpy(m_delimiters, delimiters.data(), m_count);
+    m_quote = quote;
+
+    m_scan = field_scan_scalar;
+#if defined(KON_ARCH_X86)
+    if (rt::cpu().avx512bw) {
+        m_scan = field_scan_avx512;
+    } else if (rt::cpu().avx2) {
+        m_scan = field_scan_avx2;
+    } else {
+        m_scan = field_scan_sse2;
+    }
+#elif defined(KON_ARCH_ARM64)
+    if (rt::cpu().neon) {
+        m_scan = field_scan_neon;
+    }
+#endif
+}
+
+void field_splitter::scan() noexcept {
+    const char *block = m_str + m_next;
+    std::size_t left = m_size - m_next;
+    alignas(64) char tail[64];
+    if (left < 64) {
+        std::memcpy(tail, block, left);
+        std::memset(tail + left, 0, 64 - left);
+        block = tail;
+    }
+    std::uint64_t quotes;
+    std::uint64_t mask = m_scan(block, m_delimiters, m_count, m_quote, quotes);
+    if (left < 64) {
+        std::uint64_t valid = (std::uint64_t{1} << left) - 1;
+        mask &= valid;
+        quotes &= valid;
+    }
+    if (m_quote != '\0') {
+        std::uint64_t inside = prefix_xor(quotes) ^ m_in_quote;
+        m_in_quote = static_cast<std::uint64_t>(static_cast<std::int64_t>(inside) >> 63);
+        mask &= ~inside;
+    }
+    m_base = m_next;
+    m_mask = mask;
+    m_next += 64;
+}
+
+std::size_t field_splitter::next_offsets(std::size_t *offsets, std::size_t capacity) noexcept {
+    std::size_t n = 0;
+    while (n < capacity) {
+        if (m_mask == 0) {
+            if (m_next >= m_size) {
+                break;
+            }
+            scan();
+            continue;
+        }
+        if (static_cast<std::size_t>(popcount(m_mask)) <= (capacity - n)) {
+            bit_iterator<std::uint64_t> it{m_mask};
+            std::size_t index;
+            while (it.next(index)) {
+                offsets[n++] = m_base + index;
+            }
+            m_mask = 0;
+        } else {
+            offsets[n++] = m_base + countr_zero<std::uint64_t, true>(m_mask);
+            m_mask &= m_mask - 1;
+        }
+    }
+    return n;
+}
+
+bool field_splitter::next(std::string_view &result) noexcept {
+    while (m_mask == 0) {
+        if (m_next >= m_size) {
+            if ((m_field > m_size) || (m_size == 0)) {
+                return false;
+            }
+            result = std::string_view(m_str + m_field, m_size - m_field);
+            m_field = m_size + 1;
+            return true;
+        }
+        scan();
+    }
+    std::size_t offset = m_base + countr_zero<std::uint64_t, true>(m_mask);
+    m_mask &= m_mask - 1;
+    result = std::string_view(m_str + m_field, offset - m_field);
+    m_field = offset + 1;
+    return true;
+}
+
+} // namespace kon
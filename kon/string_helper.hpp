@@ -4,6 +4,8 @@
 
 #ifndef STRING_HELPER_34B723F0_16AA_49CF_9CE4_67CA9538C1FE
 #define STRING_HELPER_34B723F0_16AA_49CF_9CE4_67CA9538C1FE
+#include <cstddef>
+#include <cstdint>
 #include <string_view>
 
 namespace kon {
@@ -38,6 +40,49 @@ struct string_splitter {
     const char *buf_end;
 };
 
+// Splits on a set of delimiters, 64 bytes are classified per step with SSE2 / AVX2 / AVX-512BW /
+// NEON compares into bitmasks. Unlike string_splitter, the empty fields are kept, e.g. "a,,b,"
+// has 4 fields: "a", "", "b" and "". With a quote character, the delimiters between a pair of
+// quotes are ignored (CSV), the quoted fields are returned as is, quotes included.
+class field_splitter {
+   public:
+    static constexpr std::size_t max_delimiters = 8;
+
+    // Only the first max_delimiters characters of delimiters are used, '\0' disables quoting.
+    field_splitter(
+        const char *str,
+        std::size_t size,
+        std::string_view delimiters,
+        char quote = '\0') noexcept;
+
+    // Stores the offsets of the next delimiters into offsets, returns the number of offsets, less
+    // than capacity at the end of the string. Field i spans [offsets[i - 1] + 1, offsets[i]).
+    std::size_t next_offsets(std::size_t *offsets, std::size_t capacity) noexcept;
+
+    bool next(std::string_view &result) noexcept;
+   private:
+    using scan_fn = std::uint64_t (*)(
+        const char *block,
+        const char *delimiters,
+        std::size_t count,
+        char quote,
+        std::uint64_t &quotes) noexcept;
+
+    void scan() noexcept;
+
+    const char *m_str;
+    std::size_t m_size;
+    std::size_t m_next;       // offset of the next block to scan
+    std::size_t m_base;       // offset of the current block
+    std::uint64_t m_mask;     // delimiters of the current block not yet returned
+    std::uint64_t m_in_quote; // all ones if the previous block ends inside quotes
+    std::size_t m_field;      // start of the next field, m_size + 1 once the last one is returned
+    scan_fn m_scan;
+    std::size_t m_count;
+    char m_delimiters[max_delimiters];
+    char m_quote;
+};
+
 } // namespace kon
 
 #endif /* string_helper.hpp */
\ No newline at end of file
@@ -29,11 +29,27 @@ class vlm_ring {
         : buffer(new std::uint8_t[message_align(size + sizeof(message_head))])
         , windex(0)
         , rindex(0)
-        , buffer_size(size) {
+        , buffer_size(size)
+        , owned(true) {
+    }
+
+    // The storage is borrowed (e.g. from an arena or a shm), it must hold storage_size(size) bytes.
+    vlm_ring(std::uint8_t* storage, std::size_t size) noexcept
+        : windex(0)
+        , rindex(0)
+        , buffer_size(size)
+        , buffer(storage)
+        , owned(false) {
     }
 
     ~vlm_ring() {
-        delete[] buffer;
+        if (owned) {
+            delete[] buffer;
+        }
+    }
+
+    static std::size_t storage_size(std::size_t size) noexcept {
+        return message_align(size + sizeof(message_head));
     }
 
     [[nodiscard]]
@@ -193,6 +209,7 @@ class vlm_ring {
     std::atomic_size_t windex, rindex;
     std::size_t buffer_size;
     std::uint8_t* buffer;
+    bool owned;
 };
 } // namespace kon
 
@@ -0,0 +1,153 @@
+// SPDX-FileCopyrightText: 2026 TypeCombinator <typecombinator@foxmail.com>
+//
+// SPDX-License-Identifier: BSD 3-Clause
+
+#include <kon/wire.hpp>
+#include <kon/xt/cpu.hpp>
+#include <utility>
+#if defined(KON_ARCH_X86)
+    #include <immintrin.h>
+#elif defined(KON_ARCH_ARM64)
+    #include <arm_neon.h>
+#endif
+
+namespace kon::detail {
+
+static void wire_byteswap_scalar(
+    std::uint8_t *dst,
+    const std::uint8_t *src,
+    std::size_t count,
+    const wire_byteswap_plan &plan) noexcept {
+    const std::size_t size = plan.record_size;
+    const std::uint8_t *permutation = plan.permutation;
+    if (dst == src) {
+        // The permutation reverses the fields, swapping the pairs undoes it.
+        for (std::size_t r = 0; r < count; r++, dst += size) {
+            for (std::size_t i = 0; i < size; i++) {
+                if (permutation[i] > i) {
+                    std::swap(dst[i], dst[permutation[i]]);
+                }
+            }
+        }
+        return;
+    }
+    for (std::size_t r = 0; r < count; r++, dst += size, src += size) {
+        for (std::size_t i = 0; i < size; i++) {
+            dst[i] = src[permutation[i]];
+        }
+    }
+}
+
+#if defined(KON_ARCH_X86)
+KON_ATTR_TARGET("avx2")
+static void wire_byteswap_avx2(
+    std::uint8_t *dst,
+    const std::uint8_t *src,
+    std::size_t blocks,
+    const wire_byteswap_plan &plan) noexcept {
+    const std::size_t block = plan.block_size;
+    for (std::size_t b = 0; b < blocks; b++, src += block, dst += block) {
+        for (std::size_t i = 0; i < block; i += 32) {
+            __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(src + i));
+            __m256i mask = _mm256_load_si256(reinterpret_cast<const __m256i *>(plan.masks + i));
+            _mm256_storeu_si256(reinterpret_cast<__m256i *>(dst + i), _mm256_shuffle_epi8(v, mask));
+        }
+    }
+}
+
+// The 16 bytes are loaded before the previous ones are stored, it also works in place.
+KON_ATTR_TARGET("ssse3")
+static void wire_byteswap_ssse3(
+    std::uint8_t *dst,
+    const std::uint8_t *src,
+    std::size_t blocks,
+    const wire_byteswap_plan &plan) noexcept {
+    const std::size_t block = plan.block_size;
+    for (std::size_t b = 0; b < blocks; b++, src += block, dst += block) {
+        __m128i prev = _mm_setzero_si128();
+        __m128i current = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src));
+        for (std::size_t i = 0; i < block; i += 16) {
+            __m128i next = _mm_setzero_si128();
+            if ((i + 16) < block) {
+                next = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i + 16));
+            }
+            auto mask = [&plan, i](const std::uint8_t *masks) {
+                return _mm_load_si128(reinterpret_cast<const __m128i *>(masks + i));
+            };
+            __m128i v = _mm_shuffle_epi8(current, mask(plan.masks));
+            if (plan.crossing) {
+                v = _mm_or_si128(v, _mm_shuffle_epi8(prev, mask(plan.prev_masks)));
+                v = _mm_or_si128(v, _mm_shuffle_epi8(next, mask(plan.next_masks)));
+            }
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i), v);
+            prev = current;
+            current = next;
+        }
+    }
+}
+#elif defined(KON_ARCH_ARM64)
+static void wire_byteswap_neon(
+    std::uint8_t *dst,
+    const std::uint8_t *src,
+    std::size_t blocks,
+    const wire_byteswap_plan &plan) noexcept {
+    const std::size_t block = plan.block_size;
+    for (std::size_t b = 0; b < blocks; b++, src += block, dst += block) {
+        uint8x16_t prev = vdupq_n_u8(0);
+        uint8x16_t current = vld1q_u8(src);
+        for (std::size_t i = 0; i < block; i += 16) {
+            uint8x16_t next = vdupq_n_u8(0);
+            if ((i + 16) < block) {
+                next = vld1q_u8(src + i + 16);
+            }
+            // The indexes out of the table (0x80) give 0, like pshufb.
+            uint8x16_t v = vqtbl1q_u8(current, vld1q_u8(plan.masks + i));
+            if (plan.crossing) {
+                v = vorrq_u8(v, vqtbl1q_u8(prev, vld1q_u8(plan.prev_masks + i)));
+                v = vorrq_u8(v, vqtbl1q_u8(next, vld1q_u8(plan.next_masks + i)));
+            }
+            vst1q_u8(dst + i, v);
+            prev = current;
+            current = next;
+        }
+    }
+}
+#endif
+
+// Returns the number of records converted by SIMD, the caller handles the rest.
+static std::size_t wire_byteswap_simd(
+    std::uint8_t *dst,
+    const std::uint8_t *src,
+    std::size_t count,
+    const wire_byteswap_plan &plan) noexcept {
+    if (plan.block_size == 0) {
+        return 0;
+    }
+    std::size_t blocks = count * plan.record_size / plan.block_size;
+#if defined(KON_ARCH_X86)
+    if (!plan.crossing && rt::cpu().avx2) {
+        wire_byteswap_avx2(dst, src, blocks, plan);
+    } else if (rt::cpu().ssse3) {
+        wire_byteswap_ssse3(dst, src, blocks, plan);
+    } else {
+        return 0;
+    }
+#elif defined(KON_ARCH_ARM64)
+    wire_byteswap_neon(dst, src, blocks, plan);
+#else
+    return 0;
+#endif
+    return blocks * plan.block_size / plan.record_size;
+}
+
+void wire_byteswap(
+    std::uint8_t *dst,
+    const std::uint8_t *src,
+    std::size_t count,
+    const wire_byteswap_plan &plan) noexcept {
+    std::size_t done = wire_byteswap_simd(dst, src, count, plan);
+    std::size_t offset = done * plan.record_size;
+    wire_byteswap_scalar(dst + offset, src + offset, count - done, plan);
+}
+
+} // namespace kon::detail
@@ -0,0 +1,481 @@
+// SPDX-FileCopyrightText: 2026 TypeCombinator <typecombinator@foxmail.com>
+//
+// SPDX-License-Identifier: BSD 3-Clause
+
+#ifndef WIRE_3124E06E_6784_450E_812E_789744F1153C
+#define WIRE_3124E06E_6784_450E_812E_789744F1153C
+#include <kon/bit.hpp>
+#include <kon/dbuf.hpp>
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <numeric>
+#include <span>
+#include <tuple>
+#include <type_traits>
+
+namespace kon {
+
+// The field kinds of a wire layout, a field is a type derived from one of them, e.g.
+//     struct total_length : kon::wire_uint<std::uint16_t> {};
+template <typename T>
+    requires(std::is_integral_v<T>)
+struct wire_uint {
+    using value_type = T;
+    static constexpr std::size_t bits = sizeof(T) * 8;
+};
+
+// Packed from the most significant bit, like the network headers, the big endian layouts only.
+template <std::size_t Bits>
+    requires((Bits > 0) && (Bits <= 57))
+struct wire_bits {
+    using value_type = std::conditional_t<
+        (Bits <= 8),
+        std::uint8_t,
+        std::conditional_t<
+            (Bits <= 16),
+            std::uint16_t,
+            std::conditional_t<(Bits <= 32), std::uint32_t, std::uint64_t>>>;
+    static constexpr std::size_t bits = Bits;
+};
+
+// It must hold the value, validate() checks it.
+template <typename T, T Value>
+struct wire_const : wire_uint<T> {
+    static constexpr T expected = Value;
+};
+
+template <typename T, std::size_t N>
+    requires(std::is_integral_v<T>)
+struct wire_array {
+    using value_type = T;
+    static constexpr std::size_t bits = sizeof(T) * 8 * N;
+    static constexpr std::size_t count = N;
+};
+
+// The variable part after the fixed one, the last field. Its length is
+// LengthField * Scale + Bias bytes, or the rest of the data without a length field.
+template <typename LengthField = void, std::size_t Scale = 1, std::ptrdiff_t Bias = 0>
+struct wire_tail {
+    using length_field = LengthField;
+    static constexpr std::size_t bits = 0;
+    static constexpr std::size_t scale = Scale;
+    static constexpr std::ptrdiff_t bias = Bias;
+};
+
+namespace detail {
+template <typename F>
+concept wire_array_field = requires { F::count; };
+
+template <typename F>
+concept wire_const_field = requires { F::expected; };
+
+template <typename F>
+concept wire_tail_field = requires { typename F::length_field; };
+} // namespace detail
+
+template <std::endian Order, typename... Fields>
+    requires(sizeof...(Fields) > 0)
+struct basic_wire_layout {
+    static constexpr std::endian order = Order;
+
+    template <typename F>
+    static constexpr std::size_t index_of = []() {
+        constexpr bool matches[] = {std::is_same_v<F, Fields>...};
+        for (std::size_t i = 0; i < sizeof...(Fields); i++) {
+            if (matches[i]) {
+                return i;
+            }
+        }
+        return sizeof...(Fields);
+    }();
+
+    template <typename F>
+    static constexpr bool contains = index_of<F> < sizeof...(Fields);
+
+    template <typename F>
+        requires(contains<F>)
+    static constexpr std::size_t bit_offset_of = []() {
+        constexpr std::size_t bits[] = {Fields::bits...};
+        std::size_t offset = 0;
+        for (std::size_t i = 0; i < index_of<F>; i++) {
+            offset += bits[i];
+        }
+        return offset;
+    }();
+
+    // The size of the fixed part.
+    static constexpr std::size_t size = (0 + ... + Fields::bits) / 8;
+
+    static constexpr bool has_tail = (detail::wire_tail_field<Fields> || ...);
+
+    static_assert(((0 + ... + Fields::bits) % 8) == 0, "The fixed part must be whole bytes.");
+    static_assert(
+        !has_tail || detail::wire_tail_field<std::tuple_element_t<
+            sizeof...(Fields) - 1,
+            std::tuple<Fields...>>>,
+        "The tail must be the last field.");
+};
+
+template <typename... Fields>
+using wire_layout = basic_wire_layout<std::endian::big, Fields...>;
+
+template <typename... Fields>
+using wire_layout_le = basic_wire_layout<std::endian::little, Fields...>;
+
+// Typed accessors over a wire format without copying it. Unlike bio, it knows the whole layout,
+// so read<F...>() decodes neighbouring fields from one load, and validate() checks the header in
+// one call.
+template <typename Layout>
+class wire_view {
+    static constexpr bool big = Layout::order == std::endian::big;
+    static constexpr bool need_swap = Layout::order != std::endian::native;
+
+    template <typename F>
+    static constexpr std::size_t bit_offset = Layout::template bit_offset_of<F>;
+
+    template <typename F>
+    static constexpr bool byte_aligned =
+        ((bit_offset<F> % 8) == 0) && (F::bits == (sizeof(typename F::value_type) * 8)) &&
+        !detail::wire_array_field<F> && !detail::wire_tail_field<F>;
+
+    // Loads N bytes at p as the high (big endian) or the low (little endian) bytes of W.
+    template <typename W, std::size_t N>
+    static W load(const std::uint8_t *p) noexcept {
+        static_assert(N <= sizeof(W));
+        W w = 0;
+        std::memcpy(&w, p, N);
+        if constexpr (need_swap) {
+            w = swap(w);
+        }
+        return w;
+    }
+
+    template <typename W>
+    static W swap(W w) noexcept {
+        if constexpr (sizeof(W) == 1) {
+            return w;
+        } else {
+            return byteswap(w);
+        }
+    }
+   public:
+    using layout = Layout;
+
+    wire_view() noexcept = default;
+
+    wire_view(std::uint8_t *data, std::size_t size) noexcept
+        : m_data{data}
+        , m_size{size} {
+    }
+
+    // Over the data of the dbuf.
+    explicit wire_view(const dbuf &buf) noexcept
+        : m_data{buf.data()}
+        , m_size{buf.data_length()} {
+    }
+
+    std::uint8_t *data() const noexcept {
+        return m_data;
+    }
+
+    std::size_t size() const noexcept {
+        return m_size;
+    }
+
+    template <typename F>
+        requires(Layout::template contains<F> && !detail::wire_array_field<F> &&
+                 !detail::wire_tail_field<F>)
+    typename F::value_type get() const noexcept {
+        using T = typename F::value_type;
+        constexpr std::size_t offset = bit_offset<F> / 8;
+        if constexpr (byte_aligned<F>) {
+            T v;
+            std::memcpy(&v, m_data + offset, sizeof(v));
+            if constexpr (need_swap && (sizeof(T) > 1)) {
+                return byteswap(v);
+            } else {
+                return v;
+            }
+        } else {
+            static_assert(big, "The bit fields are in the big endian layouts only.");
+            constexpr std::size_t shift = bit_offset<F> % 8;
+            constexpr std::size_t n = (shift + F::bits + 7) / 8;
+            auto w = load<std::uint64_t, n>(m_data + offset);
+            return static_cast<T>((w << shift) >> (64 - F::bits));
+        }
+    }
+
+    template <typename F>
+        requires(Layout::template contains<F> && detail::wire_array_field<F>)
+    typename F::value_type get(std::size_t index) const noexcept {
+        using T = typename F::value_type;
+        static_assert((bit_offset<F> % 8) == 0);
+        T v;
+        std::memcpy(&v, m_data + bit_offset<F> / 8 + index * sizeof(T), sizeof(v));
+        if constexpr (need_swap && (sizeof(T) > 1)) {
+            return byteswap(v);
+        } else {
+            return v;
+        }
+    }
+
+    template <typename F>
+        requires(Layout::template contains<F> && !detail::wire_array_field<F> &&
+                 !detail::wire_tail_field<F>)
+    void set(const std::type_identity_t<typename F::value_type> &value) const noexcept {
+        using T = typename F::value_type;
+        constexpr std::size_t offset = bit_offset<F> / 8;
+        if constexpr (byte_aligned<F>) {
+            T v = value;
+            if constexpr (need_swap && (sizeof(T) > 1)) {
+                v = byteswap(v);
+            }
+            std::memcpy(m_data + offset, &v, sizeof(v));
+        } else {
+            static_assert(big, "The bit fields are in the big endian layouts only.");
+            constexpr std::size_t shift = bit_offset<F> % 8;
+            constexpr std::size_t n = (shift + F::bits + 7) / 8;
+            constexpr std::uint64_t mask = ((std::uint64_t{1} << F::bits) - 1)
+                                        << (64 - shift - F::bits);
+            auto w = load<std::uint64_t, n>(m_data + offset);
+            auto bits = static_cast<std::uint64_t>(value) << (64 - shift - F::bits);
+            w = (w & ~mask) | (bits & mask);
+            if constexpr (need_swap) {
+                w = swap(w);
+            }
+            std::memcpy(m_data + offset, &w, n);
+        }
+    }
+
+    template <typename F>
+        requires(Layout::template contains<F> && detail::wire_array_field<F>)
+    void set(std::size_t index, const std::type_identity_t<typename F::value_type> &value)
+        const noexcept {
+        using T = typename F::value_type;
+        T v = value;
+        if constexpr (need_swap && (sizeof(T) > 1)) {
+            v = byteswap(v);
+        }
+        std::memcpy(m_data + bit_offset<F> / 8 + index * sizeof(T), &v, sizeof(v));
+    }
+
+    // Several fields at once, e.g. auto [version, ihl, length] = view.read<version, ihl, length>();
+    // The bit fields within 8 bytes come from one load and shifts. A byte aligned field is a single
+    // movbe / rev load, it's faster than extracting it from a wider load.
+    template <typename... F>
+        requires((Layout::template contains<F> && ...) && (sizeof...(F) > 0) &&
+                 ((!detail::wire_array_field<F> && !detail::wire_tail_field<F>) && ...))
+    std::tuple<typename F::value_type...> read() const noexcept {
+        constexpr std::size_t low = std::min({bit_offset<F>...}) / 8;
+        constexpr std::size_t high = (std::max({(bit_offset<F> + F::bits)...}) + 7) / 8;
+        constexpr std::size_t n = high - low;
+        if constexpr ((n <= sizeof(std::uint64_t)) && !(byte_aligned<F> && ...)) {
+            auto w = load<std::uint64_t, n>(m_data + low);
+            return {field_of<low, F>(w)...};
+        } else {
+            return {get<F>()...};
+        }
+    }
+
+    // The bytes after the fixed part.
+    std::span<std::uint8_t> tail() const noexcept {
+        return {m_data + Layout::size, tail_length()};
+    }
+
+    // The size of the fixed part and of the tail, and the wire_const fields.
+    bool validate() const noexcept {
+        if (m_size < Layout::size) {
+            return false;
+        }
+        if constexpr (Layout::has_tail) {
+            if (tail_length() > (m_size - Layout::size)) {
+                return false;
+            }
+        }
+        return check_constants(static_cast<Layout *>(nullptr));
+    }
+   private:
+    template <std::size_t low, typename F>
+    static typename F::value_type field_of(std::uint64_t w) noexcept {
+        constexpr std::size_t position = bit_offset<F> - low * 8;
+        constexpr std::uint64_t mask = (F::bits == 64) ? ~std::uint64_t{0}
+                                                       : ((std::uint64_t{1} << F::bits) - 1);
+        if constexpr (big) {
+            return static_cast<typename F::value_type>((w >> (64 - position - F::bits)) & mask);
+        } else {
+            return static_cast<typename F::value_type>((w >> position) & mask);
+        }
+    }
+
+    std::size_t tail_length() const noexcept {
+        if constexpr (Layout::has_tail) {
+            using tail_field = std::remove_cvref_t<decltype(last_field(
+                static_cast<Layout *>(nullptr)))>;
+            if constexpr (!std::is_void_v<typename tail_field::length_field>) {
+                auto length = static_cast<std::ptrdiff_t>(
+                                  get<typename tail_field::length_field>()) *
+                                  static_cast<std::ptrdiff_t>(tail_field::scale) +
+                              tail_field::bias;
+                return (length < 0) ? SIZE_MAX : static_cast<std::size_t>(length);
+            }
+        }
+        return (m_size > Layout::size) ? (m_size - Layout::size) : 0;
+    }
+
+    template <std::endian O, typename... Fields>
+        requires(sizeof...(Fields) > 0)
+    static auto last_field(basic_wire_layout<O, Fields...> *) noexcept
+        -> std::tuple_element_t<sizeof...(Fields) - 1, std::tuple<Fields...>>;
+
+    template <std::endian O, typename... Fields>
+        requires(sizeof...(Fields) > 0)
+    bool check_constants(basic_wire_layout<O, Fields...> *) const noexcept {
+        return (check_constant<Fields>() && ...);
+    }
+
+    template <typename F>
+    bool check_constant() const noexcept {
+        if constexpr (detail::wire_const_field<F>) {
+            return get<F>() == F::expected;
+        } else {
+            return true;
+        }
+    }
+
+    std::uint8_t *m_data{nullptr};
+    std::size_t m_size{0};
+};
+
+namespace detail {
+// The byte permutation converting a block of records. The output of every 16 bytes is shuffled
+// from the same 16 bytes of the input (masks), and from the neighbour ones (prev_masks,
+// next_masks) if an element crosses them, 0x80 picks no byte.
+struct wire_byteswap_plan {
+    std::uint32_t record_size;
+    std::uint32_t block_size; // 0 without SIMD, the fields only move inside the records.
+    bool crossing; // Whether any element crosses 16 bytes, the neighbour masks are all 0x80 if not.
+    const std::uint8_t *permutation; // record_size entries
+    const std::uint8_t *masks; // block_size entries for each
+    const std::uint8_t *prev_masks;
+    const std::uint8_t *next_masks;
+};
+
+void wire_byteswap(
+    std::uint8_t *dst,
+    const std::uint8_t *src,
+    std::size_t count,
+    const wire_byteswap_plan &plan) noexcept;
+
+template <typename F>
+constexpr std::size_t wire_element_size() noexcept {
+    // A tail has no value_type, it's rejected on its own before the value_type is named.
+    static_assert(!wire_tail_field<F>, "The bulk conversion takes the fixed size records only.");
+    if constexpr (wire_tail_field<F>) {
+        return 0;
+    } else {
+        static_assert(
+            ((F::bits % 8) == 0) && ((F::bits / 8) % sizeof(typename F::value_type) == 0) &&
+                (sizeof(typename F::value_type) <= 8),
+            "The bulk conversion takes the byte aligned integers up to 64 bits and their arrays.");
+        return sizeof(typename F::value_type);
+    }
+}
+
+template <typename Layout>
+struct wire_byteswap_tables {
+    static constexpr std::size_t record_size = Layout::size;
+
+    template <std::endian O, typename... Fields>
+    static constexpr auto make_permutation(basic_wire_layout<O, Fields...> *) noexcept {
+        std::array<std::uint8_t, record_size> permutation{};
+        constexpr std::size_t element_sizes[] = {wire_element_size<Fields>()...};
+        constexpr std::size_t field_sizes[] = {(Fields::bits / 8)...};
+        std::size_t offset = 0;
+        for (std::size_t f = 0; f < sizeof...(Fields); f++) {
+            std::size_t e = element_sizes[f];
+            for (std::size_t i = 0; i < field_sizes[f]; i++) {
+                std::size_t start = offset + (i / e) * e;
+                permutation[offset + i] = static_cast<std::uint8_t>(start + (e - 1 - i % e));
+            }
+            offset += field_sizes[f];
+        }
+        return permutation;
+    }
+
+    static_assert(record_size <= 256, "The records are up to 256 bytes.");
+    static constexpr std::array<std::uint8_t, record_size> permutation =
+        make_permutation(static_cast<Layout *>(nullptr));
+
+    // lcm(record_size, 32), a whole number of records in a whole number of 32 bytes.
+    static constexpr std::size_t block_size = []() {
+        std::size_t block = std::lcm(record_size, std::size_t{32});
+        return (block <= 1024) ? block : 0;
+    }();
+    static constexpr std::size_t mask_size = (block_size != 0) ? block_size : 32;
+
+    // shift is -1 / 0 / 1 for the previous / same / next 16 bytes.
+    static constexpr auto make_masks(int shift) noexcept {
+        std::array<std::uint8_t, mask_size> masks{};
+        for (std::size_t d = 0; d < mask_size; d++) {
+            std::size_t s = (d / record_size) * record_size + permutation[d % record_size];
+            int chunk = static_cast<int>(s / 16) - static_cast<int>(d / 16);
+            masks[d] = (chunk == shift) ? static_cast<std::uint8_t>(s % 16) : 0x80;
+        }
+        return masks;
+    }
+
+    alignas(32) static constexpr std::array<std::uint8_t, mask_size> masks = make_masks(0);
+    alignas(16) static constexpr std::array<std::uint8_t, mask_size> prev_masks = make_masks(-1);
+    alignas(16) static constexpr std::array<std::uint8_t, mask_size> next_masks = make_masks(1);
+
+    static constexpr bool crossing = []() {
+        for (std::size_t d = 0; d < mask_size; d++) {
+            if ((prev_masks[d] != 0x80) || (next_masks[d] != 0x80)) {
+                return true;
+            }
+        }
+        return false;
+    }();
+
+    static constexpr wire_byteswap_plan plan{
+        static_cast<std::uint32_t>(record_size),
+        static_cast<std::uint32_t>(block_size),
+        crossing,
+        permutation.data(),
+        masks.data(),
+        prev_masks.data(),
+        next_masks.data()};
+};
+} // namespace detail
+
+// Converts count records of the layout between the wire and the host byte order, dst may be src.
+// The shuffles are derived from the layout at compile time, use wire_view for single fields.
+template <typename Layout>
+void wire_byteswap(void *dst, const void *src, std::size_t count) noexcept {
+    if constexpr (Layout::order == std::endian::native) {
+        if (dst != src) {
+            std::memmove(dst, src, count * Layout::size);
+        }
+    } else {
+        detail::wire_byteswap(
+            static_cast<std::uint8_t *>(dst),
+            static_cast<const std::uint8_t *>(src),
+            count,
+            detail::wire_byteswap_tables<Layout>::plan);
+    }
+}
+
+// In place over an array of T laid out as the layout.
+template <typename Layout, typename T>
+    requires(std::is_trivially_copyable_v<T>)
+void wire_byteswap(T *records, std::size_t count) noexcept {
+    static_assert(sizeof(T) == Layout::size, "T doesn't match the layout.");
+    wire_byteswap<Layout>(records, records, count);
+}
+
+} // namespace kon
+#endif // wire.hpp
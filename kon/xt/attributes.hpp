@@ -33,6 +33,14 @@
     #define KON_ATTR_ASSUME(_cond_)
 #endif
 
+// Compile a single function for an instruction set extension, e.g. KON_ATTR_TARGET("avx2"), the
+// caller is responsible for checking kon::rt::cpu() first.
+#if defined(__GNUC__) || defined(__clang__)
+    #define KON_ATTR_TARGET(_isa_) __attribute__((target(_isa_)))
+#else
+    #define KON_ATTR_TARGET(_isa_)
+#endif
+
 #define KON_DISALLOW_COPY(_name_)                                                                  \
     _name_(const _name_ &) = delete;                                                               \
     _name_ &operator=(const _name_ &) = delete
@@ -0,0 +1,79 @@
+#ifndef XT_CPU_6A1C3E5F_2B7D_4F0A_9C84_5D3E21B7F0C6
+#define XT_CPU_6A1C3E5F_2B7D_4F0A_9C84_5D3E21B7F0C6
+#include <kon/xt/attributes.hpp>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+    #define KON_ARCH_X86 1
+    #include <cpuid.h>
+#elif defined(__aarch64__) || defined(_M_ARM64)
+    #define KON_ARCH_ARM64 1
+    #if defined(__linux__)
+        #include <sys/auxv.h>
+        #include <asm/hwcap.h>
+    #endif
+#endif
+
+namespace kon::rt {
+
+// Instruction set extensions detected at run time, SIMD kernels are dispatched by these flags, so
+// the library can be built without any `-m` option.
+struct cpu_features {
+    // x86
+    bool sse42;
+    bool ssse3;
+    bool pclmul;
+    bool popcnt;
+    bool avx2;
+    bool bmi2;
+    bool avx512f;
+    bool avx512bw;
+    bool sha;
+    // ARMv8
+    bool neon;
+    bool crc32;
+    bool sha2;
+};
+
+namespace detail {
+static inline cpu_features cpu_detect() noexcept {
+    cpu_features f{};
+#if defined(KON_ARCH_X86) && (defined(__GNUC__) || defined(__clang__))
+    __builtin_cpu_init();
+    f.sse42 = __builtin_cpu_supports("sse4.2");
+    f.ssse3 = __builtin_cpu_supports("ssse3");
+    f.pclmul = __builtin_cpu_supports("pclmul");
+    f.popcnt = __builtin_cpu_supports("popcnt");
+    // __builtin_cpu_supports also checks that the OS saves the YMM/ZMM state.
+    f.avx2 = __builtin_cpu_supports("avx2");
+    f.bmi2 = __builtin_cpu_supports("bmi2");
+    f.avx512f = __builtin_cpu_supports("avx512f");
+    f.avx512bw = __builtin_cpu_supports("avx512bw");
+    unsigned eax, ebx, ecx, edx;
+    if (__get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx)) {
+        f.sha = (ebx >> 29) & 1;
+    }
+#elif defined(KON_ARCH_ARM64)
+    f.neon = true; // Mandatory for AArch64.
+    #if defined(__linux__)
+    auto hwcap = ::getauxval(AT_HWCAP);
+    f.crc32 = (hwcap & HWCAP_CRC32) != 0;
+    f.sha2 = (hwcap & HWCAP_SHA2) != 0;
+    #else
+        #if defined(__ARM_FEATURE_CRC32)
+    f.crc32 = true;
+        #endif
+        #if defined(__ARM_FEATURE_SHA2)
+    f.sha2 = true;
+        #endif
+    #endif
+#endif
+    return f;
+}
+} // namespace detail
+
+inline const cpu_features &cpu() noexcept {
+    static const cpu_features features = detail::cpu_detect();
+    return features;
+}
+} // namespace kon::rt
+#endif // cpu.hpp
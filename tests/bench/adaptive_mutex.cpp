@@ -0,0 +1,102 @@
+#include <benchmark/benchmark.h>
+#include <kon/adaptive_mutex.hpp>
+#include <kon/spin_lock.hpp>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <mutex>
+
+namespace {
+// The critical sections of the log sinks, a copy into a ring (log_sink_circular_buffer) and a
+// buffered fwrite to a file (log_sink_file).
+struct bench_ring {
+    std::uint8_t data[1 << 16];
+    std::size_t offset;
+};
+
+bench_ring bench_buffer;
+const char bench_line[] = "2026-10-19 12:00:00.000000 [info] worker 7 handled request 123456\n";
+
+void write_ring() noexcept {
+    if ((bench_buffer.offset + sizeof(bench_line)) > sizeof(bench_buffer.data)) {
+        bench_buffer.offset = 0;
+    }
+    std::memcpy(bench_buffer.data + bench_buffer.offset, bench_line, sizeof(bench_line));
+    bench_buffer.offset += sizeof(bench_line);
+}
+
+std::FILE *bench_file = nullptr;
+
+void write_file() noexcept {
+    std::fwrite(bench_line, 1, sizeof(bench_line), bench_file);
+}
+
+template <typename Lock>
+void bench_ring_writes(benchmark::State &state, Lock &lock) {
+    for (auto _: state) {
+        std::lock_guard<Lock> guard{lock};
+        write_ring();
+    }
+    state.SetBytesProcessed(state.iterations() * sizeof(bench_line));
+}
+
+// Every 64th write flushes the file, a long critical section.
+template <typename Lock>
+void bench_file_writes(benchmark::State &state, Lock &lock) {
+    if (state.thread_index() == 0) {
+        bench_file = std::fopen("/dev/null", "wb");
+    }
+    std::uint32_t i = 0;
+    for (auto _: state) {
+        std::lock_guard<Lock> guard{lock};
+        write_file();
+        if ((++i % 64) == 0) {
+            std::fflush(bench_file);
+        }
+    }
+    if (state.thread_index() == 0) {
+        std::fclose(bench_file);
+    }
+    state.SetBytesProcessed(state.iterations() * sizeof(bench_line));
+}
+
+std::mutex bench_mutex;
+kon::spin_lock bench_spin_lock;
+kon::adaptive_mutex bench_adaptive_mutex;
+} // namespace
+
+static void bm_adaptive_mutex_ring_std_mutex(benchmark::State &state) {
+    bench_ring_writes(state, bench_mutex);
+}
+
+BENCHMARK(bm_adaptive_mutex_ring_std_mutex)->ThreadRange(1, 64)->UseRealTime();
+
+static void bm_adaptive_mutex_ring_spin_lock(benchmark::State &state) {
+    bench_ring_writes(state, bench_spin_lock);
+}
+
+BENCHMARK(bm_adaptive_mutex_ring_spin_lock)->ThreadRange(1, 64)->UseRealTime();
+
+static void bm_adaptive_mutex_ring(benchmark::State &state) {
+    bench_ring_writes(state, bench_adaptive_mutex);
+}
+
+BENCHMARK(bm_adaptive_mutex_ring)->ThreadRange(1, 64)->UseRealTime();
+
+static void bm_adaptive_mutex_file_std_mutex(benchmark::State &state) {
+    bench_file_writes(state, bench_mutex);
+}
+
+BENCHMARK(bm_adaptive_mutex_file_std_mutex)->ThreadRange(1, 64)->UseRealTime();
+
+static void bm_adaptive_mutex_file_spin_lock(benchmark::State &state) {
+    bench_file_writes(state, bench_spin_lock);
+}
+
+BENCHMARK(bm_adaptive_mutex_file_spin_lock)->ThreadRange(1, 64)->UseRealTime();
+
+static void bm_adaptive_mutex_file(benchmark::State &state) {
+    bench_file_writes(state, bench_adaptive_mutex);
+}
+
+BENCHMARK(bm_adaptive_mutex_file)->ThreadRange(1, 64)->UseRealTime();
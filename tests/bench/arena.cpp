@@ -0,0 +1,64 @@
+#include <benchmark/benchmark.h>
+#include <kon/arena.hpp>
+#include <kon/pool.hpp>
+#include <cstdlib>
+#include <memory>
+
+// A burst of allocations of the same size, then all of them are freed.
+static constexpr int burst = 64;
+
+static void bm_malloc(benchmark::State &state) {
+    auto size = static_cast<std::size_t>(state.range(0));
+    void *elements[burst];
+    for (auto _: state) {
+        for (auto &e: elements) {
+            e = std::malloc(size);
+        }
+        benchmark::DoNotOptimize(elements);
+        for (auto e: elements) {
+            std::free(e);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * burst);
+}
+
+BENCHMARK(bm_malloc)->Arg(64)->Arg(2048)->ThreadRange(1, 4);
+
+static void bm_arena(benchmark::State &state) {
+    auto size = static_cast<std::size_t>(state.range(0));
+    kon::arena a{size * burst * 2};
+    void *elements[burst];
+    for (auto _: state) {
+        for (auto &e: elements) {
+            e = a.allocate(size, 64);
+        }
+        benchmark::DoNotOptimize(elements);
+        a.reset();
+    }
+    state.SetItemsProcessed(state.iterations() * burst);
+}
+
+BENCHMARK(bm_arena)->Arg(64)->Arg(2048)->ThreadRange(1, 4);
+
+static std::unique_ptr<kon::pool> bench_pool;
+
+static void bm_pool(benchmark::State &state) {
+    auto size = static_cast<std::uint32_t>(state.range(0));
+    if (state.thread_index() == 0) {
+        int err;
+        bench_pool = std::make_unique<kon::pool>(err, size, burst * 16);
+    }
+    void *elements[burst];
+    for (auto _: state) {
+        for (auto &e: elements) {
+            e = bench_pool->get();
+        }
+        benchmark::DoNotOptimize(elements);
+        for (auto e: elements) {
+            bench_pool->put(e);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * burst);
+}
+
+BENCHMARK(bm_pool)->Arg(64)->Arg(2048)->ThreadRange(1, 4);
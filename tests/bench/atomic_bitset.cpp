@@ -0,0 +1,56 @@
+#include <benchmark/benchmark.h>
+#include <kon/atomic_bitset.hpp>
+#include <kon/dynamic_bitset.hpp>
+#include <mutex>
+
+namespace {
+constexpr std::size_t slot_num = 1 << 16;
+constexpr std::size_t hold_num = 8;
+
+kon::atomic_bitset bench_slots;
+
+// A set bit is a free slot.
+kon::dynamic_bitset bench_free_slots;
+std::mutex bench_lock;
+} // namespace
+
+// Every thread takes a few slots then gives them back.
+static void bm_atomic_bitset_acquire_release(benchmark::State &state) {
+    if (state.thread_index() == 0) {
+        (void) bench_slots.init(slot_num);
+    }
+    std::size_t held[hold_num];
+    for (auto _: state) {
+        for (auto &pos: held) {
+            pos = bench_slots.acquire_first_free();
+        }
+        for (auto pos: held) {
+            bench_slots.release(pos);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * hold_num);
+}
+
+BENCHMARK(bm_atomic_bitset_acquire_release)->ThreadRange(1, 64)->UseRealTime();
+
+static void bm_locked_bitset_acquire_release(benchmark::State &state) {
+    if (state.thread_index() == 0) {
+        (void) bench_free_slots.resize(slot_num);
+        bench_free_slots.set();
+    }
+    std::size_t held[hold_num];
+    for (auto _: state) {
+        for (auto &pos: held) {
+            std::lock_guard<std::mutex> guard{bench_lock};
+            pos = bench_free_slots.find_first();
+            bench_free_slots.reset(pos);
+        }
+        for (auto pos: held) {
+            std::lock_guard<std::mutex> guard{bench_lock};
+            bench_free_slots.set(pos);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * hold_num);
+}
+
+BENCHMARK(bm_locked_bitset_acquire_release)->ThreadRange(1, 64)->UseRealTime();
@@ -0,0 +1,57 @@
+#include <benchmark/benchmark.h>
+#include <kon/base16.hpp>
+#include <random>
+#include <vector>
+
+static std::vector<std::uint8_t> random_bytes(std::size_t size) {
+    std::mt19937 gen(17);
+    std::vector<std::uint8_t> v(size);
+    for (auto &e: v) {
+        e = static_cast<std::uint8_t>(gen());
+    }
+    return v;
+}
+
+static void bm_base16_encode(benchmark::State &state) {
+    auto data = random_bytes(state.range(0));
+    std::vector<char> str(data.size() * 2);
+    for (auto _: state) {
+        auto n = kon::base16_encode(data.data(), data.size(), str.data(), str.size());
+        benchmark::DoNotOptimize(n);
+        benchmark::DoNotOptimize(str.data());
+    }
+    state.SetBytesProcessed(state.iterations() * data.size());
+}
+
+BENCHMARK(bm_base16_encode)->Arg(16)->Arg(64)->Arg(1024)->Arg(9000);
+
+static void bm_base16_encode_lut2(benchmark::State &state) {
+    auto data = random_bytes(state.range(0));
+    std::vector<char> str(data.size() * 2);
+    for (auto _: state) {
+        char *out = str.data();
+        for (auto e: data) {
+            const char *encode_pair = &kon::base16_encode_lut2[e << 1];
+            *out++ = encode_pair[0];
+            *out++ = encode_pair[1];
+        }
+        benchmark::DoNotOptimize(str.data());
+    }
+    state.SetBytesProcessed(state.iterations() * data.size());
+}
+
+BENCHMARK(bm_base16_encode_lut2)->Arg(16)->Arg(64)->Arg(1024)->Arg(9000);
+
+static void bm_base16_decode(benchmark::State &state) {
+    auto data = random_bytes(state.range(0));
+    std::vector<char> str(data.size() * 2);
+    kon::base16_encode(data.data(), data.size(), str.data(), str.size());
+    for (auto _: state) {
+        auto n = kon::base16_decode(str.data(), str.size(), data.data(), data.size());
+        benchmark::DoNotOptimize(n);
+        benchmark::DoNotOptimize(data.data());
+    }
+    state.SetBytesProcessed(state.iterations() * data.size());
+}
+
+BENCHMARK(bm_base16_decode)->Arg(16)->Arg(64)->Arg(1024)->Arg(9000);
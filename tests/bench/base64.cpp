@@ -0,0 +1,60 @@
+#include <benchmark/benchmark.h>
+#include <kon/base64.hpp>
+#include <random>
+#include <vector>
+
+static std::vector<std::uint8_t> random_bytes(std::size_t size) {
+    std::mt19937 gen(17);
+    std::vector<std::uint8_t> v(size);
+    for (auto &e: v) {
+        e = static_cast<std::uint8_t>(gen());
+    }
+    return v;
+}
+
+static void bm_base64_encode(benchmark::State &state) {
+    auto data = random_bytes(state.range(0));
+    std::vector<char> str(kon::base64_encoded_size(data.size()));
+    for (auto _: state) {
+        auto n = kon::base64_encode(data.data(), data.size(), str.data(), str.size());
+        benchmark::DoNotOptimize(n);
+        benchmark::DoNotOptimize(str.data());
+    }
+    state.SetBytesProcessed(state.iterations() * data.size());
+}
+
+BENCHMARK(bm_base64_encode)->Arg(32)->Arg(256)->Arg(4096)->Arg(65536);
+
+static void bm_base64_decode(benchmark::State &state) {
+    auto data = random_bytes(state.range(0));
+    std::vector<char> str(kon::base64_encoded_size(data.size()));
+    kon::base64_encode(data.data(), data.size(), str.data(), str.size());
+    for (auto _: state) {
+        std::size_t data_size = data.size();
+        auto n = kon::base64_decode(str.data(), str.size(), data.data(), data_size);
+        benchmark::DoNotOptimize(n);
+        benchmark::DoNotOptimize(data.data());
+    }
+    state.SetBytesProcessed(state.iterations() * data.size());
+}
+
+BENCHMARK(bm_base64_decode)->Arg(32)->Arg(256)->Arg(4096)->Arg(65536);
+
+static void bm_base64_stream_encode(benchmark::State &state) {
+    auto data = random_bytes(65536);
+    std::vector<char> str(kon::base64_encoded_size(data.size()) + 4);
+    const std::size_t chunk = state.range(0);
+    for (auto _: state) {
+        kon::base64_encoder encoder;
+        encoder.start();
+        char *out = str.data();
+        for (std::size_t i = 0; i < data.size(); i += chunk) {
+            out += encoder.update(data.data() + i, std::min(chunk, data.size() - i), out);
+        }
+        out += encoder.finish(out);
+        benchmark::DoNotOptimize(out);
+    }
+    state.SetBytesProcessed(state.iterations() * data.size());
+}
+
+BENCHMARK(bm_base64_stream_encode)->Arg(100)->Arg(1000)->Arg(16384);
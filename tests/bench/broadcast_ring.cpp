@@ -0,0 +1,84 @@
+#include <benchmark/benchmark.h>
+#include <kon/broadcast_ring.hpp>
+#include <kon/vlm_ring.hpp>
+#include <cstdint>
+#include <cstring>
+#include <thread>
+
+namespace {
+// A 64 bytes market data like update, fanned out from thread 0 to all the other threads.
+struct bench_update {
+    std::uint64_t sn;
+    std::uint64_t fields[7];
+};
+
+constexpr std::size_t ring_size = 64 * 1024;
+constexpr std::size_t max_readers = 4;
+
+kon::broadcast_ring bench_broadcast{ring_size, kon::broadcast_ring::mode::gating};
+kon::vlm_ring bench_rings[max_readers]{ring_size, ring_size, ring_size, ring_size};
+
+void backoff() noexcept {
+    std::this_thread::yield();
+}
+} // namespace
+
+// Every update is written once, each reader reads it by its own cursor.
+static void bm_fan_out_broadcast_ring(benchmark::State &state) {
+    bench_update update{};
+    if (state.thread_index() == 0) {
+        for (auto _: state) {
+            update.sn++;
+            while (!bench_broadcast.push(
+                1, reinterpret_cast<const std::uint8_t *>(&update), sizeof(update))) {
+                backoff();
+            }
+        }
+        return;
+    }
+    kon::broadcast_ring::consumer c;
+    c.subscribe(bench_broadcast);
+    kon::broadcast_ring::zc_scope zcs;
+    for (auto _: state) {
+        while (!c.read_begin(zcs)) {
+            backoff();
+        }
+        std::memcpy(&update, zcs.data, sizeof(update));
+        c.read_end(zcs);
+        benchmark::DoNotOptimize(update);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK(bm_fan_out_broadcast_ring)->Threads(2)->Threads(3)->Threads(5)->UseRealTime();
+
+// The same with a copy of every update pushed into a vlm_ring per reader.
+static void bm_fan_out_vlm_rings(benchmark::State &state) {
+    bench_update update{};
+    std::size_t readers = static_cast<std::size_t>(state.threads()) - 1;
+    if (state.thread_index() == 0) {
+        for (auto _: state) {
+            update.sn++;
+            for (std::size_t i = 0; i < readers; i++) {
+                while (!bench_rings[i].push(
+                    1, reinterpret_cast<const std::uint8_t *>(&update), sizeof(update))) {
+                    backoff();
+                }
+            }
+        }
+        return;
+    }
+    auto &ring = bench_rings[state.thread_index() - 1];
+    kon::vlm_ring::zc_scope zcs;
+    for (auto _: state) {
+        while (!ring.pop_begin(zcs)) {
+            backoff();
+        }
+        std::memcpy(&update, zcs.data, sizeof(update));
+        ring.pop_end(zcs);
+        benchmark::DoNotOptimize(update);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK(bm_fan_out_vlm_rings)->Threads(2)->Threads(3)->Threads(5)->UseRealTime();
@@ -0,0 +1,163 @@
+#include <benchmark/benchmark.h>
+#include <kon/bitset.hpp>
+#include <kon/dynamic_bitset.hpp>
+#include <bitset>
+#include <memory>
+#include <random>
+
+namespace {
+// Not a multiple of 64, kon::bitset needs a partial last word.
+constexpr std::size_t bit_num = 1000003;
+
+struct bench_sets {
+    std::unique_ptr<kon::bitset<bit_num, std::uint64_t>> kon_bits[2];
+    std::unique_ptr<std::bitset<bit_num>> std_bits[2];
+    kon::dynamic_bitset dynamic_bits[2];
+};
+
+// 1 in density bits are set.
+std::unique_ptr<bench_sets> make_sets(unsigned density) {
+    std::mt19937 gen(17);
+    auto sets = std::make_unique<bench_sets>();
+    for (int k = 0; k < 2; k++) {
+        sets->kon_bits[k] = std::make_unique<kon::bitset<bit_num, std::uint64_t>>();
+        sets->kon_bits[k]->reset();
+        sets->std_bits[k] = std::make_unique<std::bitset<bit_num>>();
+        (void) sets->dynamic_bits[k].resize(bit_num);
+        for (std::size_t i = 0; i < bit_num; i++) {
+            if ((gen() % density) == 0) {
+                sets->kon_bits[k]->set(i);
+                sets->std_bits[k]->set(i);
+                sets->dynamic_bits[k].set(i);
+            }
+        }
+    }
+    return sets;
+}
+} // namespace
+
+static void bm_bitset_count_kon(benchmark::State &state) {
+    auto sets = make_sets(2);
+    for (auto _: state) {
+        benchmark::DoNotOptimize(sets->kon_bits[0]->count());
+    }
+    state.SetBytesProcessed(state.iterations() * bit_num / 8);
+}
+
+BENCHMARK(bm_bitset_count_kon);
+
+static void bm_bitset_count_std(benchmark::State &state) {
+    auto sets = make_sets(2);
+    for (auto _: state) {
+        benchmark::DoNotOptimize(sets->std_bits[0]->count());
+    }
+    state.SetBytesProcessed(state.iterations() * bit_num / 8);
+}
+
+BENCHMARK(bm_bitset_count_std);
+
+static void bm_bitset_count_dynamic(benchmark::State &state) {
+    auto sets = make_sets(2);
+    for (auto _: state) {
+        benchmark::DoNotOptimize(sets->dynamic_bits[0].count());
+    }
+    state.SetBytesProcessed(state.iterations() * bit_num / 8);
+}
+
+BENCHMARK(bm_bitset_count_dynamic);
+
+static void bm_bitset_or_kon(benchmark::State &state) {
+    auto sets = make_sets(2);
+    for (auto _: state) {
+        *sets->kon_bits[0] |= *sets->kon_bits[1];
+        benchmark::ClobberMemory();
+    }
+    state.SetBytesProcessed(state.iterations() * bit_num / 8);
+}
+
+BENCHMARK(bm_bitset_or_kon);
+
+static void bm_bitset_or_std(benchmark::State &state) {
+    auto sets = make_sets(2);
+    for (auto _: state) {
+        *sets->std_bits[0] |= *sets->std_bits[1];
+        benchmark::ClobberMemory();
+    }
+    state.SetBytesProcessed(state.iterations() * bit_num / 8);
+}
+
+BENCHMARK(bm_bitset_or_std);
+
+static void bm_bitset_or_dynamic(benchmark::State &state) {
+    auto sets = make_sets(2);
+    for (auto _: state) {
+        sets->dynamic_bits[0] |= sets->dynamic_bits[1];
+        benchmark::ClobberMemory();
+    }
+    state.SetBytesProcessed(state.iterations() * bit_num / 8);
+}
+
+BENCHMARK(bm_bitset_or_dynamic);
+
+// The set bits of a sparse set, 1 in 1000.
+static void bm_bitset_iterate_kon(benchmark::State &state) {
+    auto sets = make_sets(1000);
+    const auto &bits = *sets->kon_bits[0];
+    for (auto _: state) {
+        std::size_t sum = 0;
+        for (std::size_t y = 0; y < bits.element_number; y++) {
+            kon::bit_for_each(bits.data[y], [&sum, y](unsigned char i) {
+                sum += y * 64 + i;
+            });
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetBytesProcessed(state.iterations() * bit_num / 8);
+}
+
+BENCHMARK(bm_bitset_iterate_kon);
+
+static void bm_bitset_iterate_std(benchmark::State &state) {
+    auto sets = make_sets(1000);
+    const auto &bits = *sets->std_bits[0];
+    for (auto _: state) {
+        std::size_t sum = 0;
+        for (auto i = bits._Find_first(); i < bit_num; i = bits._Find_next(i)) {
+            sum += i;
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetBytesProcessed(state.iterations() * bit_num / 8);
+}
+
+BENCHMARK(bm_bitset_iterate_std);
+
+static void bm_bitset_iterate_dynamic(benchmark::State &state) {
+    auto sets = make_sets(1000);
+    const auto &bits = sets->dynamic_bits[0];
+    for (auto _: state) {
+        std::size_t sum = 0;
+        bits.for_each_set([&sum](std::size_t i) {
+            sum += i;
+        });
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetBytesProcessed(state.iterations() * bit_num / 8);
+}
+
+BENCHMARK(bm_bitset_iterate_dynamic);
+
+static void bm_bitset_find_next_dynamic(benchmark::State &state) {
+    auto sets = make_sets(1000);
+    const auto &bits = sets->dynamic_bits[0];
+    for (auto _: state) {
+        std::size_t sum = 0;
+        for (auto i = bits.find_first(); i != kon::dynamic_bitset::npos; i = bits.find_next(i)) {
+            sum += i;
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetBytesProcessed(state.iterations() * bit_num / 8);
+}
+
+BENCHMARK(bm_bitset_find_next_dynamic);
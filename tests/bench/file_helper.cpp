@@ -0,0 +1,51 @@
+#include <benchmark/benchmark.h>
+#include <kon/file_helper.hpp>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <string>
+
+// 2000 files of 0 to 8 KB in 20 directories, they stay in the page cache.
+static std::string load_directory_bench_dir() {
+    auto dir = std::filesystem::temp_directory_path() / "kon_bench_load_directory";
+    if (!std::filesystem::exists(dir / "19" / "1999")) {
+        std::mt19937 gen(17);
+        for (std::size_t i = 0; i < 2000; i++) {
+            auto sub = dir / std::to_string(i % 20);
+            std::filesystem::create_directories(sub);
+            std::string content(gen() % 8192, 'x');
+            std::ofstream{sub / std::to_string(i), std::ios::binary}.write(
+                content.data(),
+                content.size());
+        }
+    }
+    return dir.string();
+}
+
+static void bm_read_all_files(benchmark::State &state) {
+    auto dir = load_directory_bench_dir();
+    for (auto _: state) {
+        std::size_t total = 0;
+        for (const auto &entry: std::filesystem::recursive_directory_iterator(dir)) {
+            if (entry.is_regular_file()) {
+                std::size_t size;
+                auto data = kon::file_helper::read_all(entry.path().string(), size);
+                total += size;
+            }
+        }
+        benchmark::DoNotOptimize(total);
+    }
+}
+
+BENCHMARK(bm_read_all_files)->Unit(benchmark::kMillisecond);
+
+static void bm_load_directory(benchmark::State &state) {
+    auto dir = load_directory_bench_dir();
+    for (auto _: state) {
+        kon::file_helper::bulk_load load;
+        auto ret = kon::file_helper::load_directory(dir, load, state.range(0));
+        benchmark::DoNotOptimize(ret);
+    }
+}
+
+BENCHMARK(bm_load_directory)->Arg(1)->Arg(4)->Arg(8)->Unit(benchmark::kMillisecond);
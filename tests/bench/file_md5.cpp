@@ -0,0 +1,64 @@
+#include <benchmark/benchmark.h>
+#include <kon/hash/md5.hpp>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <string>
+#include <vector>
+
+// The files stay in the page cache, it measures the overhead of each mode over md5 itself.
+static std::string file_md5_bench_file(std::size_t size) {
+    auto path = std::filesystem::temp_directory_path() / ("kon_bench_md5_" + std::to_string(size));
+    if (!std::filesystem::exists(path) || (std::filesystem::file_size(path) != size)) {
+        std::mt19937 gen(17);
+        std::vector<char> content(size);
+        for (auto &e: content) {
+            e = static_cast<char>(gen());
+        }
+        std::ofstream file(path, std::ios::binary);
+        file.write(content.data(), content.size());
+    }
+    return path.string();
+}
+
+static void bm_file_md5(benchmark::State &state) {
+    auto size = static_cast<std::size_t>(state.range(0));
+    auto mode = static_cast<kon::file_md5_mode>(state.range(1));
+    auto path = file_md5_bench_file(size);
+    unsigned char output[16];
+    for (auto _: state) {
+        auto ret = kon::file_md5(path, output, mode);
+        benchmark::DoNotOptimize(ret);
+        benchmark::DoNotOptimize(output);
+    }
+    state.SetBytesProcessed(state.iterations() * size);
+}
+
+BENCHMARK(bm_file_md5)
+    ->ArgNames({"size", "mode"})
+    ->ArgsProduct({
+        {64 << 10, 1 << 20, 16 << 20, 128 << 20},
+        {static_cast<int>(kon::file_md5_mode::stream),
+         static_cast<int>(kon::file_md5_mode::mmap),
+         static_cast<int>(kon::file_md5_mode::threaded)},
+    });
+
+static void bm_directory_md5(benchmark::State &state) {
+    auto dir = std::filesystem::temp_directory_path() / "kon_bench_md5_dir";
+    std::filesystem::create_directories(dir);
+    for (int i = 0; i < 64; i++) {
+        auto src = file_md5_bench_file(1 << 20);
+        auto dst = dir / std::to_string(i);
+        if (!std::filesystem::exists(dst)) {
+            std::filesystem::copy_file(src, dst);
+        }
+    }
+    std::vector<kon::file_md5_result> results;
+    for (auto _: state) {
+        auto ret = kon::directory_md5(dir.string(), results, state.range(0));
+        benchmark::DoNotOptimize(ret);
+    }
+    state.SetBytesProcessed(state.iterations() * (64 << 20));
+}
+
+BENCHMARK(bm_directory_md5)->ArgName("threads")->Arg(1)->Arg(4)->Arg(16)->UseRealTime();
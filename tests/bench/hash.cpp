@@ -0,0 +1,49 @@
+#include <benchmark/benchmark.h>
+#include <kon/hash/crc32c.hpp>
+#include <kon/hash/sha256.hpp>
+#include <kon/hash/xxh3.hpp>
+#include <random>
+#include <vector>
+
+static std::vector<unsigned char> random_bytes(std::size_t size) {
+    std::mt19937 gen(17);
+    std::vector<unsigned char> v(size);
+    for (auto &e: v) {
+        e = static_cast<unsigned char>(gen());
+    }
+    return v;
+}
+
+static void bm_crc32c(benchmark::State &state) {
+    auto data = random_bytes(state.range(0));
+    for (auto _: state) {
+        auto crc = kon::crc32c(data.data(), data.size());
+        benchmark::DoNotOptimize(crc);
+    }
+    state.SetBytesProcessed(state.iterations() * data.size());
+}
+
+BENCHMARK(bm_crc32c)->Arg(64)->Arg(1024)->Arg(65536)->Arg(1 << 20);
+
+static void bm_xxh3(benchmark::State &state) {
+    auto data = random_bytes(state.range(0));
+    for (auto _: state) {
+        auto hash = kon::xxh3(data.data(), data.size());
+        benchmark::DoNotOptimize(hash);
+    }
+    state.SetBytesProcessed(state.iterations() * data.size());
+}
+
+BENCHMARK(bm_xxh3)->Arg(16)->Arg(64)->Arg(1024)->Arg(65536)->Arg(1 << 20);
+
+static void bm_sha256(benchmark::State &state) {
+    auto data = random_bytes(state.range(0));
+    unsigned char output[32];
+    for (auto _: state) {
+        kon::sha256(data.data(), data.size(), output);
+        benchmark::DoNotOptimize(output);
+    }
+    state.SetBytesProcessed(state.iterations() * data.size());
+}
+
+BENCHMARK(bm_sha256)->Arg(64)->Arg(1024)->Arg(65536)->Arg(1 << 20);
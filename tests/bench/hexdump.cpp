@@ -0,0 +1,69 @@
+#include <benchmark/benchmark.h>
+#include <kon/log.hpp>
+#include <kon/base16.hpp>
+#include <fmt/format.h>
+#include <random>
+#include <vector>
+
+static std::vector<std::uint8_t> random_bytes(std::size_t size) {
+    std::mt19937 gen(17);
+    std::vector<std::uint8_t> v(size);
+    for (auto &e: v) {
+        e = static_cast<std::uint8_t>(gen());
+    }
+    return v;
+}
+
+static void bm_hexdump(benchmark::State &state) {
+    auto data = random_bytes(state.range(0));
+    kon::hexdump_options options{};
+    std::vector<char> out(kon::hexdump_size(data.size(), options));
+    for (auto _: state) {
+        auto n = kon::hexdump(data.data(), data.size(), out.data(), options);
+        benchmark::DoNotOptimize(n);
+        benchmark::DoNotOptimize(out.data());
+    }
+    state.SetBytesProcessed(state.iterations() * data.size());
+}
+
+BENCHMARK(bm_hexdump)->Arg(64)->Arg(1500)->Arg(9000);
+
+static void bm_hexdump_mem_view(benchmark::State &state) {
+    auto data = random_bytes(state.range(0));
+    for (auto _: state) {
+        auto buffer = fmt::memory_buffer();
+        fmt::format_to(fmt::appender(buffer), "{}", kon::mem_view{data.data(), data.size()});
+        benchmark::DoNotOptimize(buffer.data());
+    }
+    state.SetBytesProcessed(state.iterations() * data.size());
+}
+
+BENCHMARK(bm_hexdump_mem_view)->Arg(64)->Arg(1500)->Arg(9000);
+
+// The previous byte-by-byte formatter.
+static void bm_hexdump_bytewise(benchmark::State &state) {
+    auto data = random_bytes(state.range(0));
+    for (auto _: state) {
+        auto buffer = fmt::memory_buffer();
+        auto out = fmt::appender(buffer);
+        std::size_t line_count = 0;
+        for (auto e: data) {
+            if (line_count < 32u) {
+                if ((line_count != 0) && (line_count & 3) == 0) {
+                    *out++ = ' ';
+                }
+            } else {
+                *out++ = '\n';
+                line_count = 0;
+            }
+            const char *encode_pair = &kon::base16_encode_lut2[e << 1];
+            *out++ = encode_pair[0];
+            *out++ = encode_pair[1];
+            line_count++;
+        }
+        benchmark::DoNotOptimize(buffer.data());
+    }
+    state.SetBytesProcessed(state.iterations() * data.size());
+}
+
+BENCHMARK(bm_hexdump_bytewise)->Arg(64)->Arg(1500)->Arg(9000);
@@ -0,0 +1,116 @@
+#include <benchmark/benchmark.h>
+#include <kon/dynamic_bitset.hpp>
+#include <kon/hierarchical_bitset.hpp>
+#include <random>
+#include <vector>
+
+namespace {
+constexpr std::size_t bit_num = 1 << 20;
+
+// 1 in density bits are set.
+std::vector<std::size_t> bench_positions(std::size_t density) {
+    std::mt19937 gen(17);
+    std::vector<std::size_t> positions;
+    for (std::size_t i = 0; i < bit_num; i++) {
+        if ((gen() % density) == 0) {
+            positions.push_back(i);
+        }
+    }
+    return positions;
+}
+} // namespace
+
+static void bm_find_next_hierarchical(benchmark::State &state) {
+    kon::hierarchical_bitset bits;
+    (void) bits.init(bit_num);
+    for (auto pos: bench_positions(state.range(0))) {
+        bits.set(pos);
+    }
+    for (auto _: state) {
+        std::size_t sum = 0;
+        for (auto i = bits.find_first(); i != kon::hierarchical_bitset::npos;
+             i = bits.find_next(i)) {
+            sum += i;
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+}
+
+BENCHMARK(bm_find_next_hierarchical)->Arg(100)->Arg(10000);
+
+static void bm_find_next_dynamic(benchmark::State &state) {
+    kon::dynamic_bitset bits;
+    (void) bits.resize(bit_num);
+    for (auto pos: bench_positions(state.range(0))) {
+        bits.set(pos);
+    }
+    for (auto _: state) {
+        std::size_t sum = 0;
+        for (auto i = bits.find_first(); i != kon::dynamic_bitset::npos; i = bits.find_next(i)) {
+            sum += i;
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+}
+
+BENCHMARK(bm_find_next_dynamic)->Arg(100)->Arg(10000);
+
+// A timer wheel like use, the earliest slot is taken and a later one is armed.
+static void bm_pop_first_hierarchical(benchmark::State &state) {
+    kon::hierarchical_bitset bits;
+    (void) bits.init(bit_num);
+    auto positions = bench_positions(10000);
+    for (auto pos: positions) {
+        bits.set(pos);
+    }
+    std::size_t i = 0;
+    for (auto _: state) {
+        auto first = bits.find_first();
+        bits.reset(first);
+        bits.set(positions[i++ % positions.size()]);
+        benchmark::DoNotOptimize(first);
+    }
+}
+
+BENCHMARK(bm_pop_first_hierarchical);
+
+static void bm_pop_first_dynamic(benchmark::State &state) {
+    kon::dynamic_bitset bits;
+    (void) bits.resize(bit_num);
+    auto positions = bench_positions(10000);
+    for (auto pos: positions) {
+        bits.set(pos);
+    }
+    std::size_t i = 0;
+    for (auto _: state) {
+        auto first = bits.find_first();
+        bits.reset(first);
+        bits.set(positions[i++ % positions.size()]);
+        benchmark::DoNotOptimize(first);
+    }
+}
+
+BENCHMARK(bm_pop_first_dynamic);
+
+// A single bit at the end, the worst case of a flat scan.
+static void bm_find_last_bit_hierarchical(benchmark::State &state) {
+    kon::hierarchical_bitset bits;
+    (void) bits.init(bit_num);
+    bits.set(bit_num - 1);
+    for (auto _: state) {
+        benchmark::DoNotOptimize(bits.find_first());
+    }
+}
+
+BENCHMARK(bm_find_last_bit_hierarchical);
+
+static void bm_find_last_bit_dynamic(benchmark::State &state) {
+    kon::dynamic_bitset bits;
+    (void) bits.resize(bit_num);
+    bits.set(bit_num - 1);
+    for (auto _: state) {
+        benchmark::DoNotOptimize(bits.find_first());
+    }
+}
+
+BENCHMARK(bm_find_last_bit_dynamic);
@@ -0,0 +1,68 @@
+#include <benchmark/benchmark.h>
+#include <kon/line_reader.hpp>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <string>
+
+// Lines of 0 to 159 characters, the file stays in the page cache.
+static std::string line_reader_bench_file(std::size_t size) {
+    auto path = std::filesystem::temp_directory_path() /
+                ("kon_bench_lines_" + std::to_string(size));
+    if (!std::filesystem::exists(path) || (std::filesystem::file_size(path) != size)) {
+        std::mt19937 gen(17);
+        std::string content;
+        content.reserve(size);
+        while (content.size() < size) {
+            std::size_t len = gen() % 160;
+            for (std::size_t i = 0; (i < len) && (content.size() < size - 1); i++) {
+                content.push_back(static_cast<char>('a' + gen() % 26));
+            }
+            content.push_back('\n');
+        }
+        std::ofstream file(path, std::ios::binary);
+        file.write(content.data(), content.size());
+    }
+    return path.string();
+}
+
+static void bm_line_reader(benchmark::State &state) {
+    auto size = static_cast<std::size_t>(state.range(0));
+    auto mode = static_cast<kon::read_mode>(state.range(1));
+    auto path = line_reader_bench_file(size);
+    for (auto _: state) {
+        kon::line_reader reader;
+        reader.open(path, mode);
+        std::string_view line;
+        std::size_t n = 0;
+        while (reader.next(line) == 1) {
+            n += line.size();
+        }
+        benchmark::DoNotOptimize(n);
+    }
+    state.SetBytesProcessed(state.iterations() * size);
+}
+
+BENCHMARK(bm_line_reader)
+    ->ArgNames({"size", "mode"})
+    ->ArgsProduct({
+        {1 << 20, 64 << 20},
+        {static_cast<long>(kon::read_mode::mmap), static_cast<long>(kon::read_mode::stream)},
+    });
+
+static void bm_getline(benchmark::State &state) {
+    auto size = static_cast<std::size_t>(state.range(0));
+    auto path = line_reader_bench_file(size);
+    for (auto _: state) {
+        std::ifstream file(path, std::ios::binary);
+        std::string line;
+        std::size_t n = 0;
+        while (std::getline(file, line)) {
+            n += line.size();
+        }
+        benchmark::DoNotOptimize(n);
+    }
+    state.SetBytesProcessed(state.iterations() * size);
+}
+
+BENCHMARK(bm_getline)->Arg(1 << 20)->Arg(64 << 20);
@@ -0,0 +1,79 @@
+#include <benchmark/benchmark.h>
+#include <kon/file_helper.hpp>
+#include <kon/mapped_file.hpp>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <string>
+#include <vector>
+
+// The file stays in the page cache, it measures the cost of getting the data into memory.
+static std::string mapped_file_bench_file(std::size_t size) {
+    auto path = std::filesystem::temp_directory_path() /
+                ("kon_bench_mapped_" + std::to_string(size));
+    if (!std::filesystem::exists(path) || (std::filesystem::file_size(path) != size)) {
+        std::mt19937 gen(17);
+        std::vector<char> content(size);
+        for (auto &e: content) {
+            e = static_cast<char>(gen());
+        }
+        std::ofstream file(path, std::ios::binary);
+        file.write(content.data(), content.size());
+    }
+    return path.string();
+}
+
+// Touch one byte of every page.
+static std::size_t touch_pages(const char *data, std::size_t size) {
+    std::size_t sum = 0;
+    for (std::size_t i = 0; i < size; i += 4096) {
+        sum += static_cast<unsigned char>(data[i]);
+    }
+    return sum;
+}
+
+static void bm_read_all(benchmark::State &state) {
+    auto size = static_cast<std::size_t>(state.range(0));
+    auto path = mapped_file_bench_file(size);
+    for (auto _: state) {
+        std::size_t file_size;
+        auto data = kon::file_helper::read_all(path, file_size);
+        benchmark::DoNotOptimize(touch_pages(reinterpret_cast<char *>(data.get()), file_size));
+    }
+    state.SetBytesProcessed(state.iterations() * size);
+}
+
+BENCHMARK(bm_read_all)->Arg(1 << 20)->Arg(64 << 20);
+
+static void bm_read_all_mapped(benchmark::State &state) {
+    auto size = static_cast<std::size_t>(state.range(0));
+    auto path = mapped_file_bench_file(size);
+    for (auto _: state) {
+        kon::mapped_file file;
+        kon::file_helper::read_all(path, file);
+        benchmark::DoNotOptimize(touch_pages(file.data(), file.size()));
+    }
+    state.SetBytesProcessed(state.iterations() * size);
+}
+
+BENCHMARK(bm_read_all_mapped)->Arg(1 << 20)->Arg(64 << 20);
+
+// Page faults of a lazy mapping against MAP_POPULATE and huge pages.
+static void bm_mapped_file(benchmark::State &state) {
+    auto size = static_cast<std::size_t>(state.range(0));
+    auto path = mapped_file_bench_file(size);
+    kon::mapped_file_options options{
+        .populate = state.range(1) != 0,
+        .huge_pages = state.range(2) != 0,
+    };
+    for (auto _: state) {
+        int err;
+        kon::mapped_file file(err, path, options);
+        benchmark::DoNotOptimize(touch_pages(file.data(), file.size()));
+    }
+    state.SetBytesProcessed(state.iterations() * size);
+}
+
+BENCHMARK(bm_mapped_file)
+    ->ArgNames({"size", "populate", "huge_pages"})
+    ->ArgsProduct({{64 << 20}, {0, 1}, {0, 1}});
@@ -0,0 +1,43 @@
+#include <benchmark/benchmark.h>
+#include <kon/hash/md5.hpp>
+#include <random>
+#include <vector>
+
+static std::vector<unsigned char> random_bytes(std::size_t size) {
+    std::mt19937 gen(17);
+    std::vector<unsigned char> v(size);
+    for (auto &e: v) {
+        e = static_cast<unsigned char>(gen());
+    }
+    return v;
+}
+
+static void bm_md5(benchmark::State &state) {
+    auto data = random_bytes(state.range(0));
+    unsigned char output[16];
+    for (auto _: state) {
+        kon::md5(data.data(), data.size(), output);
+        benchmark::DoNotOptimize(output);
+    }
+    state.SetBytesProcessed(state.iterations() * data.size());
+}
+
+BENCHMARK(bm_md5)->RangeMultiplier(4)->Range(64, 1 << 20);
+
+// Unaligned input, fed by chunks which are not multiple of the block size.
+static void bm_md5_context_unaligned(benchmark::State &state) {
+    auto data = random_bytes(state.range(0) + 1);
+    unsigned char output[16];
+    for (auto _: state) {
+        kon::md5_context ctx;
+        ctx.start();
+        for (std::size_t i = 1; i < data.size(); i += 1000) {
+            ctx.update(data.data() + i, std::min<std::size_t>(1000, data.size() - i));
+        }
+        ctx.finish(output);
+        benchmark::DoNotOptimize(output);
+    }
+    state.SetBytesProcessed(state.iterations() * (data.size() - 1));
+}
+
+BENCHMARK(bm_md5_context_unaligned)->RangeMultiplier(16)->Range(1024, 1 << 20);
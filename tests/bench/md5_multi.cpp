@@ -0,0 +1,47 @@
+#include <benchmark/benchmark.h>
+#include <kon/hash/md5.hpp>
+#include <kon/hash/md5_multi.hpp>
+#include <random>
+#include <vector>
+
+static constexpr std::size_t md5_multi_jobs = 64;
+
+static std::vector<unsigned char> random_bytes(std::size_t size) {
+    std::mt19937 gen(17);
+    std::vector<unsigned char> v(size);
+    for (auto &e: v) {
+        e = static_cast<unsigned char>(gen());
+    }
+    return v;
+}
+
+// 64 messages of the same size, hashed one after the other.
+static void bm_md5_serial(benchmark::State &state) {
+    auto data = random_bytes(state.range(0) * md5_multi_jobs);
+    unsigned char output[16];
+    for (auto _: state) {
+        for (std::size_t i = 0; i < md5_multi_jobs; i++) {
+            kon::md5(data.data() + i * state.range(0), state.range(0), output);
+            benchmark::DoNotOptimize(output);
+        }
+    }
+    state.SetBytesProcessed(state.iterations() * data.size());
+}
+
+BENCHMARK(bm_md5_serial)->Arg(64)->Arg(1024)->Arg(16384)->Arg(262144);
+
+static void bm_md5_multi(benchmark::State &state) {
+    auto data = random_bytes(state.range(0) * md5_multi_jobs);
+    std::vector<kon::md5_job> jobs(md5_multi_jobs);
+    for (auto _: state) {
+        for (std::size_t i = 0; i < md5_multi_jobs; i++) {
+            jobs[i].input = data.data() + i * state.range(0);
+            jobs[i].ilen = state.range(0);
+        }
+        kon::md5_multi_hash(jobs.data(), jobs.size());
+        benchmark::DoNotOptimize(jobs.data());
+    }
+    state.SetBytesProcessed(state.iterations() * data.size());
+}
+
+BENCHMARK(bm_md5_multi)->Arg(64)->Arg(1024)->Arg(16384)->Arg(262144);
@@ -0,0 +1,77 @@
+#include <benchmark/benchmark.h>
+#include <kon/pool.hpp>
+#include <memory>
+
+static std::unique_ptr<kon::pool> bench_pool;
+
+// The pool is shared by the threads of a run.
+static void setup_pool(benchmark::State &state, const kon::pool_options &options = {}) {
+    if (state.thread_index() == 0) {
+        int err;
+        bench_pool = std::make_unique<kon::pool>(err, 2048, 8192, options);
+        if (err != 0) {
+            state.SkipWithError("pool");
+        }
+    }
+}
+
+static void bm_pool_get_put(benchmark::State &state) {
+    setup_pool(state);
+    for (auto _: state) {
+        auto e = bench_pool->get();
+        benchmark::DoNotOptimize(e);
+        bench_pool->put(e);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK(bm_pool_get_put)->ThreadRange(1, 8);
+
+// A burst larger than the cache, it goes through the free ring.
+static void bm_pool_get_put_burst(benchmark::State &state) {
+    setup_pool(state);
+    void *elements[128];
+    for (auto _: state) {
+        for (auto &e: elements) {
+            e = bench_pool->get();
+        }
+        benchmark::DoNotOptimize(elements);
+        for (auto e: elements) {
+            bench_pool->put(e);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * 128);
+}
+
+BENCHMARK(bm_pool_get_put_burst)->ThreadRange(1, 8);
+
+static void bm_pool_get_put_bulk(benchmark::State &state) {
+    setup_pool(state);
+    auto n = static_cast<std::size_t>(state.range(0));
+    void *elements[256];
+    for (auto _: state) {
+        if (!bench_pool->get_bulk(elements, n)) {
+            continue;
+        }
+        benchmark::DoNotOptimize(elements);
+        bench_pool->put_bulk(elements, n);
+    }
+    state.SetItemsProcessed(state.iterations() * n);
+}
+
+BENCHMARK(bm_pool_get_put_bulk)->Arg(8)->Arg(32)->Arg(256)->ThreadRange(1, 8);
+
+static void bm_pool_dbuf_bulk(benchmark::State &state) {
+    setup_pool(state, {.headroom = 128, .huge_pages = true});
+    kon::dbuf bufs[32];
+    for (auto _: state) {
+        if (!bench_pool->get_bulk(bufs, 32)) {
+            continue;
+        }
+        benchmark::DoNotOptimize(bufs);
+        bench_pool->put_bulk(bufs, 32);
+    }
+    state.SetItemsProcessed(state.iterations() * 32);
+}
+
+BENCHMARK(bm_pool_dbuf_bulk)->ThreadRange(1, 8);
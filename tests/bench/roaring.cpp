@@ -0,0 +1,101 @@
+#include <benchmark/benchmark.h>
+#include <kon/dynamic_bitset.hpp>
+#include <kon/roaring.hpp>
+#include <algorithm>
+#include <iterator>
+#include <memory>
+#include <random>
+#include <vector>
+
+namespace {
+constexpr std::size_t universe = std::size_t{1} << 24;
+
+struct bench_sets {
+    kon::roaring_bitmap roaring[2];
+    kon::dynamic_bitset bits[2];
+    kon::dynamic_bitset result;
+    std::vector<std::uint32_t> sorted[2];
+};
+
+// 1 in density values of the universe are set.
+std::unique_ptr<bench_sets> make_sets(unsigned density) {
+    std::mt19937 gen(17);
+    auto sets = std::make_unique<bench_sets>();
+    for (int k = 0; k < 2; k++) {
+        (void) sets->bits[k].resize(universe);
+        for (std::uint32_t v = 0; v < universe; v++) {
+            if ((gen() % density) == 0) {
+                sets->roaring[k].add(v);
+                sets->bits[k].set(v);
+                sets->sorted[k].push_back(v);
+            }
+        }
+    }
+    (void) sets->result.resize(universe);
+    return sets;
+}
+
+void set_memory(benchmark::State &state, std::size_t roaring, std::size_t bits) {
+    state.counters["roaring_bytes"] = static_cast<double>(roaring);
+    state.counters["bitset_bytes"] = static_cast<double>(bits);
+}
+} // namespace
+
+static void bm_roaring_and(benchmark::State &state) {
+    auto sets = make_sets(static_cast<unsigned>(state.range(0)));
+    for (auto _: state) {
+        auto result = kon::roaring_and(sets->roaring[0], sets->roaring[1]);
+        benchmark::DoNotOptimize(result);
+    }
+    set_memory(
+        state, sets->roaring[0].memory_usage() + sets->roaring[1].memory_usage(), universe / 4);
+}
+
+BENCHMARK(bm_roaring_and)->Arg(1000)->Arg(100)->Arg(2);
+
+static void bm_roaring_and_cardinality(benchmark::State &state) {
+    auto sets = make_sets(static_cast<unsigned>(state.range(0)));
+    for (auto _: state) {
+        benchmark::DoNotOptimize(kon::roaring_and_cardinality(sets->roaring[0], sets->roaring[1]));
+    }
+}
+
+BENCHMARK(bm_roaring_and_cardinality)->Arg(1000)->Arg(100)->Arg(2);
+
+static void bm_roaring_or(benchmark::State &state) {
+    auto sets = make_sets(static_cast<unsigned>(state.range(0)));
+    for (auto _: state) {
+        auto result = kon::roaring_or(sets->roaring[0], sets->roaring[1]);
+        benchmark::DoNotOptimize(result);
+    }
+}
+
+BENCHMARK(bm_roaring_or)->Arg(1000)->Arg(100)->Arg(2);
+
+static void bm_roaring_and_bitset(benchmark::State &state) {
+    auto sets = make_sets(static_cast<unsigned>(state.range(0)));
+    for (auto _: state) {
+        (void) sets->result.assign(sets->bits[0]);
+        sets->result &= sets->bits[1];
+        benchmark::DoNotOptimize(sets->result.count());
+    }
+}
+
+BENCHMARK(bm_roaring_and_bitset)->Arg(1000)->Arg(100)->Arg(2);
+
+static void bm_roaring_and_sorted(benchmark::State &state) {
+    auto sets = make_sets(static_cast<unsigned>(state.range(0)));
+    std::vector<std::uint32_t> result;
+    for (auto _: state) {
+        result.clear();
+        std::set_intersection(
+            sets->sorted[0].begin(),
+            sets->sorted[0].end(),
+            sets->sorted[1].begin(),
+            sets->sorted[1].end(),
+            std::back_inserter(result));
+        benchmark::DoNotOptimize(result.data());
+    }
+}
+
+BENCHMARK(bm_roaring_and_sorted)->Arg(1000)->Arg(100)->Arg(2);
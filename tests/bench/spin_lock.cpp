@@ -0,0 +1,126 @@
+#include <benchmark/benchmark.h>
+#include <kon/seqlock.hpp>
+#include <kon/spin_lock.hpp>
+#include <cstdint>
+#include <mutex>
+#include <shared_mutex>
+
+namespace {
+// A few cache lines changed under the lock.
+struct bench_table {
+    std::uint64_t values[32];
+};
+
+bench_table bench_shared;
+
+template <typename Lock>
+void update_locked(benchmark::State &state, Lock &lock) {
+    for (auto _: state) {
+        std::lock_guard<Lock> guard{lock};
+        for (auto &e: bench_shared.values) {
+            e++;
+        }
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+// 1 in 16 is a write.
+template <typename Lock>
+void read_mostly(benchmark::State &state, Lock &lock) {
+    std::uint64_t i = 0;
+    for (auto _: state) {
+        if ((i++ % 16) == 0) {
+            std::unique_lock<Lock> guard{lock};
+            bench_shared.values[i % 32]++;
+        } else {
+            std::shared_lock<Lock> guard{lock};
+            benchmark::DoNotOptimize(bench_shared.values[i % 32]);
+        }
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+std::mutex bench_mutex;
+kon::spin_lock bench_spin_lock;
+kon::ticket_lock bench_ticket_lock;
+kon::mcs_lock bench_mcs_lock;
+std::shared_mutex bench_shared_mutex;
+kon::rw_spin_lock bench_rw_spin_lock;
+kon::seqlock<bench_table> bench_seqlock;
+} // namespace
+
+static void bm_lock_std_mutex(benchmark::State &state) {
+    update_locked(state, bench_mutex);
+}
+
+BENCHMARK(bm_lock_std_mutex)->ThreadRange(1, 64)->UseRealTime();
+
+static void bm_lock_spin_lock(benchmark::State &state) {
+    update_locked(state, bench_spin_lock);
+}
+
+BENCHMARK(bm_lock_spin_lock)->ThreadRange(1, 64)->UseRealTime();
+
+static void bm_lock_ticket_lock(benchmark::State &state) {
+    update_locked(state, bench_ticket_lock);
+}
+
+BENCHMARK(bm_lock_ticket_lock)->ThreadRange(1, 64)->UseRealTime();
+
+static void bm_lock_mcs_lock(benchmark::State &state) {
+    for (auto _: state) {
+        kon::mcs_lock::guard guard{bench_mcs_lock};
+        for (auto &e: bench_shared.values) {
+            e++;
+        }
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK(bm_lock_mcs_lock)->ThreadRange(1, 64)->UseRealTime();
+
+static void bm_lock_read_mostly_shared_mutex(benchmark::State &state) {
+    read_mostly(state, bench_shared_mutex);
+}
+
+BENCHMARK(bm_lock_read_mostly_shared_mutex)->ThreadRange(1, 64)->UseRealTime();
+
+static void bm_lock_read_mostly_rw_spin_lock(benchmark::State &state) {
+    read_mostly(state, bench_rw_spin_lock);
+}
+
+BENCHMARK(bm_lock_read_mostly_rw_spin_lock)->ThreadRange(1, 64)->UseRealTime();
+
+// The snapshot of the whole table, 1 in 16 is a write.
+static void bm_lock_snapshot_std_mutex(benchmark::State &state) {
+    std::uint64_t i = 0;
+    for (auto _: state) {
+        std::lock_guard<std::mutex> guard{bench_mutex};
+        if ((i++ % 16) == 0) {
+            bench_shared.values[i % 32]++;
+        } else {
+            bench_table copy = bench_shared;
+            benchmark::DoNotOptimize(copy);
+        }
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK(bm_lock_snapshot_std_mutex)->ThreadRange(1, 64)->UseRealTime();
+
+static void bm_lock_snapshot_seqlock(benchmark::State &state) {
+    std::uint64_t i = 0;
+    for (auto _: state) {
+        if ((i++ % 16) == 0) {
+            bench_seqlock.update([i](bench_table &table) {
+                table.values[i % 32]++;
+            });
+        } else {
+            bench_table copy = bench_seqlock.load();
+            benchmark::DoNotOptimize(copy);
+        }
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK(bm_lock_snapshot_seqlock)->ThreadRange(1, 64)->UseRealTime();
@@ -0,0 +1,157 @@
+#include <benchmark/benchmark.h>
+#include <kon/mpmc_queue.hpp>
+#include <kon/spsc_queue.hpp>
+#include <kon/vlm_ring.hpp>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <thread>
+
+namespace {
+// A 16 bytes event, the traffic the fixed-size queues are for.
+struct bench_event {
+    std::uint64_t sn;
+    std::uint64_t payload;
+};
+
+constexpr std::size_t queue_size = 1024;
+constexpr std::size_t batch_size = 32;
+
+kon::spsc_queue<bench_event, queue_size> bench_spsc;
+kon::mpmc_queue<bench_event, queue_size> bench_mpmc;
+kon::vlm_ring bench_ring{queue_size * (sizeof(bench_event) + sizeof(kon::vlm_ring::message_head))};
+
+void backoff() noexcept {
+    std::this_thread::yield();
+}
+
+template <typename Queue>
+void push_one(Queue &q, const bench_event &e) noexcept {
+    while (!q.try_push(e)) {
+        backoff();
+    }
+}
+
+template <typename Queue>
+void pop_one(Queue &q, bench_event &e) noexcept {
+    while (!q.try_pop(e)) {
+        backoff();
+    }
+}
+
+void push_one(kon::vlm_ring &q, const bench_event &e) noexcept {
+    while (!q.push(1, reinterpret_cast<const std::uint8_t *>(&e), sizeof(e))) {
+        backoff();
+    }
+}
+
+void pop_one(kon::vlm_ring &q, bench_event &e) noexcept {
+    kon::vlm_ring::zc_scope zcs;
+    while (!q.pop_begin(zcs)) {
+        backoff();
+    }
+    std::memcpy(&e, zcs.data, sizeof(e));
+    q.pop_end(zcs);
+}
+
+// A batch pushed then popped by one thread, the cost of the operations without a transfer.
+template <typename Queue>
+void bench_round_trip(benchmark::State &state, Queue &q) {
+    bench_event e{0, 0};
+    for (auto _: state) {
+        for (std::size_t i = 0; i < batch_size; i++) {
+            e.sn = i;
+            push_one(q, e);
+        }
+        for (std::size_t i = 0; i < batch_size; i++) {
+            pop_one(q, e);
+            benchmark::DoNotOptimize(e);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * batch_size);
+}
+
+// The even threads produce, the odd ones consume, the items are the ones consumed.
+template <typename Queue>
+void bench_transfer(benchmark::State &state, Queue &q) {
+    bench_event e{0, 0};
+    bool producer = (state.thread_index() % 2) == 0;
+    for (auto _: state) {
+        if (producer) {
+            e.sn++;
+            push_one(q, e);
+        } else {
+            pop_one(q, e);
+            benchmark::DoNotOptimize(e);
+        }
+    }
+    state.SetItemsProcessed(producer ? 0 : state.iterations());
+}
+
+template <typename Queue>
+void bench_transfer_bulk(benchmark::State &state, Queue &q) {
+    bench_event events[batch_size]{};
+    bool producer = (state.thread_index() % 2) == 0;
+    for (auto _: state) {
+        std::size_t done = 0;
+        while (done < batch_size) {
+            std::size_t n = producer ? q.try_push_bulk(events + done, batch_size - done)
+                                     : q.try_pop_bulk(events + done, batch_size - done);
+            if (n == 0) {
+                backoff();
+            }
+            done += n;
+        }
+        benchmark::DoNotOptimize(events);
+    }
+    state.SetItemsProcessed(producer ? 0 : (state.iterations() * batch_size));
+}
+} // namespace
+
+static void bm_queue_round_trip_spsc(benchmark::State &state) {
+    bench_round_trip(state, bench_spsc);
+}
+
+BENCHMARK(bm_queue_round_trip_spsc);
+
+static void bm_queue_round_trip_mpmc(benchmark::State &state) {
+    bench_round_trip(state, bench_mpmc);
+}
+
+BENCHMARK(bm_queue_round_trip_mpmc);
+
+static void bm_queue_round_trip_vlm_ring(benchmark::State &state) {
+    bench_round_trip(state, bench_ring);
+}
+
+BENCHMARK(bm_queue_round_trip_vlm_ring);
+
+static void bm_queue_transfer_spsc(benchmark::State &state) {
+    bench_transfer(state, bench_spsc);
+}
+
+BENCHMARK(bm_queue_transfer_spsc)->Threads(2)->UseRealTime();
+
+static void bm_queue_transfer_spsc_bulk(benchmark::State &state) {
+    bench_transfer_bulk(state, bench_spsc);
+}
+
+BENCHMARK(bm_queue_transfer_spsc_bulk)->Threads(2)->UseRealTime();
+
+static void bm_queue_transfer_vlm_ring(benchmark::State &state) {
+    bench_transfer(state, bench_ring);
+}
+
+BENCHMARK(bm_queue_transfer_vlm_ring)->Threads(2)->UseRealTime();
+
+static void bm_queue_transfer_mpmc(benchmark::State &state) {
+    bench_transfer(state, bench_mpmc);
+}
+
+BENCHMARK(bm_queue_transfer_mpmc)->Threads(2)->Threads(4)->Threads(8)->UseRealTime();
+
+static void bm_queue_transfer_mpmc_bulk(benchmark::State &state) {
+    bench_transfer_bulk(state, bench_mpmc);
+}
+
+BENCHMARK(bm_queue_transfer_mpmc_bulk)->Threads(2)->Threads(4)->Threads(8)->UseRealTime();
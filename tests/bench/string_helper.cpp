@@ -0,0 +1,69 @@
+#include <benchmark/benchmark.h>
+#include <kon/string_helper.hpp>
+#include <random>
+#include <string>
+#include <vector>
+
+// Records of 8 fields of 1 to 16 characters, the delimiter is ';'.
+static std::string random_records(std::size_t size) {
+    std::mt19937 gen(17);
+    std::string s;
+    s.reserve(size + 32);
+    std::size_t field = 0;
+    while (s.size() < size) {
+        std::size_t len = 1 + gen() % 16;
+        for (std::size_t i = 0; i < len; i++) {
+            s.push_back(static_cast<char>('a' + gen() % 26));
+        }
+        s.push_back((++field % 8 == 0) ? '\n' : ';');
+    }
+    return s;
+}
+
+static void bm_string_splitter(benchmark::State &state) {
+    auto input = random_records(state.range(0));
+    for (auto _: state) {
+        kon::string_splitter<';'> splitter(input.data(), input.size());
+        std::string_view field;
+        std::size_t n = 0;
+        while (splitter.next(field)) {
+            n++;
+        }
+        benchmark::DoNotOptimize(n);
+    }
+    state.SetBytesProcessed(state.iterations() * input.size());
+}
+
+BENCHMARK(bm_string_splitter)->Arg(4096)->Arg(1 << 20);
+
+static void bm_field_splitter(benchmark::State &state) {
+    auto input = random_records(state.range(0));
+    for (auto _: state) {
+        kon::field_splitter splitter(input.data(), input.size(), ";");
+        std::string_view field;
+        std::size_t n = 0;
+        while (splitter.next(field)) {
+            n++;
+        }
+        benchmark::DoNotOptimize(n);
+    }
+    state.SetBytesProcessed(state.iterations() * input.size());
+}
+
+BENCHMARK(bm_field_splitter)->Arg(4096)->Arg(1 << 20);
+
+static void bm_field_splitter_offsets(benchmark::State &state) {
+    auto input = random_records(state.range(0));
+    std::vector<std::size_t> offsets(1024);
+    for (auto _: state) {
+        kon::field_splitter splitter(input.data(), input.size(), ";\n", '"');
+        std::size_t n;
+        do {
+            n = splitter.next_offsets(offsets.data(), offsets.size());
+            benchmark::DoNotOptimize(offsets.data());
+        } while (n == offsets.size());
+    }
+    state.SetBytesProcessed(state.iterations() * input.size());
+}
+
+BENCHMARK(bm_field_splitter_offsets)->Arg(4096)->Arg(1 << 20);
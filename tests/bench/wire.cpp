@@ -0,0 +1,139 @@
+#include <benchmark/benchmark.h>
+#include <kon/bio.hpp>
+#include <kon/wire.hpp>
+#include <random>
+#include <vector>
+
+namespace {
+// A market data header, 24 bytes in big endian.
+#pragma pack(push, 1)
+struct packed_header {
+    std::uint16_t length;
+    std::uint16_t type;
+    std::uint32_t sequence;
+    std::uint8_t flags;
+    std::uint8_t channel;
+    std::uint16_t count;
+    std::uint64_t timestamp;
+    std::uint32_t instrument;
+};
+#pragma pack(pop)
+
+struct length : kon::wire_uint<std::uint16_t> {};
+struct type : kon::wire_uint<std::uint16_t> {};
+struct sequence : kon::wire_uint<std::uint32_t> {};
+struct flags : kon::wire_uint<std::uint8_t> {};
+struct channel : kon::wire_uint<std::uint8_t> {};
+struct count : kon::wire_uint<std::uint16_t> {};
+struct timestamp : kon::wire_uint<std::uint64_t> {};
+struct instrument : kon::wire_uint<std::uint32_t> {};
+
+using header =
+    kon::wire_layout<length, type, sequence, flags, channel, count, timestamp, instrument>;
+
+constexpr std::size_t frame_num = 4096;
+
+std::vector<std::uint8_t> bench_frames() {
+    std::mt19937 gen(17);
+    std::vector<std::uint8_t> frames(frame_num * sizeof(packed_header));
+    for (auto &e: frames) {
+        e = static_cast<std::uint8_t>(gen());
+    }
+    return frames;
+}
+} // namespace
+
+static void bm_bio_fields(benchmark::State &state) {
+    auto frames = bench_frames();
+    for (auto _: state) {
+        std::uint64_t sum = 0;
+        for (std::size_t i = 0; i < frame_num; i++) {
+            kon::bio<packed_header, true> view{frames.data() + i * sizeof(packed_header)};
+            sum += KON_BIO_READ(view, length) + KON_BIO_READ(view, type) +
+                   KON_BIO_READ(view, sequence) + KON_BIO_READ(view, timestamp);
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetBytesProcessed(state.iterations() * frames.size());
+}
+
+BENCHMARK(bm_bio_fields);
+
+static void bm_wire_fields(benchmark::State &state) {
+    auto frames = bench_frames();
+    for (auto _: state) {
+        std::uint64_t sum = 0;
+        for (std::size_t i = 0; i < frame_num; i++) {
+            kon::wire_view<header> view{
+                frames.data() + i * sizeof(packed_header), sizeof(packed_header)};
+            auto [l, t, s] = view.read<length, type, sequence>();
+            sum += l + t + s + view.get<timestamp>();
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetBytesProcessed(state.iterations() * frames.size());
+}
+
+BENCHMARK(bm_wire_fields);
+
+namespace {
+// A price level of a book snapshot, 12 bytes in big endian.
+struct level {
+    std::uint32_t price;
+    std::uint32_t quantity;
+    std::uint16_t orders;
+    std::uint8_t side;
+    std::uint8_t flags;
+};
+
+struct price : kon::wire_uint<std::uint32_t> {};
+struct quantity : kon::wire_uint<std::uint32_t> {};
+struct orders : kon::wire_uint<std::uint16_t> {};
+struct side : kon::wire_uint<std::uint8_t> {};
+
+using level_record = kon::wire_layout<price, quantity, orders, side, flags>;
+
+constexpr std::size_t level_num = 10000;
+
+std::vector<level> bench_levels() {
+    std::mt19937 gen(17);
+    std::vector<level> levels(level_num);
+    for (auto &e: levels) {
+        e = {static_cast<std::uint32_t>(gen()),
+             static_cast<std::uint32_t>(gen()),
+             static_cast<std::uint16_t>(gen()),
+             0,
+             0};
+    }
+    return levels;
+}
+} // namespace
+
+static void bm_byteswap_fields(benchmark::State &state) {
+    auto levels = bench_levels();
+    for (auto _: state) {
+        for (auto &e: levels) {
+            kon::bio<level, true> view{reinterpret_cast<std::uint8_t *>(&e)};
+            KON_BIO_WRITE(view, KON_BIO_READ(view, price), price);
+            KON_BIO_WRITE(view, KON_BIO_READ(view, quantity), quantity);
+            KON_BIO_WRITE(view, KON_BIO_READ(view, orders), orders);
+        }
+        benchmark::DoNotOptimize(levels.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetBytesProcessed(state.iterations() * level_num * sizeof(level));
+}
+
+BENCHMARK(bm_byteswap_fields);
+
+static void bm_byteswap_bulk(benchmark::State &state) {
+    auto levels = bench_levels();
+    for (auto _: state) {
+        kon::wire_byteswap<level_record>(levels.data(), levels.size());
+        benchmark::DoNotOptimize(levels.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetBytesProcessed(state.iterations() * level_num * sizeof(level));
+}
+
+BENCHMARK(bm_byteswap_bulk);
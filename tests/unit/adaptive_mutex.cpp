@@ -0,0 +1,67 @@
+#include <catch2/catch_test_macros.hpp>
+#include <kon/adaptive_mutex.hpp>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace {
+bool count_under_lock(kon::adaptive_mutex &lock, int thread_count, int iterations) {
+    int counter = 0;
+    std::vector<std::thread> threads;
+    for (int i = 0; i < thread_count; i++) {
+        threads.emplace_back([&]() {
+            for (int j = 0; j < iterations; j++) {
+                std::lock_guard<kon::adaptive_mutex> guard{lock};
+                counter++;
+            }
+        });
+    }
+    for (auto &t: threads) {
+        t.join();
+    }
+    return counter == (thread_count * iterations);
+}
+} // namespace
+
+TEST_CASE("adaptive_mutex", "[adaptive_mutex]") {
+    kon::adaptive_mutex lock;
+    REQUIRE(lock.try_lock());
+    REQUIRE_FALSE(lock.try_lock());
+    lock.unlock();
+    REQUIRE(count_under_lock(lock, 4, 20000));
+
+    // Without spinning, every waiter sleeps.
+    kon::adaptive_mutex sleeper{0};
+    REQUIRE(count_under_lock(sleeper, 8, 5000));
+    REQUIRE(sleeper.try_lock());
+    sleeper.unlock();
+}
+
+TEST_CASE("adaptive_mutex_long_hold", "[adaptive_mutex]") {
+    kon::adaptive_mutex lock;
+    std::atomic<int> stage{0};
+    lock.lock();
+    std::vector<std::thread> waiters;
+    for (int i = 0; i < 3; i++) {
+        waiters.emplace_back([&]() {
+            stage++;
+            std::lock_guard<kon::adaptive_mutex> guard{lock};
+            stage += 10;
+        });
+    }
+    while (stage != 3) {
+        std::this_thread::yield();
+    }
+    // The waiters are asleep by now, all of them are woken one by one.
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    REQUIRE(stage == 3);
+    lock.unlock();
+    for (auto &t: waiters) {
+        t.join();
+    }
+    REQUIRE(stage == 33);
+    REQUIRE(lock.try_lock());
+    lock.unlock();
+}
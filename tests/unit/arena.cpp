@@ -0,0 +1,121 @@
+#include <catch2/catch_test_macros.hpp>
+#include <kon/arena.hpp>
+#include <kon/vlm_ring.hpp>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+TEST_CASE("allocate", "[arena]") {
+    kon::arena a{256};
+
+    auto p0 = static_cast<std::uint8_t *>(a.allocate(10, 1));
+    auto p1 = static_cast<std::uint8_t *>(a.allocate(8, 8));
+    REQUIRE(p0 != nullptr);
+    REQUIRE(p1 == (p0 + 16 - (reinterpret_cast<std::uintptr_t>(p0) & 7)));
+    REQUIRE((reinterpret_cast<std::uintptr_t>(p1) & 7) == 0);
+
+    // Larger than a chunk.
+    auto p2 = static_cast<std::uint8_t *>(a.allocate(1000, 64));
+    REQUIRE(p2 != nullptr);
+    REQUIRE((reinterpret_cast<std::uintptr_t>(p2) & 63) == 0);
+    std::memset(p2, 0x5A, 1000);
+
+    REQUIRE(a.iova(p0) == reinterpret_cast<std::uintptr_t>(p0));
+    REQUIRE(a.iova(p2 + 999) == reinterpret_cast<std::uintptr_t>(p2 + 999));
+    REQUIRE(a.iova(&a) == 0);
+}
+
+TEST_CASE("rewind", "[arena]") {
+    kon::arena a{256};
+
+    auto p0 = a.allocate(100, 1);
+    auto point = a.mark();
+    auto p1 = a.allocate(100, 1);
+    auto p2 = a.allocate(100, 1); // The second chunk.
+    REQUIRE(p1 != nullptr);
+    REQUIRE(p2 != nullptr);
+
+    a.rewind(point);
+    REQUIRE(a.allocate(100, 1) == p1);
+    REQUIRE(a.allocate(100, 1) == p2); // The chunk is reused.
+
+    a.reset();
+    REQUIRE(a.allocate(100, 1) == p0);
+
+    a.release();
+    kon::arena::marker empty = a.mark();
+    REQUIRE(a.allocate(100, 1) != nullptr);
+    a.rewind(empty);
+}
+
+TEST_CASE("region", "[arena]") {
+    alignas(64) std::uint8_t region[256];
+    constexpr std::uintptr_t region_iova = 0x10000;
+
+    SECTION("fixed") {
+        kon::arena a{region, region_iova, sizeof(region)};
+        kon::dbuf buf;
+
+        REQUIRE(a.allocate(buf, 100, 16));
+        REQUIRE(buf.va() == region);
+        REQUIRE(buf.iova() == region_iova);
+        REQUIRE(buf.capacity() == 100);
+        REQUIRE(buf.headroom() == 16);
+
+        REQUIRE(a.allocate(buf, 100, 16));
+        REQUIRE(buf.va() == (region + 128));
+        REQUIRE(buf.iova() == (region_iova + 128));
+
+        REQUIRE(!a.allocate(buf, 100, 16)); // Exhausted.
+        a.reset();
+        REQUIRE(a.allocate(buf, 100, 16));
+        REQUIRE(buf.va() == region);
+    }
+    SECTION("grow") {
+        kon::arena a{region, region_iova, sizeof(region), true, 1024};
+        kon::dbuf buf;
+
+        REQUIRE(a.allocate(buf, 200));
+        REQUIRE(buf.iova() == region_iova);
+        REQUIRE(a.allocate(buf, 200));
+        REQUIRE(buf.va() != (region + 256));
+        REQUIRE(buf.iova() == reinterpret_cast<std::uintptr_t>(buf.va()));
+
+        a.release();
+        REQUIRE(a.allocate(buf, 200));
+        REQUIRE(buf.va() == region);
+    }
+}
+
+TEST_CASE("arena_allocator", "[arena]") {
+    kon::arena a{1024};
+    std::vector<std::uint64_t, kon::arena_allocator<std::uint64_t>> v{
+        kon::arena_allocator<std::uint64_t>{a}};
+
+    for (std::uint64_t i = 0; i < 1000; i++) {
+        v.push_back(i);
+    }
+    for (std::uint64_t i = 0; i < 1000; i++) {
+        REQUIRE(v[i] == i);
+    }
+    REQUIRE(a.iova(v.data()) == reinterpret_cast<std::uintptr_t>(v.data()));
+}
+
+TEST_CASE("vlm_ring_storage", "[arena]") {
+    kon::arena a{1024};
+    auto storage = static_cast<std::uint8_t *>(a.allocate(kon::vlm_ring::storage_size(64), 8));
+    REQUIRE(storage != nullptr);
+
+    kon::vlm_ring q{storage, 64};
+    std::uint8_t data[4] = {1, 2, 3, 4};
+    REQUIRE(q.push(7, data, sizeof(data)));
+
+    kon::vlm_ring::zc_scope zcs;
+    REQUIRE(q.pop_begin(zcs));
+    REQUIRE(zcs.data == (storage + sizeof(kon::vlm_ring::message_head)));
+    REQUIRE(zcs.head->type == 7);
+    REQUIRE(zcs.head->length == 4);
+    REQUIRE(std::memcmp(zcs.data, data, sizeof(data)) == 0);
+    q.pop_end(zcs);
+    REQUIRE(q.empty());
+}
@@ -0,0 +1,77 @@
+#include <catch2/catch_test_macros.hpp>
+#include <kon/atomic_bitset.hpp>
+#include <thread>
+#include <vector>
+
+TEST_CASE("atomic_bitset", "[atomic_bitset]") {
+    constexpr auto npos = kon::atomic_bitset::npos;
+    kon::atomic_bitset bs;
+    REQUIRE(bs.acquire_first_free() == npos);
+
+    REQUIRE(bs.init(100));
+    REQUIRE(bs.count() == 0);
+    REQUIRE(bs.try_set(7));
+    REQUIRE(!bs.try_set(7));
+    REQUIRE(bs.test(7));
+
+    // The slots past the size are never handed out.
+    std::vector<bool> taken(100);
+    taken[7] = true;
+    for (int i = 0; i < 99; i++) {
+        auto pos = bs.acquire_first_free();
+        REQUIRE(pos < 100);
+        REQUIRE(!taken[pos]);
+        taken[pos] = true;
+    }
+    REQUIRE(bs.count() == 100);
+    REQUIRE(bs.acquire_first_free() == npos);
+
+    bs.release(42);
+    REQUIRE(!bs.test(42));
+    REQUIRE(bs.acquire_first_free() == 42);
+    bs.release(99);
+    REQUIRE(bs.acquire_first_free() == 99);
+}
+
+TEST_CASE("atomic_bitset_multi_thread", "[atomic_bitset]") {
+    constexpr std::size_t thread_num = 8;
+    constexpr std::size_t slot_num = 3000;
+    kon::atomic_bitset bs;
+    REQUIRE(bs.init(slot_num));
+
+    // The threads take all the slots, each slot once.
+    std::vector<std::vector<std::size_t>> owned(thread_num);
+    std::vector<std::thread> threads;
+    for (std::size_t t = 0; t < thread_num; t++) {
+        threads.emplace_back([&bs, &owned, t]() {
+            for (int round = 0; round < 1000; round++) {
+                auto pos = bs.acquire_first_free();
+                if (pos != kon::atomic_bitset::npos) {
+                    owned[t].push_back(pos);
+                }
+                if (((round % 3) == 0) && !owned[t].empty()) {
+                    bs.release(owned[t].back());
+                    owned[t].pop_back();
+                }
+            }
+            for (auto pos = bs.acquire_first_free(); pos != kon::atomic_bitset::npos;
+                 pos = bs.acquire_first_free()) {
+                owned[t].push_back(pos);
+            }
+        });
+    }
+    for (auto &t: threads) {
+        t.join();
+    }
+    std::vector<int> owners(slot_num);
+    for (auto &slots: owned) {
+        for (auto pos: slots) {
+            REQUIRE(pos < slot_num);
+            owners[pos]++;
+        }
+    }
+    for (auto n: owners) {
+        REQUIRE(n == 1);
+    }
+    REQUIRE(bs.count() == slot_num);
+}
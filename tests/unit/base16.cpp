@@ -1,5 +1,7 @@
 #include <kon/base16.hpp>
 #include <catch2/catch_test_macros.hpp>
+#include <cctype>
+#include <cstring>
 
 TEST_CASE("base16_decode", "[base16]") {
     using namespace std::literals;
@@ -47,4 +49,63 @@ TEST_CASE("base16_decode", "[base16]") {
         std::size_t pos = kon::base16_decode(str.data(), str.size(), data, sizeof(data));
         REQUIRE(pos == 0);
     }
-}
\ No newline at end of file
+}
+
+TEST_CASE("base16_encode", "[base16]") {
+    using namespace std::literals;
+
+    {
+        static const std::uint8_t data[3] = {0x12, 0xAB, 0xF0};
+        char str[6];
+        REQUIRE(kon::base16_encode(data, sizeof(data), str, sizeof(str)) == 6);
+        REQUIRE(std::string_view{str, 6} == "12abf0"sv);
+        REQUIRE(kon::base16_encode(data, sizeof(data), str, sizeof(str), true) == 6);
+        REQUIRE(std::string_view{str, 6} == "12ABF0"sv);
+    }
+
+    {
+        static const std::uint8_t data[3] = {0x12, 0xAB, 0xF0};
+        char str[5];
+        REQUIRE(kon::base16_encode(data, sizeof(data), str, sizeof(str)) == 4);
+        REQUIRE(std::string_view{str, 4} == "12ab"sv);
+    }
+}
+
+TEST_CASE("base16_simd", "[base16]") {
+    // Long enough for the 32 and 16 bytes kernels and the scalar tail.
+    std::uint8_t data[123];
+    for (std::size_t i = 0; i < sizeof(data); i++) {
+        data[i] = static_cast<std::uint8_t>(i * 37 + 11);
+    }
+    for (bool upper_case: {false, true}) {
+        char str[sizeof(data) * 2];
+        REQUIRE(
+            kon::base16_encode(data, sizeof(data), str, sizeof(str), upper_case) == sizeof(str));
+        for (std::size_t i = 0; i < sizeof(data); i++) {
+            uint8_t high = kon::base16_char_decode(str[i * 2]);
+            uint8_t low = kon::base16_char_decode(str[i * 2 + 1]);
+            REQUIRE(((high << 4) | low) == data[i]);
+            REQUIRE((std::isupper(str[i * 2]) != 0) == (upper_case && high >= 10));
+        }
+
+        std::uint8_t decoded[sizeof(data)];
+        REQUIRE(kon::base16_decode(str, sizeof(str), decoded, sizeof(decoded)) == sizeof(str));
+        REQUIRE(memcmp(data, decoded, sizeof(data)) == 0);
+
+        // Decoding stops at an invalid character, wherever it is.
+        for (std::size_t pos: {0, 2, 40, 64, 100, 130, 200, 244}) {
+            char bad[sizeof(str)];
+            memcpy(bad, str, sizeof(str));
+            bad[pos] = 'g';
+            REQUIRE(kon::base16_decode(bad, sizeof(bad), decoded, sizeof(decoded)) == pos);
+            REQUIRE(memcmp(data, decoded, pos / 2) == 0);
+            bad[pos] = 'G';
+            bad[pos + 1] = '/';
+            REQUIRE(kon::base16_decode(bad, sizeof(bad), decoded, sizeof(decoded)) == pos);
+            bad[pos] = str[pos];
+            REQUIRE(kon::base16_decode(bad, sizeof(bad), decoded, sizeof(decoded)) == 0);
+        }
+        // Not enough space.
+        REQUIRE(kon::base16_decode(str, sizeof(str), decoded, sizeof(decoded) - 1) == 0);
+    }
+}
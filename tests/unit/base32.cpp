@@ -0,0 +1,78 @@
+#include <kon/base32.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <string>
+#include <string_view>
+
+using namespace std::literals;
+
+static std::string base32_encode_helper(std::string_view data, kon::base32_variant variant) {
+    std::string str(kon::base32_encoded_size(data.size(), variant), '\0');
+    auto n = kon::base32_encode(
+        reinterpret_cast<const std::uint8_t *>(data.data()),
+        data.size(),
+        str.data(),
+        str.size(),
+        variant);
+    str.resize(n);
+    return str;
+}
+
+static std::string
+    base32_decode_helper(std::string_view str, kon::base32_variant variant, std::size_t &pos) {
+    std::string data(kon::base32_decoded_size(str.size()), '\0');
+    std::size_t data_size = data.size();
+    pos = kon::base32_decode(
+        str.data(), str.size(), reinterpret_cast<std::uint8_t *>(data.data()), data_size, variant);
+    data.resize(data_size);
+    return data;
+}
+
+// Reference: https://www.rfc-editor.org/rfc/rfc4648#section-10
+TEST_CASE("base32_rfc4648", "[base32]") {
+    static const std::string_view vectors[][3] = {
+        {""sv, ""sv, ""sv},
+        {"f"sv, "MY======"sv, "CO======"sv},
+        {"fo"sv, "MZXQ===="sv, "CPNG===="sv},
+        {"foo"sv, "MZXW6==="sv, "CPNMU==="sv},
+        {"foob"sv, "MZXW6YQ="sv, "CPNMUOG="sv},
+        {"fooba"sv, "MZXW6YTB"sv, "CPNMUOJ1"sv},
+        {"foobar"sv, "MZXW6YTBOI======"sv, "CPNMUOJ1E8======"sv},
+    };
+    for (auto &v: vectors) {
+        std::size_t pos;
+        REQUIRE(base32_encode_helper(v[0], kon::base32_variant::standard) == v[1]);
+        REQUIRE(base32_encode_helper(v[0], kon::base32_variant::hex) == v[2]);
+        REQUIRE(base32_decode_helper(v[1], kon::base32_variant::standard, pos) == v[0]);
+        REQUIRE(pos == v[1].size());
+        REQUIRE(base32_decode_helper(v[2], kon::base32_variant::hex, pos) == v[0]);
+        REQUIRE(pos == v[2].size());
+
+        auto nopad = v[1].substr(0, v[1].find('='));
+        REQUIRE(base32_encode_helper(v[0], kon::base32_variant::standard_nopad) == nopad);
+        REQUIRE(base32_decode_helper(nopad, kon::base32_variant::standard_nopad, pos) == v[0]);
+        REQUIRE(pos == nopad.size());
+    }
+}
+
+TEST_CASE("base32_error", "[base32]") {
+    std::size_t pos;
+    REQUIRE(base32_decode_helper("mzxw6ytb"sv, kon::base32_variant::standard, pos) == "fooba"sv);
+    REQUIRE(pos == 8);
+    REQUIRE(base32_decode_helper("MZXW6YTB.MZ"sv, kon::base32_variant::standard, pos) == "fooba"sv);
+    REQUIRE(pos == 8);
+    // Truncated.
+    base32_decode_helper("MZX"sv, kon::base32_variant::standard_nopad, pos);
+    REQUIRE(pos == 0);
+    // Missing padding.
+    base32_decode_helper("MZXQ"sv, kon::base32_variant::standard, pos);
+    REQUIRE(pos == 0);
+    // A group cut by a character out of the alphabet, it's rejected without padding too.
+    base32_decode_helper("MZ!XW6"sv, kon::base32_variant::standard_nopad, pos);
+    REQUIRE(pos == 0);
+    base32_decode_helper("MZXW6YTBMZ!XW6"sv, kon::base32_variant::standard_nopad, pos);
+    REQUIRE(pos == 0);
+    REQUIRE(
+        base32_decode_helper("MZXW6YTB!MZ"sv, kon::base32_variant::standard_nopad, pos) ==
+        "fooba"sv);
+    REQUIRE(pos == 8);
+}
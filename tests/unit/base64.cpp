@@ -0,0 +1,193 @@
+#include <kon/base64.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <cstring>
+#include <string>
+#include <string_view>
+
+using namespace std::literals;
+
+static std::string base64_encode_helper(std::string_view data, kon::base64_variant variant) {
+    std::string str(kon::base64_encoded_size(data.size(), variant), '\0');
+    auto n = kon::base64_encode(
+        reinterpret_cast<const std::uint8_t *>(data.data()),
+        data.size(),
+        str.data(),
+        str.size(),
+        variant);
+    str.resize(n);
+    return str;
+}
+
+static std::string
+    base64_decode_helper(std::string_view str, kon::base64_variant variant, std::size_t &pos) {
+    std::string data(kon::base64_decoded_size(str.size()), '\0');
+    std::size_t data_size = data.size();
+    pos = kon::base64_decode(
+        str.data(), str.size(), reinterpret_cast<std::uint8_t *>(data.data()), data_size, variant);
+    data.resize(data_size);
+    return data;
+}
+
+// Reference: https://www.rfc-editor.org/rfc/rfc4648#section-10
+TEST_CASE("base64_rfc4648", "[base64]") {
+    static const std::string_view vectors[][3] = {
+        {""sv, ""sv, ""sv},
+        {"f"sv, "Zg=="sv, "Zg"sv},
+        {"fo"sv, "Zm8="sv, "Zm8"sv},
+        {"foo"sv, "Zm9v"sv, "Zm9v"sv},
+        {"foob"sv, "Zm9vYg=="sv, "Zm9vYg"sv},
+        {"fooba"sv, "Zm9vYmE="sv, "Zm9vYmE"sv},
+        {"foobar"sv, "Zm9vYmFy"sv, "Zm9vYmFy"sv},
+    };
+    for (auto &v: vectors) {
+        std::size_t pos;
+        REQUIRE(base64_encode_helper(v[0], kon::base64_variant::standard) == v[1]);
+        REQUIRE(base64_encode_helper(v[0], kon::base64_variant::standard_nopad) == v[2]);
+        REQUIRE(base64_decode_helper(v[1], kon::base64_variant::standard, pos) == v[0]);
+        REQUIRE(pos == v[1].size());
+        REQUIRE(base64_decode_helper(v[2], kon::base64_variant::standard_nopad, pos) == v[0]);
+        REQUIRE(pos == v[2].size());
+    }
+}
+
+TEST_CASE("base64_variant", "[base64]") {
+    std::size_t pos;
+    std::string_view data{"\xFB\xFF\xBF"sv};
+    REQUIRE(base64_encode_helper(data, kon::base64_variant::standard) == "+/+/"sv);
+    REQUIRE(base64_encode_helper(data, kon::base64_variant::url) == "-_-_"sv);
+    REQUIRE(base64_decode_helper("-_-_"sv, kon::base64_variant::url, pos) == data);
+    REQUIRE(pos == 4);
+    // "+/" isn't in the URL alphabet.
+    REQUIRE(base64_decode_helper("+/+/"sv, kon::base64_variant::url, pos).empty());
+    REQUIRE(pos == 0);
+    REQUIRE(base64_decode_helper("Zm9v-_-_"sv, kon::base64_variant::standard, pos) == "foo"sv);
+    REQUIRE(pos == 4);
+}
+
+TEST_CASE("base64_error", "[base64]") {
+    std::size_t pos;
+    // Stop at a group boundary.
+    REQUIRE(base64_decode_helper("Zm9v.Zm9v"sv, kon::base64_variant::standard, pos) == "foo"sv);
+    REQUIRE(pos == 4);
+    REQUIRE(base64_decode_helper("Zm9vYg==Zm9v"sv, kon::base64_variant::standard, pos) == "foob"sv);
+    REQUIRE(pos == 8);
+    // Truncated.
+    base64_decode_helper("Zm9vY"sv, kon::base64_variant::standard, pos);
+    REQUIRE(pos == 0);
+    // Missing padding.
+    base64_decode_helper("Zm9vYg"sv, kon::base64_variant::standard, pos);
+    REQUIRE(pos == 0);
+    base64_decode_helper("Zm9vYg="sv, kon::base64_variant::standard, pos);
+    REQUIRE(pos == 0);
+    // A character out of the alphabet inside a group.
+    for (auto variant: {kon::base64_variant::standard_nopad, kon::base64_variant::url_nopad}) {
+        REQUIRE(base64_decode_helper("QU!D"sv, variant, pos).empty());
+        REQUIRE(pos == 0);
+        REQUIRE(base64_decode_helper("Zm9vQU!D"sv, variant, pos).empty());
+        REQUIRE(pos == 0);
+        REQUIRE(base64_decode_helper("Zm9v!QUJD"sv, variant, pos) == "foo"sv);
+        REQUIRE(pos == 4);
+    }
+    base64_decode_helper("QU!D"sv, kon::base64_variant::standard, pos);
+    REQUIRE(pos == 0);
+    // Not enough space.
+    std::uint8_t data[4];
+    std::size_t data_size = 3;
+    REQUIRE(kon::base64_decode("Zm9vYg==", 8, data, data_size) == 0);
+    char str[7];
+    REQUIRE(kon::base64_encode(data, 4, str, sizeof(str)) == 0);
+}
+
+TEST_CASE("base64_simd", "[base64]") {
+    // Long enough for the SIMD kernels, and all tail lengths.
+    std::string data;
+    for (std::size_t i = 0; i < 300; i++) {
+        data.push_back(static_cast<char>(i * 151 + 7));
+    }
+    for (auto variant:
+         {kon::base64_variant::standard,
+          kon::base64_variant::standard_nopad,
+          kon::base64_variant::url,
+          kon::base64_variant::url_nopad}) {
+        std::string alphabet{"ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/"};
+        if (kon::base64_is_url(variant)) {
+            alphabet[62] = '-';
+            alphabet[63] = '_';
+        }
+        for (std::size_t size = 0; size <= data.size(); size += 7) {
+            std::string_view input{data.data(), size};
+            auto str = base64_encode_helper(input, variant);
+            REQUIRE(str.size() == kon::base64_encoded_size(size, variant));
+            for (std::size_t i = 0; i + 3 <= size; i += 3) {
+                auto v = (static_cast<std::uint8_t>(input[i]) << 16)
+                       | (static_cast<std::uint8_t>(input[i + 1]) << 8)
+                       | static_cast<std::uint8_t>(input[i + 2]);
+                REQUIRE(str[i / 3 * 4] == alphabet[v >> 18]);
+                REQUIRE(str[i / 3 * 4 + 3] == alphabet[v & 0x3F]);
+            }
+            std::size_t pos;
+            REQUIRE(base64_decode_helper(str, variant, pos) == input);
+            REQUIRE(pos == str.size());
+            if (str.size() > 100) {
+                auto bad = str;
+                bad[100] = '*';
+                REQUIRE(base64_decode_helper(bad, variant, pos) == input.substr(0, 75));
+                REQUIRE(pos == 100);
+            }
+        }
+    }
+}
+
+TEST_CASE("base64_stream", "[base64]") {
+    std::string data;
+    for (std::size_t i = 0; i < 200; i++) {
+        data.push_back(static_cast<char>(i * 13 + 5));
+    }
+    for (auto variant: {kon::base64_variant::standard, kon::base64_variant::url_nopad}) {
+        auto check = base64_encode_helper(data, variant);
+        for (std::size_t chunk: {1, 2, 3, 5, 64, 100}) {
+            kon::base64_encoder encoder;
+            encoder.start(variant);
+            std::string str;
+            for (std::size_t i = 0; i < data.size(); i += chunk) {
+                auto n = std::min(chunk, data.size() - i);
+                char out[(100 + 2) / 3 * 4];
+                auto size = encoder.update(
+                    reinterpret_cast<const std::uint8_t *>(data.data() + i), n, out);
+                str.append(out, size);
+            }
+            char out[4];
+            str.append(out, encoder.finish(out));
+            REQUIRE(str == check);
+
+            kon::base64_decoder decoder;
+            decoder.start(variant);
+            std::string decoded;
+            for (std::size_t i = 0; i < str.size(); i += chunk) {
+                auto n = std::min(chunk, str.size() - i);
+                std::uint8_t buffer[(100 + 3) / 4 * 3];
+                std::size_t size;
+                REQUIRE(decoder.update(str.data() + i, n, buffer, size));
+                decoded.append(reinterpret_cast<char *>(buffer), size);
+            }
+            std::uint8_t buffer[2];
+            std::size_t size;
+            REQUIRE(decoder.finish(buffer, size));
+            decoded.append(reinterpret_cast<char *>(buffer), size);
+            REQUIRE(decoded == data);
+        }
+    }
+
+    {
+        kon::base64_decoder decoder;
+        std::uint8_t buffer[16];
+        std::size_t size;
+        decoder.start();
+        REQUIRE_FALSE(decoder.update("Zg==Zg==", 8, buffer, size));
+        decoder.start();
+        REQUIRE_FALSE(decoder.update("Zm9*", 4, buffer, size));
+        decoder.start();
+        REQUIRE(decoder.update("Zm9", 3, buffer, size));
+        REQUIRE_FALSE(decoder.finish(buffer, size));
+    }
+}
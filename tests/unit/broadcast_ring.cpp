@@ -0,0 +1,234 @@
+#include <catch2/catch_test_macros.hpp>
+#include <kon/broadcast_ring.hpp>
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace {
+bool push_u64(kon::broadcast_ring &ring, std::uint64_t value) {
+    return ring.push(0x21, reinterpret_cast<const std::uint8_t *>(&value), sizeof(value));
+}
+
+bool read_u64(kon::broadcast_ring::consumer &c, std::uint64_t &value) {
+    kon::broadcast_ring::message_head head;
+    std::uint8_t data[64];
+    if (!c.read(head, data, sizeof(data))) {
+        return false;
+    }
+    REQUIRE(head.type == 0x21);
+    REQUIRE(head.length == sizeof(value));
+    std::memcpy(&value, data, sizeof(value));
+    return true;
+}
+} // namespace
+
+TEST_CASE("broadcast_ring_gating", "[broadcast_ring]") {
+    kon::broadcast_ring ring(100, kon::broadcast_ring::mode::gating);
+    REQUIRE(ring.capacity() == 128);
+    REQUIRE(ring.max_message_length() == 48);
+
+    // Nobody is subscribed, nothing gates the producer.
+    for (std::uint64_t i = 0; i < 20; i++) {
+        REQUIRE(push_u64(ring, i));
+    }
+
+    kon::broadcast_ring::consumer a;
+    kon::broadcast_ring::consumer b;
+    REQUIRE(a.subscribe(ring));
+    REQUIRE(b.subscribe(ring));
+    std::uint64_t value;
+    REQUIRE_FALSE(read_u64(a, value));
+
+    // 32 bytes a record, the slowest consumer gates the producer.
+    for (std::uint64_t i = 0; i < 4; i++) {
+        REQUIRE(push_u64(ring, 100 + i));
+    }
+    REQUIRE_FALSE(push_u64(ring, 104));
+    for (std::uint64_t i = 0; i < 4; i++) {
+        REQUIRE(read_u64(a, value));
+        REQUIRE(value == (100 + i));
+    }
+    REQUIRE_FALSE(read_u64(a, value));
+    REQUIRE_FALSE(push_u64(ring, 104));
+    REQUIRE(read_u64(b, value));
+    REQUIRE(value == 100);
+    REQUIRE(push_u64(ring, 104));
+    REQUIRE(read_u64(a, value));
+    REQUIRE(value == 104);
+
+    // An unsubscribed consumer gates nobody.
+    b.unsubscribe();
+    REQUIRE_FALSE(b.subscribed());
+    for (std::uint64_t i = 0; i < 4; i++) {
+        REQUIRE(push_u64(ring, 105 + i));
+        REQUIRE(read_u64(a, value));
+        REQUIRE(value == (105 + i));
+    }
+    REQUIRE(a.lost() == 0);
+
+    // Too long for the buffer, or for the reader.
+    std::uint8_t data[64]{};
+    REQUIRE_FALSE(ring.push(1, data, 49));
+    REQUIRE(ring.push(1, data, 48));
+    kon::broadcast_ring::message_head head;
+    REQUIRE_FALSE(a.read(head, data, 47));
+    REQUIRE(a.read(head, data, 48));
+    REQUIRE(head.length == 48);
+}
+
+TEST_CASE("broadcast_ring_turn_around", "[broadcast_ring]") {
+    kon::broadcast_ring ring(128, kon::broadcast_ring::mode::gating);
+    kon::broadcast_ring::consumer c;
+    REQUIRE(c.subscribe(ring));
+    kon::broadcast_ring::zc_scope zcs;
+    // The records are 16, 32 and 48 bytes long, they turn around at different offsets.
+    for (std::uint32_t i = 0; i < 100; i++) {
+        std::uint32_t length = (i % 3) * 16;
+        REQUIRE(ring.push_begin(zcs, length));
+        zcs.head->type = i;
+        zcs.head->length = length;
+        std::memset(zcs.data, static_cast<int>(i), length);
+        ring.push_end(zcs);
+
+        REQUIRE(c.read_begin(zcs));
+        REQUIRE(zcs.head->type == i);
+        REQUIRE(zcs.head->length == length);
+        for (std::uint32_t j = 0; j < length; j++) {
+            REQUIRE(zcs.data[j] == static_cast<std::uint8_t>(i));
+        }
+        c.read_end(zcs);
+        REQUIRE_FALSE(c.read_begin(zcs));
+    }
+    REQUIRE(c.lost() == 0);
+}
+
+TEST_CASE("broadcast_ring_overwrite", "[broadcast_ring]") {
+    kon::broadcast_ring ring(128, kon::broadcast_ring::mode::overwrite);
+    kon::broadcast_ring::consumer fast;
+    kon::broadcast_ring::consumer slow;
+    REQUIRE(fast.subscribe(ring));
+    REQUIRE(slow.subscribe(ring));
+    std::uint64_t value;
+    for (std::uint64_t i = 0; i < 10; i++) {
+        REQUIRE(push_u64(ring, i));
+        REQUIRE(read_u64(fast, value));
+        REQUIRE(value == i);
+    }
+    REQUIRE(fast.lost() == 0);
+
+    // The slow one is lapped, it resumes from the oldest message left.
+    REQUIRE(read_u64(slow, value));
+    REQUIRE(value == 6);
+    for (std::uint64_t i = 7; i < 10; i++) {
+        REQUIRE(read_u64(slow, value));
+        REQUIRE(value == i);
+    }
+    REQUIRE_FALSE(read_u64(slow, value));
+    // The loss is counted once it has read a message before the gap.
+    REQUIRE(slow.lost() == 0);
+    for (std::uint64_t i = 10; i < 20; i++) {
+        REQUIRE(push_u64(ring, i));
+    }
+    REQUIRE(read_u64(slow, value));
+    REQUIRE(value == 16);
+    REQUIRE(slow.lost() == 6);
+
+    // No zero copy writing or reading, the message stays the next one.
+    kon::broadcast_ring::zc_scope zcs;
+    REQUIRE_FALSE(ring.push_begin(zcs, 8));
+    REQUIRE(push_u64(ring, 20));
+    REQUIRE_FALSE(slow.read_begin(zcs));
+    for (std::uint64_t i = 17; i <= 20; i++) {
+        REQUIRE(read_u64(slow, value));
+        REQUIRE(value == i);
+    }
+}
+
+TEST_CASE("broadcast_ring_subscribe", "[broadcast_ring]") {
+    kon::broadcast_ring ring(256, kon::broadcast_ring::mode::gating);
+    std::vector<std::unique_ptr<kon::broadcast_ring::consumer>> consumers;
+    for (std::size_t i = 0; i < kon::broadcast_ring::max_consumers; i++) {
+        consumers.emplace_back(std::make_unique<kon::broadcast_ring::consumer>());
+        REQUIRE(consumers.back()->subscribe(ring));
+    }
+    kon::broadcast_ring::consumer extra;
+    REQUIRE_FALSE(extra.subscribe(ring));
+    REQUIRE_FALSE(extra.subscribed());
+
+    // A destroyed consumer frees its cursor.
+    REQUIRE(push_u64(ring, 1));
+    consumers[5].reset();
+    REQUIRE(extra.subscribe(ring));
+    std::uint64_t value;
+    REQUIRE_FALSE(read_u64(extra, value));
+    REQUIRE(read_u64(*consumers[6], value));
+    REQUIRE(value == 1);
+}
+
+TEST_CASE("broadcast_ring_threads", "[broadcast_ring]") {
+    constexpr std::uint64_t count = 100000;
+    constexpr std::size_t readers = 3;
+    for (auto m: {kon::broadcast_ring::mode::gating, kon::broadcast_ring::mode::overwrite}) {
+        kon::broadcast_ring ring(1024, m);
+        kon::broadcast_ring::consumer consumers[readers];
+        for (auto &c: consumers) {
+            REQUIRE(c.subscribe(ring));
+        }
+        std::atomic<bool> done{false};
+        std::vector<std::uint64_t> received(readers, 0);
+        std::vector<std::uint8_t> ordered(readers, 1); // Not a vector<bool>, shared by the readers.
+        std::vector<std::thread> threads;
+        for (std::size_t r = 0; r < readers; r++) {
+            threads.emplace_back([&, r]() {
+                kon::broadcast_ring::message_head head;
+                std::uint64_t data[8];
+                std::uint64_t last = 0;
+                while (true) {
+                    bool finished = done.load(std::memory_order_acquire);
+                    if (!consumers[r].read(
+                            head, reinterpret_cast<std::uint8_t *>(data), sizeof(data))) {
+                        if (finished) {
+                            break;
+                        }
+                        std::this_thread::yield();
+                        continue;
+                    }
+                    // Every message repeats its number, a torn one doesn't.
+                    for (std::size_t i = 1; i < (head.length / 8); i++) {
+                        ordered[r] &= (data[i] == data[0]);
+                    }
+                    ordered[r] &= ((received[r] == 0) || (data[0] > last));
+                    last = data[0];
+                    received[r]++;
+                }
+            });
+        }
+        std::uint64_t data[8];
+        for (std::uint64_t i = 1; i <= count;) {
+            std::fill(std::begin(data), std::end(data), i);
+            auto length = static_cast<std::uint32_t>(((i % 8) + 1) * 8);
+            if (ring.push(1, reinterpret_cast<const std::uint8_t *>(data), length)) {
+                i++;
+            } else {
+                std::this_thread::yield();
+            }
+        }
+        done.store(true, std::memory_order_release);
+        for (auto &t: threads) {
+            t.join();
+        }
+        for (std::size_t r = 0; r < readers; r++) {
+            REQUIRE(ordered[r]);
+            if (m == kon::broadcast_ring::mode::gating) {
+                REQUIRE(received[r] == count);
+                REQUIRE(consumers[r].lost() == 0);
+            } else {
+                REQUIRE((received[r] + consumers[r].lost()) <= count);
+            }
+        }
+    }
+}
@@ -0,0 +1,186 @@
+#include <catch2/catch_test_macros.hpp>
+#include <kon/dbuf_chain.hpp>
+#include <cstring>
+#include <numeric>
+#include <sys/uio.h>
+#include <vector>
+
+struct chain_head {
+    std::uint16_t magic;
+    std::uint16_t length;
+};
+
+TEST_CASE("chain_append", "[dbuf_chain]") {
+    int err;
+    kon::pool p{err, 64, 16, {.headroom = 8}};
+    REQUIRE(err == 0);
+    {
+        kon::dbuf_chain chain{p};
+
+        auto head = chain.prepend<chain_head>();
+        REQUIRE(head != nullptr);
+        REQUIRE(chain.segment_count() == 1);
+        REQUIRE(chain.segment(0).headroom() == 4); // The headroom of the pool.
+
+        std::vector<std::uint8_t> payload(200);
+        std::iota(payload.begin(), payload.end(), 0);
+        REQUIRE(chain.append(payload.data(), payload.size()));
+        REQUIRE(chain.data_length() == 204);
+        // 60 bytes in the first segment, then 64 in the next ones.
+        REQUIRE(chain.segment_count() == 4);
+        REQUIRE(chain.segment(0).data_length() == 60);
+        REQUIRE(chain.segment(1).headroom() == 0);
+
+        // Contiguous, it spills into a new segment.
+        auto words = chain.append<std::uint32_t[]>(13); // 48 bytes left in the last one.
+        REQUIRE(words != nullptr);
+        REQUIRE(chain.segment_count() == 5);
+        REQUIRE(chain.data_length() == 256);
+        REQUIRE(p.available() == 11);
+
+        // No headroom left, a new segment goes in front.
+        auto outer = chain.prepend<std::uint64_t>();
+        REQUIRE(outer != nullptr);
+        *outer = 0x0123456789ABCDEFull;
+        REQUIRE(chain.segment_count() == 6);
+        REQUIRE(chain.segment(1).data() == reinterpret_cast<std::uint8_t *>(head));
+        REQUIRE(chain.data_length() == 264);
+
+        REQUIRE(chain.read<std::uint64_t>() == outer);
+        REQUIRE(chain.read<chain_head>() == head);
+        std::vector<std::uint8_t> out(200);
+        REQUIRE(chain.read(out.data(), out.size()));
+        REQUIRE(out == payload);
+        REQUIRE(chain.read<std::uint32_t[]>(13) == words);
+        REQUIRE(chain.data_length() == 0);
+        REQUIRE(!chain.read(out.data(), 1));
+    }
+    REQUIRE(p.available() == 16);
+}
+
+TEST_CASE("chain_exhausted", "[dbuf_chain]") {
+    int err;
+    kon::pool p{err, 64, 2};
+    REQUIRE(err == 0);
+    kon::dbuf_chain chain{p};
+
+    std::uint8_t data[200] = {};
+    REQUIRE(!chain.append(data, sizeof(data)));
+    REQUIRE(chain.data_length() == 128);
+    REQUIRE(chain.append<std::uint8_t>() == nullptr);
+    chain.clear();
+    REQUIRE(p.available() == 2);
+}
+
+TEST_CASE("chain_too_large", "[dbuf_chain]") {
+    int err;
+    kon::pool p{err, 64, 4, {.headroom = 8}};
+    REQUIRE(err == 0);
+    kon::dbuf_chain chain{p};
+
+    // Larger than the first segment, or than its headroom, nothing is taken.
+    REQUIRE(chain.append<std::uint8_t[]>(57) == nullptr);
+    REQUIRE(chain.prepend<std::uint8_t[]>(9) == nullptr);
+    REQUIRE(chain.segment_count() == 0);
+    REQUIRE(p.available() == 4);
+
+    REQUIRE(chain.append<std::uint8_t[]>(56) != nullptr);
+    for (int i = 0; i < 8; i++) {
+        REQUIRE(chain.append<std::uint8_t[]>(65) == nullptr);
+        REQUIRE(chain.prepend<std::uint8_t[]>(65) == nullptr);
+    }
+    REQUIRE(chain.segment_count() == 1);
+    REQUIRE(chain.data_length() == 56);
+    REQUIRE(p.available() == 3);
+
+    REQUIRE(chain.append<std::uint8_t[]>(64) != nullptr);
+    REQUIRE(chain.prepend<std::uint8_t[]>(72) == nullptr);
+    REQUIRE(chain.prepend<std::uint8_t[]>(64) != nullptr); // The headroom is 8, a new segment.
+    REQUIRE(chain.segment_count() == 3);
+    chain.clear();
+    REQUIRE(p.available() == 4);
+}
+
+TEST_CASE("chain_push_back", "[dbuf_chain]") {
+    std::uint8_t frame0[8] = {1, 2, 3, 4, 5, 6, 7, 8};
+    std::uint8_t frame1[4] = {9, 10, 11, 12};
+    kon::dbuf_chain chain;
+
+    kon::dbuf buf0{frame0, 0x1000, 0, sizeof(frame0)};
+    buf0.reset(0, sizeof(frame0));
+    kon::dbuf buf1{frame1, 0x2000, 0, sizeof(frame1)};
+    buf1.reset(0, sizeof(frame1));
+    REQUIRE(chain.push_back(buf0));
+    REQUIRE(chain.push_back(buf1));
+    REQUIRE(chain.data_length() == 12);
+    REQUIRE(chain.append<std::uint8_t>() == nullptr); // No pool.
+
+    // Crosses the segments.
+    REQUIRE(chain.adjust(6));
+    REQUIRE(chain.read<std::uint32_t>() == nullptr);
+    std::uint8_t out[4];
+    REQUIRE(chain.read(out, sizeof(out)));
+    REQUIRE(out[0] == 7);
+    REQUIRE(out[3] == 10);
+    REQUIRE(chain.data_length() == 2);
+    REQUIRE(!chain.adjust(3));
+    REQUIRE(chain.adjust(2));
+    REQUIRE(chain.data_length() == 0);
+}
+
+TEST_CASE("chain_iovec", "[dbuf_chain]") {
+    int err;
+    kon::pool p{err, 32, 8, {.headroom = 16}};
+    REQUIRE(err == 0);
+    kon::dbuf_chain chain{p};
+
+    std::uint8_t data[100];
+    std::iota(data, data + sizeof(data), 0);
+    REQUIRE(chain.append(data, sizeof(data)));
+    REQUIRE(chain.adjust(10));
+
+    struct iovec iov[8];
+    auto n = chain.to_iovec(iov, 8);
+    REQUIRE(n == 4);
+    REQUIRE(iov[0].iov_len == 6);
+    REQUIRE(static_cast<std::uint8_t *>(iov[0].iov_base)[0] == 10);
+    std::size_t total = 0;
+    for (std::size_t i = 0; i < n; i++) {
+        total += iov[i].iov_len;
+    }
+    REQUIRE(total == 90);
+    REQUIRE(chain.to_iovec(iov, 2) == 2);
+
+    std::uint8_t out[90];
+    chain.copy_to(out);
+    REQUIRE(std::memcmp(out, data + 10, sizeof(out)) == 0);
+    REQUIRE(chain.data_length() == 90);
+}
+
+TEST_CASE("chain_linearize", "[dbuf_chain]") {
+    int err;
+    kon::pool p{err, 64, 8, {.headroom = 16}};
+    REQUIRE(err == 0);
+    kon::dbuf_chain chain{p};
+
+    std::uint8_t data[100];
+    std::iota(data, data + sizeof(data), 0);
+    REQUIRE(chain.append(data, 40));
+    REQUIRE(chain.linearize() == chain.segment(0).data()); // A single segment.
+
+    REQUIRE(chain.append(data + 40, 20));
+    REQUIRE(chain.segment_count() == 2);
+    auto linear = chain.linearize();
+    REQUIRE(linear != nullptr);
+    REQUIRE(chain.segment_count() == 1);
+    REQUIRE(chain.segment(0).headroom() == 4);
+    REQUIRE(std::memcmp(linear, data, 60) == 0);
+    REQUIRE(p.available() == 7);
+
+    REQUIRE(chain.append(data + 60, 40));
+    REQUIRE(chain.linearize() == nullptr); // 100 bytes don't fit in a segment.
+    REQUIRE(chain.adjust(50));
+    linear = chain.linearize();
+    REQUIRE(linear != nullptr);
+    REQUIRE(std::memcmp(linear, data + 50, 50) == 0);
+}
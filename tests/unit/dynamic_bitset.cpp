@@ -0,0 +1,147 @@
+#include <catch2/catch_test_macros.hpp>
+#include <kon/dynamic_bitset.hpp>
+#include <random>
+#include <vector>
+
+namespace {
+bool same(const kon::dynamic_bitset &bs, const std::vector<bool> &expected) {
+    if (bs.size() != expected.size()) {
+        return false;
+    }
+    std::size_t count = 0;
+    for (std::size_t i = 0; i < expected.size(); i++) {
+        if (bs.test(i) != expected[i]) {
+            return false;
+        }
+        count += expected[i];
+    }
+    return bs.count() == count;
+}
+
+std::vector<bool> random_bits(std::mt19937 &gen, std::size_t size, unsigned density) {
+    std::vector<bool> bits(size);
+    for (std::size_t i = 0; i < size; i++) {
+        bits[i] = (gen() % 100) < density;
+    }
+    return bits;
+}
+
+void assign_bits(kon::dynamic_bitset &bs, const std::vector<bool> &bits) {
+    REQUIRE(bs.resize(bits.size()));
+    bs.reset();
+    for (std::size_t i = 0; i < bits.size(); i++) {
+        if (bits[i]) {
+            bs.set(i);
+        }
+    }
+}
+} // namespace
+
+TEST_CASE("dynamic_bitset", "[dynamic_bitset]") {
+    kon::dynamic_bitset bs;
+    REQUIRE(bs.size() == 0);
+    REQUIRE(bs.none());
+    REQUIRE(bs.all());
+    REQUIRE(bs.find_first() == kon::dynamic_bitset::npos);
+
+    REQUIRE(bs.resize(1000));
+    REQUIRE(bs.word_count() == 16);
+    REQUIRE((reinterpret_cast<std::uintptr_t>(bs.words()) % 64) == 0);
+    REQUIRE(bs.none());
+
+    bs.set(0).set(63).set(64).set(999);
+    REQUIRE(bs.count() == 4);
+    REQUIRE(bs.find_first() == 0);
+    REQUIRE(bs.find_next(0) == 63);
+    REQUIRE(bs.find_next(63) == 64);
+    REQUIRE(bs.find_next(64) == 999);
+    REQUIRE(bs.find_next(999) == kon::dynamic_bitset::npos);
+    bs.reset(0).flip(63);
+    REQUIRE(bs.find_first() == 64);
+
+    bs.set();
+    REQUIRE(bs.all());
+    REQUIRE(bs.count() == 1000);
+    bs.flip();
+    REQUIRE(bs.none());
+
+    bs.set(200, 10);
+    REQUIRE(bs.count() == 191);
+    REQUIRE(bs.find_first() == 10);
+    bs.reset(199, 11);
+    REQUIRE(bs.count() == 2);
+    REQUIRE(bs.find_next(10) == 200);
+    bs.set(5, 3);
+    REQUIRE(bs.count() == 5);
+
+    // The bits past the size are cut, the kept ones are unchanged.
+    REQUIRE(bs.resize(8));
+    REQUIRE(bs.count() == 3);
+    REQUIRE(bs.resize(5000));
+    REQUIRE(bs.count() == 3);
+    REQUIRE(bs.find_next(5) == kon::dynamic_bitset::npos);
+
+    kon::dynamic_bitset other{std::move(bs)};
+    REQUIRE(bs.size() == 0);
+    REQUIRE(other.size() == 5000);
+    REQUIRE(bs.assign(other));
+    REQUIRE(bs == other);
+    bs.set(4999);
+    REQUIRE(!(bs == other));
+}
+
+TEST_CASE("dynamic_bitset_random", "[dynamic_bitset]") {
+    std::mt19937 gen(17);
+    for (std::size_t size: {1, 63, 64, 65, 511, 512, 513, 4096, 100003}) {
+        for (unsigned density: {0, 1, 50, 100}) {
+            auto a = random_bits(gen, size, density);
+            auto b = random_bits(gen, size, 50);
+            kon::dynamic_bitset x;
+            kon::dynamic_bitset y;
+            assign_bits(x, a);
+            assign_bits(y, b);
+            REQUIRE(same(x, a));
+            REQUIRE(x.any() == (x.count() != 0));
+            REQUIRE(x.all() == (x.count() == size));
+
+            std::vector<std::size_t> expected;
+            for (std::size_t i = 0; i < size; i++) {
+                if (a[i]) {
+                    expected.push_back(i);
+                }
+            }
+            std::vector<std::size_t> found;
+            x.for_each_set([&found](std::size_t pos) {
+                found.push_back(pos);
+            });
+            REQUIRE(found == expected);
+            found.clear();
+            for (auto pos = x.find_first(); pos != kon::dynamic_bitset::npos;
+                 pos = x.find_next(pos)) {
+                found.push_back(pos);
+            }
+            REQUIRE(found == expected);
+
+            auto expect = [&a, &b, size](auto op) {
+                std::vector<bool> result(size);
+                for (std::size_t i = 0; i < size; i++) {
+                    result[i] = op(a[i], b[i]);
+                }
+                return result;
+            };
+            kon::dynamic_bitset z;
+            REQUIRE(z.assign(x));
+            z &= y;
+            REQUIRE(same(z, expect([](bool l, bool r) { return l && r; })));
+            REQUIRE(z.assign(x));
+            z |= y;
+            REQUIRE(same(z, expect([](bool l, bool r) { return l || r; })));
+            REQUIRE(z.assign(x));
+            z ^= y;
+            REQUIRE(same(z, expect([](bool l, bool r) { return l != r; })));
+            REQUIRE(z.assign(x));
+            z.and_not(y);
+            REQUIRE(same(z, expect([](bool l, bool r) { return l && !r; })));
+        }
+    }
+}
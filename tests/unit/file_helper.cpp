@@ -2,6 +2,8 @@
 #include <iostream>
 #include <fstream>
 #include <kon/file_helper.hpp>
+#include <algorithm>
+#include <vector>
 
 static int read_all_to_string(const std::string& filePath, std::string& file_content) {
     std::ifstream file(filePath, std::ios::ate | std::ios::binary);
@@ -30,4 +32,49 @@ TEST_CASE("read_all", "[file_helper]") {
     REQUIRE(read_all_to_string(file_path, file_content) == 0);
 
     CHECK(file_content == std::string_view{reinterpret_cast<char*>(file_data.get()), file_size});
-}
\ No newline at end of file
+}
+TEST_CASE("read_all_mapped", "[file_helper]") {
+    std::string file_path{"tests/unit/CMakeLists.txt"};
+    kon::mapped_file file;
+    REQUIRE(kon::file_helper::read_all(file_path, file) == 0);
+
+    std::string file_content{};
+    REQUIRE(read_all_to_string(file_path, file_content) == 0);
+
+    CHECK(file_content == std::string_view{file.data(), file.size()});
+    REQUIRE(kon::file_helper::read_all("tests/unit/none", file) != 0);
+}
+
+TEST_CASE("load_directory", "[file_helper]") {
+    auto dir = std::filesystem::temp_directory_path() / "kon_load_directory";
+    std::filesystem::remove_all(dir);
+    std::filesystem::create_directories(dir / "a" / "b");
+    std::filesystem::create_directories(dir / "c");
+
+    std::vector<std::pair<std::string, std::string>> files;
+    for (std::size_t i = 0; i < 50; i++) {
+        std::string path = (i % 3 == 0) ? "a/b/" : ((i % 3 == 1) ? "c/" : "");
+        path += "file" + std::to_string(i);
+        std::string content(i * 37, static_cast<char>('a' + i % 26));
+        std::ofstream{dir / path, std::ios::binary}.write(content.data(), content.size());
+        files.emplace_back(path, content);
+    }
+    std::filesystem::create_symlink(dir / "file2", dir / "link");
+    files.emplace_back("link", files[2].second);
+    std::sort(files.begin(), files.end());
+
+    for (std::size_t threads: {1, 4}) {
+        kon::file_helper::bulk_load load;
+        REQUIRE(kon::file_helper::load_directory(dir.string(), load, threads) == 0);
+        REQUIRE(load.files.size() == files.size());
+        for (std::size_t i = 0; i < files.size(); i++) {
+            REQUIRE(load.files[i].path == files[i].first);
+            REQUIRE(load.files[i].err == 0);
+            REQUIRE(load.files[i].content == files[i].second);
+            REQUIRE(load.files[i].content.data()[files[i].second.size()] == '\0');
+        }
+    }
+    kon::file_helper::bulk_load load;
+    REQUIRE(kon::file_helper::load_directory((dir / "none").string(), load) == -1);
+    std::filesystem::remove_all(dir);
+}
@@ -0,0 +1,67 @@
+#include <kon/hash/crc32c.hpp>
+#include <cstring>
+#include <string_view>
+#include <vector>
+#include <catch2/catch_test_macros.hpp>
+
+static std::uint32_t crc32c_bitwise(const unsigned char *p, std::size_t n) noexcept {
+    std::uint32_t crc = 0xFFFFFFFF;
+    while (n-- != 0) {
+        crc ^= *p++;
+        for (int k = 0; k < 8; k++) {
+            crc = (crc >> 1) ^ ((crc & 1) ? 0x82F63B78 : 0);
+        }
+    }
+    return ~crc;
+}
+
+static std::vector<unsigned char> crc32c_test_data(std::size_t size) {
+    std::vector<unsigned char> v(size);
+    for (std::size_t i = 0; i < size; i++) {
+        v[i] = static_cast<unsigned char>(i * 131 + 7);
+    }
+    return v;
+}
+
+TEST_CASE("crc32c", "[crc32c]") {
+    std::string_view check = "123456789";
+    REQUIRE(kon::crc32c(reinterpret_cast<const unsigned char *>(check.data()), check.size()) ==
+            0xE3069283);
+    REQUIRE(kon::crc32c(nullptr, 0) == 0);
+
+    // RFC 3720 B.4, 32 bytes of zeros and 32 bytes of ones.
+    unsigned char zeros[32] = {};
+    unsigned char ones[32];
+    std::memset(ones, 0xFF, sizeof(ones));
+    REQUIRE(kon::crc32c(zeros, sizeof(zeros)) == 0x8A9136AA);
+    REQUIRE(kon::crc32c(ones, sizeof(ones)) == 0x62A8AB43);
+}
+
+TEST_CASE("crc32c_interleave", "[crc32c]") {
+    // Cover the unaligned head, the 3-way long and short streams and the tail.
+    auto data = crc32c_test_data(8192 * 3 * 2 + 256 * 3 + 100);
+    for (std::size_t offset = 0; offset < 8; offset++) {
+        for (std::size_t len: {0, 7, 8, 255, 767, 768, 769, 24575, 24576, 24577, 50000}) {
+            if (offset + len > data.size()) {
+                continue;
+            }
+            REQUIRE(kon::crc32c(data.data() + offset, len) ==
+                    crc32c_bitwise(data.data() + offset, len));
+        }
+    }
+}
+
+TEST_CASE("crc32c_context", "[crc32c]") {
+    auto data = crc32c_test_data(30000);
+    auto expected = crc32c_bitwise(data.data(), data.size());
+    for (std::size_t chunk: {1, 3, 64, 1000, 8193, 30000}) {
+        kon::crc32c_context ctx;
+        ctx.start();
+        for (std::size_t i = 0; i < data.size(); i += chunk) {
+            ctx.update(data.data() + i, std::min(chunk, data.size() - i));
+        }
+        REQUIRE(ctx.finish() == expected);
+    }
+    auto head = kon::crc32c(data.data(), 1234);
+    REQUIRE(kon::crc32c_extend(head, data.data() + 1234, data.size() - 1234) == expected);
+}
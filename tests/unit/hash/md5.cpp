@@ -1,5 +1,10 @@
 #include <kon/hash/md5.hpp>
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
 #include <string_view>
+#include <vector>
 #include <catch2/catch_test_macros.hpp>
 #include <kon/types.hpp>
 
@@ -37,4 +42,74 @@ TEST_CASE("md5", "[md5]") {
     for (uint32_t i = 0; i < kon::array_size(md5_test_buf); i++) {
         REQUIRE(md5_test_helper(md5_test_buf[i], md5_test_sum[i]));
     }
-}
\ No newline at end of file
+}
+
+TEST_CASE("md5_unaligned", "[md5]") {
+    // One million 'a', fed from an unaligned address in chunks across the block boundaries.
+    static const unsigned char check[16] = {
+        0x77, 0x07, 0xD6, 0xAE, 0x4E, 0x02, 0x7C, 0x70,
+        0xEE, 0xA2, 0xA9, 0x35, 0xC2, 0x29, 0x6F, 0x21};
+    std::vector<unsigned char> data(1000000 + 3, 'a');
+    for (std::size_t chunk: {1, 63, 65, 1000, 4096 + 3, 1000000}) {
+        kon::md5_context ctx;
+        ctx.start();
+        for (std::size_t i = 3; i < data.size(); i += chunk) {
+            ctx.update(data.data() + i, std::min(chunk, data.size() - i));
+        }
+        unsigned char output[16];
+        ctx.finish(output);
+        REQUIRE(memcmp(output, check, sizeof(output)) == 0);
+    }
+}
+
+static std::string md5_write_test_file(const std::filesystem::path &path, std::size_t size) {
+    std::string content(size, '\0');
+    for (std::size_t i = 0; i < size; i++) {
+        content[i] = static_cast<char>(i * 131 + i / 4099);
+    }
+    std::ofstream file(path, std::ios::binary);
+    file.write(content.data(), content.size());
+    return content;
+}
+
+TEST_CASE("file_md5", "[md5]") {
+    auto dir = std::filesystem::temp_directory_path() / "kon_file_md5";
+    std::filesystem::remove_all(dir);
+    std::filesystem::create_directories(dir / "sub");
+
+    std::vector<std::pair<std::string, std::string>> files;
+    for (std::size_t size: {0, 100, 32768, 1048576 + 37, 9 * 1048576 + 1}) {
+        auto path = ((size & 1) ? dir / "sub" : dir) / std::to_string(size);
+        files.emplace_back(path.string(), md5_write_test_file(path, size));
+    }
+    for (const auto &[path, content]: files) {
+        unsigned char check[16];
+        kon::md5(reinterpret_cast<const unsigned char *>(content.data()), content.size(), check);
+        for (auto mode: {
+                 kon::file_md5_mode::automatic,
+                 kon::file_md5_mode::stream,
+                 kon::file_md5_mode::mmap,
+                 kon::file_md5_mode::threaded}) {
+            unsigned char output[16];
+            REQUIRE(kon::file_md5(path, output, mode) == 0);
+            REQUIRE(memcmp(output, check, sizeof(output)) == 0);
+        }
+    }
+    unsigned char output[16];
+    REQUIRE(kon::file_md5((dir / "none").string(), output) == -1);
+
+    std::vector<kon::file_md5_result> results;
+    REQUIRE(kon::directory_md5(dir.string(), results, 3) == 0);
+    REQUIRE(results.size() == files.size());
+    std::sort(files.begin(), files.end());
+    for (std::size_t i = 0; i < files.size(); i++) {
+        unsigned char check[16];
+        const auto &content = files[i].second;
+        kon::md5(reinterpret_cast<const unsigned char *>(content.data()), content.size(), check);
+        REQUIRE(results[i].file_name == files[i].first);
+        REQUIRE(results[i].err == 0);
+        REQUIRE(memcmp(results[i].md5, check, sizeof(check)) == 0);
+    }
+    REQUIRE(kon::directory_md5((dir / "none").string(), results) == -1);
+    std::filesystem::remove_all(dir);
+}
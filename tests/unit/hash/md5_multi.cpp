@@ -0,0 +1,59 @@
+#include <kon/hash/md5_multi.hpp>
+#include <kon/hash/md5.hpp>
+#include <cstring>
+#include <random>
+#include <vector>
+#include <catch2/catch_test_macros.hpp>
+
+static bool md5_multi_check(const kon::md5_job &job) noexcept {
+    unsigned char output[16];
+    kon::md5(job.input, job.ilen, output);
+    return std::memcmp(output, job.output, sizeof(output)) == 0;
+}
+
+TEST_CASE("md5_multi", "[md5_multi]") {
+    std::mt19937 gen(17);
+    std::vector<unsigned char> data(70000);
+    for (auto &e: data) {
+        e = static_cast<unsigned char>(gen());
+    }
+    // Cover the padding boundaries and mixed lengths.
+    std::vector<kon::md5_job> jobs;
+    for (std::size_t len: {0, 1, 55, 56, 63, 64, 65, 119, 120, 127, 128, 129, 1000, 65536}) {
+        jobs.push_back({data.data() + len % 7, len, {}, nullptr});
+    }
+    for (int i = 0; i < 100; i++) {
+        std::size_t len = gen() % 5000;
+        jobs.push_back({data.data() + gen() % 1000, len, {}, nullptr});
+    }
+    kon::md5_multi_hash(jobs.data(), jobs.size());
+    for (const auto &job: jobs) {
+        REQUIRE(md5_multi_check(job));
+    }
+}
+
+TEST_CASE("md5_multi_submit", "[md5_multi]") {
+    std::vector<unsigned char> data(4096, 0x5A);
+    kon::md5_job jobs[20];
+    for (std::size_t i = 0; i < 20; i++) {
+        jobs[i] = {data.data(), i * 200, {}, reinterpret_cast<void *>(i)};
+    }
+    kon::md5_multi ctx;
+    ctx.start();
+    REQUIRE((ctx.lanes() == 4 || ctx.lanes() == 8));
+
+    std::size_t completed = 0;
+    for (auto &job: jobs) {
+        if (auto done = ctx.submit(&job); done != nullptr) {
+            REQUIRE(md5_multi_check(*done));
+            completed++;
+        }
+    }
+    REQUIRE(completed == 20 - (ctx.lanes() - 1));
+    while (auto done = ctx.flush()) {
+        REQUIRE(md5_multi_check(*done));
+        completed++;
+    }
+    REQUIRE(completed == 20);
+    REQUIRE(ctx.flush() == nullptr);
+}
@@ -0,0 +1,69 @@
+#include <kon/hash/sha256.hpp>
+#include <string_view>
+#include <vector>
+#include <catch2/catch_test_macros.hpp>
+#include <kon/base16.hpp>
+#include <kon/types.hpp>
+
+static std::vector<unsigned char> sha256_test_data(std::size_t size) {
+    std::vector<unsigned char> v(size);
+    for (std::size_t i = 0; i < size; i++) {
+        v[i] = static_cast<unsigned char>(i * 131 + 7);
+    }
+    return v;
+}
+
+static std::string sha256_hex(const unsigned char output[32]) {
+    char str[64];
+    kon::base16_encode(output, 32, str, sizeof(str));
+    return std::string(str, sizeof(str));
+}
+
+using namespace std::string_view_literals;
+
+// Generated by python hashlib.
+static const struct {
+    std::size_t len;
+    std::string_view sum;
+} sha256_test_sum[] = {
+    {0, "e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855"sv},
+    {3, "17aef23a39d753e713c203c152454d29fa8e39a98e83a69b39a5094dba9ae951"sv},
+    {55, "16ed9c4697ca11d5f6fb25ea7900252dd4cb97215d7f6d0b2bb3e2a86ac0ec72"sv},
+    {56, "939ada93b2fe1e9c596d767bb408567c83e253667f0b25e5be8e16f35f2cbac9"sv},
+    {63, "6073f83b09ae82016cdbe24c18996c48f0eaa08ca675d0f6b90b807fc29e0149"sv},
+    {64, "b337ba9b0c69c391364e985fdcb23a889887e59800832c92fbfa22b8a3c40304"sv},
+    {65, "9d6a3fb113b586b4ab97bc11c993a27bd9b7bbcb756e0646083dc47a679600e6"sv},
+    {1000, "533b698850849b7908b20a22658f639c0b2a476f1791f85f50188287c31a9aba"sv},
+    {5999, "8d31ca3ced071bdf50be0277dc12b37a44f0cd32dbb6bea2361a6e710b64c79b"sv},
+};
+
+TEST_CASE("sha256", "[sha256]") {
+    unsigned char output[32];
+    auto abc = "abc"sv;
+    kon::sha256(reinterpret_cast<const unsigned char *>(abc.data()), abc.size(), output);
+    REQUIRE(sha256_hex(output) ==
+            "ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad");
+
+    auto data = sha256_test_data(6000);
+    for (uint32_t i = 0; i < kon::array_size(sha256_test_sum); i++) {
+        kon::sha256(data.data(), sha256_test_sum[i].len, output);
+        REQUIRE(sha256_hex(output) == sha256_test_sum[i].sum);
+    }
+}
+
+TEST_CASE("sha256_context", "[sha256]") {
+    auto data = sha256_test_data(6000);
+    for (uint32_t i = 0; i < kon::array_size(sha256_test_sum); i++) {
+        auto len = sha256_test_sum[i].len;
+        for (std::size_t chunk: {1, 13, 64, 100, 6000}) {
+            kon::sha256_context ctx;
+            ctx.start();
+            for (std::size_t off = 0; off < len; off += chunk) {
+                ctx.update(data.data() + off, std::min(chunk, len - off));
+            }
+            unsigned char output[32];
+            ctx.finish(output);
+            REQUIRE(sha256_hex(output) == sha256_test_sum[i].sum);
+        }
+    }
+}
@@ -0,0 +1,79 @@
+#include <kon/hash/xxh3.hpp>
+#include <vector>
+#include <catch2/catch_test_macros.hpp>
+#include <kon/types.hpp>
+
+static std::vector<unsigned char> xxh3_test_data(std::size_t size) {
+    std::vector<unsigned char> v(size);
+    for (std::size_t i = 0; i < size; i++) {
+        v[i] = static_cast<unsigned char>(i * 131 + 7);
+    }
+    return v;
+}
+
+static constexpr std::uint64_t xxh3_test_seed = 0x9E3779B97F4A7C15ULL;
+
+// Generated by the reference implementation, XXH3_64bits and XXH3_64bits_withSeed.
+static const struct {
+    std::size_t len;
+    std::uint64_t hash;
+    std::uint64_t seeded_hash;
+} xxh3_test_sum[] = {
+    {0, 0x2d06800538d394c2ULL, 0x602b0e2cd6662c8bULL},
+    {1, 0x4c5cca45d0f4811fULL, 0x2f3acd3805f81de3ULL},
+    {3, 0x6e3e2670e61106acULL, 0xbc74611d87f659e0ULL},
+    {4, 0x5c4c63133443d03fULL, 0x6c3753177c607de4ULL},
+    {8, 0xf9fd4dd0b04d78f5ULL, 0xbc72d0531396303fULL},
+    {9, 0x7c20df9712c26edfULL, 0x93c5aa006102daf5ULL},
+    {16, 0x86abf6baccea0858ULL, 0x69d001b16ecf450aULL},
+    {17, 0xb58bf5dc5022d071ULL, 0xb7c99d19be27eb69ULL},
+    {64, 0x1291d2d4042330ddULL, 0x543fa55d8db03991ULL},
+    {128, 0x10d17f72c0ccba41ULL, 0x49b81c6e0abb9305ULL},
+    {129, 0x1648bdc3db49d1a2ULL, 0x5e3831b221810b00ULL},
+    {200, 0xc0fbc0f4e181c826ULL, 0x83264818fb531769ULL},
+    {240, 0xb6cfaf343fab81e6ULL, 0x76a73ec26433f82cULL},
+    {241, 0x956cae592c67279eULL, 0x2be236ba3bacf75cULL},
+    {1024, 0x70bd377d9574f4bbULL, 0xd8cf6b464541f232ULL},
+    {1025, 0x66c4487c41e127a7ULL, 0x8dc3a55e9c26d886ULL},
+    {2048, 0x8b46caa67dab3a30ULL, 0x9f2f0261a2592b60ULL},
+    {5999, 0x17159621c26d971bULL, 0xe0f44c1fa82fd679ULL},
+};
+
+TEST_CASE("xxh3", "[xxh3]") {
+    auto data = xxh3_test_data(6000);
+    for (uint32_t i = 0; i < kon::array_size(xxh3_test_sum); i++) {
+        const auto &t = xxh3_test_sum[i];
+        REQUIRE(kon::xxh3(data.data(), t.len) == t.hash);
+        REQUIRE(kon::xxh3(data.data(), t.len, xxh3_test_seed) == t.seeded_hash);
+    }
+}
+
+TEST_CASE("xxh3_context", "[xxh3]") {
+    auto data = xxh3_test_data(6000);
+    for (uint32_t i = 0; i < kon::array_size(xxh3_test_sum); i++) {
+        const auto &t = xxh3_test_sum[i];
+        for (std::size_t chunk: {1, 7, 64, 100, 256, 1000, 6000}) {
+            kon::xxh3_context ctx;
+            ctx.start();
+            kon::xxh3_context seeded;
+            seeded.start(xxh3_test_seed);
+            for (std::size_t off = 0; off < t.len; off += chunk) {
+                ctx.update(data.data() + off, std::min(chunk, t.len - off));
+                seeded.update(data.data() + off, std::min(chunk, t.len - off));
+            }
+            REQUIRE(ctx.finish() == t.hash);
+            REQUIRE(seeded.finish() == t.seeded_hash);
+        }
+    }
+}
+
+TEST_CASE("xxh3_context_finish", "[xxh3]") {
+    // finish() doesn't alter the context.
+    auto data = xxh3_test_data(6000);
+    kon::xxh3_context ctx;
+    ctx.start();
+    ctx.update(data.data(), 1024);
+    REQUIRE(ctx.finish() == kon::xxh3(data.data(), 1024));
+    ctx.update(data.data() + 1024, 6000 - 1024);
+    REQUIRE(ctx.finish() == kon::xxh3(data.data(), 6000));
+}
@@ -0,0 +1,84 @@
+#include <kon/hexdump.hpp>
+#include <kon/log.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <fmt/format.h>
+#include <string>
+
+using namespace std::literals;
+
+// The original byte-by-byte layout of fmt::formatter<kon::mem_view>.
+static std::string hexdump_reference(const std::uint8_t *data, std::size_t size) {
+    static const char digits[] = "0123456789abcdef";
+    std::string out;
+    std::size_t line_count = 0;
+    for (std::size_t i = 0; i < size; i++) {
+        if (line_count < 32u) {
+            if ((line_count != 0) && (line_count & 3) == 0) {
+                out.push_back(' ');
+            }
+        } else {
+            out.push_back('\n');
+            line_count = 0;
+        }
+        out.push_back(digits[data[i] >> 4]);
+        out.push_back(digits[data[i] & 0x0F]);
+        line_count++;
+    }
+    return out;
+}
+
+static std::string hexdump_helper(const void *va, std::size_t size, kon::hexdump_options options) {
+    std::string out(kon::hexdump_size(size, options), '\0');
+    REQUIRE(kon::hexdump(va, size, out.data(), options) == out.size());
+    return out;
+}
+
+TEST_CASE("hexdump", "[hexdump]") {
+    std::uint8_t data[1500];
+    for (std::size_t i = 0; i < sizeof(data); i++) {
+        data[i] = static_cast<std::uint8_t>(i * 7 + 3);
+    }
+
+    SECTION("default") {
+        for (std::size_t size = 0; size < sizeof(data); size += 13) {
+            REQUIRE(hexdump_helper(data, size, {}) == hexdump_reference(data, size));
+        }
+        REQUIRE(hexdump_helper(data, sizeof(data), {}) == hexdump_reference(data, sizeof(data)));
+    }
+
+    SECTION("offset and ascii") {
+        const char str[] = "0123456789abcdefghijklmnopqrstuvwxyz\x01";
+        auto out = hexdump_helper(str, sizeof(str) - 1, {true, true});
+        REQUIRE(
+            out
+            == "00000000: 30313233 34353637 38396162 63646566 6768696a 6b6c6d6e 6f707172 73747576"
+               "  0123456789abcdefghijklmnopqrstuv\n"
+               "00000020: 7778797a 01"
+                   + std::string(71 - 11, ' ') + "  wxyz.");
+        for (std::size_t size = 1; size < sizeof(data); size += 31) {
+            for (bool offset: {false, true}) {
+                out = hexdump_helper(data, size, {offset, true});
+                std::size_t lines = (size + 31) / 32;
+                std::size_t width = (offset ? 10 : 0) + 71 + 2;
+                std::size_t last = size - (lines - 1) * 32;
+                REQUIRE(out.size() == (lines - 1) * (width + 32 + 1) + width + last);
+                for (std::size_t i = 0; i < lines; i++) {
+                    REQUIRE(out[i * (width + 33) + width - 2] == ' ');
+                }
+            }
+        }
+    }
+
+    SECTION("formatter") {
+        REQUIRE(fmt::format("{}", kon::mem_view{data, 0}).empty());
+        for (std::size_t size: {1, 32, 100, 512, 513, 1500}) {
+            REQUIRE(fmt::format("{}", kon::mem_view{data, size}) == hexdump_reference(data, size));
+            REQUIRE(
+                fmt::format("{:oa}", kon::mem_view{data, size})
+                == hexdump_helper(data, size, {true, true}));
+            REQUIRE(
+                fmt::format("{:o}", kon::mem_view{data, size})
+                == hexdump_helper(data, size, {true, false}));
+        }
+    }
+}
@@ -0,0 +1,85 @@
+#include <catch2/catch_test_macros.hpp>
+#include <kon/hierarchical_bitset.hpp>
+#include <random>
+#include <set>
+
+TEST_CASE("hierarchical_bitset", "[hierarchical_bitset]") {
+    constexpr auto npos = kon::hierarchical_bitset::npos;
+    kon::hierarchical_bitset bs;
+    REQUIRE(bs.find_first() == npos);
+    REQUIRE(bs.find_prev(10) == npos);
+
+    REQUIRE(bs.init(0));
+    REQUIRE(bs.none());
+    REQUIRE(bs.find_next(0) == npos);
+
+    REQUIRE(bs.init(1 << 24));
+    REQUIRE(bs.depth() == 4);
+    REQUIRE(bs.none());
+    bs.set(5).set(4096).set((1 << 24) - 1);
+    REQUIRE(bs.any());
+    REQUIRE(bs.find_first() == 5);
+    REQUIRE(bs.find_last() == (1 << 24) - 1);
+    REQUIRE(bs.find_next(5) == 4096);
+    REQUIRE(bs.find_next(4096) == (1 << 24) - 1);
+    REQUIRE(bs.find_next((1 << 24) - 1) == npos);
+    REQUIRE(bs.find_prev(1 << 24) == (1 << 24) - 1);
+    REQUIRE(bs.find_prev(4096) == 5);
+    REQUIRE(bs.find_prev(5) == npos);
+
+    bs.reset(5);
+    REQUIRE(bs.find_first() == 4096);
+    bs.reset(4096).reset((1 << 24) - 1);
+    REQUIRE(bs.none());
+    REQUIRE(bs.find_last() == npos);
+
+    kon::hierarchical_bitset other{std::move(bs)};
+    REQUIRE(other.size() == (1 << 24));
+    REQUIRE(bs.size() == 0);
+    other.set(7);
+    REQUIRE(other.find_first() == 7);
+    other.reset();
+    REQUIRE(other.none());
+}
+
+TEST_CASE("hierarchical_bitset_random", "[hierarchical_bitset]") {
+    constexpr auto npos = kon::hierarchical_bitset::npos;
+    std::mt19937 gen(17);
+    for (std::size_t size: {1, 63, 64, 65, 4095, 4096, 4097, 262147, 1000003}) {
+        kon::hierarchical_bitset bs;
+        REQUIRE(bs.init(size));
+        std::set<std::size_t> expected;
+        for (int round = 0; round < 2000; round++) {
+            std::size_t pos = gen() % size;
+            if ((gen() % 3) != 0) {
+                bs.set(pos);
+                expected.insert(pos);
+            } else {
+                bs.reset(pos);
+                expected.erase(pos);
+            }
+            REQUIRE(bs.test(pos) == expected.contains(pos));
+
+            std::size_t probe = gen() % size;
+            auto next = expected.upper_bound(probe);
+            REQUIRE(bs.find_next(probe) == ((next == expected.end()) ? npos : *next));
+            auto prev = expected.lower_bound(probe);
+            REQUIRE(bs.find_prev(probe) == ((prev == expected.begin()) ? npos : *--prev));
+        }
+        REQUIRE(bs.find_first() == (expected.empty() ? npos : *expected.begin()));
+        REQUIRE(bs.find_last() == (expected.empty() ? npos : *expected.rbegin()));
+
+        // The whole walk, and the set drained from the front like a priority index.
+        std::set<std::size_t> found;
+        for (auto pos = bs.find_first(); pos != npos; pos = bs.find_next(pos)) {
+            found.insert(pos);
+        }
+        REQUIRE(found == expected);
+        for (auto pos = bs.find_first(); pos != npos; pos = bs.find_first()) {
+            REQUIRE(pos == *expected.begin());
+            expected.erase(expected.begin());
+            bs.reset(pos);
+        }
+        REQUIRE(expected.empty());
+    }
+}
@@ -0,0 +1,169 @@
+#include <catch2/catch_test_macros.hpp>
+#include <kon/line_reader.hpp>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <vector>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+static std::vector<std::string> line_reader_write_test_file(
+    const std::filesystem::path &path,
+    std::size_t count,
+    bool trailing_newline) {
+    std::mt19937 gen(17);
+    std::vector<std::string> lines;
+    std::ofstream file(path, std::ios::binary);
+    for (std::size_t i = 0; i < count; i++) {
+        // Mostly short lines, some empty ones and some longer than the chunks.
+        std::size_t len = (i % 97 == 0) ? 5000 + gen() % 3000 : gen() % 80;
+        std::string line(len, '\0');
+        for (auto &c: line) {
+            c = static_cast<char>('a' + gen() % 26);
+        }
+        file << line;
+        if (trailing_newline || (i + 1 < count)) {
+            file << '\n';
+        }
+        lines.push_back(std::move(line));
+    }
+    return lines;
+}
+
+TEST_CASE("line_reader", "[line_reader]") {
+    auto dir = std::filesystem::temp_directory_path() / "kon_line_reader";
+    std::filesystem::remove_all(dir);
+    std::filesystem::create_directories(dir);
+
+    for (bool trailing_newline: {true, false}) {
+        auto path = (dir / (trailing_newline ? "lines" : "lines_unterminated")).string();
+        auto lines = line_reader_write_test_file(path, 2000, trailing_newline);
+        for (auto mode: {kon::read_mode::automatic, kon::read_mode::mmap, kon::read_mode::stream}) {
+            for (std::size_t chunk_size: {64, 4096, 1 << 20}) {
+                kon::line_reader reader;
+                REQUIRE(reader.open(path, mode, chunk_size) == 0);
+                std::string_view line;
+                std::size_t i = 0;
+                int ret;
+                while ((ret = reader.next(line)) == 1) {
+                    REQUIRE(i < lines.size());
+                    REQUIRE(line == lines[i]);
+                    i++;
+                }
+                REQUIRE(ret == 0);
+                REQUIRE(i == lines.size());
+            }
+        }
+    }
+
+    SECTION("empty") {
+        auto path = (dir / "empty").string();
+        std::ofstream{path};
+        for (auto mode: {kon::read_mode::automatic, kon::read_mode::mmap, kon::read_mode::stream}) {
+            kon::line_reader reader;
+            REQUIRE(reader.open(path, mode) == 0);
+            std::string_view line;
+            REQUIRE(reader.next(line) == 0);
+        }
+    }
+
+    SECTION("procfs") {
+        // A size of 0 but some content, it's streamed.
+        kon::line_reader reader;
+        REQUIRE(reader.open("/proc/self/status") == 0);
+        std::string_view line;
+        REQUIRE(reader.next(line) == 1);
+        REQUIRE(line.starts_with("Name:"));
+    }
+
+    SECTION("none") {
+        kon::line_reader reader;
+        REQUIRE(reader.open((dir / "none").string()) == -1);
+        std::string_view line;
+        REQUIRE(reader.next(line) == 0);
+    }
+    std::filesystem::remove_all(dir);
+}
+
+TEST_CASE("chunk_reader", "[line_reader]") {
+    auto path = (std::filesystem::temp_directory_path() / "kon_chunk_reader").string();
+    std::string content(100000, '\0');
+    for (std::size_t i = 0; i < content.size(); i++) {
+        content[i] = static_cast<char>(i * 131 + i / 4099);
+    }
+    std::ofstream{path, std::ios::binary}.write(content.data(), content.size());
+
+    for (auto mode: {kon::read_mode::mmap, kon::read_mode::stream}) {
+        kon::chunk_reader reader;
+        REQUIRE(reader.open(path, mode, 4096) == 0);
+        REQUIRE(reader.mapped() == (mode == kon::read_mode::mmap));
+        std::string data;
+        std::string_view chunk;
+        while (reader.next(chunk, 10) == 1) {
+            // The last 10 bytes of the previous chunk come first.
+            std::size_t carry = data.empty() ? 0 : 10;
+            REQUIRE(data.substr(data.size() - carry) == chunk.substr(0, carry));
+            data.append(chunk.substr(carry));
+        }
+        REQUIRE(data == content);
+    }
+    std::filesystem::remove(path);
+}
+
+TEST_CASE("chunk_reader_fifo", "[line_reader]") {
+    auto path = (std::filesystem::temp_directory_path() / "kon_chunk_reader_fifo").string();
+    std::filesystem::remove(path);
+    REQUIRE(::mkfifo(path.c_str(), 0600) == 0);
+    // Opened read-write, so neither the open of the reader nor its reads see the end of it.
+    int writer = ::open(path.c_str(), O_RDWR);
+    REQUIRE(writer >= 0);
+    {
+        kon::chunk_reader reader;
+        REQUIRE(reader.open(path, kon::read_mode::automatic, 4096) == 0);
+        REQUIRE_FALSE(reader.mapped());
+        std::string content(10000, 'x');
+        REQUIRE(::write(writer, content.data(), content.size()) == 10000);
+        std::string_view chunk;
+        REQUIRE(reader.next(chunk) == 1);
+        REQUIRE(chunk.size() == 4096);
+        REQUIRE(reader.next(chunk) == 1);
+        REQUIRE(chunk.size() == 4096);
+        // A short chunk is handed over, the reader thread then waits for the bytes that never
+        // come.
+        REQUIRE(reader.next(chunk) == 1);
+        REQUIRE(chunk.size() == 1808);
+        reader.close();
+        REQUIRE(reader.next(chunk) == -1);
+    }
+    ::close(writer);
+    std::filesystem::remove(path);
+}
+
+TEST_CASE("line_reader_fifo", "[line_reader]") {
+    auto path = (std::filesystem::temp_directory_path() / "kon_line_reader_fifo").string();
+    std::filesystem::remove(path);
+    REQUIRE(::mkfifo(path.c_str(), 0600) == 0);
+    int writer = ::open(path.c_str(), O_RDWR);
+    REQUIRE(writer >= 0);
+    {
+        // A line at a time, each one is read before the next one is written.
+        kon::line_reader reader;
+        REQUIRE(reader.open(path, kon::read_mode::automatic, 4096) == 0);
+        std::string_view line;
+        for (std::string text: {"first", "", "third"}) {
+            text += '\n';
+            REQUIRE(::write(writer, text.data(), text.size()) == static_cast<ssize_t>(text.size()));
+            REQUIRE(reader.next(line) == 1);
+            REQUIRE(line == text.substr(0, text.size() - 1));
+        }
+        // The rest of a line comes later.
+        REQUIRE(::write(writer, "fou", 3) == 3);
+        REQUIRE(::write(writer, "rth\n", 4) == 4);
+        REQUIRE(reader.next(line) == 1);
+        REQUIRE(line == "fourth");
+        reader.close();
+    }
+    ::close(writer);
+    std::filesystem::remove(path);
+}
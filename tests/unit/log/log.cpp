@@ -1,7 +1,27 @@
 #include <kon/log/log_sink_circular_buffer.hpp>
 #include <catch2/catch_test_macros.hpp>
+#include <algorithm>
+#include <string>
 #include <vector>
 
+namespace {
+// Writes more than the inline buffer of the logger, then throws.
+struct throwing_value {};
+} // namespace
+
+template <>
+struct fmt::formatter<throwing_value> {
+    constexpr auto parse(fmt::format_parse_context &ctx) {
+        return ctx.begin();
+    }
+
+    auto format(const throwing_value &, fmt::format_context &ctx) const -> decltype(ctx.out()) {
+        auto out = ctx.out();
+        out = std::fill_n(out, 4 * fmt::inline_buffer_size, 'x');
+        throw fmt::format_error{"throwing_value"};
+    }
+};
+
 TEST_CASE("basic", "[log_sink_cirular_buffer]") {
     constexpr std::size_t sink_buffer_size = 8;
     constexpr std::size_t input_buffer_size = 128;
@@ -152,4 +172,21 @@ TEST_CASE("read_slice of tail_space", "[log_sink_cirular_buffer]") {
             }
         }
     }
-}
\ No newline at end of file
+}
+
+TEST_CASE("print rewinds the arena on a throwing formatter", "[logger]") {
+    kon::log_sink_circular_buffer sink{};
+    REQUIRE(sink.initialize(64 * 1024) == 0);
+    kon::logger logger{};
+    logger.set_sink(kon::log_sink_circular_buffer::sink_if, &sink);
+
+    // A long message first, so that the arena has a chunk and the marker is stable.
+    logger.print("{}", std::string(4 * fmt::inline_buffer_size, 'y'));
+    auto point = kon::logger::tls_format_arena.mark();
+    for (unsigned i{}; i < 8; i++) {
+        REQUIRE_THROWS_AS(logger.print("{}", throwing_value{}), fmt::format_error);
+        auto after = kon::logger::tls_format_arena.mark();
+        REQUIRE(after.current == point.current);
+        REQUIRE(after.ptr == point.ptr);
+    }
+}
@@ -0,0 +1,88 @@
+#include <catch2/catch_test_macros.hpp>
+#include <kon/mapped_file.hpp>
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+TEST_CASE("mapped_file", "[mapped_file]") {
+    auto path = (std::filesystem::temp_directory_path() / "kon_mapped_file").string();
+    std::filesystem::remove(path);
+
+    SECTION("read_only") {
+        std::string content(10000, '\0');
+        for (std::size_t i = 0; i < content.size(); i++) {
+            content[i] = static_cast<char>(i * 131);
+        }
+        std::ofstream{path, std::ios::binary}.write(content.data(), content.size());
+        for (bool populate: {false, true}) {
+            for (bool huge_pages: {false, true}) {
+                int err;
+                kon::mapped_file file(
+                    err,
+                    path,
+                    {.populate = populate,
+                     .huge_pages = huge_pages,
+                     .advice = kon::file_advice::sequential});
+                REQUIRE(err == 0);
+                REQUIRE(file);
+                REQUIRE(file.size() == content.size());
+                file.prefetch(4000, 100000);
+                file.populate(1, 5000);
+                REQUIRE(std::string_view(file.data(), file.size()) == content);
+                // The released pages are read again.
+                file.release(0, 5000);
+                file.release(8000, 100000);
+                REQUIRE(std::string_view(file.data(), file.size()) == content);
+                // Read-only, it can't grow nor be written.
+                REQUIRE(file.resize(20000) != 0);
+                REQUIRE(file.write(0, "X", 1) == -1);
+                REQUIRE(file.data()[0] == content[0]);
+            }
+        }
+    }
+
+    SECTION("none") {
+        int err;
+        kon::mapped_file file(err, path);
+        REQUIRE(err != 0);
+        REQUIRE_FALSE(file);
+    }
+
+    SECTION("grow_on_write") {
+        int err;
+        kon::mapped_file file(err, path, {.writable = true, .reserve = 1 << 20});
+        REQUIRE(err == 0);
+        REQUIRE(file.size() == 0);
+        char *data = file.data();
+        std::string expected;
+        for (std::size_t i = 0; i < 1000; i++) {
+            auto record = std::to_string(i) + ";";
+            REQUIRE(file.write(expected.size(), record.data(), record.size()) == 0);
+            expected += record;
+        }
+        // Within the reservation, the data doesn't move.
+        REQUIRE(file.data() == data);
+        REQUIRE(std::string_view(file.data(), file.size()) == expected);
+
+        // Beyond the reservation, it moves.
+        std::string tail(2 << 20, 'x');
+        REQUIRE(file.write(expected.size(), tail.data(), tail.size()) == 0);
+        expected += tail;
+        REQUIRE(std::string_view(file.data(), file.size()) == expected);
+        REQUIRE(file.resize(100) == 0);
+        REQUIRE(file.size() == 100);
+        REQUIRE(file.sync() == 0);
+
+        kon::mapped_file moved = std::move(file);
+        REQUIRE_FALSE(file);
+        REQUIRE(moved.size() == 100);
+        moved = kon::mapped_file();
+        REQUIRE(std::filesystem::file_size(path) == 100);
+
+        std::ifstream stream(path, std::ios::binary);
+        std::string content(100, '\0');
+        stream.read(content.data(), content.size());
+        REQUIRE(content == expected.substr(0, 100));
+    }
+    std::filesystem::remove(path);
+}
@@ -0,0 +1,98 @@
+#include <catch2/catch_test_macros.hpp>
+#include <kon/mpmc_queue.hpp>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <vector>
+
+TEST_CASE("mpmc_queue", "[mpmc_queue]") {
+    auto q = std::make_unique<kon::mpmc_queue<std::uint32_t, 4>>();
+    REQUIRE(q->empty());
+    std::uint32_t v = 0;
+    REQUIRE_FALSE(q->try_pop(v));
+    for (std::uint32_t i = 0; i < 4; i++) {
+        REQUIRE(q->try_push(i));
+    }
+    REQUIRE_FALSE(q->try_push(4));
+    REQUIRE(q->size() == 4);
+    REQUIRE(q->try_pop(v));
+    REQUIRE(v == 0);
+    REQUIRE(q->try_push(4));
+
+    std::uint32_t out[8];
+    REQUIRE(q->try_pop_bulk(out, 8) == 4);
+    for (std::uint32_t i = 0; i < 4; i++) {
+        REQUIRE(out[i] == (i + 1));
+    }
+    REQUIRE(q->try_pop_bulk(out, 8) == 0);
+    REQUIRE(q->try_pop_bulk(out, 0) == 0);
+
+    std::uint32_t in[6] = {10, 11, 12, 13, 14, 15};
+    REQUIRE(q->try_push_bulk(in, 6) == 4);
+    REQUIRE(q->try_push_bulk(in, 6) == 0);
+    REQUIRE(q->try_pop_bulk(out, 3) == 3);
+    REQUIRE(q->try_push_bulk(in + 4, 2) == 2);
+    REQUIRE(q->try_pop_bulk(out + 3, 8) == 3);
+    REQUIRE(out[0] == 10);
+    REQUIRE(out[3] == 13);
+    REQUIRE(out[5] == 15);
+    REQUIRE(q->empty());
+}
+
+TEST_CASE("mpmc_queue_threads", "[mpmc_queue]") {
+    constexpr std::uint64_t per_producer = 50000;
+    constexpr int producers = 3;
+    constexpr int consumers = 3;
+    auto q = std::make_unique<kon::mpmc_queue<std::uint64_t, 128>>();
+    std::atomic<std::uint64_t> popped{0};
+    std::atomic<std::uint64_t> sum{0};
+    std::vector<std::thread> threads;
+    for (int p = 0; p < producers; p++) {
+        threads.emplace_back([&q, p]() {
+            std::uint64_t next = 0;
+            std::uint64_t batch[4];
+            while (next < per_producer) {
+                if ((next % 2) == 0) {
+                    next += q->try_push((p * per_producer) + next);
+                } else {
+                    std::size_t n = 0;
+                    for (; (n < 4) && ((next + n) < per_producer); n++) {
+                        batch[n] = (p * per_producer) + next + n;
+                    }
+                    next += q->try_push_bulk(batch, n);
+                }
+                std::this_thread::yield();
+            }
+        });
+    }
+    for (int c = 0; c < consumers; c++) {
+        threads.emplace_back([&q, &popped, &sum, c]() {
+            std::uint64_t batch[5];
+            std::uint64_t local = 0;
+            while (popped.load() < (producers * per_producer)) {
+                std::size_t n = 0;
+                if ((c % 2) == 0) {
+                    n = q->try_pop(batch[0]) ? 1 : 0;
+                } else {
+                    n = q->try_pop_bulk(batch, 5);
+                }
+                for (std::size_t i = 0; i < n; i++) {
+                    local += batch[i];
+                }
+                popped += n;
+                if (n == 0) {
+                    std::this_thread::yield();
+                }
+            }
+            sum += local;
+        });
+    }
+    for (auto &t: threads) {
+        t.join();
+    }
+    std::uint64_t total = producers * per_producer;
+    REQUIRE(popped == total);
+    REQUIRE(sum == (total * (total - 1) / 2));
+    REQUIRE(q->empty());
+}
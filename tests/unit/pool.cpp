@@ -0,0 +1,253 @@
+#include <catch2/catch_test_macros.hpp>
+#include <kon/pool.hpp>
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <set>
+#include <thread>
+#include <vector>
+
+TEST_CASE("get_put", "[pool]") {
+    int err;
+    kon::pool p{err, 100, 200, {.headroom = 32}};
+    REQUIRE(err == 0);
+    REQUIRE(p.count() == 200);
+    REQUIRE(p.available() == 200);
+
+    std::vector<void *> elements;
+    std::set<void *> unique;
+    for (int i = 0; i < 200; i++) {
+        auto e = p.get();
+        REQUIRE(e != nullptr);
+        REQUIRE((reinterpret_cast<std::uintptr_t>(e) & 63) == 0);
+        elements.push_back(e);
+        unique.insert(e);
+    }
+    REQUIRE(unique.size() == 200);
+    REQUIRE(p.get() == nullptr);
+    REQUIRE(p.available() == 0);
+
+    for (auto e: elements) {
+        p.put(e);
+    }
+    REQUIRE(p.available() == 200);
+    // The last one put is the first one got.
+    REQUIRE(p.get() == elements.back());
+}
+
+TEST_CASE("pool_dbuf", "[pool]") {
+    alignas(64) std::uint8_t region[64 * 5 + 8];
+    constexpr std::uintptr_t region_iova = 0x20008; // The first element is at +56.
+    int err;
+    kon::pool p{err, region, region_iova, sizeof(region), 64, {.headroom = 16}};
+    REQUIRE(err == 0);
+    REQUIRE(p.count() == 4);
+
+    kon::dbuf buf;
+    REQUIRE(p.get(buf));
+    REQUIRE((buf.iova() & 63) == 0);
+    REQUIRE(buf.iova() >= (region_iova + 56));
+    REQUIRE(buf.va() == (region + (buf.iova() - region_iova)));
+    REQUIRE(buf.capacity() == 64);
+    REQUIRE(buf.headroom() == 16);
+    REQUIRE(p.iova(buf.va()) == buf.iova());
+    p.put(buf);
+    REQUIRE(p.available() == 4);
+}
+
+TEST_CASE("pool_invalid", "[pool]") {
+    int err;
+    std::uint8_t region[64];
+    kon::pool p0{err, 0, 10};
+    REQUIRE(err == -2);
+    kon::pool p1{err, 64, 10, {.alignment = 48}};
+    REQUIRE(err == -2);
+    kon::pool p2{err, region, 0x1001, 32, 16};
+    REQUIRE(err == -2);
+}
+
+TEST_CASE("pool_multi_thread", "[pool]") {
+    constexpr int thread_num = 4;
+    constexpr int rounds = 20000;
+    int err;
+    kon::pool p{err, 64, 512};
+    REQUIRE(err == 0);
+
+    std::atomic<bool> shared{false};
+    auto worker = [&p, &shared](int id) {
+        std::vector<std::uint64_t *> held;
+        for (int r = 0; r < rounds; r++) {
+            auto e = static_cast<std::uint64_t *>(p.get());
+            if (e != nullptr) {
+                *e = id;
+                held.push_back(e);
+            }
+            if ((held.size() > 100) || ((e == nullptr) && !held.empty())) {
+                for (auto h: held) {
+                    if (*h != static_cast<std::uint64_t>(id)) {
+                        shared = true; // Handed to another thread too.
+                    }
+                    p.put(h);
+                }
+                held.clear();
+            }
+        }
+        for (auto h: held) {
+            p.put(h);
+        }
+    };
+    std::vector<std::thread> threads;
+    for (int i = 0; i < thread_num; i++) {
+        threads.emplace_back(worker, i);
+    }
+    for (auto &t: threads) {
+        t.join();
+    }
+    REQUIRE_FALSE(shared);
+    REQUIRE(p.available() == 512);
+    REQUIRE(kon::thread_slot() >= 0);
+}
+
+TEST_CASE("pool_thread_exit", "[pool]") {
+    int err;
+    kon::pool p{err, 64, 48};
+    REQUIRE(err == 0);
+
+    // The worker leaves all the buffers in its cache.
+    std::atomic<bool> exhausted{false};
+    std::thread worker{[&p, &exhausted]() {
+        void *elements[48];
+        for (auto &e: elements) {
+            e = p.get();
+            if (e == nullptr) {
+                exhausted = true;
+            }
+        }
+        for (auto e: elements) {
+            if (e != nullptr) {
+                p.put(e);
+            }
+        }
+    }};
+    worker.join();
+    REQUIRE_FALSE(exhausted);
+    REQUIRE(p.available() == 48);
+
+    std::set<void *> unique;
+    for (int i = 0; i < 48; i++) {
+        auto e = p.get();
+        REQUIRE(e != nullptr);
+        unique.insert(e);
+    }
+    REQUIRE(unique.size() == 48);
+    REQUIRE(p.get() == nullptr);
+    for (auto e: unique) {
+        p.put(e);
+    }
+}
+
+TEST_CASE("pool_bulk", "[pool]") {
+    int err;
+    kon::pool p{err, 64, 100};
+    REQUIRE(err == 0);
+
+    void *elements[100];
+    REQUIRE(p.get_bulk(elements, 10));
+    REQUIRE(p.get_bulk(elements + 10, 80)); // Bypasses the cache.
+    REQUIRE(!p.get_bulk(elements + 90, 20)); // All or nothing.
+    REQUIRE(p.available() == 10);
+    REQUIRE(p.get_bulk(elements + 90, 10));
+    REQUIRE(p.get() == nullptr);
+
+    std::set<void *> unique(elements, elements + 100);
+    REQUIRE(unique.size() == 100);
+
+    p.put_bulk(elements, 30);
+    p.put_bulk(elements + 30, 30); // Flushes the cache.
+    p.put_bulk(elements + 60, 40);
+    REQUIRE(p.available() == 100);
+
+    kon::dbuf bufs[100];
+    REQUIRE(p.get_bulk(bufs, 70));
+    REQUIRE(!p.get_bulk(bufs + 70, 40));
+    REQUIRE(p.available() == 30);
+    for (auto &buf: bufs) {
+        if (buf.va() == nullptr) {
+            continue;
+        }
+        REQUIRE(buf.iova() == reinterpret_cast<std::uintptr_t>(buf.va()));
+        REQUIRE(buf.capacity() == 64);
+    }
+    p.put_bulk(bufs, 70);
+    REQUIRE(p.available() == 100);
+}
+
+TEST_CASE("pool_huge_pages", "[pool]") {
+    int err;
+    SECTION("virtual") {
+        kon::pool p{err, 3000, 1500, {.headroom = 128, .huge_pages = true}};
+        REQUIRE(err == 0);
+
+        std::vector<kon::dbuf> bufs(1500);
+        REQUIRE(p.get_bulk(bufs.data(), bufs.size()));
+        for (auto &buf: bufs) {
+            auto va = reinterpret_cast<std::uintptr_t>(buf.va());
+            // Never crosses a huge page.
+            REQUIRE((va >> 21) == ((va + 2999) >> 21));
+            REQUIRE(buf.iova() == va);
+            REQUIRE(buf.headroom() == 128);
+            std::memset(buf.va(), 0x5A, 3000);
+        }
+        p.put_bulk(bufs.data(), bufs.size());
+        REQUIRE(p.available() == 1500);
+    }
+    SECTION("physical") {
+        // Needs the hugetlbfs pages and CAP_SYS_ADMIN.
+        kon::pool p{err, 2048, 2048, {.huge_pages = true, .physical_iova = true}};
+        REQUIRE(((err == 0) || (err == -3)));
+        if (err == 0) {
+            auto e0 = static_cast<std::uint8_t *>(p.get());
+            auto e1 = static_cast<std::uint8_t *>(p.get());
+            REQUIRE(p.iova(e0) != reinterpret_cast<std::uintptr_t>(e0));
+            REQUIRE(((p.iova(e1) - p.iova(e0)) == static_cast<std::uintptr_t>(e1 - e0)));
+        }
+    }
+}
+
+TEST_CASE("pool_multi_thread_bulk", "[pool]") {
+    constexpr int thread_num = 4;
+    constexpr int rounds = 5000;
+    int err;
+    kon::pool p{err, 64, 256};
+    REQUIRE(err == 0);
+
+    std::atomic<bool> shared{false};
+    auto worker = [&p, &shared](int id) {
+        std::uint64_t *elements[40];
+        for (int r = 0; r < rounds; r++) {
+            std::size_t n = 1 + ((r * 7 + id) % 40);
+            if (!p.get_bulk(reinterpret_cast<void **>(elements), n)) {
+                continue;
+            }
+            for (std::size_t i = 0; i < n; i++) {
+                *elements[i] = id;
+            }
+            for (std::size_t i = 0; i < n; i++) {
+                if (*elements[i] != static_cast<std::uint64_t>(id)) {
+                    shared = true;
+                }
+            }
+            p.put_bulk(reinterpret_cast<void **>(elements), n);
+        }
+    };
+    std::vector<std::thread> threads;
+    for (int i = 0; i < thread_num; i++) {
+        threads.emplace_back(worker, i);
+    }
+    for (auto &t: threads) {
+        t.join();
+    }
+    REQUIRE_FALSE(shared);
+    REQUIRE(p.available() == 256);
+}
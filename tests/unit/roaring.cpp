@@ -0,0 +1,362 @@
+#include <catch2/catch_test_macros.hpp>
+#include <kon/roaring.hpp>
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <new>
+#include <random>
+#include <set>
+#include <utility>
+#include <vector>
+
+namespace {
+std::vector<std::uint32_t> values_of(const auto &bitmap) {
+    std::vector<std::uint32_t> values;
+    bitmap.for_each([&values](std::uint32_t v) {
+        values.push_back(v);
+    });
+    return values;
+}
+
+bool same(const kon::roaring_bitmap &bitmap, const std::set<std::uint32_t> &expected) {
+    if (bitmap.cardinality() != expected.size()) {
+        return false;
+    }
+    auto values = values_of(bitmap);
+    return std::equal(values.begin(), values.end(), expected.begin(), expected.end());
+}
+
+// Sparse values over the whole range, a dense block under the key 7 and runs under the key 9.
+std::set<std::uint32_t> mixed_values(std::mt19937 &gen) {
+    std::set<std::uint32_t> values;
+    for (int i = 0; i < 3000; i++) {
+        values.insert(gen());
+    }
+    for (int i = 0; i < 30000; i++) {
+        values.insert((7u << 16) | (gen() & 0xFFFF));
+    }
+    for (std::uint32_t start = 0; start < 60000; start += 1000 + gen() % 1000) {
+        std::uint32_t length = 1 + gen() % 500;
+        for (std::uint32_t v = start; v < (start + length); v++) {
+            values.insert((9u << 16) | v);
+        }
+    }
+    return values;
+}
+
+kon::roaring_bitmap make_bitmap(const std::set<std::uint32_t> &values) {
+    kon::roaring_bitmap bitmap;
+    for (auto v: values) {
+        bitmap.add(v);
+    }
+    return bitmap;
+}
+
+struct aligned_buffer {
+    explicit aligned_buffer(std::size_t size)
+        : data{static_cast<std::uint8_t *>(::operator new(size, std::align_val_t{64}))} {
+    }
+
+    ~aligned_buffer() {
+        ::operator delete(data, std::align_val_t{64});
+    }
+
+    std::uint8_t *data;
+};
+} // namespace
+
+TEST_CASE("roaring_bitmap", "[roaring]") {
+    std::mt19937 gen(17);
+    auto expected = mixed_values(gen);
+    auto bitmap = make_bitmap(expected);
+    REQUIRE(same(bitmap, expected));
+    for (int i = 0; i < 10000; i++) {
+        std::uint32_t v = (i % 2) ? gen() : ((7u << 16) | (gen() & 0xFFFF));
+        REQUIRE(bitmap.contains(v) == expected.contains(v));
+    }
+    bool has_bitmap = false;
+    for (std::size_t i = 0; i < bitmap.container_count(); i++) {
+        has_bitmap |= bitmap.container(i).type == kon::roaring_container_type::bitmap;
+    }
+    REQUIRE(has_bitmap);
+
+    // Down to an array and back.
+    std::vector<std::uint32_t> dense;
+    for (auto v: expected) {
+        if ((v >> 16) == 7) {
+            dense.push_back(v);
+        }
+    }
+    std::shuffle(dense.begin(), dense.end(), gen);
+    for (std::size_t i = 0; i < dense.size(); i++) {
+        REQUIRE(bitmap.remove(dense[i]));
+        REQUIRE_FALSE(bitmap.remove(dense[i]));
+        expected.erase(dense[i]);
+        if ((i % 1000) == 0) {
+            REQUIRE(same(bitmap, expected));
+        }
+    }
+    REQUIRE(same(bitmap, expected));
+    for (auto v: dense) {
+        bitmap.add(v);
+        expected.insert(v);
+    }
+    REQUIRE(same(bitmap, expected));
+
+    bitmap.clear();
+    REQUIRE(bitmap.empty());
+    REQUIRE(bitmap.cardinality() == 0);
+    REQUIRE_FALSE(bitmap.remove(1));
+}
+
+TEST_CASE("roaring_bitmap_runs", "[roaring]") {
+    std::mt19937 gen(17);
+    auto expected = mixed_values(gen);
+    for (std::uint32_t v = 0; v < 65536; v++) {
+        expected.insert((11u << 16) | v);
+    }
+    expected.insert(0xFFFFFFFF);
+    auto bitmap = make_bitmap(expected);
+    std::size_t before = bitmap.memory_usage();
+    bitmap.run_optimize();
+    REQUIRE(bitmap.memory_usage() < before);
+    REQUIRE(same(bitmap, expected));
+    std::size_t runs = 0;
+    for (std::size_t i = 0; i < bitmap.container_count(); i++) {
+        runs += bitmap.container(i).type == kon::roaring_container_type::run;
+    }
+    REQUIRE(runs >= 2);
+    for (std::uint32_t v = (9u << 16); v < (10u << 16); v++) {
+        REQUIRE(bitmap.contains(v) == expected.contains(v));
+    }
+    REQUIRE(bitmap.contains((11u << 16) | 0xFFFF));
+
+    // A change turns a run back.
+    REQUIRE(bitmap.remove((11u << 16) | 100));
+    expected.erase((11u << 16) | 100);
+    bitmap.add((9u << 16) | 65535);
+    expected.insert((9u << 16) | 65535);
+    REQUIRE(same(bitmap, expected));
+}
+
+TEST_CASE("roaring_run_at_the_top", "[roaring]") {
+    // A run under the key 0xFFFF ending at 0xFFFFFFFF.
+    kon::roaring_bitmap bitmap;
+    std::set<std::uint32_t> expected;
+    for (std::uint32_t v = 0xFFFFFFF0; v != 0; v++) {
+        bitmap.add(v);
+        expected.insert(v);
+    }
+    bitmap.run_optimize();
+    REQUIRE(bitmap.container_count() == 1);
+    REQUIRE(bitmap.container(0).type == kon::roaring_container_type::run);
+    REQUIRE(same(bitmap, expected));
+
+    aligned_buffer buffer(bitmap.serialized_size());
+    bitmap.serialize(buffer.data);
+    kon::roaring_view view;
+    REQUIRE(view.init(buffer.data, bitmap.serialized_size()));
+    auto values = values_of(view);
+    REQUIRE(std::equal(values.begin(), values.end(), expected.begin(), expected.end()));
+}
+
+TEST_CASE("roaring_algebra", "[roaring]") {
+    std::mt19937 gen(17);
+    auto a_values = mixed_values(gen);
+    auto b_values = mixed_values(gen);
+    for (std::uint32_t v = 0; v < 40000; v += 3) {
+        b_values.insert((7u << 16) | v); // A bitmap and an array under 7.
+    }
+    auto a = make_bitmap(a_values);
+    auto b = make_bitmap(b_values);
+    std::set<std::uint32_t> and_values;
+    std::set<std::uint32_t> or_values;
+    std::set_intersection(
+        a_values.begin(),
+        a_values.end(),
+        b_values.begin(),
+        b_values.end(),
+        std::inserter(and_values, and_values.end()));
+    std::set_union(
+        a_values.begin(),
+        a_values.end(),
+        b_values.begin(),
+        b_values.end(),
+        std::inserter(or_values, or_values.end()));
+
+    for (int round = 0; round < 2; round++) {
+        REQUIRE(same(kon::roaring_and(a, b), and_values));
+        REQUIRE(same(kon::roaring_and(b, a), and_values));
+        REQUIRE(same(kon::roaring_or(a, b), or_values));
+        REQUIRE(kon::roaring_and_cardinality(a, b) == and_values.size());
+        REQUIRE(kon::roaring_and_cardinality(b, a) == and_values.size());
+        a.run_optimize(); // With the runs.
+    }
+
+    // Sparse arrays with many common values, the vector path and its tails.
+    kon::roaring_bitmap c;
+    kon::roaring_bitmap d;
+    std::set<std::uint32_t> c_values;
+    std::set<std::uint32_t> d_values;
+    for (std::uint32_t v = 0; v < 4000; v++) {
+        if ((gen() % 3) != 0) {
+            c.add(v * 2);
+            c_values.insert(v * 2);
+        }
+        if ((gen() % 3) != 0) {
+            d.add(v * 3);
+            d_values.insert(v * 3);
+        }
+    }
+    std::set<std::uint32_t> cd_values;
+    std::set_intersection(
+        c_values.begin(),
+        c_values.end(),
+        d_values.begin(),
+        d_values.end(),
+        std::inserter(cd_values, cd_values.end()));
+    REQUIRE(same(kon::roaring_and(c, d), cd_values));
+    REQUIRE(kon::roaring_and_cardinality(d, c) == cd_values.size());
+    REQUIRE(kon::roaring_and(c, kon::roaring_bitmap{}).empty());
+    REQUIRE(same(kon::roaring_or(c, kon::roaring_bitmap{}), c_values));
+}
+
+TEST_CASE("roaring_view", "[roaring]") {
+    std::mt19937 gen(17);
+    auto expected = mixed_values(gen);
+    auto bitmap = make_bitmap(expected);
+    bitmap.run_optimize();
+    std::size_t size = bitmap.serialized_size();
+    aligned_buffer buffer(size);
+    bitmap.serialize(buffer.data);
+
+    kon::roaring_view view;
+    REQUIRE(view.init(buffer.data, size));
+    REQUIRE(view.cardinality() == expected.size());
+    REQUIRE(view.container_count() == bitmap.container_count());
+    auto values = values_of(view);
+    REQUIRE(std::equal(values.begin(), values.end(), expected.begin(), expected.end()));
+    for (int i = 0; i < 10000; i++) {
+        std::uint32_t v = (i % 2) ? gen() : ((9u << 16) | (gen() & 0xFFFF));
+        REQUIRE(view.contains(v) == expected.contains(v));
+    }
+    REQUIRE(same(kon::roaring_and(view, bitmap), expected));
+    REQUIRE(same(kon::roaring_or(bitmap, view), expected));
+    REQUIRE(kon::roaring_and_cardinality(view, view) == expected.size());
+
+    REQUIRE_FALSE(view.init(buffer.data, size - 1));
+    REQUIRE_FALSE(view.init(buffer.data + 8, size - 8));
+    buffer.data[0] ^= 1;
+    REQUIRE_FALSE(view.init(buffer.data, size));
+    buffer.data[0] ^= 1;
+    REQUIRE(view.init(buffer.data, size));
+
+    kon::roaring_bitmap empty;
+    aligned_buffer small(empty.serialized_size());
+    empty.serialize(small.data);
+    REQUIRE(view.init(small.data, empty.serialized_size()));
+    REQUIRE(view.cardinality() == 0);
+    REQUIRE_FALSE(view.contains(0));
+}
+
+TEST_CASE("roaring_view_corrupted", "[roaring]") {
+    // An array under the key 1 and two runs under the key 2.
+    kon::roaring_bitmap bitmap;
+    for (std::uint32_t v: {1, 5, 9}) {
+        bitmap.add((1u << 16) | v);
+    }
+    for (std::uint32_t v = 100; v < 400; v++) {
+        if ((v < 200) || (v >= 300)) {
+            bitmap.add((2u << 16) | v);
+        }
+    }
+    bitmap.run_optimize();
+    REQUIRE(bitmap.container(0).type == kon::roaring_container_type::array);
+    REQUIRE(bitmap.container(1).type == kon::roaring_container_type::run);
+    std::size_t size = bitmap.serialized_size();
+    aligned_buffer buffer(size);
+    bitmap.serialize(buffer.data);
+    kon::roaring_view view;
+    REQUIRE(view.init(buffer.data, size));
+    auto payload = [&buffer](std::size_t index) {
+        kon::roaring_view::entry e;
+        std::memcpy(
+            &e, buffer.data + sizeof(kon::roaring_view::header) + index * sizeof(e), sizeof(e));
+        return reinterpret_cast<std::uint16_t *>(buffer.data + e.offset);
+    };
+    auto array = payload(0);
+    auto runs = payload(1);
+
+    // An unsorted array, then a repeated value.
+    std::swap(array[0], array[1]);
+    REQUIRE_FALSE(view.init(buffer.data, size));
+    array[0] = array[1];
+    REQUIRE_FALSE(view.init(buffer.data, size));
+    array[1] = 5;
+    REQUIRE(view.init(buffer.data, size));
+
+    // A run past 0xFFFF, then overlapping and unsorted runs.
+    runs[2] = 0xFF00;
+    runs[3] = 0x100;
+    REQUIRE_FALSE(view.init(buffer.data, size));
+    runs[2] = 150;
+    runs[3] = 99;
+    REQUIRE_FALSE(view.init(buffer.data, size));
+    runs[2] = 50;
+    REQUIRE_FALSE(view.init(buffer.data, size));
+    runs[2] = 0xFF00;
+    runs[3] = 99; // The same length.
+    REQUIRE(view.init(buffer.data, size));
+}
+
+TEST_CASE("roaring_view_wrong_cardinality", "[roaring]") {
+    // An array under the key 1, a bitmap under the key 2 and a run under the key 3.
+    kon::roaring_bitmap bitmap;
+    for (std::uint32_t v: {1, 5, 9}) {
+        bitmap.add((1u << 16) | v);
+    }
+    for (std::uint32_t v = 0; v < 10000; v += 2) {
+        bitmap.add((2u << 16) | v);
+    }
+    for (std::uint32_t v = 100; v < 300; v++) {
+        bitmap.add((3u << 16) | v);
+    }
+    bitmap.run_optimize();
+    REQUIRE(bitmap.container(1).type == kon::roaring_container_type::bitmap);
+    REQUIRE(bitmap.container(2).type == kon::roaring_container_type::run);
+    std::size_t size = bitmap.serialized_size();
+    aligned_buffer buffer(size);
+    bitmap.serialize(buffer.data);
+    kon::roaring_view view;
+    REQUIRE(view.init(buffer.data, size));
+    REQUIRE(view.cardinality() == 5203);
+
+    auto entry_at = [&buffer](std::size_t index) {
+        return buffer.data + sizeof(kon::roaring_view::header) +
+               index * sizeof(kon::roaring_view::entry);
+    };
+    auto set_cardinality = [&entry_at](std::size_t index, std::uint32_t cardinality) {
+        std::memcpy(
+            entry_at(index) + offsetof(kon::roaring_view::entry, cardinality),
+            &cardinality,
+            sizeof(cardinality));
+    };
+    for (std::size_t index: {0, 1, 2}) {
+        auto cardinality = bitmap.container(index).cardinality;
+        set_cardinality(index, cardinality + 1);
+        REQUIRE_FALSE(view.init(buffer.data, size));
+        set_cardinality(index, cardinality - 1);
+        REQUIRE_FALSE(view.init(buffer.data, size));
+        set_cardinality(index, cardinality);
+        REQUIRE(view.init(buffer.data, size));
+    }
+
+    // A bitmap of no more than array_max values is never written.
+    kon::roaring_view::entry e;
+    std::memcpy(&e, entry_at(1), sizeof(e));
+    auto words = reinterpret_cast<std::uint64_t *>(buffer.data + e.offset);
+    std::memset(words + 64, 0, (1024 - 64) * 8);
+    set_cardinality(1, 64 * 32);
+    REQUIRE_FALSE(view.init(buffer.data, size));
+}
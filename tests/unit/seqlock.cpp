@@ -0,0 +1,99 @@
+#include <catch2/catch_test_macros.hpp>
+#include <kon/seqlock.hpp>
+#include <atomic>
+#include <cstdint>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace {
+// Not a multiple of 8 bytes, every field is the same in a whole snapshot.
+struct snapshot {
+    std::uint32_t a;
+    std::uint32_t b;
+    std::uint16_t c[5];
+};
+
+snapshot make_snapshot(std::uint32_t v) {
+    auto low = static_cast<std::uint16_t>(v);
+    return {v, v, {low, low, low, low, low}};
+}
+
+bool whole(const snapshot &s) {
+    auto low = static_cast<std::uint16_t>(s.a);
+    for (auto e: s.c) {
+        if (e != low) {
+            return false;
+        }
+    }
+    return s.a == s.b;
+}
+} // namespace
+
+TEST_CASE("seqlock", "[seqlock]") {
+    kon::seqlock<snapshot> lock;
+    REQUIRE(whole(lock.load()));
+    REQUIRE(lock.load().a == 0);
+    lock.store(make_snapshot(7));
+    REQUIRE(lock.load().c[4] == 7);
+    lock.update([](snapshot &s) {
+        s = make_snapshot(s.a + 1);
+    });
+    REQUIRE(lock.load().a == 8);
+
+    kon::seqlock<int> value{42};
+    REQUIRE(value.load() == 42);
+}
+
+TEST_CASE("seqlock_update_throw", "[seqlock]") {
+    kon::seqlock<snapshot> lock{make_snapshot(3)};
+    REQUIRE_THROWS_AS(
+        lock.update([](snapshot &s) {
+            s = make_snapshot(9);
+            throw std::runtime_error{"update"};
+        }),
+        std::runtime_error);
+    // Unchanged, and neither the readers nor the writers are held off.
+    REQUIRE(lock.load().a == 3);
+    lock.store(make_snapshot(5));
+    REQUIRE(lock.load().c[0] == 5);
+}
+
+TEST_CASE("seqlock_concurrent", "[seqlock]") {
+    kon::seqlock<snapshot> lock;
+    std::atomic<bool> done{false};
+    std::atomic<bool> torn{false};
+    std::vector<std::thread> threads;
+    for (int i = 0; i < 2; i++) {
+        threads.emplace_back([&]() {
+            std::uint32_t last = 0;
+            while (!done) {
+                auto s = lock.load();
+                if (!whole(s) || (s.a < last)) {
+                    torn = true;
+                }
+                last = s.a;
+            }
+        });
+    }
+    // Two writers, the updates aren't lost.
+    std::thread writer([&]() {
+        for (int i = 0; i < 20000; i++) {
+            lock.update([](snapshot &s) {
+                s = make_snapshot(s.a + 1);
+            });
+        }
+    });
+    for (int i = 0; i < 20000; i++) {
+        lock.update([](snapshot &s) {
+            s = make_snapshot(s.a + 1);
+        });
+    }
+    writer.join();
+    done = true;
+    for (auto &t: threads) {
+        t.join();
+    }
+    REQUIRE_FALSE(torn);
+    REQUIRE(lock.load().a == 40000);
+}
@@ -1,6 +1,10 @@
 #include <catch2/catch_test_macros.hpp>
 #include <filesystem>
 #include <kon/shm.hpp>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <unistd.h>
 
 struct shm_test_data {
     std::uint64_t tag;
@@ -57,4 +61,44 @@ TEST_CASE("shm", "[shm]") {
         REQUIRE_FALSE(shm0.is_first());
     }
     std::filesystem::remove(shm_file_path, ec);
-}
\ No newline at end of file
+}
+
+TEST_CASE("shm_size_race", "[shm]") {
+    // The processes race to size a file left with no size, with different sizes. It's never
+    // shrunk under the mapping of one of them, which gets a SIGBUS then.
+    std::string shm_file{"shm_size_race_file"};
+    auto shm_file_path = std::filesystem::path{"/dev/shm"} / shm_file;
+    constexpr int processes = 4;
+    for (int round = 0; round < 20; round++) {
+        std::error_code ec;
+        std::filesystem::remove(shm_file_path, ec);
+        int fd = shm_open(shm_file.c_str(), O_CREAT | O_RDWR, 0600);
+        REQUIRE(fd >= 0);
+        close(fd);
+        pid_t pids[processes];
+        for (int i = 0; i < processes; i++) {
+            pids[i] = fork();
+            if (pids[i] == 0) {
+                std::size_t size = 4096 * (processes - i);
+                int err;
+                kon::shm shm(err, shm_file, size);
+                if (err == 0) {
+                    for (int j = 0; j < 100; j++) {
+                        static_cast<volatile char *>(shm.data())[size - 1] = 1;
+                        usleep(10);
+                    }
+                }
+                _exit(((err == 0) || (err == -1)) ? 0 : 1);
+            }
+        }
+        for (auto pid: pids) {
+            REQUIRE(pid > 0);
+            int status = -1;
+            REQUIRE(waitpid(pid, &status, 0) == pid);
+            REQUIRE(WIFEXITED(status));
+            REQUIRE(WEXITSTATUS(status) == 0);
+        }
+    }
+    std::error_code ec;
+    std::filesystem::remove(shm_file_path, ec);
+}
@@ -0,0 +1,191 @@
+#include <catch2/catch_test_macros.hpp>
+#include <kon/bitset.hpp>
+#include <kon/shm.hpp>
+#include <kon/shm_store.hpp>
+#include <kon/spsc_queue.hpp>
+#include <atomic>
+#include <cstdint>
+#include <filesystem>
+#include <sys/wait.h>
+#include <unistd.h>
+
+namespace {
+const std::string store_file{"shm_store_test_file"};
+constexpr std::size_t store_size = 64 * 1024;
+
+void remove_store_file() {
+    std::error_code ec;
+    std::filesystem::remove(std::filesystem::path{"/dev/shm"} / store_file, ec);
+}
+
+// A segment holding the state word only.
+void write_state(std::uint64_t state) {
+    int err;
+    kon::shm raw(err, store_file, store_size);
+    REQUIRE(err == 0);
+    static_cast<std::uint64_t *>(raw.data())[0] = state;
+}
+
+// A pid nobody has, the one of an exited child.
+pid_t dead_pid() {
+    pid_t pid = fork();
+    if (pid == 0) {
+        _exit(0);
+    }
+    waitpid(pid, nullptr, 0);
+    return pid;
+}
+} // namespace
+
+TEST_CASE("shm_store", "[shm_store]") {
+    remove_store_file();
+    using table = kon::bitset<1000, std::uint64_t>;
+    using queue = kon::spsc_queue<std::uint64_t, 16>;
+    {
+        int err;
+        kon::shm_store store(err, store_file, store_size, 3);
+        REQUIRE(err == 0);
+        REQUIRE(store.is_first());
+        REQUIRE(store.find("table") == nullptr);
+
+        auto *t = store.find_or_construct<table>("table");
+        REQUIRE(t != nullptr);
+        REQUIRE(t->none());
+        t->set(17);
+        t->set(999);
+        auto *q = store.find_or_construct<queue>("queue");
+        REQUIRE(q != nullptr);
+        REQUIRE(q->try_push(42));
+        REQUIRE(store.find_or_construct<table>("table") == t);
+
+        auto *block = static_cast<std::uint8_t *>(store.find_or_allocate("block", 100, 64));
+        REQUIRE(block != nullptr);
+        REQUIRE((reinterpret_cast<std::uintptr_t>(block) % 64) == 0);
+        REQUIRE(block[99] == 0);
+        block[99] = 7;
+        // The same name with another size or type.
+        REQUIRE(store.find_or_allocate("block", 101, 64) == nullptr);
+        REQUIRE(store.find<queue>("table") == nullptr);
+        REQUIRE(store.find_or_allocate(std::string(48, 'x'), 8) == nullptr);
+
+        std::uint64_t offset = store.allocate(8, 8);
+        REQUIRE(offset != 0);
+        *static_cast<std::uint64_t *>(store.at(offset)) = 0x1234;
+        *static_cast<std::uint64_t *>(store.find_or_allocate("offset", 8)) = offset;
+        REQUIRE(store.offset_of(store.at(offset)) == offset);
+
+        std::size_t available = store.available();
+        REQUIRE(store.allocate(available + 1, 1) == 0);
+        REQUIRE(store.allocate(available, 1) != 0);
+        REQUIRE(store.available() == 0);
+        REQUIRE(store.find_or_allocate("full", 1) == nullptr);
+    }
+    {
+        // Mapped again, at another address.
+        int err;
+        kon::shm_store store(err, store_file, store_size, 3);
+        REQUIRE(err == 0);
+        REQUIRE_FALSE(store.is_first());
+        auto *t = store.find<table>("table");
+        REQUIRE(t != nullptr);
+        REQUIRE((*t)[17]);
+        REQUIRE((*t)[999]);
+        REQUIRE(t->count() == 2);
+        std::uint64_t value = 0;
+        REQUIRE(store.find<queue>("queue")->try_pop(value));
+        REQUIRE(value == 42);
+        std::size_t size = 0;
+        auto *block = static_cast<std::uint8_t *>(store.find("block", &size));
+        REQUIRE(size == 100);
+        REQUIRE(block[99] == 7);
+        auto offset = *store.find<std::uint64_t>("offset");
+        REQUIRE(*static_cast<std::uint64_t *>(store.at(offset)) == 0x1234);
+    }
+    {
+        int err;
+        kon::shm_store store(err, store_file, store_size, 4);
+        REQUIRE(err == -8);
+        REQUIRE(store.find("table") == nullptr);
+    }
+    {
+        int err;
+        kon::shm_store store(err, store_file, store_size / 2, 3);
+        REQUIRE(err == -9);
+    }
+    {
+        int err;
+        kon::shm_store store(err, store_file, 64, 3);
+        REQUIRE(err == -6);
+    }
+    remove_store_file();
+}
+
+TEST_CASE("shm_store_not_a_store", "[shm_store]") {
+    // Ready but no magic, then the words of another program, they're left as they are.
+    const std::uint64_t states[]{0x2, 0x5, 0x0000123400000007, 0x0000123400000000};
+    for (auto state: states) {
+        remove_store_file();
+        write_state(state);
+        {
+            int err;
+            kon::shm_store store(err, store_file, store_size, 1);
+            REQUIRE(err == -7);
+            REQUIRE_FALSE(store.is_first());
+        }
+        int err;
+        kon::shm raw(err, store_file, store_size);
+        REQUIRE(err == 0);
+        REQUIRE(static_cast<std::uint64_t *>(raw.data())[0] == state);
+    }
+    remove_store_file();
+}
+
+TEST_CASE("shm_store_creator_crash", "[shm_store]") {
+    // The creator died initializing it, the state word holds its pid. 0 and the pids of the
+    // groups of processes are no owners.
+    const std::uint64_t pids[]{static_cast<std::uint64_t>(dead_pid()), 0, 0xFFFFFFFF};
+    for (auto pid: pids) {
+        remove_store_file();
+        write_state((pid << 32) | 1);
+        int err;
+        kon::shm_store store(err, store_file, store_size, 1);
+        REQUIRE(err == 0);
+        REQUIRE(store.is_first());
+        REQUIRE(store.find_or_allocate("block", 8) != nullptr);
+    }
+    remove_store_file();
+}
+
+TEST_CASE("shm_store_processes", "[shm_store]") {
+    remove_store_file();
+    constexpr std::uint64_t count = 10000;
+    // The child and the parent race to create the store and the counter.
+    pid_t pid = fork();
+    if (pid == 0) {
+        int err;
+        kon::shm_store store(err, store_file, store_size, 1);
+        auto *counter = store.find_or_construct<std::atomic<std::uint64_t>>("counter", 0u);
+        if ((err != 0) || (counter == nullptr)) {
+            _exit(1);
+        }
+        for (std::uint64_t i = 0; i < count; i++) {
+            counter->fetch_add(1, std::memory_order_relaxed);
+        }
+        _exit(0);
+    }
+    REQUIRE(pid > 0);
+    int err;
+    kon::shm_store store(err, store_file, store_size, 1);
+    REQUIRE(err == 0);
+    auto *counter = store.find_or_construct<std::atomic<std::uint64_t>>("counter", 0u);
+    REQUIRE(counter != nullptr);
+    for (std::uint64_t i = 0; i < count; i++) {
+        counter->fetch_add(1, std::memory_order_relaxed);
+    }
+    int status = -1;
+    REQUIRE(waitpid(pid, &status, 0) == pid);
+    REQUIRE(WIFEXITED(status));
+    REQUIRE(WEXITSTATUS(status) == 0);
+    REQUIRE(counter->load() == (2 * count));
+    remove_store_file();
+}
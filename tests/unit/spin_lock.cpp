@@ -1,5 +1,12 @@
 #include <catch2/catch_test_macros.hpp>
 #include <kon/spin_lock.hpp>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <shared_mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
 
 TEST_CASE("spin_lock", "[spin_lock]") {
     kon::spin_lock lock;
@@ -68,4 +75,121 @@ TEST_CASE("spin_lock", "[spin_lock]") {
         t.join();
         REQUIRE(shared_value == 2);
     }
-}
\ No newline at end of file
+}
+
+namespace {
+// Every thread adds to a plain counter under the lock.
+template <typename Lock>
+bool count_under_lock(Lock &lock) {
+    constexpr int thread_count = 4;
+    constexpr int iterations = 10000;
+    int counter = 0;
+    std::vector<std::thread> threads;
+    for (int i = 0; i < thread_count; i++) {
+        threads.emplace_back([&]() {
+            for (int j = 0; j < iterations; j++) {
+                if constexpr (std::is_same_v<Lock, kon::mcs_lock>) {
+                    kon::mcs_lock::guard guard{lock};
+                    counter++;
+                } else {
+                    std::lock_guard<Lock> guard{lock};
+                    counter++;
+                }
+            }
+        });
+    }
+    for (auto &t: threads) {
+        t.join();
+    }
+    return counter == thread_count * iterations;
+}
+} // namespace
+
+TEST_CASE("spin_lock_try_lock", "[spin_lock]") {
+    kon::spin_lock lock;
+    REQUIRE(lock.try_lock());
+    REQUIRE_FALSE(lock.try_lock());
+    lock.unlock();
+    REQUIRE(count_under_lock(lock));
+}
+
+TEST_CASE("ticket_lock", "[spin_lock]") {
+    kon::ticket_lock lock;
+    REQUIRE(lock.try_lock());
+    REQUIRE_FALSE(lock.try_lock());
+    lock.unlock();
+    lock.lock();
+    lock.unlock();
+    REQUIRE(count_under_lock(lock));
+    REQUIRE(lock.try_lock());
+    lock.unlock();
+}
+
+TEST_CASE("mcs_lock", "[spin_lock]") {
+    kon::mcs_lock lock;
+    kon::mcs_lock::node a;
+    kon::mcs_lock::node b;
+    REQUIRE(lock.try_lock(a));
+    REQUIRE_FALSE(lock.try_lock(b));
+
+    // The waiter is handed the lock in order.
+    std::atomic<int> stage{0};
+    std::thread t([&]() {
+        kon::mcs_lock::node n;
+        stage = 1;
+        lock.lock(n);
+        stage = 2;
+        lock.unlock(n);
+    });
+    while (stage != 1) {
+        std::this_thread::yield();
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    REQUIRE(stage == 1);
+    lock.unlock(a);
+    t.join();
+    REQUIRE(stage == 2);
+    REQUIRE(lock.try_lock(b));
+    lock.unlock(b);
+    REQUIRE(count_under_lock(lock));
+}
+
+TEST_CASE("rw_spin_lock", "[spin_lock]") {
+    kon::rw_spin_lock lock;
+    REQUIRE(lock.try_lock_shared());
+    REQUIRE(lock.try_lock_shared());
+    REQUIRE_FALSE(lock.try_lock());
+    lock.unlock_shared();
+    lock.unlock_shared();
+    REQUIRE(lock.try_lock());
+    REQUIRE_FALSE(lock.try_lock_shared());
+    lock.unlock();
+    REQUIRE(count_under_lock(lock));
+
+    // The readers never see a half written pair.
+    int pair[2] = {0, 0};
+    std::atomic<bool> done{false};
+    std::atomic<bool> torn{false};
+    std::vector<std::thread> readers;
+    for (int i = 0; i < 3; i++) {
+        readers.emplace_back([&]() {
+            while (!done) {
+                std::shared_lock<kon::rw_spin_lock> guard{lock};
+                if (pair[0] != pair[1]) {
+                    torn = true;
+                }
+            }
+        });
+    }
+    for (int i = 0; i < 10000; i++) {
+        std::unique_lock<kon::rw_spin_lock> guard{lock};
+        pair[0]++;
+        pair[1]++;
+    }
+    done = true;
+    for (auto &t: readers) {
+        t.join();
+    }
+    REQUIRE_FALSE(torn);
+    REQUIRE(pair[0] == 10000);
+}
@@ -0,0 +1,87 @@
+#include <catch2/catch_test_macros.hpp>
+#include <kon/spsc_queue.hpp>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace {
+struct event {
+    std::uint64_t sn;
+    std::uint32_t type;
+    std::uint32_t length;
+};
+} // namespace
+
+TEST_CASE("spsc_queue", "[spsc_queue]") {
+    auto q = std::make_unique<kon::spsc_queue<event, 8>>();
+    REQUIRE(q->empty());
+    REQUIRE(q->capacity() == 8);
+    event e{};
+    REQUIRE_FALSE(q->try_pop(e));
+    for (std::uint64_t i = 0; i < 8; i++) {
+        REQUIRE(q->try_push({i, 1, 2}));
+    }
+    REQUIRE_FALSE(q->try_push({8, 1, 2}));
+    REQUIRE(q->size() == 8);
+    for (std::uint64_t i = 0; i < 8; i++) {
+        REQUIRE(q->try_pop(e));
+        REQUIRE(e.sn == i);
+        REQUIRE(e.length == 2);
+    }
+    REQUIRE(q->empty());
+
+    // The bulk copies wrap around.
+    event in[6];
+    event out[8];
+    for (std::uint64_t round = 0; round < 5; round++) {
+        for (std::uint64_t i = 0; i < 6; i++) {
+            in[i] = {round * 6 + i, 0, 0};
+        }
+        REQUIRE(q->try_push_bulk(in, 6) == 6);
+        REQUIRE(q->try_push_bulk(in, 6) == 2);
+        REQUIRE(q->try_pop_bulk(out, 3) == 3);
+        REQUIRE(q->try_pop_bulk(out + 3, 8) == 5);
+        for (std::uint64_t i = 0; i < 6; i++) {
+            REQUIRE(out[i].sn == (round * 6 + i));
+        }
+        REQUIRE(out[6].sn == (round * 6));
+        REQUIRE(out[7].sn == (round * 6 + 1));
+        REQUIRE(q->try_pop_bulk(out, 8) == 0);
+    }
+}
+
+TEST_CASE("spsc_queue_threads", "[spsc_queue]") {
+    constexpr std::uint64_t count = 200000;
+    auto q = std::make_unique<kon::spsc_queue<std::uint64_t, 64>>();
+    std::thread producer([&q]() {
+        std::uint64_t next = 0;
+        std::uint64_t batch[5];
+        while (next < count) {
+            if ((next % 3) == 0) {
+                next += q->try_push(next);
+            } else {
+                std::size_t n = 0;
+                for (; (n < 5) && ((next + n) < count); n++) {
+                    batch[n] = next + n;
+                }
+                next += q->try_push_bulk(batch, n);
+            }
+        }
+    });
+    std::uint64_t expected = 0;
+    bool ordered = true;
+    std::uint64_t batch[7];
+    while (expected < count) {
+        std::size_t n = q->try_pop_bulk(batch, 7);
+        for (std::size_t i = 0; i < n; i++) {
+            ordered &= batch[i] == expected++;
+        }
+        if (n == 0) {
+            std::this_thread::yield();
+        }
+    }
+    producer.join();
+    REQUIRE(ordered);
+    REQUIRE(q->empty());
+}
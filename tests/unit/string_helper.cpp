@@ -1,5 +1,7 @@
 #include <catch2/catch_test_macros.hpp>
 #include <kon/string_helper.hpp>
+#include <random>
+#include <vector>
 
 TEST_CASE("string_splitter", "[string_helper]") {
     SECTION("empty0") {
@@ -100,4 +102,100 @@ TEST_CASE("string_splitter", "[string_helper]") {
 
         REQUIRE_FALSE(splitter.next(result));
     }
-}
\ No newline at end of file
+}
+
+static std::vector<std::size_t> field_offsets_ref(const std::string &input, char quote) {
+    std::vector<std::size_t> offsets;
+    bool in_quote = false;
+    for (std::size_t i = 0; i < input.size(); i++) {
+        char c = input[i];
+        if ((quote != '\0') && (c == quote)) {
+            in_quote = !in_quote;
+        } else if (!in_quote && ((c == ',') || (c == ';') || (c == '\t'))) {
+            offsets.push_back(i);
+        }
+    }
+    return offsets;
+}
+
+TEST_CASE("field_splitter", "[string_helper]") {
+    SECTION("empty") {
+        std::string input{""};
+        kon::field_splitter splitter(input.data(), input.size(), ",");
+        std::string_view result;
+        REQUIRE_FALSE(splitter.next(result));
+    }
+
+    SECTION("empty_fields") {
+        std::string input{",a,,b,"};
+        kon::field_splitter splitter(input.data(), input.size(), ",");
+        std::string_view result;
+        for (auto expected: {"", "a", "", "b", ""}) {
+            REQUIRE(splitter.next(result));
+            REQUIRE(result == expected);
+        }
+        REQUIRE_FALSE(splitter.next(result));
+    }
+
+    SECTION("delimiter_set") {
+        std::string input{"abc,de;f\tghij"};
+        kon::field_splitter splitter(input.data(), input.size(), ",;\t");
+        std::string_view result;
+        for (auto expected: {"abc", "de", "f", "ghij"}) {
+            REQUIRE(splitter.next(result));
+            REQUIRE(result == expected);
+        }
+        REQUIRE_FALSE(splitter.next(result));
+    }
+
+    SECTION("quoted") {
+        std::string input{"1,\"a,b\",\"c\"\"d,e\",2"};
+        kon::field_splitter splitter(input.data(), input.size(), ",", '"');
+        std::string_view result;
+        for (auto expected: {"1", "\"a,b\"", "\"c\"\"d,e\"", "2"}) {
+            REQUIRE(splitter.next(result));
+            REQUIRE(result == expected);
+        }
+        REQUIRE_FALSE(splitter.next(result));
+    }
+
+    SECTION("quoted_across_blocks") {
+        std::string quoted = "\"" + std::string(100, ',') + "\"";
+        std::string input = std::string(60, 'x') + "," + quoted + ",y";
+        kon::field_splitter splitter(input.data(), input.size(), ",", '"');
+        std::string_view result;
+        REQUIRE(splitter.next(result));
+        REQUIRE(result == std::string(60, 'x'));
+        REQUIRE(splitter.next(result));
+        REQUIRE(result == quoted);
+        REQUIRE(splitter.next(result));
+        REQUIRE(result == "y");
+        REQUIRE_FALSE(splitter.next(result));
+    }
+
+    SECTION("offsets") {
+        std::mt19937 gen(17);
+        const char alphabet[] = "ab,;\t\"";
+        for (std::size_t size: {1, 63, 64, 65, 127, 128, 1000, 4099}) {
+            std::string input(size, 'a');
+            for (auto &c: input) {
+                c = alphabet[gen() % (sizeof(alphabet) - 1)];
+            }
+            for (char quote: {'\0', '"'}) {
+                auto expected = field_offsets_ref(input, quote);
+                // A small capacity stops in the middle of the blocks.
+                for (std::size_t capacity: {1, 7, 64, 4096}) {
+                    kon::field_splitter splitter(input.data(), input.size(), ",;\t", quote);
+                    std::vector<std::size_t> offsets;
+                    std::vector<std::size_t> chunk(capacity);
+                    std::size_t n;
+                    do {
+                        n = splitter.next_offsets(chunk.data(), capacity);
+                        offsets.insert(offsets.end(), chunk.begin(), chunk.begin() + n);
+                    } while (n == capacity);
+                    REQUIRE(offsets == expected);
+                }
+            }
+        }
+    }
+}
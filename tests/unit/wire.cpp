@@ -0,0 +1,286 @@
+#include <catch2/catch_test_macros.hpp>
+#include <kon/wire.hpp>
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+namespace kon_wire_test {
+struct version : kon::wire_bits<4> {};
+struct ihl : kon::wire_bits<4> {};
+struct tos : kon::wire_uint<std::uint8_t> {};
+struct total_length : kon::wire_uint<std::uint16_t> {};
+struct id : kon::wire_uint<std::uint16_t> {};
+struct flags : kon::wire_bits<3> {};
+struct fragment_offset : kon::wire_bits<13> {};
+struct ttl : kon::wire_uint<std::uint8_t> {};
+struct protocol : kon::wire_uint<std::uint8_t> {};
+struct checksum : kon::wire_uint<std::uint16_t> {};
+struct source : kon::wire_uint<std::uint32_t> {};
+struct destination : kon::wire_uint<std::uint32_t> {};
+struct options : kon::wire_tail<ihl, 4, -20> {};
+
+using ipv4_header = kon::wire_layout<
+    version,
+    ihl,
+    tos,
+    total_length,
+    id,
+    flags,
+    fragment_offset,
+    ttl,
+    protocol,
+    checksum,
+    source,
+    destination,
+    options>;
+
+struct magic : kon::wire_const<std::uint16_t, 0xCAFE> {};
+struct count : kon::wire_uint<std::uint8_t> {};
+struct levels : kon::wire_array<std::uint32_t, 3> {};
+struct sequence : kon::wire_uint<std::uint64_t> {};
+struct reserved : kon::wire_bits<24> {};
+struct payload : kon::wire_tail<count, 2> {};
+
+using le_message = kon::wire_layout_le<magic, count, sequence, levels, payload>;
+using be_message = kon::wire_layout<magic, reserved, count, sequence, levels, payload>;
+} // namespace kon_wire_test
+
+using namespace kon_wire_test;
+
+static std::uint8_t ipv4_frame[28] = {
+    0x46, 0x00, 0x00, 0x1C, 0x1C, 0x46, 0x40, 0x00, 0x40, 0x06, 0xB1, 0xE6, 0xAC, 0x10,
+    0x0A, 0x63, 0xAC, 0x10, 0x0A, 0x0C, 0x01, 0x01, 0x08, 0x0A, 0xAA, 0xBB, 0xCC, 0xDD};
+
+TEST_CASE("ipv4_get", "[wire]") {
+    static_assert(ipv4_header::size == 20);
+    std::uint8_t frame[sizeof(ipv4_frame)];
+    std::memcpy(frame, ipv4_frame, sizeof(frame));
+    kon::wire_view<ipv4_header> view{frame, sizeof(frame)};
+
+    REQUIRE(view.validate());
+    REQUIRE(view.get<version>() == 4);
+    REQUIRE(view.get<ihl>() == 6);
+    REQUIRE(view.get<tos>() == 0);
+    REQUIRE(view.get<total_length>() == 0x1C);
+    REQUIRE(view.get<id>() == 0x1C46);
+    REQUIRE(view.get<flags>() == 2);
+    REQUIRE(view.get<fragment_offset>() == 0);
+    REQUIRE(view.get<ttl>() == 0x40);
+    REQUIRE(view.get<protocol>() == 6);
+    REQUIRE(view.get<checksum>() == 0xB1E6);
+    REQUIRE(view.get<source>() == 0xAC100A63);
+    REQUIRE(view.get<destination>() == 0xAC100A0C);
+    REQUIRE(view.tail().size() == 4);
+    REQUIRE(view.tail().data() == (frame + 20));
+
+    auto [v, h, length, i, f, o] =
+        view.read<version, ihl, total_length, id, flags, fragment_offset>();
+    REQUIRE(v == 4);
+    REQUIRE(h == 6);
+    REQUIRE(length == 0x1C);
+    REQUIRE(i == 0x1C46);
+    REQUIRE(f == 2);
+    REQUIRE(o == 0);
+
+    // 16 bytes, a load per field.
+    auto [t, s, d] = view.read<ttl, source, destination>();
+    REQUIRE(t == 0x40);
+    REQUIRE(s == 0xAC100A63);
+    REQUIRE(d == 0xAC100A0C);
+
+    SECTION("invalid") {
+        REQUIRE(!kon::wire_view<ipv4_header>{frame, 23}.validate()); // The options are cut.
+        REQUIRE(!kon::wire_view<ipv4_header>{frame, 19}.validate());
+        frame[0] = 0x44; // ihl < 5
+        REQUIRE(!view.validate());
+    }
+}
+
+TEST_CASE("ipv4_set", "[wire]") {
+    std::uint8_t frame[sizeof(ipv4_frame)] = {};
+    kon::dbuf buf;
+    buf.init(frame, 0, 0, sizeof(frame));
+    buf.append(sizeof(frame));
+    kon::wire_view<ipv4_header> view{buf};
+
+    view.set<version>(4);
+    view.set<ihl>(6);
+    view.set<total_length>(0x1C);
+    view.set<id>(0x1C46);
+    view.set<flags>(2);
+    view.set<fragment_offset>(0);
+    view.set<ttl>(0x40);
+    view.set<protocol>(6);
+    view.set<checksum>(0xB1E6);
+    view.set<source>(0xAC100A63);
+    view.set<destination>(0xAC100A0C);
+    std::memcpy(view.tail().data(), ipv4_frame + 20, view.tail().size());
+    REQUIRE(std::memcmp(frame, ipv4_frame, 24) == 0); // The header and its options.
+
+    // The neighbour bits are kept.
+    view.set<fragment_offset>(0x1FFF);
+    REQUIRE(view.get<flags>() == 2);
+    REQUIRE(view.get<fragment_offset>() == 0x1FFF);
+    view.set<flags>(0);
+    REQUIRE(view.get<fragment_offset>() == 0x1FFF);
+    REQUIRE(frame[6] == 0x1F);
+    REQUIRE(frame[7] == 0xFF);
+}
+
+TEST_CASE("little_endian_layout", "[wire]") {
+    static_assert(le_message::size == 23);
+    std::uint8_t frame[27] = {};
+    kon::wire_view<le_message> view{frame, sizeof(frame)};
+    REQUIRE(!view.validate());
+
+    view.set<magic>(0xCAFE);
+    view.set<count>(2);
+    view.set<sequence>(0x0123456789ABCDEFull);
+    view.set<levels>(0, 10);
+    view.set<levels>(2, 0x12345678);
+    REQUIRE(view.validate());
+    REQUIRE(frame[0] == 0xFE);
+    REQUIRE(frame[3] == 0xEF);
+    REQUIRE(frame[19] == 0x78);
+    REQUIRE(view.get<levels>(0) == 10);
+    REQUIRE(view.get<levels>(2) == 0x12345678);
+    REQUIRE(view.tail().size() == 4);
+
+    auto [m, c, s] = view.read<magic, count, sequence>();
+    REQUIRE(m == 0xCAFE);
+    REQUIRE(c == 2);
+    REQUIRE(s == 0x0123456789ABCDEFull);
+
+    view.set<count>(3); // The payload is cut.
+    REQUIRE(!view.validate());
+}
+
+TEST_CASE("big_endian_layout", "[wire]") {
+    static_assert(be_message::size == 26);
+    std::uint8_t frame[26] = {};
+    kon::wire_view<be_message> view{frame, sizeof(frame)};
+
+    view.set<magic>(0xCAFE);
+    view.set<reserved>(0xABCDEF);
+    view.set<sequence>(0x0123456789ABCDEFull);
+    REQUIRE(view.validate());
+    REQUIRE(frame[2] == 0xAB);
+    REQUIRE(frame[4] == 0xEF);
+    REQUIRE(view.get<reserved>() == 0xABCDEF);
+
+    auto [m, r, c, s] = view.read<magic, reserved, count, sequence>();
+    REQUIRE(m == 0xCAFE);
+    REQUIRE(r == 0xABCDEF);
+    REQUIRE(c == 0);
+    REQUIRE(s == 0x0123456789ABCDEFull);
+}
+
+namespace kon_wire_test {
+struct price : kon::wire_uint<std::uint32_t> {};
+struct quantity : kon::wire_uint<std::uint32_t> {};
+struct orders : kon::wire_uint<std::uint16_t> {};
+struct side : kon::wire_uint<std::uint8_t> {};
+struct level_flags : kon::wire_uint<std::uint8_t> {};
+struct timestamp : kon::wire_uint<std::uint64_t> {};
+struct venues : kon::wire_array<std::uint16_t, 4> {};
+struct prices : kon::wire_array<std::uint32_t, 2> {};
+struct sizes : kon::wire_array<std::uint64_t, 4> {};
+
+using level_record = kon::wire_layout<price, quantity, orders, side, level_flags>;
+using quote_record = kon::wire_layout<timestamp, price, quantity, venues>;
+using odd_record = kon::wire_layout<side, timestamp, prices>;
+using wide_record = kon::wire_layout<side, sizes>; // 33 bytes, too long a block for SIMD.
+
+// Swaps every element of size sizes[i] on its own.
+static std::vector<std::uint8_t> reference_byteswap(
+    const std::vector<std::uint8_t> &src,
+    std::initializer_list<std::size_t> sizes) {
+    std::vector<std::uint8_t> dst(src.size());
+    std::size_t offset = 0;
+    while (offset < src.size()) {
+        for (auto size: sizes) {
+            for (std::size_t i = 0; i < size; i++) {
+                dst[offset + i] = src[offset + size - 1 - i];
+            }
+            offset += size;
+        }
+    }
+    return dst;
+}
+
+template <typename Layout>
+static void check_byteswap(std::size_t count, std::initializer_list<std::size_t> sizes) {
+    std::vector<std::uint8_t> src(count * Layout::size);
+    for (std::size_t i = 0; i < src.size(); i++) {
+        src[i] = static_cast<std::uint8_t>(i * 7 + 3);
+    }
+    auto expected = reference_byteswap(src, sizes);
+
+    std::vector<std::uint8_t> dst(src.size());
+    kon::wire_byteswap<Layout>(dst.data(), src.data(), count);
+    REQUIRE(dst == expected);
+
+    auto in_place = src;
+    kon::wire_byteswap<Layout>(in_place.data(), in_place.data(), count);
+    REQUIRE(in_place == expected);
+
+    // The 16 bytes kernel, the neighbour masks pick nothing if no element crosses them.
+    auto plan = kon::detail::wire_byteswap_tables<Layout>::plan;
+    plan.crossing = true;
+    std::fill(dst.begin(), dst.end(), 0);
+    kon::detail::wire_byteswap(dst.data(), src.data(), count, plan);
+    REQUIRE(dst == expected);
+
+    // Without SIMD.
+    plan.block_size = 0;
+    std::fill(dst.begin(), dst.end(), 0);
+    kon::detail::wire_byteswap(dst.data(), src.data(), count, plan);
+    REQUIRE(dst == expected);
+    in_place = src;
+    kon::detail::wire_byteswap(in_place.data(), in_place.data(), count, plan);
+    REQUIRE(in_place == expected);
+}
+} // namespace kon_wire_test
+
+TEST_CASE("wire_byteswap", "[wire]") {
+    static_assert(level_record::size == 12);
+    using level_tables = kon::detail::wire_byteswap_tables<level_record>;
+    static_assert((level_tables::block_size == 96) && !level_tables::crossing);
+    using odd_tables = kon::detail::wire_byteswap_tables<odd_record>;
+    static_assert((odd_tables::block_size == 544) && odd_tables::crossing);
+    static_assert(kon::detail::wire_byteswap_tables<wide_record>::block_size == 0);
+    for (std::size_t count: {0, 1, 3, 4, 5, 17, 1000, 1001}) {
+        check_byteswap<level_record>(count, {4, 4, 2, 1, 1});
+        check_byteswap<quote_record>(count, {8, 4, 4, 2, 2, 2, 2});
+        check_byteswap<odd_record>(count, {1, 8, 4, 4});
+        check_byteswap<wide_record>(count, {1, 8, 8, 8, 8});
+    }
+}
+
+TEST_CASE("wire_byteswap_records", "[wire]") {
+    struct level {
+        std::uint32_t price;
+        std::uint32_t quantity;
+        std::uint16_t orders;
+        std::uint8_t side;
+        std::uint8_t flags;
+    };
+
+    level levels[100];
+    for (std::uint32_t i = 0; i < 100; i++) {
+        levels[i] = {
+            kon::byteswap(i * 100),
+            kon::byteswap(i + 1),
+            kon::byteswap(static_cast<std::uint16_t>(i)),
+            1,
+            2};
+    }
+    kon::wire_byteswap<level_record>(levels, 100);
+    for (std::uint32_t i = 0; i < 100; i++) {
+        REQUIRE(levels[i].price == i * 100);
+        REQUIRE(levels[i].quantity == i + 1);
+        REQUIRE(levels[i].orders == i);
+        REQUIRE(levels[i].side == 1);
+        REQUIRE(levels[i].flags == 2);
+    }
+}